@@ -0,0 +1,32 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+/**
+ * Time a callable and report its throughput as a row of the benchmark table; names longer than the name column
+ * simply push the rest of their row to the right.
+ * @param name the name of the step.
+ * @param n the number of items processed.
+ * @param unit the item name.
+ * @param fn the callable.
+ */
+template<typename Fn>
+void run(const std::string &name, std::size_t n, const std::string &unit, Fn fn) {
+
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto stop = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(stop - start).count();
+
+    std::cout << "| " << name << std::string(30 - std::min<std::size_t>(30, name.size()), ' ') << "| "
+              << static_cast<double>(n) / seconds / 1E6 << " M" << unit << "/s" << std::endl;
+
+}
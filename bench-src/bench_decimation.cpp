@@ -0,0 +1,97 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "mesh.hpp"
+#include "decimation.hpp"
+
+#include "bench_common.hpp"
+
+using namespace org::lesleisnagy::geomlib;
+
+/**
+ * A bumpy sphere: an octahedron whose faces are split into n x n triangles, projected onto a wavy radius.
+ */
+TriangleMesh<double> bumpy_sphere(std::size_t n) {
+
+    TriangleMesh<double> mesh;
+    const long m = long(n);
+
+    // Vertices are shared between faces through their lattice coordinates on the octahedron.
+    std::unordered_map<long, std::size_t> index;
+    auto vertex = [&](long x, long y, long z) {
+        auto [it, inserted] = index.try_emplace(((x + m) * (2 * m + 1) + (y + m)) * (2 * m + 1) + (z + m), 0);
+        std::size_t &v = it->second;
+        if (inserted) {
+            Vector3D<double> r(static_cast<double>(x), static_cast<double>(y), static_cast<double>(z));
+            r = r / sqrt(norm_squared(r));
+            const double radius = 1.0 + 0.05 * sin(12.0 * r.x()) * sin(10.0 * r.y()) * sin(8.0 * r.z());
+            v = mesh.vertices.size();
+            mesh.vertices.push_back(radius * r);
+        }
+        return v;
+    };
+
+    for (long sx: {-1, 1}) {
+        for (long sy: {-1, 1}) {
+            for (long sz: {-1, 1}) {
+                auto point = [&](long i, long j) { return vertex(sx * i, sy * j, sz * (m - i - j)); };
+                const bool flip = sx * sy * sz < 0;
+                auto add = [&](std::size_t a, std::size_t b, std::size_t c) {
+                    mesh.triangles.push_back(flip ? std::array<std::size_t, 3>{a, c, b}
+                                                  : std::array<std::size_t, 3>{a, b, c});
+                };
+                for (long i = 0; i < m; ++i) {
+                    for (long j = 0; i + j < m; ++j) {
+                        add(point(i, j), point(i + 1, j), point(i, j + 1));
+                        if (i + j + 2 <= m) add(point(i + 1, j), point(i + 1, j + 1), point(i, j + 1));
+                    }
+                }
+            }
+        }
+    }
+    return mesh;
+
+}
+
+int main() {
+
+    const TriangleMesh<double> mesh = bumpy_sphere(512);
+    const std::size_t target = mesh.n_triangles() / 20;
+    const std::size_t n_collapses = (mesh.n_triangles() - target) / 2;
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|           Decimation, " << mesh.n_triangles() << " to " << target << " triangles, "
+              << default_thread_count() << " threads" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+
+    std::size_t checksum = 0;
+
+    run("blocks", n_collapses, "collapses", [&] {
+        checksum += decimate(mesh, target).n_triangles();
+    });
+
+    run("blocks, serial", n_collapses, "collapses", [&] {
+        checksum += decimate(mesh, target, DecimationOptions(), 1).n_triangles();
+    });
+
+    DecimationOptions single_queue;
+    single_queue.block_triangles = 0;
+    run("single queue", n_collapses, "collapses", [&] {
+        checksum += decimate(mesh, target, single_queue).n_triangles();
+    });
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| checksum: " << checksum << std::endl;
+
+    return 0;
+
+}
@@ -0,0 +1,61 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "mesh.hpp"
+#include "delaunay.hpp"
+
+#include "bench_common.hpp"
+
+using namespace org::lesleisnagy::geomlib;
+
+int main() {
+
+    const std::size_t n_points = 1000000;
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    Vector3DSoA<double> points(n_points);
+    for (std::size_t i = 0; i < n_points; ++i) points.set(i, Vector3D<double>(dist(gen), dist(gen), dist(gen)));
+
+    // A lattice with many cospherical points exercises the exact predicates.
+    const std::size_t side = 100;
+    Vector3DSoA<double> lattice(side * side * side);
+    for (std::size_t i = 0; i < side * side * side; ++i) {
+        lattice.set(i, Vector3D<double>(double(i % side), double(i / side % side), double(i / side / side)));
+    }
+
+    // The number of tetrahedra, to report throughput in tetrahedra.
+    const std::size_t n_tetrahedra = delaunay_tetrahedralisation(points).n_tetrahedra();
+    const std::size_t n_lattice = delaunay_tetrahedralisation(lattice).n_tetrahedra();
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|           Delaunay, " << n_points << " points, " << n_tetrahedra << " tetrahedra, "
+              << default_thread_count() << " threads" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+
+    std::size_t checksum = 0;
+
+    run("random", n_tetrahedra, "tetrahedra", [&] {
+        checksum += delaunay_tetrahedralisation(points).n_tetrahedra();
+    });
+
+    run("random, serial", n_tetrahedra, "tetrahedra", [&] {
+        checksum += delaunay_tetrahedralisation(points, 1).n_tetrahedra();
+    });
+
+    run("lattice", n_lattice, "tetrahedra", [&] {
+        checksum += delaunay_tetrahedralisation(lattice).n_tetrahedra();
+    });
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| checksum: " << checksum << std::endl;
+
+    return 0;
+
+}
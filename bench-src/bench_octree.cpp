@@ -0,0 +1,79 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "octree.hpp"
+
+#include "bench_common.hpp"
+
+using namespace org::lesleisnagy::geomlib;
+
+int main() {
+
+    const std::size_t n = 10000000;
+    const std::size_t n_queries = 1000000;
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    Vector3DSoA<double> points(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        points.x()[i] = dist(gen);
+        points.y()[i] = dist(gen);
+        points.z()[i] = dist(gen);
+    }
+    Vector3DSoA<double> queries(n_queries);
+    for (std::size_t i = 0; i < n_queries; ++i) {
+        queries.x()[i] = dist(gen);
+        queries.y()[i] = dist(gen);
+        queries.z()[i] = dist(gen);
+    }
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|           linear octree, " << n << " uniform points, "
+              << default_thread_count() << " threads" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+
+    std::size_t checksum = 0;
+
+    run("build, serial", n, "points", [&] {
+        LinearOctree<double> octree(points, 32, 1);
+        checksum += octree.permutation()[0];
+    });
+
+    std::unique_ptr<LinearOctree<double>> octree;
+    run("build, parallel", n, "points", [&] {
+        octree = std::make_unique<LinearOctree<double>>(points, 32);
+        checksum += octree->permutation()[0];
+    });
+
+    std::vector<std::size_t> indices(n_queries * 8);
+    run("8 nearest, parallel", n_queries, "queries", [&] {
+        octree->nearest(queries, 8, indices.data());
+        checksum += indices[0];
+    });
+
+    run("radius 0.01, serial", n_queries / 10, "queries", [&] {
+        for (std::size_t q = 0; q < n_queries / 10; ++q) checksum += octree->within_radius(queries[q], 0.01).size();
+    });
+
+    run("box 0.02^3, serial", n_queries / 10, "queries", [&] {
+        for (std::size_t q = 0; q < n_queries / 10; ++q) {
+            checksum += octree->within_box(queries[q] - Vector3D<double>(0.01, 0.01, 0.01),
+                                           queries[q] + Vector3D<double>(0.01, 0.01, 0.01)).size();
+        }
+    });
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| checksum: " << checksum << std::endl;
+
+    return 0;
+
+}
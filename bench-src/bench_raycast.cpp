@@ -0,0 +1,111 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "mesh.hpp"
+#include "raycast.hpp"
+
+#include "bench_common.hpp"
+
+using namespace org::lesleisnagy::geomlib;
+
+/**
+ * A unit sphere built from an n_theta x n_phi latitude/longitude grid.
+ */
+TriangleMesh<double> sphere(std::size_t n_theta, std::size_t n_phi) {
+
+    TriangleMesh<double> mesh;
+    for (std::size_t i = 0; i <= n_theta; ++i) {
+        const double theta = M_PI * double(i) / double(n_theta);
+        for (std::size_t j = 0; j < n_phi; ++j) {
+            const double phi = 2.0 * M_PI * double(j) / double(n_phi);
+            mesh.vertices.push_back(Vector3D<double>(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta)));
+        }
+    }
+    for (std::size_t i = 0; i < n_theta; ++i) {
+        for (std::size_t j = 0; j < n_phi; ++j) {
+            const std::size_t a = i * n_phi + j, b = i * n_phi + (j + 1) % n_phi;
+            const std::size_t c = a + n_phi, d = b + n_phi;
+            if (i != 0) mesh.triangles.push_back({a, c, b});
+            if (i + 1 != n_theta) mesh.triangles.push_back({b, c, d});
+        }
+    }
+    return mesh;
+
+}
+
+int main() {
+
+    const std::size_t n_rays = 4000000;
+
+    TriangleMesh<double> mesh = sphere(256, 512);
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    // Coherent primary rays: a parallel beam, ordered row by row.
+    const std::size_t side = 2000;
+    Vector3DSoA<double> beam_origins(side * side), beam_directions(side * side);
+    for (std::size_t i = 0; i < side; ++i) {
+        for (std::size_t j = 0; j < side; ++j) {
+            beam_origins.set(i * side + j, Vector3D<double>(-1.2 + 2.4 * double(i) / side,
+                                                            -1.2 + 2.4 * double(j) / side, 3.0));
+            beam_directions.set(i * side + j, Vector3D<double>(0.0, 0.0, -1.0));
+        }
+    }
+    // Incoherent rays with random origins and directions.
+    Vector3DSoA<double> origins(n_rays), directions(n_rays);
+    for (std::size_t r = 0; r < n_rays; ++r) {
+        origins.set(r, Vector3D<double>(dist(gen), dist(gen), dist(gen)));
+        directions.set(r, Vector3D<double>(normal(gen), normal(gen), normal(gen)));
+    }
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|           triangle BVH, " << mesh.n_triangles() << " triangles, "
+              << default_thread_count() << " threads" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+
+    std::size_t checksum = 0;
+
+    std::unique_ptr<TriangleBvh<double>> bvh;
+    run("build", mesh.n_triangles(), "triangles", [&] {
+        bvh = std::make_unique<TriangleBvh<double>>(mesh);
+        checksum += bvh->nodes().size();
+    });
+
+    std::vector<RayHit<double>> hits(n_rays);
+    run("closest hit, beam", side * side, "rays", [&] {
+        bvh->intersect(beam_origins, beam_directions, hits.data());
+        checksum += hits[side * side / 2].triangle;
+    });
+
+    run("closest hit, beam, serial", side * side, "rays", [&] {
+        bvh->intersect(beam_origins, beam_directions, hits.data(), 1);
+        checksum += hits[side * side / 2].triangle;
+    });
+
+    run("closest hit, random", n_rays, "rays", [&] {
+        bvh->intersect(origins, directions, hits.data());
+        checksum += hits[0].triangle;
+    });
+
+    std::vector<std::size_t> crossings(n_rays);
+    run("crossings, random", n_rays, "rays", [&] {
+        bvh->count_crossings(origins, directions, crossings.data());
+        checksum += crossings[0];
+    });
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| checksum: " << checksum << std::endl;
+
+    return 0;
+
+}
@@ -0,0 +1,98 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#include <array>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "dual.hpp"
+
+#include "bench_common.hpp"
+
+using namespace org::lesleisnagy::geomlib;
+
+using Vec3D = Vector3D<double>;
+using Tet = std::array<Vec3D, 4>;
+
+/**
+ * Apply a callable to every tetrahedron and sum its results, a checksum that stops the work being optimised away.
+ * @param tets the tetrahedra.
+ * @param fn the callable (const Tet &) -> double.
+ * @return the checksum.
+ */
+template<typename Fn>
+double sum_over(const std::vector<Tet> &tets, Fn fn) {
+
+    double checksum = 0.0;
+    for (const Tet &t: tets) checksum += fn(t);
+    return checksum;
+
+}
+
+int main() {
+
+    const std::size_t n = 1000000;
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    std::vector<Tet> tets(n);
+    for (Tet &t: tets) {
+        for (Vec3D &r: t) r = Vec3D(dist(gen), dist(gen), dist(gen));
+    }
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|           gradient of tetrahedron_volume w.r.t. 12 vertex coordinates     |" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+
+    double sum = 0.0;
+
+    run("value only", n, "tet", [&] {
+        sum += sum_over(tets, [](const Tet &t) {
+            return tetrahedron_volume(t[0], t[1], t[2], t[3]);
+        });
+    });
+
+    run("forward finite differences", n, "tet", [&] {
+        sum += sum_over(tets, [](const Tet &t) {
+            const double h = 1E-7;
+            double v0 = tetrahedron_volume(t[0], t[1], t[2], t[3]);
+            double acc = 0.0;
+            for (std::size_t k = 0; k < 12; ++k) {
+                Tet p = t;
+                Vec3D dh(k % 3 == 0 ? h : 0.0, k % 3 == 1 ? h : 0.0, k % 3 == 2 ? h : 0.0);
+                p[k / 3] = p[k / 3] + dh;
+                acc += (tetrahedron_volume(p[0], p[1], p[2], p[3]) - v0) / h;
+            }
+            return acc;
+        });
+    });
+
+    run("Dual<double, 12>", n, "tet", [&] {
+        sum += sum_over(tets, [](const Tet &t) {
+            auto v = tetrahedron_volume(seed<12>(t[0], 0), seed<12>(t[1], 3), seed<12>(t[2], 6), seed<12>(t[3], 9));
+            double acc = 0.0;
+            for (double g: v.gradient()) acc += g;
+            return acc;
+        });
+    });
+
+    run("tetrahedron_volume_gradient", n, "tet", [&] {
+        sum += sum_over(tets, [](const Tet &t) {
+            auto g = tetrahedron_volume_gradient(t[0], t[1], t[2], t[3]);
+            double acc = 0.0;
+            for (const Vec3D &gi: g) acc += gi.x() + gi.y() + gi.z();
+            return acc;
+        });
+    });
+
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| checksum: " << sum << std::endl;
+
+    return 0;
+
+}
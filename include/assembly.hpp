@@ -0,0 +1,495 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+#include <colouring.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Return the gradients of the four barycentric coordinates (the P1 shape functions) of a tetrahedron. The
+     * gradient of the i-th coordinate is the inward normal of the opposite face scaled by the inverse height, which
+     * is independent of the orientation of the element; the gradients sum to zero.
+     * @param r1 vector representing a point on the tetrahedron.
+     * @param r2 vector representing a point on the tetrahedron.
+     * @param r3 vector representing a point on the tetrahedron.
+     * @param r4 vector representing a point on the tetrahedron.
+     * @return the barycentric coordinate gradients.
+     */
+    template<typename Real>
+    std::array<Vector3D<Real>, 4> barycentric_gradients(const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                                                        const Vector3D<Real> &r3, const Vector3D<Real> &r4) {
+
+        const Vector3D<Real> e12 = r2 - r1;
+        const Vector3D<Real> e13 = r3 - r1;
+        const Vector3D<Real> e14 = r4 - r1;
+
+        // Face area vectors (twice the area, outward for positively oriented elements), indexed by opposite vertex.
+        const Vector3D<Real> n4 = cross(e13, e12);
+        const Vector3D<Real> n3 = cross(e12, e14);
+        const Vector3D<Real> n2 = cross(e14, e13);
+
+        // 6V with the sign of tetrahedron_volume(); dividing by it flips the normals of negatively oriented elements.
+        const Real minus_inverse = Real(1) / dot(e12, n2);
+
+        const Vector3D<Real> g2 = minus_inverse * n2;
+        const Vector3D<Real> g3 = minus_inverse * n3;
+        const Vector3D<Real> g4 = minus_inverse * n4;
+
+        return {Real(-1) * ((g2 + g3) + g4), g2, g3, g4};
+
+    }
+
+    /**
+     * A sparse matrix in compressed sparse row form; the column indices of each row are sorted.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct CsrMatrix {
+
+        /** The start of each row in `columns` and `values`, n_rows() + 1 entries. */
+        std::vector<std::size_t> row_offsets;
+
+        /** The column index of each stored entry. */
+        std::vector<std::size_t> columns;
+
+        /** The value of each stored entry. */
+        std::vector<Real> values;
+
+        /**
+         * Retrieve the number of rows.
+         * @return the number of rows.
+         */
+        [[nodiscard]] inline std::size_t n_rows() const {
+            return row_offsets.empty() ? 0 : row_offsets.size() - 1;
+        }
+
+        /**
+         * Retrieve the number of stored entries.
+         * @return the number of stored entries.
+         */
+        [[nodiscard]] inline std::size_t n_nonzeros() const { return columns.size(); }
+
+        /**
+         * Retrieve an entry of the matrix by binary search of its row.
+         * @param i the row index.
+         * @param j the column index.
+         * @return the entry, zero if it is not stored.
+         */
+        [[nodiscard]] Real operator()(std::size_t i, std::size_t j) const {
+            auto first = columns.begin() + static_cast<std::ptrdiff_t>(row_offsets[i]);
+            auto last = columns.begin() + static_cast<std::ptrdiff_t>(row_offsets[i + 1]);
+            auto it = std::lower_bound(first, last, j);
+            if (it == last || *it != j) return Real(0);
+            return values[static_cast<std::size_t>(it - columns.begin())];
+        }
+
+        /**
+         * Compute y = A x in parallel over contiguous row ranges.
+         * @param x the input vector, n_rows() entries (the matrix is taken to be square).
+         * @param y the output vector, n_rows() entries.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void multiply(const Real *x, Real *y, std::size_t n_threads = 0) const {
+            parallel_for(0, n_rows(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    Real sum = Real(0);
+                    for (std::size_t k = row_offsets[i]; k < row_offsets[i + 1]; ++k) sum += values[k] * x[columns[k]];
+                    y[i] = sum;
+                }
+            }, n_threads);
+        }
+
+    };
+
+    /**
+     * The sparsity pattern of a P1 (vertex based) operator on a tetrahedral mesh, together with the maps needed to
+     * scatter element matrices into it. The pattern depends only on the connectivity, so it is built once and reused
+     * for every re-assembly after the vertices move or the coefficients change.
+     *
+     * Two maps are stored: for each element the 16 value slots of its local matrix (row major), and for each vertex
+     * the list of incident (element, local vertex) pairs. The latter lets the rows be accumulated independently of
+     * each other, which makes the parallel scatter free of atomics and its result independent of the thread count.
+     */
+    class AssemblyPattern {
+
+    public:
+
+        /**
+         * Build the pattern of a tetrahedral mesh.
+         * @param tetrahedra the four vertex indices of each tetrahedron.
+         * @param n_vertices the number of vertices (rows).
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        AssemblyPattern(const std::vector<std::array<std::size_t, 4>> &tetrahedra, std::size_t n_vertices,
+                        std::size_t n_threads = 0) : _n_elements(tetrahedra.size()) {
+
+            // Vertex to (element, local vertex) incidence by counting sort.
+            _incidence_offsets.assign(n_vertices + 1, 0);
+            for (const auto &t: tetrahedra) {
+                for (std::size_t v: t) {
+                    if (v >= n_vertices) throw std::out_of_range("AssemblyPattern: vertex index out of range");
+                    ++_incidence_offsets[v + 1];
+                }
+            }
+            for (std::size_t i = 0; i < n_vertices; ++i) _incidence_offsets[i + 1] += _incidence_offsets[i];
+            _incidences.resize(4 * _n_elements);
+            {
+                std::vector<std::size_t> fill(_incidence_offsets.begin(), _incidence_offsets.end() - 1);
+                for (std::size_t e = 0; e < _n_elements; ++e) {
+                    for (std::size_t a = 0; a < 4; ++a) _incidences[fill[tetrahedra[e][a]]++] = 4 * e + a;
+                }
+            }
+
+            // Row lengths, then the sorted column indices of each row, rows being independent.
+            _row_offsets.assign(n_vertices + 1, 0);
+            parallel_for(0, n_vertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::vector<std::size_t> scratch;
+                for (std::size_t i = begin; i < end; ++i) {
+                    row_columns(tetrahedra, i, scratch);
+                    _row_offsets[i + 1] = scratch.size();
+                }
+            }, n_threads);
+            for (std::size_t i = 0; i < n_vertices; ++i) _row_offsets[i + 1] += _row_offsets[i];
+
+            _columns.resize(_row_offsets[n_vertices]);
+            _element_slots.resize(16 * _n_elements);
+            parallel_for(0, n_vertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::vector<std::size_t> scratch;
+                for (std::size_t i = begin; i < end; ++i) {
+                    row_columns(tetrahedra, i, scratch);
+                    auto first = _columns.begin() + static_cast<std::ptrdiff_t>(_row_offsets[i]);
+                    auto last = _columns.begin() + static_cast<std::ptrdiff_t>(_row_offsets[i + 1]);
+                    std::copy(scratch.begin(), scratch.end(), first);
+                    // Row a of each incident element's local matrix lands in this row; every slot is written once.
+                    for (std::size_t k = _incidence_offsets[i]; k < _incidence_offsets[i + 1]; ++k) {
+                        const std::size_t e = _incidences[k] / 4, a = _incidences[k] % 4;
+                        for (std::size_t b = 0; b < 4; ++b) {
+                            auto it = std::lower_bound(first, last, tetrahedra[e][b]);
+                            _element_slots[16 * e + 4 * a + b] = static_cast<std::size_t>(it - _columns.begin());
+                        }
+                    }
+                }
+            }, n_threads);
+
+        }
+
+        /**
+         * Retrieve the number of rows (vertices).
+         * @return the number of rows.
+         */
+        [[nodiscard]] inline std::size_t n_rows() const { return _row_offsets.size() - 1; }
+
+        /**
+         * Retrieve the number of elements the pattern was built for.
+         * @return the number of elements.
+         */
+        [[nodiscard]] inline std::size_t n_elements() const { return _n_elements; }
+
+        /**
+         * Retrieve the number of stored entries.
+         * @return the number of stored entries.
+         */
+        [[nodiscard]] inline std::size_t n_nonzeros() const { return _columns.size(); }
+
+        /**
+         * Retrieve the row offsets of the CSR pattern.
+         * @return the row offsets, n_rows() + 1 entries.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &row_offsets() const { return _row_offsets; }
+
+        /**
+         * Retrieve the sorted column indices of the CSR pattern.
+         * @return the column indices.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &columns() const { return _columns; }
+
+        /**
+         * Retrieve the value slots of the element matrices: entry 16 e + 4 a + b is the position in the CSR values of
+         * local entry (a, b) of element e.
+         * @return the element slots.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &element_slots() const { return _element_slots; }
+
+        /**
+         * Retrieve the offsets of each vertex's incidence list.
+         * @return the incidence offsets, n_rows() + 1 entries.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &incidence_offsets() const { return _incidence_offsets; }
+
+        /**
+         * Retrieve the vertex incidences, each encoded as 4 e + a for local vertex a of element e.
+         * @return the incidences grouped by vertex.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &incidences() const { return _incidences; }
+
+        /**
+         * Create a matrix with this pattern and zero values.
+         * @return the matrix.
+         */
+        template<typename Real>
+        [[nodiscard]] CsrMatrix<Real> matrix() const {
+            CsrMatrix<Real> result;
+            result.row_offsets = _row_offsets;
+            result.columns = _columns;
+            result.values.assign(_columns.size(), Real(0));
+            return result;
+        }
+
+    private:
+
+        std::size_t _n_elements;
+
+        std::vector<std::size_t> _row_offsets;
+        std::vector<std::size_t> _columns;
+        std::vector<std::size_t> _element_slots;
+        std::vector<std::size_t> _incidence_offsets;
+        std::vector<std::size_t> _incidences;
+
+        /**
+         * Collect the sorted, unique vertices sharing an element with vertex i.
+         */
+        void row_columns(const std::vector<std::array<std::size_t, 4>> &tetrahedra, std::size_t i,
+                         std::vector<std::size_t> &scratch) const {
+            scratch.clear();
+            for (std::size_t k = _incidence_offsets[i]; k < _incidence_offsets[i + 1]; ++k) {
+                const auto &t = tetrahedra[_incidences[k] / 4];
+                scratch.insert(scratch.end(), t.begin(), t.end());
+            }
+            std::sort(scratch.begin(), scratch.end());
+            scratch.erase(std::unique(scratch.begin(), scratch.end()), scratch.end());
+        }
+
+    };
+
+    /**
+     * Assemble a P1 operator from element matrices. The element matrices are computed in parallel over elements
+     * into a scratch buffer, then every row gathers the contributions of its incident elements, so no two threads
+     * ever write the same entry and the result does not depend on the thread count.
+     * @tparam Kernel callable with signature void(std::size_t element, const Vector3D<Real> &r1,
+     * const Vector3D<Real> &r2, const Vector3D<Real> &r3, const Vector3D<Real> &r4, Real *local) writing the 4 x 4
+     * element matrix in row major order.
+     * @param mesh the tetrahedral mesh.
+     * @param pattern the pattern of the mesh's connectivity.
+     * @param kernel the element matrix kernel.
+     * @param matrix the output, which must have been created by pattern.matrix(); its values are overwritten.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real, typename Kernel>
+    void assemble(const TetrahedralMesh<Real> &mesh, const AssemblyPattern &pattern, Kernel kernel,
+                  CsrMatrix<Real> &matrix, std::size_t n_threads = 0) {
+
+        if (pattern.n_elements() != mesh.n_tetrahedra() || pattern.n_rows() != mesh.n_vertices()) {
+            throw std::invalid_argument("assemble: the pattern does not belong to the mesh");
+        }
+        if (matrix.values.size() != pattern.n_nonzeros()) {
+            throw std::invalid_argument("assemble: the matrix does not have the pattern's shape");
+        }
+
+        std::vector<Real> local(16 * mesh.n_tetrahedra());
+
+        parallel_for(0, mesh.n_tetrahedra(), [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t e = begin; e < end; ++e) {
+                const auto &t = mesh.tetrahedra[e];
+                kernel(e, mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]], mesh.vertices[t[3]],
+                       &local[16 * e]);
+            }
+        }, n_threads);
+
+        const std::vector<std::size_t> &offsets = pattern.incidence_offsets();
+        const std::vector<std::size_t> &incidences = pattern.incidences();
+        const std::vector<std::size_t> &slots = pattern.element_slots();
+
+        parallel_for(0, pattern.n_rows(), [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                for (std::size_t k = matrix.row_offsets[i]; k < matrix.row_offsets[i + 1]; ++k) {
+                    matrix.values[k] = Real(0);
+                }
+                for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                    const std::size_t row = 4 * incidences[k];
+                    for (std::size_t b = 0; b < 4; ++b) matrix.values[slots[row + b]] += local[row + b];
+                }
+            }
+        }, n_threads);
+
+    }
+
+    /**
+     * Assemble a P1 operator from element matrices by scattering them directly into the matrix, one colour of
+     * elements at a time. Elements of the same colour share no vertex and therefore no matrix entry, so the scatter
+     * needs neither atomics nor the scratch buffer of the gathering assemble(); the summation order, and hence the
+     * rounding, follows the colouring rather than the element order.
+     * @tparam Kernel callable as for the gathering assemble().
+     * @param mesh the tetrahedral mesh.
+     * @param pattern the pattern of the mesh's connectivity.
+     * @param colouring a colouring of the mesh's tetrahedra.
+     * @param kernel the element matrix kernel.
+     * @param matrix the output, which must have been created by pattern.matrix(); its values are overwritten.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real, typename Kernel>
+    void assemble(const TetrahedralMesh<Real> &mesh, const AssemblyPattern &pattern, const ElementColouring &colouring,
+                  Kernel kernel, CsrMatrix<Real> &matrix, std::size_t n_threads = 0) {
+
+        if (pattern.n_elements() != mesh.n_tetrahedra() || pattern.n_rows() != mesh.n_vertices() ||
+            colouring.n_elements() != mesh.n_tetrahedra()) {
+            throw std::invalid_argument("assemble: the pattern or colouring does not belong to the mesh");
+        }
+        if (matrix.values.size() != pattern.n_nonzeros()) {
+            throw std::invalid_argument("assemble: the matrix does not have the pattern's shape");
+        }
+
+        std::fill(matrix.values.begin(), matrix.values.end(), Real(0));
+
+        const std::vector<std::size_t> &slots = pattern.element_slots();
+
+        parallel_for_coloured(colouring, [&](std::size_t begin, std::size_t end, std::size_t) {
+            std::array<Real, 16> local;
+            for (std::size_t k = begin; k < end; ++k) {
+                const std::size_t e = colouring.elements()[k];
+                const auto &t = mesh.tetrahedra[e];
+                kernel(e, mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]], mesh.vertices[t[3]],
+                       local.data());
+                for (std::size_t ab = 0; ab < 16; ++ab) matrix.values[slots[16 * e + ab]] += local[ab];
+            }
+        }, n_threads);
+
+    }
+
+    /**
+     * The element kernel of the P1 stiffness matrix \f$K_{ij} = \int c \nabla\phi_i \cdot \nabla\phi_j\f$: each
+     * element contributes \f$c_e |V_e| \nabla\lambda_a \cdot \nabla\lambda_b\f$ using barycentric_gradients() and
+     * tetrahedron_volume().
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct StiffnessKernel {
+
+        /** Optional per-element coefficients c_e, nullptr for one. */
+        const Real *coefficients = nullptr;
+
+        void operator()(std::size_t e, const Vector3D<Real> &r1, const Vector3D<Real> &r2, const Vector3D<Real> &r3,
+                        const Vector3D<Real> &r4, Real *local) const {
+            const std::array<Vector3D<Real>, 4> g = barycentric_gradients(r1, r2, r3, r4);
+            Real volume = tetrahedron_volume(r1, r2, r3, r4);
+            if (volume < Real(0)) volume = Real(-1) * volume;
+            if (coefficients) volume = volume * coefficients[e];
+            for (std::size_t a = 0; a < 4; ++a) {
+                for (std::size_t b = a; b < 4; ++b) {
+                    local[4 * a + b] = volume * dot(g[a], g[b]);
+                    local[4 * b + a] = local[4 * a + b];
+                }
+            }
+        }
+
+    };
+
+    /**
+     * The element kernel of the consistent P1 mass matrix \f$M_{ij} = \int c \phi_i \phi_j\f$: each element
+     * contributes \f$c_e |V_e| (1 + \delta_{ab}) / 20\f$ using tetrahedron_volume().
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct MassKernel {
+
+        /** Optional per-element coefficients c_e, nullptr for one. */
+        const Real *coefficients = nullptr;
+
+        void operator()(std::size_t e, const Vector3D<Real> &r1, const Vector3D<Real> &r2, const Vector3D<Real> &r3,
+                        const Vector3D<Real> &r4, Real *local) const {
+            Real volume = tetrahedron_volume(r1, r2, r3, r4);
+            if (volume < Real(0)) volume = Real(-1) * volume;
+            if (coefficients) volume = volume * coefficients[e];
+            const Real off_diagonal = volume / Real(20);
+            const Real diagonal = volume / Real(10);
+            for (std::size_t a = 0; a < 4; ++a) {
+                for (std::size_t b = 0; b < 4; ++b) local[4 * a + b] = a == b ? diagonal : off_diagonal;
+            }
+        }
+
+    };
+
+    /**
+     * Assemble the P1 stiffness matrix of a tetrahedral mesh with StiffnessKernel.
+     * @param mesh the tetrahedral mesh.
+     * @param pattern the pattern of the mesh's connectivity.
+     * @param matrix the output, which must have been created by pattern.matrix(); its values are overwritten.
+     * @param coefficients optional per-element coefficients c_e, nullptr for one.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real>
+    void assemble_stiffness(const TetrahedralMesh<Real> &mesh, const AssemblyPattern &pattern,
+                            CsrMatrix<Real> &matrix, const std::type_identity_t<Real> *coefficients = nullptr,
+                            std::size_t n_threads = 0) {
+
+        assemble(mesh, pattern, StiffnessKernel<Real>{coefficients}, matrix, n_threads);
+
+    }
+
+    /**
+     * Assemble the P1 stiffness matrix of a tetrahedral mesh with StiffnessKernel, scattering by colour.
+     * @param mesh the tetrahedral mesh.
+     * @param pattern the pattern of the mesh's connectivity.
+     * @param colouring a colouring of the mesh's tetrahedra.
+     * @param matrix the output, which must have been created by pattern.matrix(); its values are overwritten.
+     * @param coefficients optional per-element coefficients c_e, nullptr for one.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real>
+    void assemble_stiffness(const TetrahedralMesh<Real> &mesh, const AssemblyPattern &pattern,
+                            const ElementColouring &colouring, CsrMatrix<Real> &matrix,
+                            const std::type_identity_t<Real> *coefficients = nullptr, std::size_t n_threads = 0) {
+
+        assemble(mesh, pattern, colouring, StiffnessKernel<Real>{coefficients}, matrix, n_threads);
+
+    }
+
+    /**
+     * Assemble the consistent P1 mass matrix of a tetrahedral mesh with MassKernel.
+     * @param mesh the tetrahedral mesh.
+     * @param pattern the pattern of the mesh's connectivity.
+     * @param matrix the output, which must have been created by pattern.matrix(); its values are overwritten.
+     * @param coefficients optional per-element coefficients c_e, nullptr for one.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real>
+    void assemble_mass(const TetrahedralMesh<Real> &mesh, const AssemblyPattern &pattern,
+                       CsrMatrix<Real> &matrix, const std::type_identity_t<Real> *coefficients = nullptr,
+                       std::size_t n_threads = 0) {
+
+        assemble(mesh, pattern, MassKernel<Real>{coefficients}, matrix, n_threads);
+
+    }
+
+    /**
+     * Assemble the consistent P1 mass matrix of a tetrahedral mesh with MassKernel, scattering by colour.
+     * @param mesh the tetrahedral mesh.
+     * @param pattern the pattern of the mesh's connectivity.
+     * @param colouring a colouring of the mesh's tetrahedra.
+     * @param matrix the output, which must have been created by pattern.matrix(); its values are overwritten.
+     * @param coefficients optional per-element coefficients c_e, nullptr for one.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real>
+    void assemble_mass(const TetrahedralMesh<Real> &mesh, const AssemblyPattern &pattern,
+                       const ElementColouring &colouring, CsrMatrix<Real> &matrix,
+                       const std::type_identity_t<Real> *coefficients = nullptr, std::size_t n_threads = 0) {
+
+        assemble(mesh, pattern, colouring, MassKernel<Real>{coefficients}, matrix, n_threads);
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,585 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Pre-computed, observer independent geometry of a triangular boundary panel shared by all potential kernels.
+     * Edge \f$j\f$ runs from \f$r_j\f$ to \f$r_{j+1}\f$ (indices modulo three), \f$\xi_j\f$ is its unit direction and
+     * \f$\eta_j = \hat{n} \times \xi_j\f$ its in-plane, inward pointing unit normal.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct TrianglePanel {
+
+        /** The vertices. */
+        std::array<Vector3D<Real>, 3> r;
+
+        /** The unit normal, as given by triangle_normal(). */
+        Vector3D<Real> normal;
+
+        /** The edge unit directions. */
+        std::array<Vector3D<Real>, 3> xi;
+
+        /** The in-plane inward edge normals. */
+        std::array<Vector3D<Real>, 3> eta;
+
+        /** The edge lengths. */
+        std::array<Real, 3> s;
+
+        /** The (unregularised) area. */
+        Real area;
+
+        /**
+         * Create a panel from the three vertices of a triangle.
+         * @param r1 vector representing a point on the triangle.
+         * @param r2 vector representing a point on the triangle.
+         * @param r3 vector representing a point on the triangle.
+         */
+        TrianglePanel(const Vector3D<Real> &r1, const Vector3D<Real> &r2, const Vector3D<Real> &r3)
+                : r{r1, r2, r3}, normal(triangle_normal(r1, r2, r3)) {
+
+            using std::sqrt;
+
+            for (int j = 0; j < 3; ++j) {
+                Vector3D<Real> e = r[(j + 1) % 3] - r[j];
+                s[j] = sqrt(dot(e, e));
+                xi[j] = e / s[j];
+                eta[j] = cross(normal, xi[j]);
+            }
+
+            Vector3D<Real> c = cross(r2 - r1, r3 - r1);
+            area = sqrt(dot(c, c)) / Real(2);
+
+        }
+
+    };
+
+    /**
+     * Return the signed solid angle subtended by a triangle at an observation point (Van Oosterom & Strackee).
+     * The solid angle is positive when the observer lies behind the triangle, i.e. on the side opposite to
+     * triangle_normal(), so that the solid angles of a closed, outward wound surface sum to \f$4\pi\f$ at interior
+     * points and to zero at exterior points. It equals \f$\int_T \hat{n} \cdot (r' - r) / |r' - r|^3\, dA'\f$. On the
+     * triangle itself the solid angle jumps by \f$4\pi\f$ and the sign returned is that of the rounded triple product.
+     * @param r the observation point.
+     * @param r1 vector representing a point on the triangle.
+     * @param r2 vector representing a point on the triangle.
+     * @param r3 vector representing a point on the triangle.
+     * @return the solid angle in steradians.
+     */
+    template<typename Real>
+    Real solid_angle(const Vector3D<Real> &r, const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                     const Vector3D<Real> &r3) {
+
+        using std::atan2;
+        using std::sqrt;
+
+        const Vector3D<Real> a = r1 - r;
+        const Vector3D<Real> b = r2 - r;
+        const Vector3D<Real> c = r3 - r;
+
+        const Real la = sqrt(dot(a, a));
+        const Real lb = sqrt(dot(b, b));
+        const Real lc = sqrt(dot(c, c));
+
+        const Real numerator = dot(a, cross(b, c));
+        const Real denominator = la * lb * lc + dot(a, b) * lc + dot(a, c) * lb + dot(b, c) * la;
+
+        return Real(2) * atan2(numerator, denominator);
+
+    }
+
+    namespace detail {
+
+        /**
+         * Observer dependent edge quantities of a panel.
+         */
+        template<typename Real>
+        struct PanelEdgeIntegrals {
+
+            /** The signed height \f$\zeta = \hat{n} \cdot (r_1 - r)\f$ of the panel above the observer. */
+            Real zeta;
+
+            /** The line integrals \f$P_j = \int_{e_j} 1/R\, ds\f$. */
+            std::array<Real, 3> p;
+
+            /** The in-plane distances \f$t_j\f$ of the projected observer from the edge lines (positive inside). */
+            std::array<Real, 3> t;
+
+            /** The distances \f$|r_j - r|\f$. */
+            std::array<Real, 3> distance;
+
+            /** The projections \f$\xi_j \cdot (r_j - r)\f$ and \f$\xi_j \cdot (r_{j+1} - r)\f$. */
+            std::array<Real, 3> l_minus;
+            std::array<Real, 3> l_plus;
+
+        };
+
+        template<typename Real>
+        PanelEdgeIntegrals<Real> panel_edge_integrals(const TrianglePanel<Real> &panel, const Vector3D<Real> &r) {
+
+            using std::log;
+            using std::sqrt;
+
+            PanelEdgeIntegrals<Real> e;
+
+            std::array<Vector3D<Real>, 3> rho = {panel.r[0] - r, panel.r[1] - r, panel.r[2] - r};
+            for (int j = 0; j < 3; ++j) e.distance[j] = sqrt(dot(rho[j], rho[j]));
+
+            e.zeta = dot(panel.normal, rho[0]);
+
+            for (int j = 0; j < 3; ++j) {
+
+                const int k = (j + 1) % 3;
+
+                e.t[j] = Real(-1) * dot(panel.eta[j], rho[j]);
+                e.l_minus[j] = dot(panel.xi[j], rho[j]);
+                e.l_plus[j] = dot(panel.xi[j], rho[k]);
+
+                // ln((R- + R+ + s) / (R- + R+ - s)), the denominator only vanishes for observers on the edge itself
+                // where every term that uses P_j carries a vanishing factor (t_j or zeta).
+                const Real sum = e.distance[j] + e.distance[k];
+                const Real den = sum - panel.s[j];
+                e.p[j] = den > Real(0) ? Real(log((sum + panel.s[j]) / den)) : Real(0);
+
+            }
+
+            return e;
+
+        }
+
+        template<typename Real>
+        Real single_layer_from_edges(const PanelEdgeIntegrals<Real> &e, const Real &omega) {
+
+            Real result = Real(0);
+            for (int j = 0; j < 3; ++j) result = result + e.t[j] * e.p[j];
+
+            Real abs_zeta = e.zeta < Real(0) ? Real(-1) * e.zeta : e.zeta;
+            Real abs_omega = omega < Real(0) ? Real(-1) * omega : omega;
+
+            return result - abs_zeta * abs_omega;
+
+        }
+
+    } // namespace detail
+
+    /**
+     * Return the single-layer integral of a unit density over a triangle, \f$\int_T 1 / |r - r'|\, dA'\f$, in closed
+     * form (Wilton et al.): \f$\sum_j t_j P_j - |\zeta|\,|\Omega|\f$. No \f$1/4\pi\f$ factor is applied.
+     * @param r the observation point.
+     * @param panel the triangle panel.
+     * @return the single-layer integral.
+     */
+    template<typename Real>
+    Real single_layer(const Vector3D<Real> &r, const TrianglePanel<Real> &panel) {
+
+        const auto e = detail::panel_edge_integrals(panel, r);
+        const Real omega = solid_angle(r, panel.r[0], panel.r[1], panel.r[2]);
+
+        return detail::single_layer_from_edges(e, omega);
+
+    }
+
+    /**
+     * Return the single-layer integral of a unit density over a triangle.
+     * @param r the observation point.
+     * @param r1 vector representing a point on the triangle.
+     * @param r2 vector representing a point on the triangle.
+     * @param r3 vector representing a point on the triangle.
+     * @return the single-layer integral.
+     */
+    template<typename Real>
+    Real single_layer(const Vector3D<Real> &r, const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                      const Vector3D<Real> &r3) {
+
+        return single_layer(r, TrianglePanel<Real>(r1, r2, r3));
+
+    }
+
+    /**
+     * Return the single-layer integrals of the three linear (hat) basis functions of a triangle,
+     * \f$\int_T \phi_i(r') / |r - r'|\, dA'\f$; they sum to single_layer(). No \f$1/4\pi\f$ factor is applied.
+     * @param r the observation point.
+     * @param panel the triangle panel.
+     * @return the three basis function integrals, ordered as the panel vertices.
+     */
+    template<typename Real>
+    std::array<Real, 3> single_layer_linear(const Vector3D<Real> &r, const TrianglePanel<Real> &panel) {
+
+        const auto e = detail::panel_edge_integrals(panel, r);
+        const Real omega = solid_angle(r, panel.r[0], panel.r[1], panel.r[2]);
+        const Real s0 = detail::single_layer_from_edges(e, omega);
+
+        // Q_j = int_{e_j} R ds = (l+ R+ - l- R- + R0^2 P_j) / 2.
+        std::array<Real, 3> q;
+        for (int j = 0; j < 3; ++j) {
+            const int k = (j + 1) % 3;
+            const Real r0_squared = e.t[j] * e.t[j] + e.zeta * e.zeta;
+            q[j] = (e.l_plus[j] * e.distance[k] - e.l_minus[j] * e.distance[j] + r0_squared * e.p[j]) / Real(2);
+        }
+
+        std::array<Real, 3> result;
+        for (int i = 0; i < 3; ++i) {
+            const int m = (i + 1) % 3;
+            Real sum = Real(0);
+            for (int j = 0; j < 3; ++j) sum = sum + dot(panel.xi[m], panel.xi[j]) * q[j];
+            const Real offset = dot(panel.eta[m], panel.r[m] - r);
+            result[i] = panel.s[m] / (Real(2) * panel.area) * (Real(-1) * sum - offset * s0);
+        }
+
+        return result;
+
+    }
+
+    /**
+     * Return the double-layer integrals of the three linear (hat) basis functions of a triangle (Lindholm),
+     * \f$\int_T \phi_i(r')\, \hat{n} \cdot (r' - r) / |r' - r|^3\, dA'\f$; they sum to solid_angle(). No
+     * \f$1/4\pi\f$ factor is applied.
+     * @param r the observation point.
+     * @param panel the triangle panel.
+     * @return the three basis function integrals, ordered as the panel vertices.
+     */
+    template<typename Real>
+    std::array<Real, 3> double_layer_linear(const Vector3D<Real> &r, const TrianglePanel<Real> &panel) {
+
+        const auto e = detail::panel_edge_integrals(panel, r);
+        const Real omega = solid_angle(r, panel.r[0], panel.r[1], panel.r[2]);
+
+        std::array<Real, 3> result;
+        for (int i = 0; i < 3; ++i) {
+            const int m = (i + 1) % 3;
+            Real sum = Real(0);
+            for (int j = 0; j < 3; ++j) sum = sum + dot(panel.xi[m], panel.xi[j]) * e.p[j];
+            const Real offset = dot(panel.eta[m], panel.r[m] - r);
+            result[i] = panel.s[m] / (Real(2) * panel.area) * (e.zeta * sum - offset * omega);
+        }
+
+        return result;
+
+    }
+
+    /**
+     * Return the double-layer integrals of the three linear basis functions of a triangle.
+     * @param r the observation point.
+     * @param r1 vector representing a point on the triangle.
+     * @param r2 vector representing a point on the triangle.
+     * @param r3 vector representing a point on the triangle.
+     * @return the three basis function integrals, ordered as r1, r2 & r3.
+     */
+    template<typename Real>
+    std::array<Real, 3> double_layer_linear(const Vector3D<Real> &r, const Vector3D<Real> &r1,
+                                            const Vector3D<Real> &r2, const Vector3D<Real> &r3) {
+
+        return double_layer_linear(r, TrianglePanel<Real>(r1, r2, r3));
+
+    }
+
+    /**
+     * Return the single-layer integrals of the three linear basis functions of a triangle.
+     * @param r the observation point.
+     * @param r1 vector representing a point on the triangle.
+     * @param r2 vector representing a point on the triangle.
+     * @param r3 vector representing a point on the triangle.
+     * @return the three basis function integrals, ordered as r1, r2 & r3.
+     */
+    template<typename Real>
+    std::array<Real, 3> single_layer_linear(const Vector3D<Real> &r, const Vector3D<Real> &r1,
+                                            const Vector3D<Real> &r2, const Vector3D<Real> &r3) {
+
+        return single_layer_linear(r, TrianglePanel<Real>(r1, r2, r3));
+
+    }
+
+    /**
+     * The boundary-element interaction kernels available for batch evaluation.
+     */
+    enum class BemKernel {
+        /** Solid angle per (target, triangle), see solid_angle(). */
+        SolidAngle,
+        /** Single layer of a unit density per (target, triangle), see single_layer(). */
+        SingleLayer,
+        /** Double layer of the linear basis, accumulated per (target, vertex), see double_layer_linear(). */
+        DoubleLayerLinear,
+        /** Single layer of the linear basis, accumulated per (target, vertex), see single_layer_linear(). */
+        SingleLayerLinear
+    };
+
+    /**
+     * Pre-compute the panels of every triangle of a surface mesh.
+     * @param mesh the triangle mesh.
+     * @return one panel per triangle.
+     */
+    template<typename Real>
+    std::vector<TrianglePanel<Real>> triangle_panels(const TriangleMesh<Real> &mesh) {
+
+        const std::size_t n = mesh.n_triangles();
+
+        std::vector<TrianglePanel<Real>> panels;
+        panels.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto &t = mesh.triangles[i];
+            panels.emplace_back(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]]);
+        }
+
+        return panels;
+
+    }
+
+    /**
+     * Evaluate a dense block of boundary-element interactions between a set of target points and the triangles of a
+     * surface mesh. The result is row-major with one row per target; rows have one column per triangle for
+     * BemKernel::SolidAngle and BemKernel::SingleLayer and one column per mesh vertex for the linear kernels. Work is
+     * tiled into (target block x triangle block) tiles so that a tile of panels stays in cache while it is swept by a
+     * block of targets, and target blocks are distributed over threads (each thread owns whole rows, so the
+     * accumulation into vertex columns is race free).
+     * @param targets the target (observation) points.
+     * @param mesh the source triangle mesh.
+     * @param kernel the interaction kernel.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the dense interaction block.
+     */
+    template<typename Real>
+    std::vector<Real> bem_matrix(const Vector3DSoA<Real> &targets, const TriangleMesh<Real> &mesh, BemKernel kernel,
+                                 std::size_t n_threads = 0) {
+
+        constexpr std::size_t target_block = 32;
+        constexpr std::size_t triangle_block = 128;
+
+        const std::vector<TrianglePanel<Real>> panels = triangle_panels(mesh);
+
+        const std::size_t n_targets = targets.size();
+        const std::size_t n_triangles = mesh.n_triangles();
+        const bool per_vertex = kernel == BemKernel::DoubleLayerLinear || kernel == BemKernel::SingleLayerLinear;
+        const std::size_t n_columns = per_vertex ? mesh.n_vertices() : n_triangles;
+
+        std::vector<Real> matrix(n_targets * n_columns, Real(0));
+
+        parallel_for(0, n_targets, [&](std::size_t begin, std::size_t end, std::size_t) {
+
+            for (std::size_t tb = begin; tb < end; tb += target_block) {
+                const std::size_t te = std::min(end, tb + target_block);
+
+                for (std::size_t pb = 0; pb < n_triangles; pb += triangle_block) {
+                    const std::size_t pe = std::min(n_triangles, pb + triangle_block);
+
+                    for (std::size_t i = tb; i < te; ++i) {
+                        const Vector3D<Real> r = targets[i];
+                        Real *row = matrix.data() + i * n_columns;
+
+                        for (std::size_t p = pb; p < pe; ++p) {
+                            const TrianglePanel<Real> &panel = panels[p];
+                            switch (kernel) {
+                                case BemKernel::SolidAngle:
+                                    row[p] = solid_angle(r, panel.r[0], panel.r[1], panel.r[2]);
+                                    break;
+                                case BemKernel::SingleLayer:
+                                    row[p] = single_layer(r, panel);
+                                    break;
+                                case BemKernel::DoubleLayerLinear: {
+                                    const auto w = double_layer_linear(r, panel);
+                                    const auto &t = mesh.triangles[p];
+                                    for (int k = 0; k < 3; ++k) row[t[k]] = row[t[k]] + w[k];
+                                    break;
+                                }
+                                case BemKernel::SingleLayerLinear: {
+                                    const auto w = single_layer_linear(r, panel);
+                                    const auto &t = mesh.triangles[p];
+                                    for (int k = 0; k < 3; ++k) row[t[k]] = row[t[k]] + w[k];
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+        }, n_threads, 1);
+
+        return matrix;
+
+    }
+
+    /**
+     * Single entry access to a boundary-element interaction matrix, as needed by compressed (e.g. hierarchical)
+     * representations that never form the dense matrix. Rows are target points; columns are triangles for
+     * BemKernel::SolidAngle and BemKernel::SingleLayer and mesh vertices for the linear kernels, in which case an entry
+     * gathers the basis function contributions of every triangle sharing the vertex. Entries agree with bem_matrix().
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class BemInteraction {
+
+    public:
+
+        /**
+         * Create the interaction between a set of target points and a source mesh.
+         * @param targets the target (observation) points.
+         * @param mesh the source triangle mesh.
+         * @param kernel the interaction kernel.
+         */
+        BemInteraction(const Vector3DSoA<Real> &targets, const TriangleMesh<Real> &mesh, BemKernel kernel)
+                : _targets(targets), _mesh(mesh), _kernel(kernel), _panels(triangle_panels(mesh)) {
+
+            // Vertex to (triangle, local vertex) adjacency in compressed row form.
+            _offsets.assign(mesh.n_vertices() + 1, 0);
+            for (const auto &t: mesh.triangles) for (std::size_t v: t) _offsets[v + 1]++;
+            for (std::size_t v = 0; v < mesh.n_vertices(); ++v) _offsets[v + 1] += _offsets[v];
+            _incident.resize(_offsets.back());
+            std::vector<std::size_t> fill(_offsets.begin(), _offsets.end() - 1);
+            for (std::size_t p = 0; p < mesh.n_triangles(); ++p) {
+                for (std::size_t k = 0; k < 3; ++k) _incident[fill[mesh.triangles[p][k]]++] = {p, k};
+            }
+
+        }
+
+        /**
+         * Retrieve the number of rows (target points).
+         * @return the number of rows.
+         */
+        [[nodiscard]] inline std::size_t n_rows() const { return _targets.size(); }
+
+        /**
+         * Retrieve the number of columns (triangles or vertices, depending on the kernel).
+         * @return the number of columns.
+         */
+        [[nodiscard]] inline std::size_t n_columns() const {
+            return per_vertex() ? _mesh.n_vertices() : _mesh.n_triangles();
+        }
+
+        /**
+         * Retrieve the positions associated with the columns: the vertices for the linear kernels and the triangle
+         * centres, as given by triangle_center(), otherwise.
+         * @return the column positions.
+         */
+        [[nodiscard]] Vector3DSoA<Real> column_points() const {
+
+            if (per_vertex()) return _mesh.vertices;
+
+            Vector3DSoA<Real> centers(_mesh.n_triangles());
+            for (std::size_t p = 0; p < _mesh.n_triangles(); ++p) {
+                const TrianglePanel<Real> &panel = _panels[p];
+                centers.set(p, triangle_center(panel.r[0], panel.r[1], panel.r[2]));
+            }
+            return centers;
+
+        }
+
+        /**
+         * Evaluate a single matrix entry.
+         * @param i the row (target) index.
+         * @param j the column (triangle or vertex) index.
+         * @return the matrix entry.
+         */
+        Real operator()(std::size_t i, std::size_t j) const {
+
+            const Vector3D<Real> r = _targets[i];
+
+            switch (_kernel) {
+                case BemKernel::SolidAngle: {
+                    const TrianglePanel<Real> &panel = _panels[j];
+                    return solid_angle(r, panel.r[0], panel.r[1], panel.r[2]);
+                }
+                case BemKernel::SingleLayer:
+                    return single_layer(r, _panels[j]);
+                case BemKernel::DoubleLayerLinear:
+                case BemKernel::SingleLayerLinear: {
+                    Real sum = Real(0);
+                    for (std::size_t a = _offsets[j]; a < _offsets[j + 1]; ++a) {
+                        const auto &[p, k] = _incident[a];
+                        const auto w = _kernel == BemKernel::DoubleLayerLinear ? double_layer_linear(r, _panels[p])
+                                                                               : single_layer_linear(r, _panels[p]);
+                        sum = sum + w[k];
+                    }
+                    return sum;
+                }
+            }
+
+            return Real(0);
+
+        }
+
+    private:
+
+        [[nodiscard]] inline bool per_vertex() const {
+            return _kernel == BemKernel::DoubleLayerLinear || _kernel == BemKernel::SingleLayerLinear;
+        }
+
+        const Vector3DSoA<Real> &_targets;
+        const TriangleMesh<Real> &_mesh;
+        BemKernel _kernel;
+        std::vector<TrianglePanel<Real>> _panels;
+        std::vector<std::size_t> _offsets;
+        std::vector<std::pair<std::size_t, std::size_t>> _incident;
+
+    };
+
+    /**
+     * Evaluate the solid angles subtended by a batch of triangles at a batch of points held in structure-of-arrays
+     * form, \f$\Omega_{ij}\f$ for target i and triangle j (row-major). The loop body is branch free so that, for
+     * double precision, the compiler can vectorise it across triangles given a vector `atan2` (e.g. glibc's libmvec).
+     * @param targets the target points.
+     * @param r1 the first vertex of each triangle.
+     * @param r2 the second vertex of each triangle.
+     * @param r3 the third vertex of each triangle.
+     * @param out the (targets.size() x r1.size()) output array.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real>
+    void solid_angles(const Vector3DSoA<Real> &targets, const Vector3DSoA<Real> &r1, const Vector3DSoA<Real> &r2,
+                      const Vector3DSoA<Real> &r3, Real *out, std::size_t n_threads = 0) {
+
+        const std::size_t n_triangles = r1.size();
+        const Real *x1 = r1.x(), *y1 = r1.y(), *z1 = r1.z();
+        const Real *x2 = r2.x(), *y2 = r2.y(), *z2 = r2.z();
+        const Real *x3 = r3.x(), *y3 = r3.y(), *z3 = r3.z();
+
+        parallel_for(0, targets.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+
+            using std::atan2;
+            using std::sqrt;
+
+            for (std::size_t i = begin; i < end; ++i) {
+
+                const Real px = targets.x()[i], py = targets.y()[i], pz = targets.z()[i];
+                Real *row = out + i * n_triangles;
+
+                for (std::size_t j = 0; j < n_triangles; ++j) {
+
+                    const Real ax = x1[j] - px, ay = y1[j] - py, az = z1[j] - pz;
+                    const Real bx = x2[j] - px, by = y2[j] - py, bz = z2[j] - pz;
+                    const Real cx = x3[j] - px, cy = y3[j] - py, cz = z3[j] - pz;
+
+                    const Real la = sqrt(ax * ax + ay * ay + az * az);
+                    const Real lb = sqrt(bx * bx + by * by + bz * bz);
+                    const Real lc = sqrt(cx * cx + cy * cy + cz * cz);
+
+                    const Real numerator = ax * (by * cz - bz * cy) + ay * (bz * cx - bx * cz) + az * (bx * cy - by * cx);
+                    const Real denominator = la * lb * lc + (ax * bx + ay * by + az * bz) * lc +
+                                             (ax * cx + ay * cy + az * cz) * lb + (bx * cx + by * cy + bz * cz) * la;
+
+                    row[j] = Real(2) * atan2(numerator, denominator);
+
+                }
+            }
+
+        }, n_threads, 1);
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
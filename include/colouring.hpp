@@ -0,0 +1,227 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * A colouring of the elements of a mesh such that no two elements of the same colour share a vertex, so that the
+     * elements of one colour can be processed concurrently by kernels scattering into per-vertex (or per vertex
+     * pair) storage without atomics or locks.
+     *
+     * Since two elements conflict exactly when they share a vertex, every vertex keeps a bit mask of the colours of
+     * its incident elements and an element's admissible colours are found from the masks of its own vertices alone,
+     * without visiting its neighbours. The elements are coloured first-fit in parallel over contiguous index
+     * ranges: an element claims its colour on each vertex with an atomic fetch-or and, should another thread have
+     * claimed the same colour on one of them in the meantime, releases its claims and tries again. With one thread
+     * this is the sequential greedy colouring, with more threads the colouring is equally valid but may differ.
+     *
+     * Optionally the colours are then balanced in a sequential pass which moves elements, in index order, from
+     * over-full colours into the emptiest admissible under-full colour. Within each colour the elements are stored
+     * in ascending index order, so that a mesh with a locality preserving element order keeps it inside every bucket.
+     */
+    class ElementColouring {
+
+    public:
+
+        /**
+         * Colour the elements of a mesh.
+         * @tparam N the number of vertices per element, e.g. 3 for triangles or 4 for tetrahedra.
+         * @param elements the vertex indices of each element.
+         * @param n_vertices the number of vertices.
+         * @param balance whether the colour class sizes should be balanced.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         * @throws std::out_of_range if a vertex index is not below n_vertices.
+         * @throws std::invalid_argument if an element lists a vertex more than once.
+         */
+        template<std::size_t N>
+        ElementColouring(const std::vector<std::array<std::size_t, N>> &elements, std::size_t n_vertices,
+                         bool balance = true, std::size_t n_threads = 0) : _colours(elements.size()) {
+
+            const std::size_t n = elements.size();
+
+            // First-fit never needs more colours than an element has distinct neighbours, plus one.
+            std::vector<std::size_t> degree(n_vertices, 0);
+            std::size_t max_degree = 0;
+            for (const auto &element: elements) {
+                for (std::size_t a = 0; a < N; ++a) {
+                    const std::size_t v = element[a];
+                    if (v >= n_vertices) throw std::out_of_range("ElementColouring: vertex index out of range");
+                    // A repeated vertex would find its own claim and retry forever.
+                    for (std::size_t b = 0; b < a; ++b) {
+                        if (element[b] == v) throw std::invalid_argument("ElementColouring: repeated element vertex");
+                    }
+                    max_degree = std::max(max_degree, ++degree[v]);
+                }
+            }
+            const std::size_t words = (N * max_degree) / 64 + 1;
+
+            std::vector<std::atomic<std::uint64_t>> masks(n_vertices * words);
+
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::vector<std::uint64_t> used(words);
+                for (std::size_t e = begin; e < end; ++e) {
+                    for (;;) {
+                        std::fill(used.begin(), used.end(), 0);
+                        for (std::size_t v: elements[e]) {
+                            for (std::size_t w = 0; w < words; ++w) {
+                                used[w] |= masks[v * words + w].load(std::memory_order_relaxed);
+                            }
+                        }
+                        std::size_t w = 0;
+                        while (~used[w] == 0) ++w;
+                        const std::size_t c = 64 * w + static_cast<std::size_t>(std::countr_one(used[w]));
+                        const std::uint64_t bit = std::uint64_t(1) << (c % 64);
+
+                        // Claim the colour on every vertex, releasing the claims if another element got there first.
+                        std::size_t claimed = 0;
+                        for (; claimed < N; ++claimed) {
+                            auto &mask = masks[elements[e][claimed] * words + w];
+                            if (mask.fetch_or(bit, std::memory_order_relaxed) & bit) break;
+                        }
+                        if (claimed == N) {
+                            _colours[e] = c;
+                            break;
+                        }
+                        for (std::size_t k = 0; k < claimed; ++k) {
+                            masks[elements[e][k] * words + w].fetch_and(~bit, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            }, n_threads);
+
+            _n_colours = 0;
+            for (std::size_t c: _colours) _n_colours = std::max(_n_colours, c + 1);
+
+            if (balance && _n_colours > 1) {
+
+                std::vector<std::size_t> sizes(_n_colours, 0);
+                for (std::size_t c: _colours) ++sizes[c];
+                const std::size_t target = (n + _n_colours - 1) / _n_colours;
+
+                // A vertex holds the bit of a colour for exactly one element, so a move simply transfers the bits.
+                std::vector<std::uint64_t> used(words);
+                for (std::size_t e = 0; e < n; ++e) {
+                    const std::size_t from = _colours[e];
+                    if (sizes[from] <= target) continue;
+                    std::fill(used.begin(), used.end(), 0);
+                    for (std::size_t v: elements[e]) {
+                        for (std::size_t w = 0; w < words; ++w) {
+                            used[w] |= masks[v * words + w].load(std::memory_order_relaxed);
+                        }
+                    }
+                    std::size_t to = _n_colours;
+                    for (std::size_t c = 0; c < _n_colours; ++c) {
+                        if (sizes[c] < target && !((used[c / 64] >> (c % 64)) & 1) &&
+                            (to == _n_colours || sizes[c] < sizes[to])) {
+                            to = c;
+                        }
+                    }
+                    if (to == _n_colours) continue;
+                    const std::uint64_t from_bit = std::uint64_t(1) << (from % 64);
+                    const std::uint64_t to_bit = std::uint64_t(1) << (to % 64);
+                    for (std::size_t v: elements[e]) {
+                        masks[v * words + from / 64].fetch_and(~from_bit, std::memory_order_relaxed);
+                        masks[v * words + to / 64].fetch_or(to_bit, std::memory_order_relaxed);
+                    }
+                    _colours[e] = to;
+                    --sizes[from];
+                    ++sizes[to];
+                }
+
+            }
+
+            // Bucket the elements by colour, ascending element index within each colour.
+            _colour_offsets.assign(_n_colours + 1, 0);
+            for (std::size_t c: _colours) ++_colour_offsets[c + 1];
+            for (std::size_t c = 0; c < _n_colours; ++c) _colour_offsets[c + 1] += _colour_offsets[c];
+            _elements.resize(n);
+            std::vector<std::size_t> fill(_colour_offsets.begin(), _colour_offsets.end() - 1);
+            for (std::size_t e = 0; e < n; ++e) _elements[fill[_colours[e]]++] = e;
+
+        }
+
+        /**
+         * Retrieve the number of colours.
+         * @return the number of colours.
+         */
+        [[nodiscard]] inline std::size_t n_colours() const { return _n_colours; }
+
+        /**
+         * Retrieve the number of elements.
+         * @return the number of elements.
+         */
+        [[nodiscard]] inline std::size_t n_elements() const { return _colours.size(); }
+
+        /**
+         * Retrieve the colour of every element.
+         * @return the element colours.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &colours() const { return _colours; }
+
+        /**
+         * Retrieve the start of each colour's bucket in elements().
+         * @return the colour offsets, n_colours() + 1 entries.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &colour_offsets() const { return _colour_offsets; }
+
+        /**
+         * Retrieve the elements grouped by colour.
+         * @return the bucketed element indices.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &elements() const { return _elements; }
+
+        /**
+         * Retrieve the number of elements of a colour.
+         * @param c the colour.
+         * @return the size of the colour's bucket.
+         */
+        [[nodiscard]] inline std::size_t colour_size(std::size_t c) const {
+            return _colour_offsets[c + 1] - _colour_offsets[c];
+        }
+
+    private:
+
+        std::size_t _n_colours = 0;
+
+        std::vector<std::size_t> _colours;
+        std::vector<std::size_t> _colour_offsets;
+        std::vector<std::size_t> _elements;
+
+    };
+
+    /**
+     * Process the elements of a mesh colour by colour, each colour in parallel over contiguous ranges of its bucket.
+     * Elements processed concurrently never share a vertex, so the callable may scatter into per-vertex storage
+     * without synchronisation.
+     * @tparam Fn callable with signature void(std::size_t bucket_begin, std::size_t bucket_end, std::size_t thread),
+     * receiving positions into colouring.elements().
+     * @param colouring the element colouring.
+     * @param fn the callable.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @param min_chunk the minimum number of elements per thread.
+     */
+    template<typename Fn>
+    void parallel_for_coloured(const ElementColouring &colouring, Fn fn, std::size_t n_threads = 0,
+                               std::size_t min_chunk = 1024) {
+
+        for (std::size_t c = 0; c < colouring.n_colours(); ++c) {
+            parallel_for(colouring.colour_offsets()[c], colouring.colour_offsets()[c + 1], fn, n_threads, min_chunk);
+        }
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,671 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <octree.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Options of SurfaceDecimator.
+     */
+    struct DecimationOptions {
+
+        /** Collapses whose quadric error exceeds this are not performed, whatever the target. */
+        double max_error = std::numeric_limits<double>::infinity();
+
+        /** The weight, relative to the triangle planes, of the planes holding boundary and feature edges in place. */
+        double boundary_weight = 1000.0;
+
+        /** The dihedral angle in radians (here 60 degrees) above which an edge is a feature to preserve. */
+        double feature_angle = 1.0471975511965976;
+
+        /** A collapse is rejected if it turns the triangle_normal() of a surviving triangle through an angle whose
+         *  cosine is this or less; zero rejects flipped and folded triangles. */
+        double min_normal_cosine = 0.0;
+
+        /** The number of triangles per block of the parallel phase; zero decimates serially. */
+        std::size_t block_triangles = 65536;
+
+    };
+
+    /**
+     * What a call to SurfaceDecimator::decimate() did.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct DecimationStatistics {
+
+        /** The number of edge collapses. */
+        std::size_t n_collapses = 0;
+
+        /** The number of those performed by the parallel phase. */
+        std::size_t n_parallel_collapses = 0;
+
+        /** The largest quadric error of a collapse. */
+        Real max_error = Real(0);
+
+    };
+
+    namespace detail {
+
+        /**
+         * A quadric error metric: the sum of the squared distances to a set of weighted planes, as a symmetric 4 x 4
+         * matrix acting on homogeneous points.
+         */
+        template<typename Real>
+        struct Quadric {
+
+            /** The upper triangle of the matrix, row by row. */
+            std::array<Real, 10> q;
+
+            Quadric() {
+                q.fill(Real(0));
+            }
+
+            /**
+             * Add the plane dot(n, r) + d = 0 with weight w.
+             */
+            void add_plane(const Vector3D<Real> &n, const Real &d, const Real &w) {
+
+                const Real a = n.x(), b = n.y(), c = n.z();
+                q[0] += w * a * a; q[1] += w * a * b; q[2] += w * a * c; q[3] += w * a * d;
+                q[4] += w * b * b; q[5] += w * b * c; q[6] += w * b * d;
+                q[7] += w * c * c; q[8] += w * c * d;
+                q[9] += w * d * d;
+
+            }
+
+            Quadric &operator+=(const Quadric &other) {
+                for (std::size_t k = 0; k < 10; ++k) q[k] += other.q[k];
+                return *this;
+            }
+
+            /**
+             * Evaluate the weighted sum of squared plane distances of a point.
+             */
+            Real error(const Vector3D<Real> &r) const {
+
+                const Real x = r.x(), y = r.y(), z = r.z();
+                return q[0] * x * x + q[4] * y * y + q[7] * z * z + q[9] +
+                       Real(2) * (q[1] * x * y + q[2] * x * z + q[5] * y * z + q[3] * x + q[6] * y + q[8] * z);
+
+            }
+
+            /**
+             * Find the point of least error, unless the planes leave it undetermined (e.g. all parallel).
+             * @param r the minimiser, on success.
+             * @return true if the 3 x 3 system is well conditioned enough to solve.
+             */
+            bool minimiser(Vector3D<Real> &r) const {
+
+                using std::fabs;
+
+                const Real c00 = q[4] * q[7] - q[5] * q[5];
+                const Real c01 = q[2] * q[5] - q[1] * q[7];
+                const Real c02 = q[1] * q[5] - q[2] * q[4];
+                const Real det = q[0] * c00 + q[1] * c01 + q[2] * c02;
+                const Real trace = q[0] + q[4] + q[7];
+                if (!(fabs(det) > Real(1E-10) * trace * trace * trace)) return false;
+
+                const Real c11 = q[0] * q[7] - q[2] * q[2];
+                const Real c12 = q[1] * q[2] - q[0] * q[5];
+                const Real c22 = q[0] * q[4] - q[1] * q[1];
+                r = Vector3D<Real>(-(c00 * q[3] + c01 * q[6] + c02 * q[8]) / det,
+                                   -(c01 * q[3] + c11 * q[6] + c12 * q[8]) / det,
+                                   -(c02 * q[3] + c12 * q[6] + c22 * q[8]) / det);
+                return true;
+
+            }
+
+        };
+
+    } // namespace detail
+
+    /**
+     * Simplification of a triangulated surface by quadric error metric edge collapses (Garland & Heckbert).
+     *
+     * Each vertex carries the quadric of the planes of its triangles (triangle_normal() and the offset through the
+     * triangle), weighted by area. Boundary edges, and edges whose dihedral angle exceeds the feature angle, add
+     * heavily weighted planes through the edge perpendicular to their triangles, so that boundaries and creases
+     * stay put. Edges are collapsed cheapest first from a priority queue, to the point minimising the summed
+     * quadric of their ends; a collapse is rejected if it would make the surface non-manifold, pinch a boundary,
+     * or turn a surviving triangle's normal too far. Triangles keep their vertex order, so the winding survives.
+     *
+     * Large meshes are decimated in batches first. The vertices are cut into blocks of consecutive Morton order and
+     * each block decimated by its own queue, in parallel, to half its triangles: a block collapses only edges whose
+     * triangles all lie within it, so blocks never touch each other's triangles. Rounds are repeated, with fresh
+     * blocks, while the surface is more than twice the target, and a serial pass over the whole surface finishes,
+     * seams included. The blocks do not depend on the number of threads, and neither does the result.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class SurfaceDecimator {
+
+    public:
+
+        /**
+         * Build the quadrics of a surface.
+         * @param mesh the surface; it is copied.
+         * @param options the collapse rules and the parallel blocks.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        explicit SurfaceDecimator(const TriangleMesh<Real> &mesh,
+                                  const DecimationOptions &options = DecimationOptions(), std::size_t n_threads = 0)
+                : _options(options), _n_threads(n_threads), _positions(mesh.vertices), _triangles(mesh.triangles) {
+
+            using std::cos;
+
+            const std::size_t n_vertices = mesh.n_vertices();
+            const std::size_t n = mesh.n_triangles();
+            _alive.assign(n, 1);
+            _n_alive = n;
+
+            _incidence_offsets.assign(n_vertices + 1, 0);
+            for (const auto &t: _triangles) for (std::size_t v: t) ++_incidence_offsets[v + 1];
+            for (std::size_t v = 0; v < n_vertices; ++v) _incidence_offsets[v + 1] += _incidence_offsets[v];
+            _incidence.resize(_incidence_offsets[n_vertices]);
+            std::vector<std::size_t> fill(_incidence_offsets.begin(), _incidence_offsets.end() - 1);
+            for (std::size_t t = 0; t < n; ++t) for (std::size_t v: _triangles[t]) _incidence[fill[v]++] = t;
+
+            _next.assign(n_vertices, none);
+            _last.resize(n_vertices);
+            _stamps.assign(n_vertices, 0);
+            _vertex_alive.resize(n_vertices);
+            for (std::size_t v = 0; v < n_vertices; ++v) {
+                _last[v] = v;
+                _vertex_alive[v] = _incidence_offsets[v] != _incidence_offsets[v + 1];
+            }
+
+            std::vector<Vector3D<Real>> normals(n);
+            std::vector<Real> areas(n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t t = begin; t < end; ++t) {
+                    const Vector3D<Real> r1 = _positions[_triangles[t][0]], r2 = _positions[_triangles[t][1]],
+                                         r3 = _positions[_triangles[t][2]];
+                    normals[t] = triangle_normal(r1, r2, r3);
+                    areas[t] = triangle_area(r1, r2, r3);
+                }
+            }, _n_threads);
+
+            // Each vertex sums the planes of its own triangles and of its own boundary and feature edges, so the
+            // vertices are independent.
+            const Real weight(options.boundary_weight);
+            const Real feature_cosine = cos(Real(options.feature_angle));
+            _quadrics.resize(n_vertices);
+            _boundary.assign(n_vertices, 0);
+            parallel_for(0, n_vertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::vector<std::pair<std::size_t, std::size_t>> edges;
+                for (std::size_t v = begin; v < end; ++v) {
+                    edges.clear();
+                    for (std::size_t i = _incidence_offsets[v]; i < _incidence_offsets[v + 1]; ++i) {
+                        const std::size_t t = _incidence[i];
+                        const Vector3D<Real> r1 = _positions[_triangles[t][0]];
+                        _quadrics[v].add_plane(normals[t], -dot(normals[t], r1), areas[t]);
+                        for (std::size_t w: _triangles[t]) if (w != v) edges.emplace_back(w, t);
+                    }
+                    std::sort(edges.begin(), edges.end());
+                    for (std::size_t i = 0; i < edges.size();) {
+                        std::size_t j = i + 1;
+                        while (j < edges.size() && edges[j].first == edges[i].first) ++j;
+                        const bool boundary = j - i != 2;
+                        if (boundary) _boundary[v] = 1;
+                        if (boundary || dot(normals[edges[i].second], normals[edges[i + 1].second]) < feature_cosine) {
+                            const Vector3D<Real> rv = _positions[v], rw = _positions[edges[i].first];
+                            for (std::size_t k = i; k < j; ++k) {
+                                const Vector3D<Real> m = normalised(cross(rw - rv, normals[edges[k].second]));
+                                _quadrics[v].add_plane(m, -dot(m, rv), weight * norm_squared(rw - rv));
+                            }
+                        }
+                        i = j;
+                    }
+                }
+            }, _n_threads);
+
+        }
+
+        /**
+         * Retrieve the number of triangles left.
+         * @return the number of triangles.
+         */
+        [[nodiscard]] std::size_t n_triangles() const {
+            return _n_alive;
+        }
+
+        /**
+         * Collapse edges until at most a target number of triangles is left, or no collapse is permitted within the
+         * maximum error. Calling again with a smaller target continues from the current surface, e.g. to build a
+         * sequence of levels of detail.
+         * @param target_triangles the number of triangles to reduce the surface to.
+         * @return what was done.
+         */
+        DecimationStatistics<Real> decimate(std::size_t target_triangles) {
+
+            DecimationStatistics<Real> statistics;
+            if (_n_alive <= target_triangles) return statistics;
+
+            // Blocks cannot collapse along their seams, so a round that went all the way to the target would
+            // over-coarsen their interiors; rounds of at most halving, re-blocked each time, keep the density even.
+            const std::size_t block = _options.block_triangles;
+            while (block > 0 && _n_alive >= 2 * block && _n_alive >= 2 * target_triangles) {
+                const std::size_t before = _n_alive;
+                decimate_blocks(std::max(target_triangles, _n_alive / 2), statistics);
+                if (_n_alive == before) break;
+            }
+
+            std::vector<std::size_t> vertices;
+            for (std::size_t v = 0; v < _vertex_alive.size(); ++v) if (_vertex_alive[v]) vertices.push_back(v);
+            _block.clear();
+            Outcome outcome;
+            Scratch scratch;
+            run(vertices, none, _n_alive - std::min(_n_alive, target_triangles), scratch, outcome);
+            _n_alive -= outcome.removed;
+            statistics.n_collapses += outcome.collapses;
+            statistics.max_error = std::max(statistics.max_error, outcome.max_error);
+
+            return statistics;
+
+        }
+
+        /**
+         * Retrieve the current surface, without the vertices collapsed away; the triangles keep their order and
+         * winding.
+         * @return the surface.
+         */
+        [[nodiscard]] TriangleMesh<Real> mesh() const {
+
+            TriangleMesh<Real> result;
+            std::vector<std::size_t> map(_vertex_alive.size(), none);
+            for (std::size_t t = 0; t < _triangles.size(); ++t) {
+                if (!_alive[t]) continue;
+                std::array<std::size_t, 3> triangle;
+                for (std::size_t k = 0; k < 3; ++k) {
+                    const std::size_t v = _triangles[t][k];
+                    if (map[v] == none) {
+                        map[v] = result.vertices.size();
+                        result.vertices.push_back(_positions[v]);
+                    }
+                    triangle[k] = map[v];
+                }
+                result.triangles.push_back(triangle);
+            }
+            return result;
+
+        }
+
+    private:
+
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * A queued collapse of v into u, valid while neither end has changed since; the position is recomputed when
+         * it is taken, to keep the queue small.
+         */
+        struct Candidate {
+
+            Real cost;
+            std::size_t u, v;
+            std::uint32_t stamp_u, stamp_v;
+
+            bool operator>(const Candidate &other) const {
+                if (cost != other.cost) return cost > other.cost;
+                return u != other.u ? u > other.u : v > other.v;
+            }
+
+        };
+
+        /** Per-thread working storage. */
+        struct Scratch {
+            std::vector<std::size_t> ring_u, ring_v, neighbours_u, neighbours_v, common, opposite;
+        };
+
+        /** What one queue did. */
+        struct Outcome {
+            std::size_t collapses = 0;
+            std::size_t removed = 0;
+            Real max_error = Real(0);
+        };
+
+        /**
+         * A parallel round: Morton ordered blocks of vertices decimated independently, each to its share of a
+         * target.
+         */
+        void decimate_blocks(std::size_t target_triangles, DecimationStatistics<Real> &statistics) {
+
+            std::vector<std::size_t> vertices;
+            for (std::size_t v = 0; v < _vertex_alive.size(); ++v) if (_vertex_alive[v]) vertices.push_back(v);
+            const std::size_t n_vertices = vertices.size();
+
+            std::array<Real, 6> b = {_positions.x()[vertices[0]], _positions.y()[vertices[0]],
+                                     _positions.z()[vertices[0]], _positions.x()[vertices[0]],
+                                     _positions.y()[vertices[0]], _positions.z()[vertices[0]]};
+            for (std::size_t v: vertices) {
+                b[0] = std::min(b[0], _positions.x()[v]); b[3] = std::max(b[3], _positions.x()[v]);
+                b[1] = std::min(b[1], _positions.y()[v]); b[4] = std::max(b[4], _positions.y()[v]);
+                b[2] = std::min(b[2], _positions.z()[v]); b[5] = std::max(b[5], _positions.z()[v]);
+            }
+            Real extent = std::max(b[3] - b[0], std::max(b[4] - b[1], b[5] - b[2]));
+            if (!(extent > Real(0))) extent = Real(1);
+            const double scale = double(std::uint64_t(1) << morton_bits) / static_cast<double>(extent);
+            const double top = double((std::uint64_t(1) << morton_bits) - 1);
+            std::vector<std::uint64_t> codes(n_vertices);
+            parallel_for(0, n_vertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                auto quantise = [&](const Real &x, const Real &lo) {
+                    return static_cast<std::uint32_t>(std::clamp(std::floor(static_cast<double>(x - lo) * scale),
+                                                                 0.0, top));
+                };
+                for (std::size_t i = begin; i < end; ++i) {
+                    const std::size_t v = vertices[i];
+                    codes[i] = morton_encode(quantise(_positions.x()[v], b[0]), quantise(_positions.y()[v], b[1]),
+                                             quantise(_positions.z()[v], b[2]));
+                }
+            }, _n_threads);
+            radix_sort(codes, vertices, 3 * morton_bits, _n_threads);
+
+            const std::size_t n_blocks = (_n_alive + _options.block_triangles - 1) / _options.block_triangles;
+            const std::size_t per_block = (n_vertices + n_blocks - 1) / n_blocks;
+            _block.assign(_vertex_alive.size(), none);
+            for (std::size_t i = 0; i < n_vertices; ++i) _block[vertices[i]] = i / per_block;
+
+            // A block's share of the target is in proportion to the triangles of its first vertices.
+            std::vector<std::size_t> counts(n_blocks, 0);
+            for (std::size_t t = 0; t < _triangles.size(); ++t) if (_alive[t]) ++counts[_block[_triangles[t][0]]];
+
+            std::vector<Outcome> outcomes(n_blocks);
+            parallel_for(0, n_blocks, [&](std::size_t begin, std::size_t end, std::size_t) {
+                Scratch scratch;
+                for (std::size_t block = begin; block < end; ++block) {
+                    const std::size_t first = block * per_block, last = std::min(n_vertices, first + per_block);
+                    const std::vector<std::size_t> members(vertices.begin() + first, vertices.begin() + last);
+                    const std::size_t share = std::size_t(double(counts[block]) * double(target_triangles) /
+                                                          double(_n_alive));
+                    run(members, block, counts[block] - std::min(counts[block], share), scratch, outcomes[block]);
+                }
+            }, _n_threads, 1);
+
+            for (const Outcome &outcome: outcomes) {
+                _n_alive -= outcome.removed;
+                statistics.n_collapses += outcome.collapses;
+                statistics.n_parallel_collapses += outcome.collapses;
+                statistics.max_error = std::max(statistics.max_error, outcome.max_error);
+            }
+
+        }
+
+        /**
+         * Collapse the edges between a set of vertices, cheapest first, until a number of triangles is removed.
+         * @param vertices the vertices.
+         * @param block the block that all triangles touched must lie in, or none.
+         * @param quota the number of triangles to remove.
+         */
+        void run(const std::vector<std::size_t> &vertices, std::size_t block, std::size_t quota, Scratch &scratch,
+                 Outcome &outcome) {
+
+            std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+            for (std::size_t u: vertices) {
+                neighbours(u, scratch.ring_u, scratch.neighbours_u);
+                for (std::size_t v: scratch.neighbours_u) {
+                    if (v > u && in_block(v, block)) queue.push(candidate(u, v));
+                }
+            }
+
+            const Real max_error(_options.max_error);
+            while (!queue.empty() && outcome.removed < quota) {
+
+                const Candidate c = queue.top();
+                queue.pop();
+                if (!_vertex_alive[c.u] || !_vertex_alive[c.v]) continue;
+                if (_stamps[c.u] != c.stamp_u || _stamps[c.v] != c.stamp_v) continue;
+                if (c.cost > max_error) break;
+                Vector3D<Real> position;
+                place(c.u, c.v, position);
+                if (!is_valid(c.u, c.v, position, block, scratch)) continue;
+
+                outcome.removed += collapse(c.u, c.v, position, scratch);
+                ++outcome.collapses;
+                outcome.max_error = std::max(outcome.max_error, c.cost);
+
+                neighbours(c.u, scratch.ring_u, scratch.neighbours_u);
+                for (std::size_t w: scratch.neighbours_u) {
+                    if (in_block(w, block)) queue.push(w < c.u ? candidate(w, c.u) : candidate(c.u, w));
+                }
+
+            }
+
+        }
+
+        bool in_block(std::size_t v, std::size_t block) const {
+            return block == none || _block[v] == block;
+        }
+
+        /**
+         * Gather the live triangles around a vertex, from the incidences of every vertex merged into it.
+         */
+        void ring(std::size_t u, std::vector<std::size_t> &triangles) const {
+
+            triangles.clear();
+            for (std::size_t w = u; w != none; w = _next[w]) {
+                for (std::size_t i = _incidence_offsets[w]; i < _incidence_offsets[w + 1]; ++i) {
+                    if (_alive[_incidence[i]]) triangles.push_back(_incidence[i]);
+                }
+            }
+
+        }
+
+        /**
+         * Gather the live triangles around a vertex and the sorted vertices that share them.
+         */
+        void neighbours(std::size_t u, std::vector<std::size_t> &triangles, std::vector<std::size_t> &vertices) const {
+
+            ring(u, triangles);
+            vertices.clear();
+            for (std::size_t t: triangles) for (std::size_t w: _triangles[t]) if (w != u) vertices.push_back(w);
+            std::sort(vertices.begin(), vertices.end());
+            vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+        }
+
+        /**
+         * Choose where collapsing an edge puts the surviving vertex: on the boundary end if only one end is on the
+         * boundary, else at the quadric minimiser if it is determined and near the edge, else at the better of the
+         * ends and the midpoint.
+         */
+        Real place(std::size_t u, std::size_t v, Vector3D<Real> &position) const {
+
+            detail::Quadric<Real> quadric = _quadrics[u];
+            quadric += _quadrics[v];
+            const Vector3D<Real> ru = _positions[u], rv = _positions[v];
+
+            Real cost;
+            if (_boundary[u] != _boundary[v]) {
+                position = _boundary[u] ? ru : rv;
+                cost = quadric.error(position);
+            } else if (quadric.minimiser(position) &&
+                       norm_squared(position - edge_center(ru, rv)) <= norm_squared(rv - ru)) {
+                cost = quadric.error(position);
+            } else {
+                position = ru;
+                cost = quadric.error(ru);
+                for (const Vector3D<Real> &r: {rv, edge_center(ru, rv)}) {
+                    const Real error = quadric.error(r);
+                    if (error < cost) {
+                        cost = error;
+                        position = r;
+                    }
+                }
+            }
+            return cost < Real(0) ? Real(0) : cost;
+
+        }
+
+        /**
+         * Queue the collapse of an edge at the cost of its placement.
+         */
+        Candidate candidate(std::size_t u, std::size_t v) const {
+
+            Vector3D<Real> position;
+            return Candidate{place(u, v, position), u, v, _stamps[u], _stamps[v]};
+
+        }
+
+        /**
+         * Test whether collapsing v into u at a position keeps the surface manifold, its boundary unpinched and its
+         * triangle normals within tolerance, and touches only triangles of the block.
+         */
+        bool is_valid(std::size_t u, std::size_t v, const Vector3D<Real> &position, std::size_t block,
+                      Scratch &scratch) const {
+
+            ring(u, scratch.ring_u);
+            ring(v, scratch.ring_v);
+            if (block != none) {
+                for (const auto *triangles: {&scratch.ring_u, &scratch.ring_v}) {
+                    for (std::size_t t: *triangles) {
+                        for (std::size_t w: _triangles[t]) if (_block[w] != block) return false;
+                    }
+                }
+            }
+
+            // The triangles on the edge, and the vertices opposite it.
+            scratch.opposite.clear();
+            for (std::size_t t: scratch.ring_u) {
+                const auto &triangle = _triangles[t];
+                if (triangle[0] != v && triangle[1] != v && triangle[2] != v) continue;
+                for (std::size_t w: triangle) if (w != u && w != v) scratch.opposite.push_back(w);
+            }
+            const std::size_t shared = scratch.opposite.size();
+            if (shared == 0 || shared > 2) return false;
+            if (shared == 2 && _boundary[u] && _boundary[v]) return false;
+            const std::size_t remaining = scratch.ring_u.size() + scratch.ring_v.size() - 2 * shared;
+            if (remaining < (_boundary[u] || _boundary[v] ? 1u : 3u)) return false;
+
+            // Link condition: the ends may share no neighbour but the opposite vertices.
+            auto gather = [](std::size_t x, const std::vector<std::size_t> &triangles,
+                             const std::vector<std::array<std::size_t, 3>> &all, std::vector<std::size_t> &out) {
+                out.clear();
+                for (std::size_t t: triangles) for (std::size_t w: all[t]) if (w != x) out.push_back(w);
+                std::sort(out.begin(), out.end());
+                out.erase(std::unique(out.begin(), out.end()), out.end());
+            };
+            gather(u, scratch.ring_u, _triangles, scratch.neighbours_u);
+            gather(v, scratch.ring_v, _triangles, scratch.neighbours_v);
+            scratch.common.clear();
+            std::set_intersection(scratch.neighbours_u.begin(), scratch.neighbours_u.end(),
+                                  scratch.neighbours_v.begin(), scratch.neighbours_v.end(),
+                                  std::back_inserter(scratch.common));
+            std::sort(scratch.opposite.begin(), scratch.opposite.end());
+            if (scratch.opposite[0] == scratch.opposite[shared - 1] && shared == 2) return false;
+            if (scratch.common != scratch.opposite) return false;
+
+            const Real min_cosine(_options.min_normal_cosine);
+            for (const auto &[x, triangles]: {std::pair(u, &scratch.ring_u), std::pair(v, &scratch.ring_v)}) {
+                for (std::size_t t: *triangles) {
+                    const auto &triangle = _triangles[t];
+                    std::array<Vector3D<Real>, 3> r;
+                    bool on_edge = false;
+                    for (std::size_t k = 0; k < 3; ++k) {
+                        r[k] = _positions[triangle[k]];
+                        on_edge = on_edge || triangle[k] == (x == u ? v : u);
+                    }
+                    if (on_edge) continue;
+                    const Vector3D<Real> before = triangle_normal(r[0], r[1], r[2]);
+                    for (std::size_t k = 0; k < 3; ++k) if (triangle[k] == x) r[k] = position;
+                    if (!(dot(triangle_normal(r[0], r[1], r[2]), before) > min_cosine)) return false;
+                }
+            }
+            return true;
+
+        }
+
+        /**
+         * Collapse v into u, moving u to a position.
+         * @return the number of triangles removed.
+         */
+        std::size_t collapse(std::size_t u, std::size_t v, const Vector3D<Real> &position, Scratch &scratch) {
+
+            ring(v, scratch.ring_v);
+            std::size_t removed = 0;
+            for (std::size_t t: scratch.ring_v) {
+                auto &triangle = _triangles[t];
+                if (triangle[0] == u || triangle[1] == u || triangle[2] == u) {
+                    _alive[t] = 0;
+                    ++removed;
+                } else {
+                    for (std::size_t &w: triangle) if (w == v) w = u;
+                }
+            }
+
+            _next[_last[u]] = v;
+            _last[u] = _last[v];
+            _vertex_alive[v] = 0;
+            _positions.set(u, position);
+            _quadrics[u] += _quadrics[v];
+            _boundary[u] = _boundary[u] || _boundary[v];
+            ++_stamps[u];
+            ++_stamps[v];
+            return removed;
+
+        }
+
+        DecimationOptions _options;
+        std::size_t _n_threads;
+
+        Vector3DSoA<Real> _positions;
+        std::vector<std::array<std::size_t, 3>> _triangles;
+        std::vector<char> _alive;
+        std::size_t _n_alive = 0;
+
+        /** The triangles around each original vertex. */
+        std::vector<std::size_t> _incidence_offsets;
+        std::vector<std::size_t> _incidence;
+
+        /** The vertices merged into each vertex, as a linked list from the vertex itself to _last. */
+        std::vector<std::size_t> _next;
+        std::vector<std::size_t> _last;
+
+        std::vector<char> _vertex_alive;
+        std::vector<char> _boundary;
+        std::vector<std::uint32_t> _stamps;
+        std::vector<detail::Quadric<Real>> _quadrics;
+
+        /** The block of each vertex in the parallel phase. */
+        std::vector<std::size_t> _block;
+
+    };
+
+    /**
+     * Simplify a triangulated surface with a SurfaceDecimator.
+     * @param mesh the surface.
+     * @param target_triangles the number of triangles to reduce the surface to.
+     * @param options the collapse rules and the parallel blocks.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the simplified surface.
+     */
+    template<typename Real>
+    TriangleMesh<Real> decimate(const TriangleMesh<Real> &mesh, std::size_t target_triangles,
+                                const DecimationOptions &options = DecimationOptions(), std::size_t n_threads = 0) {
+
+        SurfaceDecimator<Real> decimator(mesh, options, n_threads);
+        decimator.decimate(target_triangles);
+        return decimator.mesh();
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
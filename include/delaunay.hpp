@@ -0,0 +1,666 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+#include <octree.hpp>
+#include <predicates.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Return the index of a point along the Hilbert curve through the 2^21 x 2^21 x 2^21 grid, computed with
+     * Skilling's transpose algorithm (Programming the Hilbert curve, 2004). Consecutive indices are neighbouring
+     * grid cells, so sorting by the index keeps points that are close in the order close in space.
+     * @param i the x grid coordinate (21 bits).
+     * @param j the y grid coordinate (21 bits).
+     * @param k the z grid coordinate (21 bits).
+     * @return the 63-bit Hilbert index.
+     */
+    inline std::uint64_t hilbert_encode(std::uint32_t i, std::uint32_t j, std::uint32_t k) {
+
+        std::array<std::uint32_t, 3> x = {i, j, k};
+        const std::uint32_t top = std::uint32_t(1) << (morton_bits - 1);
+
+        // Inverse undo.
+        for (std::uint32_t q = top; q > 1; q >>= 1) {
+            const std::uint32_t p = q - 1;
+            for (std::size_t a = 0; a < 3; ++a) {
+                if (x[a] & q) {
+                    x[0] ^= p;
+                } else {
+                    const std::uint32_t t = (x[0] ^ x[a]) & p;
+                    x[0] ^= t;
+                    x[a] ^= t;
+                }
+            }
+        }
+
+        // Gray encode.
+        x[1] ^= x[0];
+        x[2] ^= x[1];
+        std::uint32_t t = 0;
+        for (std::uint32_t q = top; q > 1; q >>= 1) {
+            if (x[2] & q) t ^= q - 1;
+        }
+        for (std::uint32_t &c: x) c ^= t;
+
+        return (detail::morton_spread(x[0]) << 2) | (detail::morton_spread(x[1]) << 1) | detail::morton_spread(x[2]);
+
+    }
+
+    /**
+     * Return a biased randomised insertion order (Amenta, Choi & Rote 2003) of points: the points are shuffled and
+     * cut into rounds whose sizes double, the last round holding half of the points, and each round is sorted along
+     * the Hilbert curve. The early rounds spread the points over the domain so that the triangulation grows
+     * uniformly, the Hilbert order keeps consecutive insertions close together.
+     * @param points the points.
+     * @param round_ends receives the end of each round in the order.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the order.
+     */
+    inline std::vector<std::size_t> brio_order(const Vector3DSoA<double> &points, std::vector<std::size_t> &round_ends,
+                                               std::size_t n_threads = 0) {
+
+        const std::size_t n = points.size();
+        std::vector<std::size_t> order(n);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(n));
+
+        round_ends.clear();
+        for (std::size_t m = n; m > 0; m /= 2) {
+            round_ends.push_back(m);
+            if (m <= 64) break;
+        }
+        std::reverse(round_ends.begin(), round_ends.end());
+
+        std::array<double, 3> lower = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                                       std::numeric_limits<double>::max()};
+        std::array<double, 3> upper = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                                       std::numeric_limits<double>::lowest()};
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::array<double, 3> r = {points.x()[i], points.y()[i], points.z()[i]};
+            for (std::size_t a = 0; a < 3; ++a) {
+                lower[a] = std::min(lower[a], r[a]);
+                upper[a] = std::max(upper[a], r[a]);
+            }
+        }
+        double extent = 0.0;
+        for (std::size_t a = 0; a < 3; ++a) extent = std::max(extent, upper[a] - lower[a]);
+        const double top = double((std::uint32_t(1) << morton_bits) - 1);
+        const double scale = extent > 0.0 ? top / extent : 0.0;
+
+        std::size_t begin = 0;
+        for (std::size_t end: round_ends) {
+            std::vector<std::uint64_t> keys(end - begin);
+            std::vector<std::size_t> values(order.begin() + static_cast<std::ptrdiff_t>(begin),
+                                            order.begin() + static_cast<std::ptrdiff_t>(end));
+            parallel_for(0, keys.size(), [&](std::size_t b, std::size_t e, std::size_t) {
+                auto quantise = [&](double x, std::size_t a) {
+                    return static_cast<std::uint32_t>(std::clamp(std::floor((x - lower[a]) * scale), 0.0, top));
+                };
+                for (std::size_t i = b; i < e; ++i) {
+                    const std::size_t p = values[i];
+                    keys[i] = hilbert_encode(quantise(points.x()[p], 0), quantise(points.y()[p], 1),
+                                             quantise(points.z()[p], 2));
+                }
+            }, n_threads);
+            radix_sort(keys, values, 3 * morton_bits, n_threads);
+            std::copy(values.begin(), values.end(), order.begin() + static_cast<std::ptrdiff_t>(begin));
+            begin = end;
+        }
+
+        return order;
+
+    }
+
+    namespace detail {
+
+        /**
+         * Incremental Bowyer-Watson construction of the Delaunay tetrahedralisation.
+         *
+         * The convex hull is closed by ghost tetrahedra joining each hull triangle to a vertex at infinity, so every
+         * point is inserted in the same way: the tetrahedra whose circumsphere strictly contains it (for a ghost:
+         * the point lies strictly beyond its hull triangle, or on the triangle's plane and strictly inside its
+         * circumcircle) form a star-shaped cavity, which is replaced by the tetrahedra joining the point to the
+         * cavity boundary. The exact predicates guarantee that no flat tetrahedra are created, whatever the
+         * degeneracies of the input.
+         *
+         * For parallel insertion every tetrahedron carries a lock. A thread locks each tetrahedron before it reads
+         * it, during the walk to the point as well as while growing the cavity, and gives up an insertion (keeping
+         * the point for later) as soon as a lock is held by another thread; the cavity, its boundary and everything
+         * that is rewired are then held by one thread only.
+         */
+        class DelaunayBuilder {
+
+        public:
+
+            /** Vertices and tetrahedra are numbered with 32 bits to fit a tetrahedron in half a cache line. */
+            using Index = std::uint32_t;
+
+            static constexpr Index infinite = std::numeric_limits<Index>::max();
+            static constexpr Index dead = std::numeric_limits<Index>::max() - 1;
+
+            explicit DelaunayBuilder(const Vector3DSoA<double> &points) : _input(points), _points(points.size()) {
+                if (points.size() >= dead) throw std::length_error("delaunay_tetrahedralisation: too many points");
+                for (std::size_t i = 0; i < points.size(); ++i) _points[i] = points[i];
+            }
+
+            /**
+             * Triangulate the points.
+             */
+            TetrahedralMesh<double> triangulate(std::size_t n_threads) {
+
+                if (n_threads == 0) n_threads = default_thread_count();
+
+                std::vector<std::size_t> round_ends;
+                const std::vector<std::size_t> order = brio_order(_input, round_ends, n_threads);
+
+                TetrahedralMesh<double> mesh;
+                mesh.vertices = _input;
+                if (!initialise(order)) return mesh;
+
+                _workers.resize(n_threads);
+                std::size_t begin = 0;
+                for (std::size_t end: round_ends) {
+                    // Small rounds do not pay for the threads.
+                    if (n_threads == 1 || end - begin < 1024 * n_threads) {
+                        for (std::size_t i = begin; i < end; ++i) insert_serial(order[i]);
+                    } else {
+                        insert_parallel(order, begin, end, n_threads);
+                    }
+                    begin = end;
+                }
+
+                for (std::size_t t = 0; t < _size; ++t) {
+                    const auto &v = _cells[t].vertices;
+                    if (v[0] == dead || is_ghost(t)) continue;
+                    mesh.tetrahedra.push_back({v[0], v[1], v[2], v[3]});
+                }
+                return mesh;
+
+            }
+
+        private:
+
+            /** The state of a thread. */
+            struct Worker {
+                std::size_t id = 0;
+                std::size_t last = 0;
+                std::uint64_t random = 0x9E3779B97F4A7C15ULL;
+                std::vector<std::size_t> held;
+                std::vector<std::size_t> cavity;
+                std::vector<std::array<std::size_t, 3>> boundary;
+                std::vector<std::size_t> created;
+                std::vector<std::array<std::size_t, 4>> links;
+                std::vector<std::size_t> free;
+            };
+
+            enum class Outcome { Inserted, Duplicate, Busy };
+
+            const Vector3DSoA<double> &_input;
+
+            /** The points side by side, as the predicates read them. */
+            std::vector<Vector3D<double>> _points;
+
+            /** A tetrahedron: its vertices and the neighbours opposite them. */
+            struct alignas(32) Cell {
+                std::array<Index, 4> vertices;
+                std::array<Index, 4> neighbours;
+            };
+
+            std::vector<Cell> _cells;
+            std::vector<std::uint32_t> _locks;
+            std::vector<std::uint8_t> _in_cavity;
+            std::size_t _size = 0;
+            std::atomic<std::size_t> _next = 0;
+            bool _concurrent = false;
+
+            std::vector<Worker> _workers;
+
+            [[nodiscard]] bool is_ghost(std::size_t t) const {
+                const auto &v = _cells[t].vertices;
+                return v[0] == infinite || v[1] == infinite || v[2] == infinite || v[3] == infinite;
+            }
+
+            [[nodiscard]] int orient(const std::array<Index, 4> &v) const {
+                return orient3d(_points[v[0]], _points[v[1]], _points[v[2]], _points[v[3]]);
+            }
+
+            bool acquire(Worker &worker, std::size_t t) {
+                if (!_concurrent) return true;
+                std::atomic_ref<std::uint32_t> lock(_locks[t]);
+                std::uint32_t expected = 0;
+                const auto owner = static_cast<std::uint32_t>(worker.id + 1);
+                if (lock.compare_exchange_strong(expected, owner, std::memory_order_acquire)) {
+                    worker.held.push_back(t);
+                    return true;
+                }
+                return expected == owner;
+            }
+
+            void release(Worker &worker) {
+                if (!_concurrent) return;
+                for (std::size_t t: worker.held) {
+                    std::atomic_ref<std::uint32_t>(_locks[t]).store(0, std::memory_order_release);
+                }
+                worker.held.clear();
+            }
+
+            /**
+             * Test whether a tetrahedron is in conflict with point p: 1 if it is, 0 if not and -1 if a lock on the
+             * neighbour needed for a coplanar ghost could not be taken.
+             */
+            int conflict(Worker &worker, std::size_t t, std::size_t p) {
+                const auto &v = _cells[t].vertices;
+                for (std::size_t k = 0; k < 4; ++k) {
+                    if (v[k] != infinite) continue;
+                    std::array<Index, 4> w = v;
+                    w[k] = static_cast<Index>(p);
+                    const int o = orient(w);
+                    if (o != 0) return o > 0 ? 1 : 0;
+                    // On the plane of the hull triangle: inside its circumcircle exactly when inside the
+                    // circumsphere of the finite tetrahedron on the triangle.
+                    const std::size_t n = _cells[t].neighbours[k];
+                    if (!acquire(worker, n)) return -1;
+                    const auto &u = _cells[n].vertices;
+                    return insphere(_points[u[0]], _points[u[1]], _points[u[2]], _points[u[3]], _points[p]) > 0;
+                }
+                return insphere(_points[v[0]], _points[v[1]], _points[v[2]], _points[v[3]], _points[p]) > 0;
+            }
+
+            /**
+             * Walk from the worker's last tetrahedron towards point p until a tetrahedron in conflict with it.
+             */
+            Outcome locate(Worker &worker, std::size_t p, std::size_t &found) {
+
+                std::size_t t = worker.last;
+                if (!acquire(worker, t)) return Outcome::Busy;
+                if (_cells[t].vertices[0] == dead) {
+                    // Freed by another thread since: restart from any live tetrahedron.
+                    t = infinite;
+                    for (std::size_t c = worker.created.size(); c-- > 0 && t == infinite;) {
+                        const std::size_t candidate = worker.created[c];
+                        if (!acquire(worker, candidate)) return Outcome::Busy;
+                        if (_cells[candidate].vertices[0] != dead) t = candidate;
+                    }
+                    if (t == infinite) return Outcome::Busy;
+                }
+
+                const std::size_t max_steps = 4 * _size + 64;
+                for (std::size_t step = 0; step < max_steps; ++step) {
+
+                    const auto &v = _cells[t].vertices;
+                    std::size_t next = infinite;
+                    const auto k = static_cast<std::size_t>(std::find(v.begin(), v.end(), infinite) - v.begin());
+                    if (k < 4) {
+                        const int c = conflict(worker, t, p);
+                        if (c < 0) return Outcome::Busy;
+                        if (c > 0) {
+                            found = t;
+                            return Outcome::Inserted;
+                        }
+                        next = _cells[t].neighbours[k];
+                    } else {
+                        worker.random ^= worker.random << 13;
+                        worker.random ^= worker.random >> 7;
+                        worker.random ^= worker.random << 17;
+                        const std::size_t first = worker.random & 3;
+                        for (std::size_t f = 0; f < 4 && next == infinite; ++f) {
+                            const std::size_t i = (first + f) & 3;
+                            std::array<Index, 4> w = v;
+                            w[i] = static_cast<Index>(p);
+                            if (orient(w) < 0) next = _cells[t].neighbours[i];
+                        }
+                        if (next == infinite) {
+                            for (std::size_t i = 0; i < 4; ++i) {
+                                if (_points[v[i]].x() == _points[p].x() && _points[v[i]].y() == _points[p].y() &&
+                                    _points[v[i]].z() == _points[p].z()) {
+                                    return Outcome::Duplicate;
+                                }
+                            }
+                            found = t;
+                            return Outcome::Inserted;
+                        }
+                    }
+                    if (!acquire(worker, next)) return Outcome::Busy;
+                    t = next;
+
+                }
+                return Outcome::Busy;
+
+            }
+
+            /**
+             * Take a free tetrahedron, locked, or return `infinite` if there is none within the capacity.
+             */
+            std::size_t allocate(Worker &worker) {
+                while (!worker.free.empty()) {
+                    const std::size_t t = worker.free.back();
+                    worker.free.pop_back();
+                    if (acquire(worker, t)) return t;
+                }
+                if (!_concurrent) {
+                    if (_size == _cells.size()) grow(2 * _size + 64);
+                    return _size++;
+                }
+                std::size_t t = _next.load(std::memory_order_relaxed);
+                do {
+                    if (t >= _cells.size()) return infinite;
+                } while (!_next.compare_exchange_weak(t, t + 1, std::memory_order_relaxed));
+                acquire(worker, t);
+                return t;
+            }
+
+            void grow(std::size_t capacity) {
+                if (capacity >= dead) throw std::length_error("delaunay_tetrahedralisation: too many tetrahedra");
+                _cells.resize(capacity, {{dead, dead, dead, dead}, {dead, dead, dead, dead}});
+                _locks.resize(capacity, 0);
+                _in_cavity.resize(capacity, 0);
+            }
+
+            /**
+             * Insert point p, or report that it duplicates a vertex or that another thread holds a lock it needs.
+             */
+            Outcome insert(Worker &worker, std::size_t p) {
+
+                std::size_t start;
+                Outcome outcome = locate(worker, p, start);
+                if (outcome != Outcome::Inserted) {
+                    release(worker);
+                    return outcome;
+                }
+
+                // Grow the cavity across the faces of its tetrahedra.
+                worker.cavity.assign(1, start);
+                worker.boundary.clear();
+                _in_cavity[start] = 1;
+                bool busy = false;
+                for (std::size_t c = 0; c < worker.cavity.size() && !busy; ++c) {
+                    const std::size_t t = worker.cavity[c];
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        const std::size_t n = _cells[t].neighbours[i];
+                        if (!acquire(worker, n)) {
+                            busy = true;
+                            break;
+                        }
+                        if (_in_cavity[n]) continue;
+                        const int r = conflict(worker, n, p);
+                        if (r < 0) {
+                            busy = true;
+                            break;
+                        }
+                        if (r > 0) {
+                            _in_cavity[n] = 1;
+                            worker.cavity.push_back(n);
+                        } else {
+                            worker.boundary.push_back({t, i, n});
+                        }
+                    }
+                }
+
+                // Take the new tetrahedra before changing anything.
+                worker.created.clear();
+                if (!busy) {
+                    for (std::size_t b = 0; b < worker.boundary.size(); ++b) {
+                        const std::size_t t = allocate(worker);
+                        if (t == infinite) {
+                            busy = true;
+                            break;
+                        }
+                        worker.created.push_back(t);
+                    }
+                }
+                if (busy) {
+                    for (std::size_t t: worker.cavity) _in_cavity[t] = 0;
+                    worker.free.insert(worker.free.end(), worker.created.begin(), worker.created.end());
+                    worker.created.clear();
+                    release(worker);
+                    return Outcome::Busy;
+                }
+
+                // Join p to each boundary face; the faces through p pair up across the edges of the boundary, which
+                // are matched in a small open-addressing table.
+                std::size_t table_size = 16;
+                while (table_size < 6 * worker.boundary.size()) table_size *= 2;
+                if (worker.links.size() < table_size) worker.links.resize(table_size, {0, 0, infinite, 0});
+                const std::size_t mask = table_size - 1;
+                for (std::size_t b = 0; b < worker.boundary.size(); ++b) {
+                    const auto [t, i, n] = worker.boundary[b];
+                    const std::size_t created = worker.created[b];
+                    std::array<Index, 4> v = _cells[t].vertices;
+                    v[i] = static_cast<Index>(p);
+                    _cells[created].vertices = v;
+                    _cells[created].neighbours[i] = static_cast<Index>(n);
+                    for (std::size_t j = 0; j < 4; ++j) {
+                        if (_cells[n].neighbours[j] == t) _cells[n].neighbours[j] = static_cast<Index>(created);
+                        if (j == i) continue;
+                        const std::size_t m1 = (i != 0 && j != 0) ? 0 : ((i != 1 && j != 1) ? 1 : 2);
+                        const std::size_t m2 = 6 - i - j - m1;
+                        const std::size_t e1 = std::min(v[m1], v[m2]), e2 = std::max(v[m1], v[m2]);
+                        std::size_t slot = ((e1 * 0x9E3779B97F4A7C15ULL) ^ (e2 * 0xC2B2AE3D27D4EB4FULL)) >> 40 & mask;
+                        while (worker.links[slot][2] != infinite &&
+                               (worker.links[slot][0] != e1 || worker.links[slot][1] != e2)) {
+                            slot = (slot + 1) & mask;
+                        }
+                        auto &link = worker.links[slot];
+                        if (link[2] == infinite) {
+                            link = {e1, e2, created, j};
+                        } else {
+                            _cells[created].neighbours[j] = static_cast<Index>(link[2]);
+                            _cells[link[2]].neighbours[link[3]] = static_cast<Index>(created);
+                            // Each edge is shared by exactly two faces, so the slot is free again; keep it
+                            // occupied under a key no edge has, to preserve the probe sequences of the others.
+                            link[0] = link[1] = infinite;
+                        }
+                    }
+                }
+                for (std::size_t slot = 0; slot < table_size; ++slot) worker.links[slot][2] = infinite;
+
+                for (std::size_t t: worker.cavity) {
+                    _in_cavity[t] = 0;
+                    _cells[t].vertices[0] = dead;
+                    worker.free.push_back(t);
+                }
+                worker.last = worker.created.front();
+                release(worker);
+                return Outcome::Inserted;
+
+            }
+
+            void insert_serial(std::size_t p) {
+                Worker &worker = _workers[0];
+                _concurrent = false;
+                worker.id = 0;
+                if (insert(worker, p) == Outcome::Busy) {
+                    // Only a walk that failed to terminate ends here: start again from every tetrahedron in turn.
+                    for (std::size_t t = 0; t < _size; ++t) {
+                        if (_cells[t].vertices[0] == dead || conflict(worker, t, p) <= 0) continue;
+                        worker.last = t;
+                        if (insert(worker, p) != Outcome::Busy) return;
+                    }
+                }
+            }
+
+            void insert_parallel(const std::vector<std::size_t> &order, std::size_t begin, std::size_t end,
+                                 std::size_t n_threads) {
+
+                // Every insertion adds about six and a half tetrahedra; allow for more.
+                const std::size_t capacity = _size + 12 * (end - begin) + 256 * n_threads;
+                if (capacity > _cells.size()) grow(capacity);
+                _next = _size;
+
+                // Start each thread's walks next to the first point of its piece, as parallel_for() cuts them.
+                const std::size_t chunk = (end - begin + n_threads - 1) / n_threads;
+                for (std::size_t thread = 0; thread < n_threads; ++thread) {
+                    std::size_t found;
+                    if (begin + thread * chunk < end &&
+                        locate(_workers[0], order[begin + thread * chunk], found) == Outcome::Inserted) {
+                        _workers[thread].last = found;
+                    } else {
+                        _workers[thread].last = _workers[0].last;
+                    }
+                }
+                _concurrent = true;
+
+                std::vector<std::size_t> deferred;
+                std::mutex deferred_mutex;
+                parallel_for(begin, end, [&](std::size_t b, std::size_t e, std::size_t thread) {
+                    Worker &worker = _workers[thread];
+                    worker.id = thread;
+                    std::vector<std::size_t> retry;
+                    for (std::size_t i = b; i < e; ++i) {
+                        if (insert(worker, order[i]) == Outcome::Busy) retry.push_back(order[i]);
+                    }
+                    std::vector<std::size_t> failed;
+                    for (std::size_t p: retry) {
+                        if (insert(worker, p) == Outcome::Busy) failed.push_back(p);
+                    }
+                    std::lock_guard<std::mutex> lock(deferred_mutex);
+                    deferred.insert(deferred.end(), failed.begin(), failed.end());
+                }, n_threads, 1);
+
+                _size = _next;
+                _concurrent = false;
+                // Tetrahedra freed by the other workers go to the first, which runs all serial insertions.
+                for (std::size_t w = 1; w < _workers.size(); ++w) {
+                    _workers[0].free.insert(_workers[0].free.end(), _workers[w].free.begin(),
+                                            _workers[w].free.end());
+                    _workers[w].free.clear();
+                }
+                if (_cells[_workers[0].last].vertices[0] == dead) {
+                    for (std::size_t t = 0; t < _size; ++t) {
+                        if (_cells[t].vertices[0] != dead) {
+                            _workers[0].last = t;
+                            break;
+                        }
+                    }
+                }
+                for (std::size_t p: deferred) insert_serial(p);
+
+            }
+
+            /**
+             * Find four points in general position among the first in the order and build the first tetrahedron
+             * with its four ghosts. Return false if all points are coplanar.
+             */
+            bool initialise(const std::vector<std::size_t> &order) {
+
+                const std::size_t n = order.size();
+                if (n < 4) return false;
+                _workers.resize(1);
+
+                const std::size_t a = order[0];
+                std::size_t b = infinite;
+                for (std::size_t i = 1; i < n && b == infinite; ++i) {
+                    const Vector3D<double> &q = _points[order[i]];
+                    if (q.x() != _points[a].x() || q.y() != _points[a].y() || q.z() != _points[a].z()) b = order[i];
+                }
+                if (b == infinite) return false;
+
+                // The point farthest from the line through a and b, then the first point off their plane.
+                std::size_t c = infinite;
+                double farthest = 0.0;
+                for (std::size_t i = 1; i < n; ++i) {
+                    const double d2 = norm_squared(cross(_points[b] - _points[a], _points[order[i]] - _points[a]));
+                    if (d2 > farthest) {
+                        farthest = d2;
+                        c = order[i];
+                    }
+                }
+                if (c == infinite) return false;
+                for (std::size_t i = 1; i < n; ++i) {
+                    const std::size_t d = order[i];
+                    const int o = orient3d(_points[a], _points[b], _points[c], _points[d]);
+                    if (o == 0) continue;
+                    std::array<Index, 4> first = {static_cast<Index>(a), static_cast<Index>(b), static_cast<Index>(c),
+                                                  static_cast<Index>(d)};
+                    if (o < 0) std::swap(first[0], first[1]);
+                    build_first(first);
+                    return true;
+                }
+                return false;
+
+            }
+
+            void build_first(const std::array<Index, 4> &first) {
+
+                grow(64);
+                _size = 5;
+                _cells[0].vertices = first;
+                for (std::size_t i = 0; i < 4; ++i) {
+                    // Replacing vertex i by the point at infinity and swapping two vertices puts infinity beyond
+                    // the face opposite vertex i.
+                    std::array<Index, 4> g = first;
+                    g[i] = infinite;
+                    std::swap(g[(i + 1) % 4], g[(i + 2) % 4]);
+                    _cells[1 + i].vertices = g;
+                }
+
+                // Match the faces of the five tetrahedra by their sorted vertices.
+                std::vector<std::pair<std::array<std::size_t, 3>, std::pair<std::size_t, std::size_t>>> faces;
+                for (std::size_t t = 0; t < 5; ++t) {
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        std::array<std::size_t, 3> f;
+                        for (std::size_t m = 0, k = 0; m < 4; ++m) if (m != i) f[k++] = _cells[t].vertices[m];
+                        std::sort(f.begin(), f.end());
+                        faces.push_back({f, {t, i}});
+                    }
+                }
+                std::sort(faces.begin(), faces.end());
+                for (std::size_t f = 0; f + 1 < faces.size(); f += 2) {
+                    const auto [t, i] = faces[f].second;
+                    const auto [u, j] = faces[f + 1].second;
+                    _cells[t].neighbours[i] = static_cast<Index>(u);
+                    _cells[u].neighbours[j] = static_cast<Index>(t);
+                }
+                _workers[0].last = 0;
+
+            }
+
+        };
+
+    } // namespace detail
+
+    /**
+     * Return the Delaunay tetrahedralisation of a point cloud: the tetrahedra, with positive tetrahedron_volume(),
+     * whose circumspheres contain no other point, covering the convex hull of the points.
+     *
+     * The points are inserted incrementally (Bowyer-Watson) in brio_order(), with every decision taken by the exact
+     * orient3d() and insphere() predicates so that degenerate input, such as lattice points with many cospherical
+     * subsets, is handled correctly; where four or more points are cospherical one of the valid tetrahedralisations
+     * is returned. Once the triangulation has grown, each round of insertions is cut into contiguous (and thus,
+     * through the Hilbert order, spatially compact) pieces inserted concurrently, one per thread; insertions that
+     * meet another thread's region are retried and finally inserted serially.
+     * @param points the points; duplicate points are left out of the tetrahedra.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return a mesh with the points as vertices (in their original numbering) and the Delaunay tetrahedra, which is
+     * empty if all points are coplanar.
+     */
+    inline TetrahedralMesh<double> delaunay_tetrahedralisation(const Vector3DSoA<double> &points,
+                                                               std::size_t n_threads = 0) {
+
+        detail::DelaunayBuilder builder(points);
+        return builder.triangulate(n_threads);
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,561 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+#include <partition.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * The requirements on a message transport between the ranks of a distributed run: point-to-point byte messages
+     * identified by source, destination and tag. send() must not block (the message is buffered or sent
+     * asynchronously), so that a rank may post all of its sends, compute, and only then block in receive().
+     * Messages with equal source, destination and tag arrive in the order they were sent.
+     */
+    template<typename T>
+    concept Transport = requires(T &transport, const T &const_transport, std::size_t peer, std::size_t tag,
+                                 std::vector<std::byte> message) {
+        { const_transport.rank() } -> std::convertible_to<std::size_t>;
+        { const_transport.n_ranks() } -> std::convertible_to<std::size_t>;
+        transport.send(peer, tag, std::move(message));
+        { transport.receive(peer, tag) } -> std::same_as<std::vector<std::byte>>;
+    };
+
+    /**
+     * The shared state of a set of ranks communicating through memory, typically threads of one process: one mailbox
+     * per destination rank, each a set of message queues keyed by source and tag.
+     */
+    class SharedMemoryNetwork {
+
+    public:
+
+        /**
+         * Create a network for a number of ranks.
+         * @param n_ranks the number of ranks.
+         */
+        explicit SharedMemoryNetwork(std::size_t n_ranks) {
+            for (std::size_t r = 0; r < n_ranks; ++r) _mailboxes.push_back(std::make_unique<Mailbox>());
+        }
+
+        /**
+         * Retrieve the number of ranks.
+         * @return the number of ranks.
+         */
+        [[nodiscard]] inline std::size_t n_ranks() const { return _mailboxes.size(); }
+
+        /**
+         * Deposit a message in the mailbox of its destination and wake the destination if it waits for it.
+         * @param source the sending rank.
+         * @param destination the receiving rank.
+         * @param tag the message tag.
+         * @param message the message.
+         */
+        void post(std::size_t source, std::size_t destination, std::size_t tag, std::vector<std::byte> message) {
+            Mailbox &mailbox = *_mailboxes.at(destination);
+            {
+                std::lock_guard<std::mutex> lock(mailbox.mutex);
+                mailbox.messages[{source, tag}].push_back(std::move(message));
+            }
+            mailbox.ready.notify_all();
+        }
+
+        /**
+         * Take the oldest message from a source with a tag out of a mailbox, waiting until there is one.
+         * @param source the sending rank.
+         * @param destination the receiving rank.
+         * @param tag the message tag.
+         * @return the message.
+         */
+        std::vector<std::byte> take(std::size_t source, std::size_t destination, std::size_t tag) {
+            Mailbox &mailbox = *_mailboxes.at(destination);
+            std::unique_lock<std::mutex> lock(mailbox.mutex);
+            auto &queue = mailbox.messages[{source, tag}];
+            mailbox.ready.wait(lock, [&queue] { return !queue.empty(); });
+            std::vector<std::byte> message = std::move(queue.front());
+            queue.pop_front();
+            return message;
+        }
+
+    private:
+
+        struct Mailbox {
+            std::mutex mutex;
+            std::condition_variable ready;
+            std::map<std::pair<std::size_t, std::size_t>, std::deque<std::vector<std::byte>>> messages;
+        };
+
+        std::vector<std::unique_ptr<Mailbox>> _mailboxes;
+
+    };
+
+    /**
+     * The endpoint of one rank on a SharedMemoryNetwork, satisfying Transport; sends are buffered in the destination
+     * mailbox and never block.
+     */
+    class SharedMemoryTransport {
+
+    public:
+
+        /**
+         * Create the endpoint of a rank.
+         * @param network the network, which must outlive the endpoint.
+         * @param rank the rank.
+         */
+        SharedMemoryTransport(SharedMemoryNetwork &network, std::size_t rank) : _network(&network), _rank(rank) {
+            if (rank >= network.n_ranks()) throw std::out_of_range("SharedMemoryTransport: rank out of range");
+        }
+
+        /**
+         * Retrieve the rank of this endpoint.
+         * @return the rank.
+         */
+        [[nodiscard]] inline std::size_t rank() const { return _rank; }
+
+        /**
+         * Retrieve the number of ranks.
+         * @return the number of ranks.
+         */
+        [[nodiscard]] inline std::size_t n_ranks() const { return _network->n_ranks(); }
+
+        /**
+         * Send a message without blocking.
+         * @param destination the receiving rank.
+         * @param tag the message tag.
+         * @param message the message.
+         */
+        void send(std::size_t destination, std::size_t tag, std::vector<std::byte> message) {
+            _network->post(_rank, destination, tag, std::move(message));
+        }
+
+        /**
+         * Receive a message, blocking until it has arrived.
+         * @param source the sending rank.
+         * @param tag the message tag.
+         * @return the message.
+         */
+        std::vector<std::byte> receive(std::size_t source, std::size_t tag) {
+            return _network->take(source, _rank, tag);
+        }
+
+    private:
+
+        SharedMemoryNetwork *_network;
+        std::size_t _rank;
+
+    };
+
+    /**
+     * The communication pattern of one rank for one kind of entity (vertices or elements): for each neighbouring
+     * rank the local indices of the owned entities to send to it and of the ghost entities to receive from it. Both
+     * lists are ordered by global index, so the n-th value sent by one rank is the n-th value received by the other.
+     */
+    struct ExchangePlan {
+
+        /** The neighbouring ranks, ascending. */
+        std::vector<std::size_t> neighbours;
+
+        /** The start of each neighbour's send list in `send_indices`, neighbours.size() + 1 entries. */
+        std::vector<std::size_t> send_offsets = {0};
+
+        /** The local indices of the owned entities sent to each neighbour. */
+        std::vector<std::size_t> send_indices;
+
+        /** The start of each neighbour's receive list in `receive_indices`, neighbours.size() + 1 entries. */
+        std::vector<std::size_t> receive_offsets = {0};
+
+        /** The local indices of the ghost entities received from each neighbour. */
+        std::vector<std::size_t> receive_indices;
+
+    };
+
+    /**
+     * One rank's share of a partitioned tetrahedral mesh with ghost layers and local numbering. The local elements
+     * are the owned ones followed by the ghosts; the local vertices are the owned ones followed by the ghosts, a
+     * vertex being owned by the rank owning the lowest numbered element containing it. Owned elements whose vertices
+     * are all owned form the interior, which can be processed while the ghost values are still in flight.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class DistributedMesh {
+
+    public:
+
+        /**
+         * Distribute a partitioned tetrahedral mesh, computing the share and the exchange plans of every rank.
+         * @param mesh the global mesh.
+         * @param parts the rank owning each element, e.g. from partition_mesh().
+         * @param n_ranks the number of ranks.
+         * @param layers the number of ghost element layers.
+         * @return the share of each rank.
+         */
+        static std::vector<DistributedMesh> distribute(const TetrahedralMesh<Real> &mesh,
+                                                       const std::vector<std::size_t> &parts, std::size_t n_ranks,
+                                                       std::size_t layers = 1) {
+
+            constexpr std::size_t absent = std::numeric_limits<std::size_t>::max();
+
+            if (parts.size() != mesh.n_tetrahedra()) {
+                throw std::invalid_argument("DistributedMesh: one part per element is required");
+            }
+
+            std::vector<std::size_t> vertex_owner(mesh.n_vertices(), absent);
+            for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) {
+                if (parts[e] >= n_ranks) throw std::out_of_range("DistributedMesh: part out of range");
+                for (std::size_t v: mesh.tetrahedra[e]) if (vertex_owner[v] == absent) vertex_owner[v] = parts[e];
+            }
+
+            std::vector<DistributedMesh> ranks(n_ranks);
+            for (std::size_t r = 0; r < n_ranks; ++r) {
+
+                DistributedMesh &d = ranks[r];
+                d._rank = r;
+                d._n_ranks = n_ranks;
+
+                for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) {
+                    if (parts[e] == r) d._global_elements.push_back(e);
+                }
+                d._n_owned_elements = d._global_elements.size();
+                const std::vector<std::size_t> halo = halo_elements(mesh.tetrahedra, mesh.n_vertices(), parts, r,
+                                                                    layers);
+                d._global_elements.insert(d._global_elements.end(), halo.begin(), halo.end());
+
+                // Owned vertices first, then ghosts, each in order of first appearance.
+                std::vector<std::size_t> owned, ghosts;
+                std::vector<char> seen(mesh.n_vertices(), 0);
+                for (std::size_t e: d._global_elements) {
+                    for (std::size_t v: mesh.tetrahedra[e]) {
+                        if (seen[v]) continue;
+                        seen[v] = 1;
+                        (vertex_owner[v] == r ? owned : ghosts).push_back(v);
+                    }
+                }
+                d._n_owned_vertices = owned.size();
+                d._global_vertices = owned;
+                d._global_vertices.insert(d._global_vertices.end(), ghosts.begin(), ghosts.end());
+
+                d._vertex_lookup = sorted_lookup(d._global_vertices);
+                d._element_lookup = sorted_lookup(d._global_elements);
+
+                for (std::size_t v: d._global_vertices) d._mesh.vertices.push_back(mesh.vertices[v]);
+                for (std::size_t k = 0; k < d._global_elements.size(); ++k) {
+                    std::array<std::size_t, 4> t = mesh.tetrahedra[d._global_elements[k]];
+                    bool interior = true;
+                    for (std::size_t &v: t) {
+                        v = d.local_vertex(v);
+                        interior = interior && v < d._n_owned_vertices;
+                    }
+                    d._mesh.tetrahedra.push_back(t);
+                    if (k < d._n_owned_elements) (interior ? d._interior_elements : d._boundary_elements).push_back(k);
+                }
+
+            }
+
+            // Plans: the ghosts of rank r are received from their owners, which send their own copies.
+            build_plans(ranks, [&](const DistributedMesh &d) { return std::make_pair(d._n_owned_vertices,
+                                                                                     &d._global_vertices); },
+                        [&](std::size_t v) { return vertex_owner[v]; },
+                        [](DistributedMesh &d) -> ExchangePlan & { return d._vertex_plan; },
+                        [](const DistributedMesh &d, std::size_t v) { return d.local_vertex(v); });
+            build_plans(ranks, [&](const DistributedMesh &d) { return std::make_pair(d._n_owned_elements,
+                                                                                     &d._global_elements); },
+                        [&](std::size_t e) { return parts[e]; },
+                        [](DistributedMesh &d) -> ExchangePlan & { return d._element_plan; },
+                        [](const DistributedMesh &d, std::size_t e) { return d.local_element(e); });
+
+            return ranks;
+
+        }
+
+        /**
+         * Retrieve the rank of this share.
+         * @return the rank.
+         */
+        [[nodiscard]] inline std::size_t rank() const { return _rank; }
+
+        /**
+         * Retrieve the number of ranks.
+         * @return the number of ranks.
+         */
+        [[nodiscard]] inline std::size_t n_ranks() const { return _n_ranks; }
+
+        /**
+         * Retrieve the local mesh: owned elements and vertices first, ghosts after.
+         * @return the local mesh.
+         */
+        [[nodiscard]] inline const TetrahedralMesh<Real> &mesh() const { return _mesh; }
+
+        /**
+         * Retrieve the number of owned elements.
+         * @return the number of owned elements.
+         */
+        [[nodiscard]] inline std::size_t n_owned_elements() const { return _n_owned_elements; }
+
+        /**
+         * Retrieve the number of owned vertices.
+         * @return the number of owned vertices.
+         */
+        [[nodiscard]] inline std::size_t n_owned_vertices() const { return _n_owned_vertices; }
+
+        /**
+         * Retrieve the global index of each local element.
+         * @return the global element indices.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &global_elements() const { return _global_elements; }
+
+        /**
+         * Retrieve the global index of each local vertex.
+         * @return the global vertex indices.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &global_vertices() const { return _global_vertices; }
+
+        /**
+         * Retrieve the owned elements with only owned vertices (local indices).
+         * @return the interior elements.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &interior_elements() const { return _interior_elements; }
+
+        /**
+         * Retrieve the owned elements with at least one ghost vertex (local indices).
+         * @return the boundary elements.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &boundary_elements() const { return _boundary_elements; }
+
+        /**
+         * Retrieve the exchange plan of vertex values.
+         * @return the vertex plan.
+         */
+        [[nodiscard]] inline const ExchangePlan &vertex_plan() const { return _vertex_plan; }
+
+        /**
+         * Retrieve the exchange plan of element values.
+         * @return the element plan.
+         */
+        [[nodiscard]] inline const ExchangePlan &element_plan() const { return _element_plan; }
+
+        /**
+         * Map a global vertex index to the local one.
+         * @param v the global vertex index.
+         * @return the local vertex index, or std::numeric_limits<std::size_t>::max() if the vertex is not local.
+         */
+        [[nodiscard]] std::size_t local_vertex(std::size_t v) const { return find(_vertex_lookup, v); }
+
+        /**
+         * Map a global element index to the local one.
+         * @param e the global element index.
+         * @return the local element index, or std::numeric_limits<std::size_t>::max() if the element is not local.
+         */
+        [[nodiscard]] std::size_t local_element(std::size_t e) const { return find(_element_lookup, e); }
+
+    private:
+
+        std::size_t _rank = 0;
+        std::size_t _n_ranks = 1;
+
+        TetrahedralMesh<Real> _mesh;
+        std::size_t _n_owned_elements = 0;
+        std::size_t _n_owned_vertices = 0;
+        std::vector<std::size_t> _global_elements;
+        std::vector<std::size_t> _global_vertices;
+        std::vector<std::pair<std::size_t, std::size_t>> _element_lookup;
+        std::vector<std::pair<std::size_t, std::size_t>> _vertex_lookup;
+        std::vector<std::size_t> _interior_elements;
+        std::vector<std::size_t> _boundary_elements;
+
+        ExchangePlan _vertex_plan;
+        ExchangePlan _element_plan;
+
+        /**
+         * Build a (global, local) table sorted by global index.
+         */
+        static std::vector<std::pair<std::size_t, std::size_t>> sorted_lookup(const std::vector<std::size_t> &global) {
+            std::vector<std::pair<std::size_t, std::size_t>> lookup(global.size());
+            for (std::size_t k = 0; k < global.size(); ++k) lookup[k] = {global[k], k};
+            std::sort(lookup.begin(), lookup.end());
+            return lookup;
+        }
+
+        static std::size_t find(const std::vector<std::pair<std::size_t, std::size_t>> &lookup, std::size_t global) {
+            auto it = std::lower_bound(lookup.begin(), lookup.end(), std::make_pair(global, std::size_t(0)));
+            if (it == lookup.end() || it->first != global) return std::numeric_limits<std::size_t>::max();
+            return it->second;
+        }
+
+        /**
+         * Build the exchange plans of one kind of entity for all ranks: every ghost of rank r is received from its
+         * owner q, and q sends its copy; both sides order each neighbour's list by global index.
+         */
+        template<typename Entities, typename Owner, typename Plan, typename Local>
+        static void build_plans(std::vector<DistributedMesh> &ranks, Entities entities, Owner owner, Plan plan,
+                                Local local) {
+
+            const std::size_t n_ranks = ranks.size();
+
+            // (owner, receiver, global index) of every ghost copy.
+            std::vector<std::array<std::size_t, 3>> copies;
+            for (std::size_t r = 0; r < n_ranks; ++r) {
+                const auto [n_owned, global] = entities(ranks[r]);
+                for (std::size_t k = n_owned; k < global->size(); ++k) {
+                    copies.push_back({owner((*global)[k]), r, (*global)[k]});
+                }
+            }
+
+            // Receive lists, grouped by (receiver, owner).
+            std::sort(copies.begin(), copies.end(), [](const auto &a, const auto &b) {
+                return std::tie(a[1], a[0], a[2]) < std::tie(b[1], b[0], b[2]);
+            });
+            for (const auto &c: copies) {
+                ExchangePlan &p = plan(ranks[c[1]]);
+                if (p.neighbours.empty() || p.neighbours.back() != c[0]) {
+                    p.neighbours.push_back(c[0]);
+                    p.receive_offsets.push_back(p.receive_offsets.back());
+                }
+                p.receive_indices.push_back(local(ranks[c[1]], c[2]));
+                ++p.receive_offsets.back();
+            }
+
+            // Send lists, grouped by (owner, receiver); a rank's send and receive neighbours coincide when the ghost
+            // relation is symmetric, otherwise the missing side gets an empty list.
+            std::sort(copies.begin(), copies.end());
+            std::vector<std::vector<std::pair<std::size_t, std::vector<std::size_t>>>> sends(n_ranks);
+            for (const auto &c: copies) {
+                auto &list = sends[c[0]];
+                if (list.empty() || list.back().first != c[1]) list.emplace_back(c[1], std::vector<std::size_t>());
+                list.back().second.push_back(local(ranks[c[0]], c[2]));
+            }
+            for (std::size_t r = 0; r < n_ranks; ++r) {
+                ExchangePlan &p = plan(ranks[r]);
+                std::vector<std::size_t> neighbours = p.neighbours;
+                for (const auto &s: sends[r]) neighbours.push_back(s.first);
+                std::sort(neighbours.begin(), neighbours.end());
+                neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+                ExchangePlan merged;
+                merged.neighbours = neighbours;
+                std::size_t receive_k = 0, send_k = 0;
+                for (std::size_t q: neighbours) {
+                    if (receive_k < p.neighbours.size() && p.neighbours[receive_k] == q) {
+                        merged.receive_indices.insert(merged.receive_indices.end(),
+                                                      p.receive_indices.begin() +
+                                                      static_cast<std::ptrdiff_t>(p.receive_offsets[receive_k]),
+                                                      p.receive_indices.begin() +
+                                                      static_cast<std::ptrdiff_t>(p.receive_offsets[receive_k + 1]));
+                        ++receive_k;
+                    }
+                    merged.receive_offsets.push_back(merged.receive_indices.size());
+                    if (send_k < sends[r].size() && sends[r][send_k].first == q) {
+                        merged.send_indices.insert(merged.send_indices.end(), sends[r][send_k].second.begin(),
+                                                   sends[r][send_k].second.end());
+                        ++send_k;
+                    }
+                    merged.send_offsets.push_back(merged.send_indices.size());
+                }
+                p = std::move(merged);
+            }
+
+        }
+
+    };
+
+    /**
+     * Start a halo exchange: pack the owned values each neighbour needs and send them. The transport does not block
+     * on sends, so the caller may compute before calling finish_exchange().
+     * @param plan the exchange plan.
+     * @param transport the transport.
+     * @param values the local values (owned and ghost), indexed as the plan's local indices.
+     * @param tag the message tag, to keep concurrent exchanges apart.
+     */
+    template<typename T, Transport Tr>
+    void begin_exchange(const ExchangePlan &plan, Tr &transport, const T *values, std::size_t tag = 0) {
+
+        static_assert(std::is_trivially_copyable_v<T>, "halo exchange values must be trivially copyable");
+
+        for (std::size_t k = 0; k < plan.neighbours.size(); ++k) {
+            std::vector<std::byte> message((plan.send_offsets[k + 1] - plan.send_offsets[k]) * sizeof(T));
+            std::byte *out = message.data();
+            for (std::size_t i = plan.send_offsets[k]; i < plan.send_offsets[k + 1]; ++i, out += sizeof(T)) {
+                std::memcpy(out, &values[plan.send_indices[i]], sizeof(T));
+            }
+            transport.send(plan.neighbours[k], tag, std::move(message));
+        }
+
+    }
+
+    /**
+     * Complete a halo exchange: receive the neighbours' values and store them in the ghost entries.
+     * @param plan the exchange plan.
+     * @param transport the transport.
+     * @param values the local values (owned and ghost), indexed as the plan's local indices.
+     * @param tag the message tag used by begin_exchange().
+     */
+    template<typename T, Transport Tr>
+    void finish_exchange(const ExchangePlan &plan, Tr &transport, T *values, std::size_t tag = 0) {
+
+        static_assert(std::is_trivially_copyable_v<T>, "halo exchange values must be trivially copyable");
+
+        for (std::size_t k = 0; k < plan.neighbours.size(); ++k) {
+            const std::vector<std::byte> message = transport.receive(plan.neighbours[k], tag);
+            const std::size_t count = plan.receive_offsets[k + 1] - plan.receive_offsets[k];
+            if (message.size() != count * sizeof(T)) throw std::runtime_error("finish_exchange: message size mismatch");
+            const std::byte *in = message.data();
+            for (std::size_t i = plan.receive_offsets[k]; i < plan.receive_offsets[k + 1]; ++i, in += sizeof(T)) {
+                std::memcpy(&values[plan.receive_indices[i]], in, sizeof(T));
+            }
+        }
+
+    }
+
+    /**
+     * Exchange vertex values while computing: the owned vertex values are sent, `fn` processes the interior elements
+     * (which read no ghost value), the ghost values are received, and `fn` then processes the boundary elements.
+     * @tparam Fn callable with signature void(const std::size_t *elements, std::size_t count, std::size_t thread)
+     * receiving local element indices.
+     * @param mesh the rank's share of the mesh.
+     * @param transport the transport.
+     * @param values the local vertex values; the owned ones are sent, the ghost ones overwritten.
+     * @param fn the element kernel.
+     * @param tag the message tag.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real, typename T, Transport Tr, typename Fn>
+    void exchange_and_compute(const DistributedMesh<Real> &mesh, Tr &transport, T *values, Fn fn,
+                              std::size_t tag = 0, std::size_t n_threads = 0) {
+
+        begin_exchange(mesh.vertex_plan(), transport, values, tag);
+
+        const std::vector<std::size_t> &interior = mesh.interior_elements();
+        parallel_for(0, interior.size(), [&](std::size_t begin, std::size_t end, std::size_t thread) {
+            fn(interior.data() + begin, end - begin, thread);
+        }, n_threads);
+
+        finish_exchange(mesh.vertex_plan(), transport, values, tag);
+
+        const std::vector<std::size_t> &boundary = mesh.boundary_elements();
+        parallel_for(0, boundary.size(), [&](std::size_t begin, std::size_t end, std::size_t thread) {
+            fn(boundary.data() + begin, end - begin, thread);
+        }, n_threads);
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
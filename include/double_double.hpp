@@ -0,0 +1,262 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <ostream>
+#include <type_traits>
+
+namespace org::lesleisnagy::geomlib {
+
+    namespace detail {
+
+        /**
+         * Error free transformation of the sum of two doubles: \f$a + b = s + e\f$ exactly.
+         * @param a the left hand side of the sum.
+         * @param b the right hand side of the sum.
+         * @param e receives the rounding error of the sum.
+         * @return the rounded sum.
+         */
+        inline double two_sum(double a, double b, double &e) {
+
+            double s = a + b;
+            double bb = s - a;
+            e = (a - (s - bb)) + (b - bb);
+            return s;
+
+        }
+
+        /**
+         * Error free transformation of the sum of two doubles with \f$|a| \geq |b|\f$.
+         * @param a the left hand side of the sum.
+         * @param b the right hand side of the sum.
+         * @param e receives the rounding error of the sum.
+         * @return the rounded sum.
+         */
+        inline double quick_two_sum(double a, double b, double &e) {
+
+            double s = a + b;
+            e = b - (s - a);
+            return s;
+
+        }
+
+        /**
+         * Error free transformation of the product of two doubles: \f$a b = p + e\f$ exactly.
+         * @param a the left hand side of the product.
+         * @param b the right hand side of the product.
+         * @param e receives the rounding error of the product.
+         * @return the rounded product.
+         */
+        inline double two_prod(double a, double b, double &e) {
+
+            double p = a * b;
+            e = std::fma(a, b, -p);
+            return p;
+
+        }
+
+    } // namespace detail
+
+    /**
+     * A double-double real number, i.e. an unevaluated sum \f$hi + lo\f$ of two doubles with \f$|lo| \leq u |hi|\f$,
+     * giving roughly 106 bits of significand at a small multiple of the cost of double arithmetic. DoubleDouble may be
+     * used as the `Real` parameter of every template in vector3d.hpp and geometry.hpp and sits between 'double' and
+     * 'mpreal' in cost and accuracy.
+     */
+    class DoubleDouble {
+
+    public:
+
+        /**
+         * The unit round-off of double-double arithmetic (conservatively \f$2^{-104}\f$).
+         */
+        static constexpr double unit_roundoff = 4.930380657631324e-32;
+
+        /**
+         * Create a double-double zero.
+         */
+        constexpr DoubleDouble() : _hi(0.0), _lo(0.0) {}
+
+        /**
+         * Create a double-double from a built-in arithmetic value (integers beyond 53 bits are rounded).
+         * @param v the value.
+         */
+        template<typename U> requires std::is_arithmetic_v<U>
+        constexpr DoubleDouble(U v) : _hi(static_cast<double>(v)), _lo(0.0) {}
+
+        /**
+         * Create a double-double from a high and a low part; the two parts are renormalised.
+         * @param hi the high part.
+         * @param lo the low part.
+         */
+        DoubleDouble(double hi, double lo) {
+
+            _hi = detail::two_sum(hi, lo, _lo);
+
+        }
+
+        /**
+         * Retrieve the high part.
+         * @return the high part.
+         */
+        [[nodiscard]] inline double hi() const { return _hi; }
+
+        /**
+         * Retrieve the low part.
+         * @return the low part.
+         */
+        [[nodiscard]] inline double lo() const { return _lo; }
+
+        /**
+         * Round the double-double to the nearest double.
+         * @return the rounded value.
+         */
+        [[nodiscard]] inline double to_double() const { return _hi + _lo; }
+
+    private:
+
+        double _hi;
+        double _lo;
+
+    };
+
+    /**
+     * Redirection operator to display the double-double (only to double precision).
+     * @param out the output stream.
+     * @param a the double-double to display.
+     * @return the output stream with a representation of the input double-double.
+     */
+    inline std::ostream &operator<<(std::ostream &out, const DoubleDouble &a) {
+
+        out << a.hi() << " + " << a.lo();
+        return out;
+
+    }
+
+    /**
+     * Double-double negation operator.
+     * @param a the double-double to negate.
+     * @return the negated double-double.
+     */
+    inline DoubleDouble operator-(const DoubleDouble &a) {
+
+        return {-a.hi(), -a.lo()};
+
+    }
+
+    /**
+     * Double-double addition operator (IEEE style accurate sum).
+     * @param a the left hand side of the sum.
+     * @param b the right hand side of the sum.
+     * @return the sum.
+     */
+    inline DoubleDouble operator+(const DoubleDouble &a, const DoubleDouble &b) {
+
+        double s2, t2;
+        double s1 = detail::two_sum(a.hi(), b.hi(), s2);
+        double t1 = detail::two_sum(a.lo(), b.lo(), t2);
+
+        s2 += t1;
+        s1 = detail::quick_two_sum(s1, s2, s2);
+        s2 += t2;
+
+        return {s1, s2};
+
+    }
+
+    /**
+     * Double-double subtraction operator.
+     * @param a the left hand side of the difference.
+     * @param b the right hand side of the difference.
+     * @return the difference.
+     */
+    inline DoubleDouble operator-(const DoubleDouble &a, const DoubleDouble &b) {
+
+        return a + (-b);
+
+    }
+
+    /**
+     * Double-double multiplication operator.
+     * @param a the left hand side of the product.
+     * @param b the right hand side of the product.
+     * @return the product.
+     */
+    inline DoubleDouble operator*(const DoubleDouble &a, const DoubleDouble &b) {
+
+        double p2;
+        double p1 = detail::two_prod(a.hi(), b.hi(), p2);
+
+        p2 += a.hi() * b.lo() + a.lo() * b.hi();
+
+        return {p1, p2};
+
+    }
+
+    /**
+     * Double-double division operator.
+     * @param a the dividend.
+     * @param b the divisor.
+     * @return the quotient.
+     */
+    inline DoubleDouble operator/(const DoubleDouble &a, const DoubleDouble &b) {
+
+        double q1 = a.hi() / b.hi();
+        DoubleDouble r = a - DoubleDouble(q1) * b;
+
+        double q2 = r.hi() / b.hi();
+        r = r - DoubleDouble(q2) * b;
+
+        double q3 = r.hi() / b.hi();
+
+        return DoubleDouble(q1, q2) + DoubleDouble(q3);
+
+    }
+
+    /**
+     * Double-double comparison operators.
+     */
+    inline bool operator==(const DoubleDouble &a, const DoubleDouble &b) { return a.hi() == b.hi() && a.lo() == b.lo(); }
+    inline bool operator!=(const DoubleDouble &a, const DoubleDouble &b) { return !(a == b); }
+    inline bool operator<(const DoubleDouble &a, const DoubleDouble &b) {
+        return a.hi() < b.hi() || (a.hi() == b.hi() && a.lo() < b.lo());
+    }
+    inline bool operator>(const DoubleDouble &a, const DoubleDouble &b) { return b < a; }
+    inline bool operator<=(const DoubleDouble &a, const DoubleDouble &b) { return !(b < a); }
+    inline bool operator>=(const DoubleDouble &a, const DoubleDouble &b) { return !(a < b); }
+
+    /**
+     * Double-double absolute value.
+     * @param a the double-double for which we seek the absolute value.
+     * @return the absolute value.
+     */
+    inline DoubleDouble abs(const DoubleDouble &a) {
+
+        return a.hi() < 0.0 ? -a : a;
+
+    }
+
+    /**
+     * Double-double square root, computed with one Newton step from the double precision reciprocal square root
+     * (Karp's method).
+     * @param a the double-double for which we seek the square root.
+     * @return the square root, zero is returned for non-positive arguments.
+     */
+    inline DoubleDouble sqrt(const DoubleDouble &a) {
+
+        if (a.hi() <= 0.0) return {};
+
+        double x = 1.0 / std::sqrt(a.hi());
+        double ax = a.hi() * x;
+
+        DoubleDouble ax_dd(ax);
+        DoubleDouble residual = a - ax_dd * ax_dd;
+
+        return ax_dd + DoubleDouble(residual.hi() * (x * 0.5));
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,282 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include <vector3d.hpp>
+#include <geometry.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * A forward-mode automatic differentiation number carrying a value together with its gradient with respect to `N`
+     * independent variables. Dual<T, N> may be used as the `Real` parameter of every template in vector3d.hpp and
+     * geometry.hpp, so that e.g. tetrahedron_volume() evaluated on seeded vertices (see seed()) yields the volume and
+     * its gradient with respect to all twelve vertex coordinates in a single pass.
+     * @tparam T the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     * @tparam N the number of independent variables.
+     */
+    template<typename T, std::size_t N>
+    class Dual {
+
+    public:
+
+        /**
+         * Create a zero constant.
+         */
+        Dual() : _value(0) { _gradient.fill(T(0)); }
+
+        /**
+         * Create a constant (i.e. with zero gradient).
+         * @param value the value.
+         */
+        Dual(const T &value) : _value(value) { _gradient.fill(T(0)); }
+
+        /**
+         * Create a constant from a built-in arithmetic value.
+         * @param value the value.
+         */
+        template<typename U> requires (std::is_arithmetic_v<U> && !std::is_same_v<U, T>)
+        Dual(U value) : _value(value) { _gradient.fill(T(0)); }
+
+        /**
+         * Create a dual number with the given value and gradient.
+         * @param value the value.
+         * @param gradient the gradient.
+         */
+        Dual(T value, std::array<T, N> gradient) : _value(std::move(value)), _gradient(std::move(gradient)) {}
+
+        /**
+         * Create the independent variable with index `i`, i.e. the value `value` with unit gradient in direction `i`.
+         * @param value the value of the variable.
+         * @param i the index of the variable.
+         * @return the independent variable.
+         */
+        static Dual variable(const T &value, std::size_t i) {
+
+            Dual result(value);
+            result._gradient[i] = T(1);
+            return result;
+
+        }
+
+        /**
+         * Retrieve the value.
+         * @return the value.
+         */
+        [[nodiscard]] inline const T &value() const { return _value; }
+
+        /**
+         * Retrieve the gradient.
+         * @return the gradient.
+         */
+        [[nodiscard]] inline const std::array<T, N> &gradient() const { return _gradient; }
+
+        /**
+         * Retrieve the derivative with respect to the variable with index `i`.
+         * @param i the variable index.
+         * @return the partial derivative.
+         */
+        [[nodiscard]] inline const T &derivative(std::size_t i) const { return _gradient[i]; }
+
+    private:
+
+        T _value;
+        std::array<T, N> _gradient;
+
+    };
+
+    /**
+     * Redirection operator to display the dual number.
+     * @tparam T the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     * @tparam N the number of independent variables.
+     * @param out the output stream.
+     * @param a the dual number to display.
+     * @return the output stream with a representation of the input dual number.
+     */
+    template<typename T, std::size_t N>
+    std::ostream &operator<<(std::ostream &out, const Dual<T, N> &a) {
+
+        out << a.value() << " [";
+        for (std::size_t i = 0; i < N; ++i) out << (i == 0 ? "" : ", ") << a.derivative(i);
+        out << "]";
+        return out;
+
+    }
+
+    /**
+     * Dual number negation operator.
+     */
+    template<typename T, std::size_t N>
+    Dual<T, N> operator-(const Dual<T, N> &a) {
+
+        std::array<T, N> g;
+        for (std::size_t i = 0; i < N; ++i) g[i] = -a.derivative(i);
+        return {-a.value(), g};
+
+    }
+
+    /**
+     * Dual number addition operator.
+     */
+    template<typename T, std::size_t N>
+    Dual<T, N> operator+(const Dual<T, N> &a, const Dual<T, N> &b) {
+
+        std::array<T, N> g;
+        for (std::size_t i = 0; i < N; ++i) g[i] = a.derivative(i) + b.derivative(i);
+        return {a.value() + b.value(), g};
+
+    }
+
+    /**
+     * Dual number subtraction operator.
+     */
+    template<typename T, std::size_t N>
+    Dual<T, N> operator-(const Dual<T, N> &a, const Dual<T, N> &b) {
+
+        std::array<T, N> g;
+        for (std::size_t i = 0; i < N; ++i) g[i] = a.derivative(i) - b.derivative(i);
+        return {a.value() - b.value(), g};
+
+    }
+
+    /**
+     * Dual number multiplication operator, \f$(ab)' = a'b + ab'\f$.
+     */
+    template<typename T, std::size_t N>
+    Dual<T, N> operator*(const Dual<T, N> &a, const Dual<T, N> &b) {
+
+        std::array<T, N> g;
+        for (std::size_t i = 0; i < N; ++i) g[i] = a.derivative(i) * b.value() + a.value() * b.derivative(i);
+        return {a.value() * b.value(), g};
+
+    }
+
+    /**
+     * Dual number division operator, \f$(a/b)' = (a' - (a/b)b')/b\f$.
+     */
+    template<typename T, std::size_t N>
+    Dual<T, N> operator/(const Dual<T, N> &a, const Dual<T, N> &b) {
+
+        T q = a.value() / b.value();
+        std::array<T, N> g;
+        for (std::size_t i = 0; i < N; ++i) g[i] = (a.derivative(i) - q * b.derivative(i)) / b.value();
+        return {q, g};
+
+    }
+
+    /**
+     * Dual number square root, \f$(\sqrt{a})' = a' / (2\sqrt{a})\f$.
+     */
+    template<typename T, std::size_t N>
+    Dual<T, N> sqrt(const Dual<T, N> &a) {
+
+        using std::sqrt;
+
+        T s = sqrt(a.value());
+        T half_inv = T(1) / (T(2) * s);
+        std::array<T, N> g;
+        for (std::size_t i = 0; i < N; ++i) g[i] = a.derivative(i) * half_inv;
+        return {s, g};
+
+    }
+
+    /**
+     * Dual number absolute value.
+     */
+    template<typename T, std::size_t N>
+    Dual<T, N> abs(const Dual<T, N> &a) {
+
+        return a.value() < T(0) ? -a : a;
+
+    }
+
+    /**
+     * Seed a vertex as three independent variables of a Dual<T, N> computation.
+     * @tparam N the number of independent variables.
+     * @tparam T the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     * @param r the vertex.
+     * @param offset the index of the vertex's x-component variable, y & z follow consecutively.
+     * @return the seeded vertex.
+     */
+    template<std::size_t N, typename T>
+    Vector3D<Dual<T, N>> seed(const Vector3D<T> &r, std::size_t offset) {
+
+        return {Dual<T, N>::variable(r.x(), offset),
+                Dual<T, N>::variable(r.y(), offset + 1),
+                Dual<T, N>::variable(r.z(), offset + 2)};
+
+    }
+
+    /**
+     * Return the gradient of edge_length() with respect to both end points; the derivative with respect to `lhs` is
+     * \f$(l - r) / \sqrt{|l - r|^2 + \epsilon^2}\f$ and that with respect to `rhs` is its negation.
+     * @param lhs vector representing the start point of the edge.
+     * @param rhs vector representing the end point of the edge.
+     * @return the gradient with respect to `lhs` and `rhs` (in that order).
+     */
+    template<typename Real>
+    std::array<Vector3D<Real>, 2> edge_length_gradient(const Vector3D<Real> &lhs, const Vector3D<Real> &rhs) {
+
+        Vector3D<Real> d = lhs - rhs;
+        Vector3D<Real> g = d / norm(d);
+
+        return {g, Real(-1) * g};
+
+    }
+
+    /**
+     * Return the gradient of triangle_area() with respect to the three vertices; with \f$n = (r_2 - r_1) \times
+     * (r_3 - r_1)\f$ the derivative with respect to \f$r_1\f$ is \f$\frac{1}{2}(r_2 - r_3) \times n /
+     * \sqrt{|n|^2 + \epsilon^2}\f$ and the others follow by cyclic permutation.
+     * @param r1 vector representing a point on the triangle.
+     * @param r2 vector representing a point on the triangle.
+     * @param r3 vector representing a point on the triangle.
+     * @return the gradient with respect to r1, r2 & r3.
+     */
+    template<typename Real>
+    std::array<Vector3D<Real>, 3> triangle_area_gradient(const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                                                         const Vector3D<Real> &r3) {
+
+        Vector3D<Real> n = cross(r2 - r1, r3 - r1);
+        Vector3D<Real> m = n / (Real(2) * norm(n));
+
+        return {cross(r2 - r3, m), cross(r3 - r1, m), cross(r1 - r2, m)};
+
+    }
+
+    /**
+     * Return the gradient of tetrahedron_volume() with respect to the four vertices; the derivative with respect to a
+     * vertex is one sixth of the (outward oriented) area vector of the opposite face.
+     * @param r1 vector representing a point on the tetrahedron.
+     * @param r2 vector representing a point on the tetrahedron.
+     * @param r3 vector representing a point on the tetrahedron.
+     * @param r4 vector representing a point on the tetrahedron.
+     * @return the gradient with respect to r1, r2, r3 & r4.
+     */
+    template<typename Real>
+    std::array<Vector3D<Real>, 4> tetrahedron_volume_gradient(const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                                                              const Vector3D<Real> &r3, const Vector3D<Real> &r4) {
+
+        Vector3D<Real> a = r2 - r1;
+        Vector3D<Real> b = r3 - r1;
+        Vector3D<Real> c = r4 - r1;
+
+        Vector3D<Real> g2 = cross(b, c) / Real(6);
+        Vector3D<Real> g3 = cross(c, a) / Real(6);
+        Vector3D<Real> g4 = cross(a, b) / Real(6);
+        Vector3D<Real> g1 = Real(-1) * ((g2 + g3) + g4);
+
+        return {g1, g2, g3, g4};
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,497 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <double_double.hpp>
+#include <predicates.hpp>
+
+#ifdef WITH_MULTIPRECISION
+#include <mpreal.h>
+#endif // WITH_MULTIPRECISION
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * The arithmetic that produced an element's final result in a mixed-precision evaluation.
+     */
+    enum class Precision : std::uint8_t {
+        Double = 0,
+        DoubleDouble = 1,
+        MultiPrecision = 2
+    };
+
+    /**
+     * Options controlling the mixed-precision escalation engine. An element's result is accepted at a given precision
+     * when its estimated forward error bound satisfies \f$\delta \leq rtol \cdot |value| + atol\f$.
+     */
+    struct EscalationOptions {
+
+        /** The relative tolerance. */
+        double relative_tolerance = 1E-12;
+
+        /** The absolute tolerance. */
+        double absolute_tolerance = 0.0;
+
+        /** The number of bits used by the multiprecision stage (only used if built WITH_MULTIPRECISION). */
+        long multiprecision_bits = 256;
+
+    };
+
+    /**
+     * Statistics on how many elements were resolved at each precision.
+     */
+    struct EscalationStatistics {
+
+        /** The number of elements accepted in double precision. */
+        std::size_t n_double = 0;
+
+        /** The number of elements whose final result was produced in double-double precision. */
+        std::size_t n_double_double = 0;
+
+        /** The number of elements whose final result was produced in multiprecision. */
+        std::size_t n_multiprecision = 0;
+
+        /** The number of elements whose error bound still fails the tolerance at the highest available precision. */
+        std::size_t n_unresolved = 0;
+
+    };
+
+    /**
+     * The result of a mixed-precision evaluation of a scalar valued geometry function.
+     */
+    struct ScalarEscalationResult {
+
+        /** The value for each element, rounded to double. */
+        std::vector<double> values;
+
+        /** The precision that produced each value. */
+        std::vector<Precision> precision;
+
+        /** Escalation statistics. */
+        EscalationStatistics statistics;
+
+    };
+
+    /**
+     * The result of a mixed-precision evaluation of a vector valued geometry function.
+     */
+    struct VectorEscalationResult {
+
+        /** The value for each element, rounded to double. */
+        Vector3DSoA<double> values;
+
+        /** The precision that produced each value. */
+        std::vector<Precision> precision;
+
+        /** Escalation statistics. */
+        EscalationStatistics statistics;
+
+    };
+
+    namespace detail {
+
+        /**
+         * Temporarily set the regularisation-epsilon of Vector3D<Real> to that of Vector3D<double> so that each
+         * precision evaluates the same regularised quantity; the previous value is restored on destruction.
+         * @tparam Real the higher precision type.
+         */
+        template<typename Real>
+        class EpsilonGuard {
+
+        public:
+
+            EpsilonGuard() : _saved(Vector3D<Real>::eps()) {
+
+                Vector3D<Real>::set_eps(Real(Vector3D<double>::eps()));
+
+            }
+
+            ~EpsilonGuard() {
+
+                Vector3D<Real>::set_eps(_saved);
+
+            }
+
+            EpsilonGuard(const EpsilonGuard &) = delete;
+            EpsilonGuard &operator=(const EpsilonGuard &) = delete;
+
+        private:
+
+            Real _saved;
+
+        };
+
+        /**
+         * Test whether an error bound satisfies the escalation tolerance.
+         * @param bound the estimated forward error bound.
+         * @param magnitude the magnitude of the value.
+         * @param options the escalation options.
+         * @return true if the value is accepted.
+         */
+        inline bool accept(double bound, double magnitude, const EscalationOptions &options) {
+
+            return bound <= options.relative_tolerance * magnitude + options.absolute_tolerance;
+
+        }
+
+        /**
+         * Convert a double precision vector to another real type (exactly, for double-double and mpreal).
+         */
+        template<typename Real>
+        Vector3D<Real> convert(const Vector3D<double> &v) {
+
+            return {Real(v.x()), Real(v.y()), Real(v.z())};
+
+        }
+
+        /**
+         * Round a real value to double.
+         */
+        inline double to_double(double v) { return v; }
+        inline double to_double(const DoubleDouble &v) { return v.to_double(); }
+#ifdef WITH_MULTIPRECISION
+        inline double to_double(const mpfr::mpreal &v) { return v.toDouble(); }
+#endif // WITH_MULTIPRECISION
+
+        /**
+         * The tetrahedron volume in translated form \f$\frac{1}{6}(r_2 - r_1) \cdot ((r_3 - r_1) \times (r_4 - r_1))\f$,
+         * which is mathematically identical to tetrahedron_volume() but whose rounding error is bounded by the
+         * permanent of the edge vectors rather than of the (possibly large) absolute coordinates.
+         */
+        template<typename Real>
+        Real tetrahedron_volume_translated(const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                                           const Vector3D<Real> &r3, const Vector3D<Real> &r4) {
+
+            return dot(r2 - r1, cross(r3 - r1, r4 - r1)) / Real(6);
+
+        }
+
+        /**
+         * The unit round-off of the multiprecision stage.
+         */
+        inline double multiprecision_unit_roundoff(const EscalationOptions &options) {
+
+            return std::ldexp(1.0, static_cast<int>(-options.multiprecision_bits + 1));
+
+        }
+
+        /**
+         * Drive the double-double and multiprecision stages for the elements in `pending`.
+         * @param pending the indices of elements that failed the double precision bound.
+         * @param scale the per-element error scale, the bound at unit round-off u is \f$growth \cdot u \cdot scale\f$.
+         * @param growth the per-function error growth constant.
+         * @param evaluate_dd callable (index) -> magnitude that stores the double-double result for an element.
+         * @param evaluate_mp callable (index) -> magnitude that stores the multiprecision result for an element.
+         * @param precision the per-element precision tags.
+         * @param statistics the escalation statistics.
+         * @param options the escalation options.
+         */
+        template<typename EvaluateDD, typename EvaluateMP>
+        void escalate(const std::vector<std::size_t> &pending, const std::vector<double> &scale, double growth,
+                      EvaluateDD evaluate_dd, [[maybe_unused]] EvaluateMP evaluate_mp,
+                      std::vector<Precision> &precision, EscalationStatistics &statistics,
+                      const EscalationOptions &options) {
+
+            std::vector<std::size_t> still_pending;
+
+            {
+                EpsilonGuard<DoubleDouble> guard;
+                for (std::size_t i: pending) {
+                    double magnitude = evaluate_dd(i);
+                    precision[i] = Precision::DoubleDouble;
+                    if (accept(growth * DoubleDouble::unit_roundoff * scale[i], magnitude, options)) {
+                        statistics.n_double_double++;
+                    } else {
+                        still_pending.push_back(i);
+                    }
+                }
+            }
+
+#ifdef WITH_MULTIPRECISION
+            if (!still_pending.empty()) {
+
+                mp_prec_t saved_prec = mpfr::mpreal::get_default_prec();
+                mpfr::mpreal::set_default_prec(options.multiprecision_bits);
+                {
+                    EpsilonGuard<mpfr::mpreal> guard;
+                    double u = multiprecision_unit_roundoff(options);
+                    for (std::size_t i: still_pending) {
+                        double magnitude = evaluate_mp(i);
+                        precision[i] = Precision::MultiPrecision;
+                        statistics.n_multiprecision++;
+                        if (!accept(growth * u * scale[i], magnitude, options)) statistics.n_unresolved++;
+                    }
+                }
+                mpfr::mpreal::set_default_prec(saved_prec);
+
+            }
+#else
+            statistics.n_double_double += still_pending.size();
+            statistics.n_unresolved += still_pending.size();
+#endif // WITH_MULTIPRECISION
+
+        }
+
+    } // namespace detail
+
+    /**
+     * Evaluate tetrahedron volumes in double precision, re-evaluating in double-double (and then, if built
+     * WITH_MULTIPRECISION, in mpreal) only those elements whose estimated error bound fails the tolerance. The double
+     * precision pass uses the orient3d error bound \f$8u \cdot P\f$ with \f$P\f$ the permanent of the edge vectors.
+     * No rounded evaluation can meet a relative tolerance on a zero volume, so elements failing the bound are first
+     * tested with the exact orientation predicate: exactly flat elements are accepted in the double precision pass
+     * with a volume of zero rather than escalated.
+     * @param r1 the first vertex of each tetrahedron.
+     * @param r2 the second vertex of each tetrahedron.
+     * @param r3 the third vertex of each tetrahedron.
+     * @param r4 the fourth vertex of each tetrahedron.
+     * @param options the escalation options.
+     * @return the volumes, precision tags and escalation statistics.
+     */
+    inline ScalarEscalationResult escalate_tetrahedron_volume(const Vector3DSoA<double> &r1,
+                                                              const Vector3DSoA<double> &r2,
+                                                              const Vector3DSoA<double> &r3,
+                                                              const Vector3DSoA<double> &r4,
+                                                              const EscalationOptions &options = {}) {
+
+        constexpr double u = std::numeric_limits<double>::epsilon() / 2.0;
+        constexpr double growth = 8.0;
+
+        const std::size_t n = r1.size();
+
+        ScalarEscalationResult result;
+        result.values.resize(n);
+        result.precision.assign(n, Precision::Double);
+
+        std::vector<double> scale(n);
+
+        const double *x1 = r1.x(), *y1 = r1.y(), *z1 = r1.z();
+        const double *x2 = r2.x(), *y2 = r2.y(), *z2 = r2.z();
+        const double *x3 = r3.x(), *y3 = r3.y(), *z3 = r3.z();
+        const double *x4 = r4.x(), *y4 = r4.y(), *z4 = r4.z();
+        double *values = result.values.data();
+        double *scales = scale.data();
+
+        for (std::size_t i = 0; i < n; ++i) {
+
+            const double ax = x2[i] - x1[i], ay = y2[i] - y1[i], az = z2[i] - z1[i];
+            const double bx = x3[i] - x1[i], by = y3[i] - y1[i], bz = z3[i] - z1[i];
+            const double cx = x4[i] - x1[i], cy = y4[i] - y1[i], cz = z4[i] - z1[i];
+
+            const double bycz = by * cz, bzcy = bz * cy;
+            const double bzcx = bz * cx, bxcz = bx * cz;
+            const double bxcy = bx * cy, bycx = by * cx;
+
+            values[i] = (ax * (bycz - bzcy) + ay * (bzcx - bxcz) + az * (bxcy - bycx)) / 6.0;
+            scales[i] = (std::fabs(ax) * (std::fabs(bycz) + std::fabs(bzcy)) +
+                         std::fabs(ay) * (std::fabs(bzcx) + std::fabs(bxcz)) +
+                         std::fabs(az) * (std::fabs(bxcy) + std::fabs(bycx))) / 6.0;
+
+        }
+
+        std::vector<std::size_t> pending;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (detail::accept(growth * u * scales[i], std::fabs(values[i]), options)) continue;
+            if (detail::orient3d_exact(r1[i], r2[i], r3[i], r4[i]) == 0) {
+                values[i] = 0.0;
+                continue;
+            }
+            pending.push_back(i);
+        }
+        result.statistics.n_double = n - pending.size();
+
+        auto evaluate = [&](auto tag, std::size_t i) {
+
+            using Real = decltype(tag);
+
+            Real volume = detail::tetrahedron_volume_translated(
+                    detail::convert<Real>(r1[i]), detail::convert<Real>(r2[i]),
+                    detail::convert<Real>(r3[i]), detail::convert<Real>(r4[i]));
+
+            values[i] = detail::to_double(volume);
+            return std::fabs(values[i]);
+
+        };
+
+        detail::escalate(pending, scale, growth,
+                         [&](std::size_t i) { return evaluate(DoubleDouble(), i); },
+#ifdef WITH_MULTIPRECISION
+                         [&](std::size_t i) { return evaluate(mpfr::mpreal(), i); },
+#else
+                         [&](std::size_t) { return 0.0; },
+#endif // WITH_MULTIPRECISION
+                         result.precision, result.statistics, options);
+
+        return result;
+
+    }
+
+    /**
+     * Evaluate edge lengths in double precision, escalating like escalate_tetrahedron_volume(). The edge length is
+     * well conditioned (its relative error is bounded by \f$4u\f$) so escalation only occurs for tolerances close to
+     * the double precision unit round-off.
+     * @param r1 the start point of each edge.
+     * @param r2 the end point of each edge.
+     * @param options the escalation options.
+     * @return the edge lengths, precision tags and escalation statistics.
+     */
+    inline ScalarEscalationResult escalate_edge_length(const Vector3DSoA<double> &r1, const Vector3DSoA<double> &r2,
+                                                       const EscalationOptions &options = {}) {
+
+        constexpr double u = std::numeric_limits<double>::epsilon() / 2.0;
+        constexpr double growth = 4.0;
+
+        const std::size_t n = r1.size();
+        const double eps_squared = Vector3D<double>::eps_squared();
+
+        ScalarEscalationResult result;
+        result.values.resize(n);
+        result.precision.assign(n, Precision::Double);
+
+        const double *x1 = r1.x(), *y1 = r1.y(), *z1 = r1.z();
+        const double *x2 = r2.x(), *y2 = r2.y(), *z2 = r2.z();
+        double *values = result.values.data();
+
+        for (std::size_t i = 0; i < n; ++i) {
+
+            const double dx = x1[i] - x2[i], dy = y1[i] - y2[i], dz = z1[i] - z2[i];
+            values[i] = std::sqrt(dx * dx + dy * dy + dz * dz + eps_squared);
+
+        }
+
+        // The length is its own error scale.
+        std::vector<double> scale(result.values);
+
+        std::vector<std::size_t> pending;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!detail::accept(growth * u * scale[i], values[i], options)) pending.push_back(i);
+        }
+        result.statistics.n_double = n - pending.size();
+
+        auto evaluate = [&](auto tag, std::size_t i) {
+
+            using Real = decltype(tag);
+
+            Real length = edge_length(detail::convert<Real>(r1[i]), detail::convert<Real>(r2[i]));
+
+            values[i] = detail::to_double(length);
+            return values[i];
+
+        };
+
+        detail::escalate(pending, scale, growth,
+                         [&](std::size_t i) { return evaluate(DoubleDouble(), i); },
+#ifdef WITH_MULTIPRECISION
+                         [&](std::size_t i) { return evaluate(mpfr::mpreal(), i); },
+#else
+                         [&](std::size_t) { return 0.0; },
+#endif // WITH_MULTIPRECISION
+                         result.precision, result.statistics, options);
+
+        return result;
+
+    }
+
+    /**
+     * Evaluate triangle normals in double precision, escalating like escalate_tetrahedron_volume(). The components of
+     * the un-normalised normal \f$n\f$ carry the orient2d error bound \f$4u \cdot P\f$ and normalisation at most
+     * doubles the relative error so the (absolute) bound on each unit normal component is
+     * \f$8u (P / \sqrt{|n|^2 + \epsilon^2} + 1)\f$; nearly degenerate triangles escalate.
+     * @param r1 the first vertex of each triangle.
+     * @param r2 the second vertex of each triangle.
+     * @param r3 the third vertex of each triangle.
+     * @param options the escalation options.
+     * @return the unit normals, precision tags and escalation statistics.
+     */
+    inline VectorEscalationResult escalate_triangle_normal(const Vector3DSoA<double> &r1,
+                                                           const Vector3DSoA<double> &r2,
+                                                           const Vector3DSoA<double> &r3,
+                                                           const EscalationOptions &options = {}) {
+
+        constexpr double u = std::numeric_limits<double>::epsilon() / 2.0;
+        constexpr double growth = 8.0;
+
+        const std::size_t n = r1.size();
+        const double eps_squared = Vector3D<double>::eps_squared();
+
+        VectorEscalationResult result;
+        result.values.resize(n);
+        result.precision.assign(n, Precision::Double);
+
+        std::vector<double> scale(n);
+
+        const double *x1 = r1.x(), *y1 = r1.y(), *z1 = r1.z();
+        const double *x2 = r2.x(), *y2 = r2.y(), *z2 = r2.z();
+        const double *x3 = r3.x(), *y3 = r3.y(), *z3 = r3.z();
+        double *nx_out = result.values.x(), *ny_out = result.values.y(), *nz_out = result.values.z();
+        double *scales = scale.data();
+
+        for (std::size_t i = 0; i < n; ++i) {
+
+            const double ax = x2[i] - x1[i], ay = y2[i] - y1[i], az = z2[i] - z1[i];
+            const double bx = x3[i] - x1[i], by = y3[i] - y1[i], bz = z3[i] - z1[i];
+
+            const double aybz = ay * bz, azby = az * by;
+            const double azbx = az * bx, axbz = ax * bz;
+            const double axby = ax * by, aybx = ay * bx;
+
+            const double nx = aybz - azby, ny = azbx - axbz, nz = axby - aybx;
+            const double length = std::sqrt(nx * nx + ny * ny + nz * nz + eps_squared);
+
+            nx_out[i] = nx / length;
+            ny_out[i] = ny / length;
+            nz_out[i] = nz / length;
+
+            const double permanent = std::fabs(aybz) + std::fabs(azby) + std::fabs(azbx) +
+                                     std::fabs(axbz) + std::fabs(axby) + std::fabs(aybx);
+            scales[i] = permanent / length + 1.0;
+
+        }
+
+        std::vector<std::size_t> pending;
+        for (std::size_t i = 0; i < n; ++i) {
+            double magnitude = std::fmax(std::fabs(nx_out[i]), std::fmax(std::fabs(ny_out[i]), std::fabs(nz_out[i])));
+            if (!detail::accept(growth * u * scales[i], magnitude, options)) pending.push_back(i);
+        }
+        result.statistics.n_double = n - pending.size();
+
+        auto evaluate = [&](auto tag, std::size_t i) {
+
+            using Real = decltype(tag);
+
+            Vector3D<Real> normal = triangle_normal(detail::convert<Real>(r1[i]), detail::convert<Real>(r2[i]),
+                                                    detail::convert<Real>(r3[i]));
+
+            nx_out[i] = detail::to_double(normal.x());
+            ny_out[i] = detail::to_double(normal.y());
+            nz_out[i] = detail::to_double(normal.z());
+
+            return std::fmax(std::fabs(nx_out[i]), std::fmax(std::fabs(ny_out[i]), std::fabs(nz_out[i])));
+
+        };
+
+        detail::escalate(pending, scale, growth,
+                         [&](std::size_t i) { return evaluate(DoubleDouble(), i); },
+#ifdef WITH_MULTIPRECISION
+                         [&](std::size_t i) { return evaluate(mpfr::mpreal(), i); },
+#else
+                         [&](std::size_t) { return 0.0; },
+#endif // WITH_MULTIPRECISION
+                         result.precision, result.statistics, options);
+
+        return result;
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,702 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Point sources approximating densities on the triangles of a surface mesh by a quadrature rule: the potential
+     * of a per-triangle density \f$\sigma_t\f$ is \f$\sum_q w_q \sigma_{t(q)} / |x - y_q|\f$.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct QuadratureSources {
+
+        /** The quadrature points. */
+        Vector3DSoA<Real> points;
+
+        /** The quadrature weights (including the triangle area). */
+        std::vector<Real> weights;
+
+        /** The triangle each quadrature point belongs to. */
+        std::vector<std::size_t> triangle;
+
+        /**
+         * Convert per-triangle densities into point strengths.
+         * @param density the density on each triangle.
+         * @return the strength of each quadrature point.
+         */
+        [[nodiscard]] std::vector<Real> strengths(const std::vector<Real> &density) const {
+
+            std::vector<Real> q(weights.size());
+            for (std::size_t i = 0; i < q.size(); ++i) q[i] = weights[i] * density[triangle[i]];
+            return q;
+
+        }
+
+    };
+
+    /**
+     * Build quadrature point sources for the triangles of a surface mesh from triangle_center() and triangle_area():
+     * either the one point centroid rule or the three point rule with points at barycentric (2/3, 1/6, 1/6), which
+     * integrates quadratics exactly.
+     * @param mesh the triangle mesh.
+     * @param n_points the number of points per triangle, one or three.
+     * @return the quadrature sources.
+     */
+    template<typename Real>
+    QuadratureSources<Real> triangle_quadrature_sources(const TriangleMesh<Real> &mesh, std::size_t n_points = 3) {
+
+        if (n_points != 1 && n_points != 3) {
+            throw std::invalid_argument("triangle_quadrature_sources() supports one or three points per triangle");
+        }
+
+        QuadratureSources<Real> sources;
+        sources.points.reserve(n_points * mesh.n_triangles());
+        sources.weights.reserve(n_points * mesh.n_triangles());
+        sources.triangle.reserve(n_points * mesh.n_triangles());
+
+        for (std::size_t t = 0; t < mesh.n_triangles(); ++t) {
+
+            const auto &tri = mesh.triangles[t];
+            const Vector3D<Real> r1 = mesh.vertices[tri[0]];
+            const Vector3D<Real> r2 = mesh.vertices[tri[1]];
+            const Vector3D<Real> r3 = mesh.vertices[tri[2]];
+            const Real area = triangle_area(r1, r2, r3);
+            const Vector3D<Real> center = triangle_center(r1, r2, r3);
+
+            if (n_points == 1) {
+                sources.points.push_back(center);
+                sources.weights.push_back(area);
+                sources.triangle.push_back(t);
+            } else {
+                // (2/3, 1/6, 1/6) = center + (r_i - center) / 2.
+                for (const Vector3D<Real> &r: {r1, r2, r3}) {
+                    sources.points.push_back(center + (Real(1) / Real(2)) * (r - center));
+                    sources.weights.push_back(area / Real(3));
+                    sources.triangle.push_back(t);
+                }
+            }
+
+        }
+
+        return sources;
+
+    }
+
+    /**
+     * Accuracy and tree parameters of the fast multipole method.
+     */
+    struct FmmOptions {
+
+        /** The expansion order p; the truncation error decays like theta^(p+1). */
+        std::size_t order = 6;
+
+        /**
+         * The opening angle: two cells interact through expansions if (r_a + r_b) < theta * distance, where r is the
+         * largest distance of a cell's points from its centre.
+         */
+        double theta = 0.5;
+
+        /** The maximum number of (source plus target) points in a leaf cell. */
+        std::size_t leaf_size = 128;
+
+    };
+
+    /**
+     * A fast multipole method for the Laplace potential \f$\phi(x_i) = \sum_j q_j / |x_i - y_j|\f$ over an adaptive
+     * octree, using Cartesian Taylor expansions of order p (Duan & Krasny's recurrence for the derivatives of
+     * \f$1/r\f$) and a dual tree traversal to build the interaction lists. Everything that depends only on the
+     * geometry - the tree, the interaction lists, the multi-index translation tables and the M2L derivative tensors
+     * (shared between all pairs with the same separation) - is computed once in the constructor so that repeated
+     * calls to evaluate() with changing strengths only perform the upward, interaction and downward passes, each of
+     * which is threaded. Coincident source/target pairs are skipped.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class LaplaceFmm {
+
+    public:
+
+        /**
+         * Build the tree and pre-compute all geometry dependent operators.
+         * @param sources the source points.
+         * @param targets the target points.
+         * @param options the accuracy and tree parameters.
+         */
+        LaplaceFmm(const Vector3DSoA<Real> &sources, const Vector3DSoA<Real> &targets,
+                   const FmmOptions &options = FmmOptions())
+                : _order(options.order), _theta(options.theta), _n_sources(sources.size()),
+                  _n_targets(targets.size()) {
+
+            build_multi_indices();
+            build_tree(sources, targets, std::max<std::size_t>(1, options.leaf_size));
+            build_interactions();
+
+        }
+
+        /**
+         * Retrieve the number of cells of the octree.
+         * @return the number of cells.
+         */
+        [[nodiscard]] inline std::size_t n_cells() const { return _cells.size(); }
+
+        /**
+         * Retrieve the number of multipole-to-local translations per evaluation.
+         * @return the number of M2L interactions.
+         */
+        [[nodiscard]] inline std::size_t n_m2l() const { return _m2l.size(); }
+
+        /**
+         * Retrieve the number of direct (near-field) cell pairs per evaluation.
+         * @return the number of P2P interactions.
+         */
+        [[nodiscard]] inline std::size_t n_p2p() const { return _p2p.size(); }
+
+        /**
+         * Evaluate the potential at every target.
+         * @param strengths the strength of each source.
+         * @param potentials receives the potential at each target.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void evaluate(const Real *strengths, Real *potentials, std::size_t n_threads = 0) const {
+
+            const std::size_t n_cells = _cells.size();
+            const std::size_t nt = _n_terms;
+
+            std::vector<Real> q(_n_sources);
+            for (std::size_t p = 0; p < _n_sources; ++p) q[p] = strengths[_source_permutation[p]];
+
+            std::vector<Real> multipole(n_cells * nt, Real(0));
+            std::vector<Real> local(n_cells * nt, Real(0));
+            std::vector<Real> phi(_n_targets, Real(0));
+
+            // Upward pass, deepest level first: P2M at leaves, M2M elsewhere.
+            for (std::size_t level = _level_begin.size() - 1; level-- > 0;) {
+                parallel_for(_level_begin[level], _level_begin[level + 1],
+                             [&](std::size_t begin, std::size_t end, std::size_t) {
+                    std::vector<Real> px(_order + 1), py(_order + 1), pz(_order + 1);
+                    for (std::size_t c = begin; c < end; ++c) {
+                        const Cell &cell = _cells[c];
+                        Real *m = multipole.data() + c * nt;
+                        if (cell.is_leaf()) {
+                            for (std::size_t s = cell.source_begin; s < cell.source_end; ++s) {
+                                powers(_sx[s] - cell.center.x(), px);
+                                powers(_sy[s] - cell.center.y(), py);
+                                powers(_sz[s] - cell.center.z(), pz);
+                                for (std::size_t k = 0; k < nt; ++k) {
+                                    const auto &e = _exponents[k];
+                                    m[k] = m[k] + q[s] * px[e[0]] * py[e[1]] * pz[e[2]];
+                                }
+                            }
+                        } else {
+                            for (std::size_t child: cell.children) {
+                                if (child == none) continue;
+                                const Real *mc = multipole.data() + child * nt;
+                                const Real *d = _shift_powers.data() + child * nt;
+                                for (const Translation &t: _m2m_terms) {
+                                    m[t.out] = m[t.out] + t.coefficient * d[t.shift] * mc[t.in];
+                                }
+                            }
+                        }
+                    }
+                }, n_threads, 1);
+            }
+
+            if (n_threads == 0) n_threads = default_thread_count();
+
+            // M2L, grouped by separation: the operator of each distinct separation is formed once from its derivative
+            // tensor and applied to blocks of source multipoles as a small dense matrix product. Different groups
+            // share target cells, so each thread accumulates into private locals which are reduced afterwards.
+            constexpr std::size_t block = 16;
+            std::vector<std::vector<Real>> partial(n_threads);
+            parallel_for(0, _m2l_offsets.size() - 1, [&](std::size_t begin, std::size_t end, std::size_t t) {
+                std::vector<Real> &lt = partial[t];
+                lt.assign(n_cells * nt, Real(0));
+                std::vector<Real> op(nt * nt), mb(nt * block), lb(nt * block);
+                for (std::size_t g = begin; g < end; ++g) {
+                    const Real *a = _tensors.data() + g * _n_tensor_terms;
+                    for (std::size_t i = 0; i < nt * nt; ++i) {
+                        op[i] = _m2l_terms[i].coefficient * a[_m2l_terms[i].shift];
+                    }
+                    for (std::size_t first = _m2l_offsets[g]; first < _m2l_offsets[g + 1]; first += block) {
+                        const std::size_t nb = std::min(block, _m2l_offsets[g + 1] - first);
+                        if (nb < block) std::fill(mb.begin(), mb.end(), Real(0));
+                        for (std::size_t b = 0; b < nb; ++b) {
+                            const Real *m = multipole.data() + _m2l[first + b].second * nt;
+                            for (std::size_t k = 0; k < nt; ++k) mb[k * block + b] = m[k];
+                        }
+                        std::fill(lb.begin(), lb.end(), Real(0));
+                        for (std::size_t l = 0; l < nt; ++l) {
+                            Real *row = lb.data() + l * block;
+                            for (std::size_t k = 0; k < nt; ++k) {
+                                const Real c = op[l * nt + k];
+                                const Real *column = mb.data() + k * block;
+                                for (std::size_t b = 0; b < block; ++b) row[b] = row[b] + c * column[b];
+                            }
+                        }
+                        for (std::size_t b = 0; b < nb; ++b) {
+                            Real *l = lt.data() + _m2l[first + b].first * nt;
+                            for (std::size_t k = 0; k < nt; ++k) l[k] = l[k] + lb[k * block + b];
+                        }
+                    }
+                }
+            }, n_threads, 1);
+
+            // Only the chunks that ran have filled their locals.
+            partial.erase(std::remove_if(partial.begin(), partial.end(),
+                                         [](const std::vector<Real> &lt) { return lt.empty(); }), partial.end());
+
+            // Reduce the M2L contributions and evaluate the near field; each target cell owns its targets.
+            parallel_for(0, n_cells, [&](std::size_t begin, std::size_t end, std::size_t) {
+                using std::sqrt;
+                for (std::size_t c = begin; c < end; ++c) {
+                    Real *l = local.data() + c * nt;
+                    for (const std::vector<Real> &partial_local: partial) {
+                        const Real *lt = partial_local.data() + c * nt;
+                        for (std::size_t k = 0; k < nt; ++k) l[k] = l[k] + lt[k];
+                    }
+                    const Cell &target = _cells[c];
+                    for (std::size_t i = _p2p_offsets[c]; i < _p2p_offsets[c + 1]; ++i) {
+                        const Cell &source = _cells[_p2p[i]];
+                        for (std::size_t ti = target.target_begin; ti < target.target_end; ++ti) {
+                            Real sum = Real(0);
+                            for (std::size_t s = source.source_begin; s < source.source_end; ++s) {
+                                const Real dx = _tx[ti] - _sx[s], dy = _ty[ti] - _sy[s], dz = _tz[ti] - _sz[s];
+                                const Real r2 = dx * dx + dy * dy + dz * dz;
+                                if (r2 > Real(0)) sum = sum + q[s] / sqrt(r2);
+                            }
+                            phi[ti] = phi[ti] + sum;
+                        }
+                    }
+                }
+            }, n_threads, 1);
+
+            // Downward pass, root first: L2L to children, L2P at leaves.
+            for (std::size_t level = 0; level + 1 < _level_begin.size(); ++level) {
+                parallel_for(_level_begin[level], _level_begin[level + 1],
+                             [&](std::size_t begin, std::size_t end, std::size_t) {
+                    std::vector<Real> px(_order + 1), py(_order + 1), pz(_order + 1);
+                    for (std::size_t c = begin; c < end; ++c) {
+                        const Cell &cell = _cells[c];
+                        const Real *l = local.data() + c * nt;
+                        if (cell.is_leaf()) {
+                            for (std::size_t ti = cell.target_begin; ti < cell.target_end; ++ti) {
+                                powers(_tx[ti] - cell.center.x(), px);
+                                powers(_ty[ti] - cell.center.y(), py);
+                                powers(_tz[ti] - cell.center.z(), pz);
+                                Real sum = Real(0);
+                                for (std::size_t k = 0; k < nt; ++k) {
+                                    const auto &e = _exponents[k];
+                                    sum = sum + l[k] * px[e[0]] * py[e[1]] * pz[e[2]];
+                                }
+                                phi[ti] = phi[ti] + sum;
+                            }
+                        } else {
+                            for (std::size_t child: cell.children) {
+                                if (child == none) continue;
+                                Real *lc = local.data() + child * nt;
+                                const Real *d = _shift_powers.data() + child * nt;
+                                for (const Translation &t: _l2l_terms) {
+                                    lc[t.out] = lc[t.out] + t.coefficient * d[t.shift] * l[t.in];
+                                }
+                            }
+                        }
+                    }
+                }, n_threads, 1);
+            }
+
+            for (std::size_t p = 0; p < _n_targets; ++p) potentials[_target_permutation[p]] = phi[p];
+
+        }
+
+        /**
+         * Evaluate the potential at every target.
+         * @param strengths the strength of each source.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         * @return the potential at each target.
+         */
+        std::vector<Real> evaluate(const std::vector<Real> &strengths, std::size_t n_threads = 0) const {
+
+            std::vector<Real> potentials(_n_targets);
+            evaluate(strengths.data(), potentials.data(), n_threads);
+            return potentials;
+
+        }
+
+    private:
+
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        struct Cell {
+            Vector3D<Real> center;
+            Real half_width;
+            Real radius;
+            std::size_t source_begin, source_end;
+            std::size_t target_begin, target_end;
+            std::array<std::size_t, 8> children;
+            [[nodiscard]] bool is_leaf() const {
+                return std::all_of(children.begin(), children.end(), [](std::size_t c) { return c == none; });
+            }
+        };
+
+        /** One term out[...] += coefficient * shift[...] * in[...] of a translation operator. */
+        struct Translation {
+            std::size_t out, in, shift;
+            Real coefficient;
+        };
+
+        static void powers(const Real &x, std::vector<Real> &p) {
+            p[0] = Real(1);
+            for (std::size_t k = 1; k < p.size(); ++k) p[k] = p[k - 1] * x;
+        }
+
+        /** Index of the multi-index (i, j, k) in the graded ordering used for expansions up to `order`. */
+        [[nodiscard]] std::size_t index(std::size_t i, std::size_t j, std::size_t k, std::size_t order) const {
+            return _index[(i * (order + 1) + j) * (order + 1) + k];
+        }
+
+        void build_multi_indices() {
+
+            const std::size_t p = _order;
+            const std::size_t p2 = 2 * p;
+
+            // A single graded enumeration of all multi-indices up to 2p; the first n_terms entries are those up to p.
+            _index.assign((p2 + 1) * (p2 + 1) * (p2 + 1), none);
+            _exponents.clear();
+            for (std::size_t n = 0; n <= p2; ++n) {
+                for (std::size_t i = n + 1; i-- > 0;) {
+                    for (std::size_t j = n - i + 1; j-- > 0;) {
+                        const std::size_t k = n - i - j;
+                        _index[(i * (p2 + 1) + j) * (p2 + 1) + k] = _exponents.size();
+                        _exponents.push_back({i, j, k});
+                    }
+                }
+                if (n == p) _n_terms = _exponents.size();
+            }
+            _n_tensor_terms = _exponents.size();
+
+            std::vector<std::vector<Real>> binomial(p2 + 1, std::vector<Real>(p2 + 1, Real(0)));
+            for (std::size_t n = 0; n <= p2; ++n) {
+                binomial[n][0] = Real(1);
+                for (std::size_t k = 1; k <= n; ++k) binomial[n][k] = binomial[n - 1][k - 1] + (k < n ? binomial[n - 1][k] : Real(0));
+            }
+
+            auto multi_binomial = [&](const std::array<std::size_t, 3> &a, const std::array<std::size_t, 3> &b) {
+                return binomial[a[0]][b[0]] * binomial[a[1]][b[1]] * binomial[a[2]][b[2]];
+            };
+
+            // M2M: M'_k += C(k, m) d^(k - m) M_m, L2L: L'_m += C(l, m) d^(l - m) L_l, for m <= k (component wise).
+            for (std::size_t a = 0; a < _n_terms; ++a) {
+                for (std::size_t b = 0; b < _n_terms; ++b) {
+                    const auto &k = _exponents[a];
+                    const auto &m = _exponents[b];
+                    if (m[0] > k[0] || m[1] > k[1] || m[2] > k[2]) continue;
+                    const std::size_t shift = index(k[0] - m[0], k[1] - m[1], k[2] - m[2], p2);
+                    const Real c = multi_binomial(k, m);
+                    _m2m_terms.push_back({a, b, shift, c});
+                    _l2l_terms.push_back({b, a, shift, c});
+                }
+            }
+
+            // M2L: L_l += (-1)^|l| C(k + l, l) a_(k + l)(R) M_k.
+            for (std::size_t a = 0; a < _n_terms; ++a) {
+                for (std::size_t b = 0; b < _n_terms; ++b) {
+                    const auto &l = _exponents[a];
+                    const auto &k = _exponents[b];
+                    const std::array<std::size_t, 3> kl = {k[0] + l[0], k[1] + l[1], k[2] + l[2]};
+                    const Real sign = (l[0] + l[1] + l[2]) % 2 == 0 ? Real(1) : Real(-1);
+                    _m2l_terms.push_back({a, b, index(kl[0], kl[1], kl[2], p2), sign * multi_binomial(kl, l)});
+                }
+            }
+
+        }
+
+        void build_tree(const Vector3DSoA<Real> &sources, const Vector3DSoA<Real> &targets, std::size_t leaf_size) {
+
+            // Bounding cube of all points.
+            Real lower[3], upper[3];
+            bool first = true;
+            for (const Vector3DSoA<Real> *set: {&sources, &targets}) {
+                for (std::size_t i = 0; i < set->size(); ++i) {
+                    const Real c[3] = {set->x()[i], set->y()[i], set->z()[i]};
+                    for (int d = 0; d < 3; ++d) {
+                        if (first || c[d] < lower[d]) lower[d] = c[d];
+                        if (first || c[d] > upper[d]) upper[d] = c[d];
+                    }
+                    first = false;
+                }
+            }
+            if (first) for (int d = 0; d < 3; ++d) lower[d] = upper[d] = Real(0);
+
+            Real half_width = Real(0);
+            for (int d = 0; d < 3; ++d) half_width = std::max(half_width, Real((upper[d] - lower[d]) / Real(2)));
+            half_width = half_width * Real(1.0001) + Real(std::numeric_limits<double>::min());
+
+            _source_permutation.resize(_n_sources);
+            _target_permutation.resize(_n_targets);
+            for (std::size_t i = 0; i < _n_sources; ++i) _source_permutation[i] = i;
+            for (std::size_t i = 0; i < _n_targets; ++i) _target_permutation[i] = i;
+
+            Cell root;
+            root.center = Vector3D<Real>((lower[0] + upper[0]) / Real(2), (lower[1] + upper[1]) / Real(2),
+                                         (lower[2] + upper[2]) / Real(2));
+            root.half_width = half_width;
+            root.source_begin = 0;
+            root.source_end = _n_sources;
+            root.target_begin = 0;
+            root.target_end = _n_targets;
+            root.children.fill(none);
+            _cells.push_back(root);
+
+            auto octant = [](const Vector3D<Real> &r, const Vector3D<Real> &c) {
+                return std::size_t(r.x() >= c.x()) | (std::size_t(r.y() >= c.y()) << 1) |
+                       (std::size_t(r.z() >= c.z()) << 2);
+            };
+
+            // Sort a permutation range into octant buckets, returning the bucket offsets.
+            auto bucket = [&](std::vector<std::size_t> &perm, std::size_t begin, std::size_t end,
+                              const Vector3DSoA<Real> &points, const Vector3D<Real> &c) {
+                std::array<std::size_t, 9> offsets{};
+                std::vector<std::size_t> scratch(perm.begin() + begin, perm.begin() + end);
+                for (std::size_t i: scratch) offsets[octant(points[i], c) + 1]++;
+                for (std::size_t o = 0; o < 8; ++o) offsets[o + 1] += offsets[o];
+                std::array<std::size_t, 8> fill;
+                std::copy(offsets.begin(), offsets.begin() + 8, fill.begin());
+                for (std::size_t i: scratch) perm[begin + fill[octant(points[i], c)]++] = i;
+                for (std::size_t &o: offsets) o += begin;
+                return offsets;
+            };
+
+            // Breadth first so that the cells of each level are contiguous.
+            _level_begin = {0};
+            std::size_t level_end = 1;
+            constexpr std::size_t max_depth = 40;
+            for (std::size_t depth = 0; depth < max_depth && _level_begin.back() < level_end; ++depth) {
+                for (std::size_t c = _level_begin.back(); c < level_end; ++c) {
+
+                    const std::size_t count = (_cells[c].source_end - _cells[c].source_begin) +
+                                              (_cells[c].target_end - _cells[c].target_begin);
+                    if (count <= leaf_size || depth + 1 == max_depth) continue;
+
+                    const Vector3D<Real> center = _cells[c].center;
+                    const Real h = _cells[c].half_width / Real(2);
+                    auto so = bucket(_source_permutation, _cells[c].source_begin, _cells[c].source_end, sources,
+                                     center);
+                    auto to = bucket(_target_permutation, _cells[c].target_begin, _cells[c].target_end, targets,
+                                     center);
+
+                    for (std::size_t o = 0; o < 8; ++o) {
+                        if (so[o] == so[o + 1] && to[o] == to[o + 1]) continue;
+                        Cell child;
+                        child.center = center + Vector3D<Real>(o & 1 ? h : Real(-1) * h, o & 2 ? h : Real(-1) * h,
+                                                               o & 4 ? h : Real(-1) * h);
+                        child.half_width = h;
+                        child.source_begin = so[o];
+                        child.source_end = so[o + 1];
+                        child.target_begin = to[o];
+                        child.target_end = to[o + 1];
+                        child.children.fill(none);
+                        _cells[c].children[o] = _cells.size();
+                        _cells.push_back(child);
+                    }
+
+                }
+                _level_begin.push_back(level_end);
+                level_end = _cells.size();
+            }
+            if (_level_begin.back() != _cells.size()) _level_begin.push_back(_cells.size());
+
+            // Points in cell order.
+            _sx.resize(_n_sources); _sy.resize(_n_sources); _sz.resize(_n_sources);
+            for (std::size_t p = 0; p < _n_sources; ++p) {
+                const std::size_t i = _source_permutation[p];
+                _sx[p] = sources.x()[i]; _sy[p] = sources.y()[i]; _sz[p] = sources.z()[i];
+            }
+            _tx.resize(_n_targets); _ty.resize(_n_targets); _tz.resize(_n_targets);
+            for (std::size_t p = 0; p < _n_targets; ++p) {
+                const std::size_t i = _target_permutation[p];
+                _tx[p] = targets.x()[i]; _ty[p] = targets.y()[i]; _tz[p] = targets.z()[i];
+            }
+
+            // Radius of each cell about its centre.
+            for (Cell &cell: _cells) {
+                Real r2 = Real(0);
+                for (std::size_t p = cell.source_begin; p < cell.source_end; ++p) {
+                    const Real dx = _sx[p] - cell.center.x(), dy = _sy[p] - cell.center.y(), dz = _sz[p] - cell.center.z();
+                    r2 = std::max(r2, Real(dx * dx + dy * dy + dz * dz));
+                }
+                for (std::size_t p = cell.target_begin; p < cell.target_end; ++p) {
+                    const Real dx = _tx[p] - cell.center.x(), dy = _ty[p] - cell.center.y(), dz = _tz[p] - cell.center.z();
+                    r2 = std::max(r2, Real(dx * dx + dy * dy + dz * dz));
+                }
+                using std::sqrt;
+                cell.radius = sqrt(r2);
+            }
+
+            // Powers of the offset of each cell from its father, for M2M and L2L.
+            _shift_powers.assign(_cells.size() * _n_terms, Real(0));
+            for (const Cell &cell: _cells) {
+                for (std::size_t child: cell.children) {
+                    if (child == none) continue;
+                    const Vector3D<Real> d = _cells[child].center - cell.center;
+                    std::vector<Real> px(_order + 1), py(_order + 1), pz(_order + 1);
+                    powers(d.x(), px);
+                    powers(d.y(), py);
+                    powers(d.z(), pz);
+                    for (std::size_t k = 0; k < _n_terms; ++k) {
+                        const auto &e = _exponents[k];
+                        _shift_powers[child * _n_terms + k] = px[e[0]] * py[e[1]] * pz[e[2]];
+                    }
+                }
+            }
+
+        }
+
+        /** The Taylor coefficients a_k(R) = (1/k!) d^k/dy^k 1/|R - y| at y = 0 for |k| <= 2p. */
+        void derivative_tensor(const Vector3D<Real> &r, Real *a) const {
+
+            using std::sqrt;
+
+            const std::size_t p2 = 2 * _order;
+            const Real r2 = dot(r, r);
+            const Real c[3] = {r.x(), r.y(), r.z()};
+
+            a[0] = Real(1) / sqrt(r2);
+            for (std::size_t t = 1; t < _n_tensor_terms; ++t) {
+                const auto &k = _exponents[t];
+                const std::size_t n = k[0] + k[1] + k[2];
+                Real s1 = Real(0), s2 = Real(0);
+                for (int d = 0; d < 3; ++d) {
+                    std::array<std::size_t, 3> m = k;
+                    if (m[d] >= 1) {
+                        m[d] -= 1;
+                        s1 = s1 + c[d] * a[index(m[0], m[1], m[2], p2)];
+                        if (m[d] >= 1) {
+                            m[d] -= 1;
+                            s2 = s2 + a[index(m[0], m[1], m[2], p2)];
+                        }
+                    }
+                }
+                a[t] = (Real(2 * n - 1) * s1 - Real(n - 1) * s2) / (Real(n) * r2);
+            }
+
+        }
+
+        void build_interactions() {
+
+            std::vector<std::vector<std::pair<std::size_t, std::size_t>>> m2l(_cells.size());
+            std::vector<std::vector<std::size_t>> p2p(_cells.size());
+            std::map<std::array<Real, 3>, std::size_t> separations;
+
+            if (!_cells.empty()) {
+
+                std::vector<std::pair<std::size_t, std::size_t>> stack = {{0, 0}};
+                while (!stack.empty()) {
+
+                    const auto [a, b] = stack.back();
+                    stack.pop_back();
+
+                    const Cell &target = _cells[a];
+                    const Cell &source = _cells[b];
+                    if (target.target_begin == target.target_end || source.source_begin == source.source_end) continue;
+
+                    const Vector3D<Real> r = target.center - source.center;
+                    const Real distance_squared = dot(r, r);
+                    const Real radii = target.radius + source.radius;
+
+                    if (radii * radii < Real(_theta * _theta) * distance_squared) {
+                        const std::array<Real, 3> key = {r.x(), r.y(), r.z()};
+                        auto it = separations.find(key);
+                        if (it == separations.end()) it = separations.emplace(key, separations.size()).first;
+                        m2l[a].emplace_back(b, it->second);
+                        continue;
+                    }
+
+                    const bool target_leaf = target.is_leaf(), source_leaf = source.is_leaf();
+                    if (target_leaf && source_leaf) {
+                        p2p[a].push_back(b);
+                    } else if (source_leaf || (!target_leaf && target.half_width >= source.half_width)) {
+                        for (std::size_t c: target.children) if (c != none) stack.emplace_back(c, b);
+                    } else {
+                        for (std::size_t c: source.children) if (c != none) stack.emplace_back(a, c);
+                    }
+
+                }
+
+            }
+
+            // One derivative tensor per distinct separation (cells of a level sit on a regular grid).
+            _tensors.assign(separations.size() * _n_tensor_terms, Real(0));
+            for (const auto &[key, id]: separations) {
+                derivative_tensor(Vector3D<Real>(key[0], key[1], key[2]), _tensors.data() + id * _n_tensor_terms);
+            }
+
+            // M2L pairs (target cell, source cell) grouped by separation, P2P source cells grouped by target cell.
+            _m2l_offsets.assign(separations.size() + 1, 0);
+            for (const auto &list: m2l) for (const auto &[source, id]: list) _m2l_offsets[id + 1]++;
+            for (std::size_t g = 0; g < separations.size(); ++g) _m2l_offsets[g + 1] += _m2l_offsets[g];
+            _m2l.resize(_m2l_offsets.back());
+            std::vector<std::size_t> fill(_m2l_offsets.begin(), _m2l_offsets.end() - 1);
+            for (std::size_t c = 0; c < _cells.size(); ++c) {
+                for (const auto &[source, id]: m2l[c]) _m2l[fill[id]++] = {c, source};
+            }
+
+            _p2p_offsets.assign(_cells.size() + 1, 0);
+            for (std::size_t c = 0; c < _cells.size(); ++c) {
+                _p2p_offsets[c + 1] = _p2p_offsets[c] + p2p[c].size();
+                _p2p.insert(_p2p.end(), p2p[c].begin(), p2p[c].end());
+            }
+
+        }
+
+        std::size_t _order;
+        double _theta;
+        std::size_t _n_sources;
+        std::size_t _n_targets;
+
+        // Multi-index tables.
+        std::size_t _n_terms = 0;
+        std::size_t _n_tensor_terms = 0;
+        std::vector<std::size_t> _index;
+        std::vector<std::array<std::size_t, 3>> _exponents;
+        std::vector<Translation> _m2m_terms;
+        std::vector<Translation> _l2l_terms;
+        std::vector<Translation> _m2l_terms;
+
+        // Tree.
+        std::vector<Cell> _cells;
+        std::vector<std::size_t> _level_begin;
+        std::vector<std::size_t> _source_permutation;
+        std::vector<std::size_t> _target_permutation;
+        std::vector<Real> _sx, _sy, _sz;
+        std::vector<Real> _tx, _ty, _tz;
+        std::vector<Real> _shift_powers;
+
+        // Interaction lists and the M2L derivative tensors (one per distinct separation).
+        std::vector<std::size_t> _m2l_offsets;
+        std::vector<std::pair<std::size_t, std::size_t>> _m2l;
+        std::vector<std::size_t> _p2p_offsets;
+        std::vector<std::size_t> _p2p;
+        std::vector<Real> _tensors;
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
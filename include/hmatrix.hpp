@@ -0,0 +1,582 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * A node of a cluster tree: a contiguous range of the tree's permutation together with its axis aligned bounding
+     * box.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct ClusterNode {
+
+        /** Marks a missing child. */
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /** The first position of the cluster in the permutation. */
+        std::size_t begin;
+
+        /** One past the last position of the cluster in the permutation. */
+        std::size_t end;
+
+        /** The two sons, or `none` for a leaf. */
+        std::array<std::size_t, 2> children = {none, none};
+
+        /** The lower corner of the bounding box. */
+        Vector3D<Real> lower;
+
+        /** The upper corner of the bounding box. */
+        Vector3D<Real> upper;
+
+        /**
+         * Retrieve the number of indices in the cluster.
+         * @return the cluster size.
+         */
+        [[nodiscard]] inline std::size_t size() const { return end - begin; }
+
+        /**
+         * Test whether the cluster is a leaf.
+         * @return true if the cluster has no sons.
+         */
+        [[nodiscard]] inline bool is_leaf() const { return children[0] == none; }
+
+    };
+
+    /**
+     * A binary cluster tree over a set of points, built by recursively bisecting the bounding box along its longest
+     * axis at the median point. Node zero is the root and the indices of every cluster are contiguous in the
+     * permutation.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class ClusterTree {
+
+    public:
+
+        /**
+         * Build a cluster tree.
+         * @param points the points to cluster (e.g. vertex positions or triangle centres).
+         * @param leaf_size the maximum number of points in a leaf.
+         */
+        ClusterTree(const Vector3DSoA<Real> &points, std::size_t leaf_size = 32) {
+
+            const std::size_t n = points.size();
+            _permutation.resize(n);
+            std::iota(_permutation.begin(), _permutation.end(), std::size_t(0));
+            if (n == 0) return;
+
+            leaf_size = std::max<std::size_t>(1, leaf_size);
+
+            _nodes.push_back(make_node(points, 0, n));
+
+            std::vector<std::size_t> stack = {0};
+            while (!stack.empty()) {
+
+                const std::size_t current = stack.back();
+                stack.pop_back();
+
+                const std::size_t begin = _nodes[current].begin;
+                const std::size_t end = _nodes[current].end;
+                if (end - begin <= leaf_size) continue;
+
+                const Vector3D<Real> extent = _nodes[current].upper - _nodes[current].lower;
+                const Real *coordinate = points.x();
+                if (extent.y() > extent.x() && extent.y() >= extent.z()) coordinate = points.y();
+                else if (extent.z() > extent.x() && extent.z() > extent.y()) coordinate = points.z();
+
+                const std::size_t middle = begin + (end - begin) / 2;
+                std::nth_element(_permutation.begin() + begin, _permutation.begin() + middle,
+                                 _permutation.begin() + end,
+                                 [coordinate](std::size_t a, std::size_t b) { return coordinate[a] < coordinate[b]; });
+
+                const std::size_t left = _nodes.size();
+                _nodes.push_back(make_node(points, begin, middle));
+                _nodes.push_back(make_node(points, middle, end));
+                _nodes[current].children = {left, left + 1};
+
+                stack.push_back(left);
+                stack.push_back(left + 1);
+
+            }
+
+        }
+
+        /**
+         * Retrieve the nodes; node zero is the root.
+         * @return the nodes.
+         */
+        [[nodiscard]] inline const std::vector<ClusterNode<Real>> &nodes() const { return _nodes; }
+
+        /**
+         * Retrieve the permutation: position p of the cluster ordering holds original index permutation()[p].
+         * @return the permutation.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &permutation() const { return _permutation; }
+
+        /**
+         * Retrieve the number of clustered points.
+         * @return the number of points.
+         */
+        [[nodiscard]] inline std::size_t size() const { return _permutation.size(); }
+
+    private:
+
+        ClusterNode<Real> make_node(const Vector3DSoA<Real> &points, std::size_t begin, std::size_t end) const {
+
+            ClusterNode<Real> node;
+            node.begin = begin;
+            node.end = end;
+
+            Real lx = points.x()[_permutation[begin]], ux = lx;
+            Real ly = points.y()[_permutation[begin]], uy = ly;
+            Real lz = points.z()[_permutation[begin]], uz = lz;
+            for (std::size_t p = begin + 1; p < end; ++p) {
+                const std::size_t i = _permutation[p];
+                lx = std::min(lx, points.x()[i]); ux = std::max(ux, points.x()[i]);
+                ly = std::min(ly, points.y()[i]); uy = std::max(uy, points.y()[i]);
+                lz = std::min(lz, points.z()[i]); uz = std::max(uz, points.z()[i]);
+            }
+            node.lower = Vector3D<Real>(lx, ly, lz);
+            node.upper = Vector3D<Real>(ux, uy, uz);
+
+            return node;
+
+        }
+
+        std::vector<ClusterNode<Real>> _nodes;
+        std::vector<std::size_t> _permutation;
+
+    };
+
+    /**
+     * Construction parameters of a hierarchical matrix.
+     */
+    struct HMatrixOptions {
+
+        /** The maximum number of indices in a cluster tree leaf. */
+        std::size_t leaf_size = 32;
+
+        /** The admissibility parameter: a block is compressed if min(diam) <= eta * dist. */
+        double eta = 2.0;
+
+        /** The relative (Frobenius norm) tolerance of adaptive cross approximation. */
+        double tolerance = 1E-6;
+
+        /** The maximum rank of a low-rank block, zero for no limit. */
+        std::size_t max_rank = 0;
+
+    };
+
+    /**
+     * A block of a hierarchical matrix; either dense (row-major) or of low rank, \f$U V^T\f$ with column-major factors.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct HMatrixBlock {
+
+        /** The row cluster node. */
+        std::size_t row_node;
+
+        /** The column cluster node. */
+        std::size_t column_node;
+
+        /** Whether the block is stored in low-rank form. */
+        bool low_rank = false;
+
+        /** The rank of a low-rank block. */
+        std::size_t rank = 0;
+
+        /** The dense entries (rows x columns, row-major). */
+        std::vector<Real> dense;
+
+        /** The left factor (rows x rank, column-major). */
+        std::vector<Real> u;
+
+        /** The right factor (columns x rank, column-major). */
+        std::vector<Real> v;
+
+    };
+
+    namespace detail {
+
+        template<typename Real>
+        Real block_diameter(const ClusterNode<Real> &node) {
+
+            using std::sqrt;
+
+            const Vector3D<Real> d = node.upper - node.lower;
+            return sqrt(dot(d, d));
+
+        }
+
+        template<typename Real>
+        Real block_distance(const ClusterNode<Real> &a, const ClusterNode<Real> &b) {
+
+            using std::sqrt;
+
+            auto gap = [](const Real &l1, const Real &u1, const Real &l2, const Real &u2) {
+                if (u1 < l2) return Real(l2 - u1);
+                if (u2 < l1) return Real(l1 - u2);
+                return Real(0);
+            };
+
+            const Real dx = gap(a.lower.x(), a.upper.x(), b.lower.x(), b.upper.x());
+            const Real dy = gap(a.lower.y(), a.upper.y(), b.lower.y(), b.upper.y());
+            const Real dz = gap(a.lower.z(), a.upper.z(), b.lower.z(), b.upper.z());
+
+            return sqrt(dx * dx + dy * dy + dz * dz);
+
+        }
+
+        /**
+         * Adaptive cross approximation with partial pivoting of the block rows[0, m) x columns[0, n) of `entry`.
+         * Returns false (leaving the factors unspecified) if the low-rank form would not save storage.
+         */
+        template<typename Real, typename Entry>
+        bool adaptive_cross_approximation(std::size_t m, std::size_t n, const Entry &entry, const Real &tolerance,
+                                          std::size_t max_rank, std::vector<Real> &u, std::vector<Real> &v,
+                                          std::size_t &rank) {
+
+            using std::abs;
+            using std::sqrt;
+
+            // Beyond this rank the factors need more storage than the dense block.
+            const std::size_t storage_limit = m * n / (m + n);
+            const std::size_t rank_limit = std::min(max_rank == 0 ? storage_limit : max_rank, storage_limit);
+
+            u.clear();
+            v.clear();
+            rank = 0;
+
+            std::vector<bool> used_row(m, false);
+            std::vector<Real> row(n), column(m);
+            Real frobenius_squared = Real(0);
+            std::size_t pivot_row = 0;
+            std::size_t zero_rows = 0;
+
+            while (rank < rank_limit) {
+
+                used_row[pivot_row] = true;
+
+                // Residual row.
+                for (std::size_t j = 0; j < n; ++j) {
+                    Real r = entry(pivot_row, j);
+                    for (std::size_t k = 0; k < rank; ++k) r = r - u[k * m + pivot_row] * v[k * n + j];
+                    row[j] = r;
+                }
+
+                std::size_t pivot_column = 0;
+                for (std::size_t j = 1; j < n; ++j) if (abs(row[j]) > abs(row[pivot_column])) pivot_column = j;
+
+                if (row[pivot_column] == Real(0)) {
+                    // The residual row vanishes: try further unused rows before accepting the approximation.
+                    std::size_t next = m;
+                    for (std::size_t i = 0; i < m; ++i) if (!used_row[i]) { next = i; break; }
+                    if (next == m || ++zero_rows > 3) return true;
+                    pivot_row = next;
+                    continue;
+                }
+
+                const Real pivot = row[pivot_column];
+                for (std::size_t j = 0; j < n; ++j) row[j] = row[j] / pivot;
+
+                // Residual column.
+                for (std::size_t i = 0; i < m; ++i) {
+                    Real c = entry(i, pivot_column);
+                    for (std::size_t k = 0; k < rank; ++k) c = c - u[k * m + i] * v[k * n + pivot_column];
+                    column[i] = c;
+                }
+
+                // Update the Frobenius norm estimate of the approximant.
+                Real u_norm_squared = Real(0), v_norm_squared = Real(0);
+                for (std::size_t i = 0; i < m; ++i) u_norm_squared = u_norm_squared + column[i] * column[i];
+                for (std::size_t j = 0; j < n; ++j) v_norm_squared = v_norm_squared + row[j] * row[j];
+                Real cross_terms = Real(0);
+                for (std::size_t k = 0; k < rank; ++k) {
+                    Real uu = Real(0), vv = Real(0);
+                    for (std::size_t i = 0; i < m; ++i) uu = uu + u[k * m + i] * column[i];
+                    for (std::size_t j = 0; j < n; ++j) vv = vv + v[k * n + j] * row[j];
+                    cross_terms = cross_terms + uu * vv;
+                }
+                frobenius_squared = frobenius_squared + u_norm_squared * v_norm_squared + Real(2) * cross_terms;
+
+                u.insert(u.end(), column.begin(), column.end());
+                v.insert(v.end(), row.begin(), row.end());
+                ++rank;
+
+                if (sqrt(u_norm_squared * v_norm_squared) <= tolerance * sqrt(abs(frobenius_squared))) return true;
+
+                // Next pivot row: the largest entry of the new column among unused rows.
+                std::size_t next = m;
+                for (std::size_t i = 0; i < m; ++i) {
+                    if (used_row[i]) continue;
+                    if (next == m || abs(column[i]) > abs(column[next])) next = i;
+                }
+                if (next == m) return true;
+                pivot_row = next;
+
+            }
+
+            // The rank limit was reached before convergence; that is only acceptable if the caller capped the rank.
+            return max_rank != 0 && rank == max_rank;
+
+        }
+
+    } // namespace detail
+
+    /**
+     * A hierarchical matrix: the block partition induced by a row and a column cluster tree, with admissible
+     * (well-separated) blocks compressed by adaptive cross approximation and the remaining near-field blocks stored
+     * densely. For asymptotically smooth kernels (such as the boundary-element potentials of bem.hpp) storage and the
+     * cost of a matrix-vector product scale as \f$O(N \log N)\f$. Blocks are assembled in parallel and the
+     * matrix-vector product accumulates each thread's blocks into a private vector before a final reduction.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class HMatrix {
+
+    public:
+
+        /**
+         * Build a hierarchical matrix from an entry generator.
+         * @tparam Entry callable with signature Real(std::size_t row, std::size_t column) in original indices.
+         * @param row_points the positions associated with the rows.
+         * @param column_points the positions associated with the columns.
+         * @param entry the entry generator.
+         * @param options the construction parameters.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        template<typename Entry>
+        HMatrix(const Vector3DSoA<Real> &row_points, const Vector3DSoA<Real> &column_points, const Entry &entry,
+                const HMatrixOptions &options = HMatrixOptions(), std::size_t n_threads = 0)
+                : _rows(row_points, options.leaf_size), _columns(column_points, options.leaf_size) {
+
+            if (_rows.size() == 0 || _columns.size() == 0) return;
+
+            partition(0, 0, Real(options.eta));
+
+            const auto &row_permutation = _rows.permutation();
+            const auto &column_permutation = _columns.permutation();
+
+            parallel_for(0, _blocks.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+
+                for (std::size_t b = begin; b < end; ++b) {
+
+                    HMatrixBlock<Real> &block = _blocks[b];
+                    const ClusterNode<Real> &tau = _rows.nodes()[block.row_node];
+                    const ClusterNode<Real> &sigma = _columns.nodes()[block.column_node];
+                    const std::size_t m = tau.size(), n = sigma.size();
+
+                    auto local = [&](std::size_t i, std::size_t j) {
+                        return Real(entry(row_permutation[tau.begin + i], column_permutation[sigma.begin + j]));
+                    };
+
+                    if (block.low_rank &&
+                        detail::adaptive_cross_approximation(m, n, local, Real(options.tolerance), options.max_rank,
+                                                             block.u, block.v, block.rank)) {
+                        continue;
+                    }
+
+                    block.low_rank = false;
+                    block.rank = 0;
+                    block.u.clear();
+                    block.v.clear();
+                    block.dense.resize(m * n);
+                    for (std::size_t i = 0; i < m; ++i) {
+                        for (std::size_t j = 0; j < n; ++j) block.dense[i * n + j] = local(i, j);
+                    }
+
+                }
+
+            }, n_threads, 1);
+
+        }
+
+        /**
+         * Retrieve the number of rows.
+         * @return the number of rows.
+         */
+        [[nodiscard]] inline std::size_t n_rows() const { return _rows.size(); }
+
+        /**
+         * Retrieve the number of columns.
+         * @return the number of columns.
+         */
+        [[nodiscard]] inline std::size_t n_columns() const { return _columns.size(); }
+
+        /**
+         * Retrieve the blocks of the partition.
+         * @return the blocks.
+         */
+        [[nodiscard]] inline const std::vector<HMatrixBlock<Real>> &blocks() const { return _blocks; }
+
+        /**
+         * Retrieve the row cluster tree.
+         * @return the row cluster tree.
+         */
+        [[nodiscard]] inline const ClusterTree<Real> &row_tree() const { return _rows; }
+
+        /**
+         * Retrieve the column cluster tree.
+         * @return the column cluster tree.
+         */
+        [[nodiscard]] inline const ClusterTree<Real> &column_tree() const { return _columns; }
+
+        /**
+         * Retrieve the number of stored matrix coefficients (dense entries plus low-rank factors).
+         * @return the number of stored coefficients.
+         */
+        [[nodiscard]] std::size_t storage() const {
+
+            std::size_t total = 0;
+            for (const auto &block: _blocks) total += block.dense.size() + block.u.size() + block.v.size();
+            return total;
+
+        }
+
+        /**
+         * Compute \f$y = A x\f$ in the original row and column numbering.
+         * @param x the input vector (n_columns() entries).
+         * @param y the output vector (n_rows() entries).
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void multiply(const Real *x, Real *y, std::size_t n_threads = 0) const {
+
+            if (n_threads == 0) n_threads = default_thread_count();
+
+            const auto &row_permutation = _rows.permutation();
+            const auto &column_permutation = _columns.permutation();
+
+            std::vector<Real> xp(n_columns());
+            for (std::size_t p = 0; p < n_columns(); ++p) xp[p] = x[column_permutation[p]];
+
+            std::vector<std::vector<Real>> partial(n_threads);
+            parallel_for(0, _blocks.size(), [&](std::size_t begin, std::size_t end,
+                                                                         std::size_t t) {
+
+                std::vector<Real> &yp = partial[t];
+                yp.assign(n_rows(), Real(0));
+                std::vector<Real> z;
+
+                for (std::size_t b = begin; b < end; ++b) {
+
+                    const HMatrixBlock<Real> &block = _blocks[b];
+                    const ClusterNode<Real> &tau = _rows.nodes()[block.row_node];
+                    const ClusterNode<Real> &sigma = _columns.nodes()[block.column_node];
+                    const std::size_t m = tau.size(), n = sigma.size();
+                    const Real *xb = xp.data() + sigma.begin;
+                    Real *yb = yp.data() + tau.begin;
+
+                    if (block.low_rank) {
+                        // y += U (V^T x)
+                        z.assign(block.rank, Real(0));
+                        for (std::size_t k = 0; k < block.rank; ++k) {
+                            const Real *vk = block.v.data() + k * n;
+                            Real s = Real(0);
+                            for (std::size_t j = 0; j < n; ++j) s = s + vk[j] * xb[j];
+                            z[k] = s;
+                        }
+                        for (std::size_t k = 0; k < block.rank; ++k) {
+                            const Real *uk = block.u.data() + k * m;
+                            for (std::size_t i = 0; i < m; ++i) yb[i] = yb[i] + uk[i] * z[k];
+                        }
+                    } else {
+                        for (std::size_t i = 0; i < m; ++i) {
+                            const Real *row = block.dense.data() + i * n;
+                            Real s = Real(0);
+                            for (std::size_t j = 0; j < n; ++j) s = s + row[j] * xb[j];
+                            yb[i] = yb[i] + s;
+                        }
+                    }
+
+                }
+
+            }, n_threads, 1);
+
+            // Only the chunks that ran have filled their partial sums.
+            for (std::size_t p = 0; p < n_rows(); ++p) {
+                Real s = Real(0);
+                for (const std::vector<Real> &yp: partial) if (!yp.empty()) s = s + yp[p];
+                y[row_permutation[p]] = s;
+            }
+
+        }
+
+        /**
+         * Compute \f$y = A x\f$ in the original row and column numbering.
+         * @param x the input vector (n_columns() entries).
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         * @return the output vector (n_rows() entries).
+         */
+        std::vector<Real> multiply(const std::vector<Real> &x, std::size_t n_threads = 0) const {
+
+            std::vector<Real> y(n_rows());
+            multiply(x.data(), y.data(), n_threads);
+            return y;
+
+        }
+
+    private:
+
+        void partition(std::size_t row_node, std::size_t column_node, const Real &eta) {
+
+            const ClusterNode<Real> &tau = _rows.nodes()[row_node];
+            const ClusterNode<Real> &sigma = _columns.nodes()[column_node];
+
+            const Real diameter = std::min(detail::block_diameter(tau), detail::block_diameter(sigma));
+            const Real distance = detail::block_distance(tau, sigma);
+
+            if (diameter <= eta * distance && distance > Real(0)) {
+                HMatrixBlock<Real> block;
+                block.row_node = row_node;
+                block.column_node = column_node;
+                block.low_rank = true;
+                _blocks.push_back(std::move(block));
+                return;
+            }
+
+            if (tau.is_leaf() && sigma.is_leaf()) {
+                HMatrixBlock<Real> block;
+                block.row_node = row_node;
+                block.column_node = column_node;
+                _blocks.push_back(std::move(block));
+                return;
+            }
+
+            // Subdivide whichever side can still be split.
+            const std::array<std::size_t, 2> row_children = tau.children;
+            const std::array<std::size_t, 2> column_children = sigma.children;
+            if (tau.is_leaf()) {
+                for (std::size_t c: column_children) partition(row_node, c, eta);
+            } else if (sigma.is_leaf()) {
+                for (std::size_t r: row_children) partition(r, column_node, eta);
+            } else {
+                for (std::size_t r: row_children) for (std::size_t c: column_children) partition(r, c, eta);
+            }
+
+        }
+
+        ClusterTree<Real> _rows;
+        ClusterTree<Real> _columns;
+        std::vector<HMatrixBlock<Real>> _blocks;
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,339 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+#include <predicates.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    namespace detail {
+
+        /**
+         * Quickhull (Barber, Dobkin & Huhdanpaa 1996) over a subset of a point set.
+         *
+         * Each face of the current hull keeps the points that lie strictly beyond it. The point farthest beyond a
+         * face is added next: the faces it sees are removed and the horizon, the boundary of the removed faces, is
+         * joined to it. Visibility is decided by orient3d(), so that for doubles the hull is exactly convex;
+         * points on the plane of a face are not beyond it, and coplanar points are kept out of the hull where
+         * possible. Only the choice of the farthest point uses rounded distances.
+         * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+         */
+        template<typename Real>
+        class Quickhull {
+
+        public:
+
+            explicit Quickhull(const Vector3DSoA<Real> &points) : _points(points) {}
+
+            /**
+             * Return the triangles of the convex hull of the candidate points, wound so that their
+             * triangle_normal()s point outwards, or no triangles if the candidates are coplanar.
+             */
+            std::vector<std::array<std::size_t, 3>> operator()(const std::vector<std::size_t> &candidates) {
+
+                _faces.clear();
+                std::vector<std::array<std::size_t, 3>> triangles;
+                if (!initialise(candidates)) return triangles;
+
+                std::vector<std::size_t> pending = {0, 1, 2, 3};
+                std::vector<std::size_t> visible, created, orphans;
+                std::vector<std::array<std::size_t, 3>> horizon;
+                std::vector<std::pair<std::size_t, std::size_t>> starts;
+                std::size_t stamp = 0;
+
+                while (!pending.empty()) {
+
+                    const std::size_t f = pending.back();
+                    pending.pop_back();
+                    if (!_faces[f].alive || _faces[f].outside.empty()) continue;
+                    const std::size_t eye = _faces[f].farthest;
+
+                    // The faces seen from the eye form a connected region; its boundary edges make up the horizon,
+                    // each kept with the direction it has in the visible face and the hidden face across it.
+                    ++stamp;
+                    visible.assign(1, f);
+                    _faces[f].visited = stamp;
+                    horizon.clear();
+                    for (std::size_t v = 0; v < visible.size(); ++v) {
+                        const Face &face = _faces[visible[v]];
+                        for (std::size_t k = 0; k < 3; ++k) {
+                            const std::size_t n = face.neighbours[k];
+                            if (_faces[n].visited == stamp) continue;
+                            if (side(n, eye) > 0) {
+                                _faces[n].visited = stamp;
+                                visible.push_back(n);
+                            } else {
+                                horizon.push_back({face.vertices[k], face.vertices[(k + 1) % 3], n});
+                            }
+                        }
+                    }
+
+                    // Join each horizon edge (a, b) to the eye; the new face after it is the one starting at b.
+                    created.clear();
+                    starts.clear();
+                    for (const auto &[a, b, n]: horizon) {
+                        const std::size_t g = add_face(a, b, eye);
+                        created.push_back(g);
+                        starts.push_back({a, g});
+                        _faces[g].neighbours[0] = n;
+                        Face &hidden = _faces[n];
+                        for (std::size_t k = 0; k < 3; ++k) {
+                            if (hidden.vertices[k] == b && hidden.vertices[(k + 1) % 3] == a) hidden.neighbours[k] = g;
+                        }
+                    }
+                    std::sort(starts.begin(), starts.end());
+                    for (std::size_t h = 0; h < horizon.size(); ++h) {
+                        const std::size_t b = horizon[h][1];
+                        const auto next = std::lower_bound(starts.begin(), starts.end(),
+                                                           std::pair<std::size_t, std::size_t>(b, 0));
+                        _faces[created[h]].neighbours[1] = next->second;
+                        _faces[next->second].neighbours[2] = created[h];
+                    }
+
+                    // The points beyond the removed faces go to the first new face they lie beyond, if any.
+                    orphans.clear();
+                    for (std::size_t v: visible) {
+                        Face &face = _faces[v];
+                        face.alive = false;
+                        for (std::size_t p: face.outside) if (p != eye) orphans.push_back(p);
+                        face.outside.clear();
+                        face.outside.shrink_to_fit();
+                    }
+                    for (std::size_t p: orphans) assign(p, created);
+                    for (std::size_t g: created) if (!_faces[g].outside.empty()) pending.push_back(g);
+
+                }
+
+                for (const Face &face: _faces) if (face.alive) triangles.push_back(face.vertices);
+                return triangles;
+
+            }
+
+        private:
+
+            struct Face {
+                std::array<std::size_t, 3> vertices;
+                /** The face across the edge from vertices[k] to vertices[k + 1]. */
+                std::array<std::size_t, 3> neighbours = {0, 0, 0};
+                /** The unnormalised outward normal, for comparing distances beyond the face. */
+                Vector3D<Real> normal;
+                std::vector<std::size_t> outside;
+                std::size_t farthest = 0;
+                Real height = Real(0);
+                std::size_t visited = 0;
+                bool alive = true;
+            };
+
+            const Vector3DSoA<Real> &_points;
+            std::vector<Face> _faces;
+
+            [[nodiscard]] int side(std::size_t f, std::size_t p) const {
+                const auto &v = _faces[f].vertices;
+                return orient3d(_points[v[0]], _points[v[1]], _points[v[2]], _points[p]);
+            }
+
+            std::size_t add_face(std::size_t a, std::size_t b, std::size_t c) {
+                Face face;
+                face.vertices = {a, b, c};
+                face.normal = cross(_points[b] - _points[a], _points[c] - _points[a]);
+                _faces.push_back(std::move(face));
+                return _faces.size() - 1;
+            }
+
+            void assign(std::size_t p, const std::vector<std::size_t> &faces) {
+                for (std::size_t f: faces) {
+                    if (side(f, p) <= 0) continue;
+                    Face &face = _faces[f];
+                    const Real height = dot(face.normal, _points[p] - _points[face.vertices[0]]);
+                    if (face.outside.empty() || height > face.height) {
+                        face.farthest = p;
+                        face.height = height;
+                    }
+                    face.outside.push_back(p);
+                    return;
+                }
+            }
+
+            /**
+             * Build the first tetrahedron from extreme candidates and distribute the others over its faces. Return
+             * false if the candidates are coplanar.
+             */
+            bool initialise(const std::vector<std::size_t> &candidates) {
+
+                if (candidates.size() < 4) return false;
+
+                // The extreme points in x, the farthest from their line and the farthest from their plane.
+                std::size_t a = candidates[0], b = candidates[0];
+                for (std::size_t p: candidates) {
+                    if (_points.x()[p] < _points.x()[a]) a = p;
+                    if (_points.x()[p] > _points.x()[b]) b = p;
+                }
+                const Vector3D<Real> ra = _points[a];
+                Real best = Real(0);
+                if (a == b) {
+                    for (std::size_t p: candidates) {
+                        const Real d2 = norm_squared(_points[p] - ra);
+                        if (d2 > best) {
+                            best = d2;
+                            b = p;
+                        }
+                    }
+                    if (a == b) return false;
+                }
+                const Vector3D<Real> ab = _points[b] - ra;
+                std::size_t c = a;
+                best = Real(0);
+                for (std::size_t p: candidates) {
+                    const Real d2 = norm_squared(cross(ab, _points[p] - ra));
+                    if (d2 > best) {
+                        best = d2;
+                        c = p;
+                    }
+                }
+                if (c == a) return false;
+                const Vector3D<Real> normal = cross(ab, _points[c] - ra);
+                std::size_t d = a;
+                best = Real(0);
+                for (std::size_t p: candidates) {
+                    Real h = dot(normal, _points[p] - ra);
+                    if (h < Real(0)) h = -h;
+                    if (h > best && orient3d(ra, _points[b], _points[c], _points[p]) != 0) {
+                        best = h;
+                        d = p;
+                    }
+                }
+                if (d == a) {
+                    // Rounded distances may all vanish while a point is off the plane.
+                    for (std::size_t p: candidates) {
+                        if (orient3d(ra, _points[b], _points[c], _points[p]) != 0) {
+                            d = p;
+                            break;
+                        }
+                    }
+                    if (d == a) return false;
+                }
+                if (orient3d(ra, _points[b], _points[c], _points[d]) < 0) std::swap(a, b);
+
+                // With d on the positive side of (a, b, c), these faces have every other vertex behind them.
+                add_face(a, c, b);
+                add_face(a, b, d);
+                add_face(b, c, d);
+                add_face(a, d, c);
+                for (std::size_t f = 0; f < 4; ++f) {
+                    Face &face = _faces[f];
+                    for (std::size_t k = 0; k < 3; ++k) {
+                        const std::size_t u = face.vertices[k], w = face.vertices[(k + 1) % 3];
+                        for (std::size_t g = 0; g < 4; ++g) {
+                            const auto &v = _faces[g].vertices;
+                            for (std::size_t m = 0; m < 3; ++m) {
+                                if (v[m] == w && v[(m + 1) % 3] == u) face.neighbours[k] = g;
+                            }
+                        }
+                    }
+                }
+
+                const std::vector<std::size_t> first = {0, 1, 2, 3};
+                for (std::size_t p: candidates) {
+                    if (p != a && p != b && p != c && p != d) assign(p, first);
+                }
+                return true;
+
+            }
+
+        };
+
+    } // namespace detail
+
+    /**
+     * Return the triangles of the convex hull of a point set as triples of point indices, wound so that their
+     * triangle_normal()s point outwards.
+     *
+     * The hull is built by quickhull with exact orientation tests for doubles; for other types the tests are
+     * evaluated in the arithmetic of the type, so that a high precision 'mpreal' run serves as an exact reference.
+     * Large point sets are divided into one contiguous piece per thread, the hull of each piece is found
+     * concurrently and the hull of the union of their vertices, usually a tiny fraction of the points, is the
+     * result. Points on the plane of a hull face are generally not made hull vertices, but (as for any
+     * incremental hull) one that was added before the face became coplanar with it remains.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     * @param points the points.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the hull triangles, none if all points are coplanar.
+     */
+    template<typename Real>
+    std::vector<std::array<std::size_t, 3>> convex_hull_triangles(const Vector3DSoA<Real> &points,
+                                                                  std::size_t n_threads = 0) {
+
+        // Below this many points per thread the pieces are not worth their merge.
+        constexpr std::size_t min_piece = 65536;
+
+        std::vector<std::size_t> candidates;
+        if (n_threads != 1 && points.size() >= 2 * min_piece) {
+            std::mutex mutex;
+            parallel_for(0, points.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::vector<std::size_t> piece(end - begin);
+                for (std::size_t i = begin; i < end; ++i) piece[i - begin] = i;
+                const std::vector<std::array<std::size_t, 3>> triangles = detail::Quickhull<Real>(points)(piece);
+                if (!triangles.empty()) {
+                    piece.clear();
+                    for (const auto &t: triangles) piece.insert(piece.end(), t.begin(), t.end());
+                    std::sort(piece.begin(), piece.end());
+                    piece.erase(std::unique(piece.begin(), piece.end()), piece.end());
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                candidates.insert(candidates.end(), piece.begin(), piece.end());
+            }, n_threads, min_piece);
+            std::sort(candidates.begin(), candidates.end());
+        } else {
+            candidates.resize(points.size());
+            for (std::size_t i = 0; i < points.size(); ++i) candidates[i] = i;
+        }
+
+        return detail::Quickhull<Real>(points)(candidates);
+
+    }
+
+    /**
+     * Return the convex hull of a point set as a closed triangle mesh of its hull vertices, with outward
+     * triangle_normal()s; see convex_hull_triangles().
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     * @param points the points.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the hull, empty if all points are coplanar.
+     */
+    template<typename Real>
+    TriangleMesh<Real> convex_hull(const Vector3DSoA<Real> &points, std::size_t n_threads = 0) {
+
+        const std::vector<std::array<std::size_t, 3>> triangles = convex_hull_triangles(points, n_threads);
+
+        std::vector<std::size_t> vertices;
+        for (const auto &t: triangles) vertices.insert(vertices.end(), t.begin(), t.end());
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+        TriangleMesh<Real> mesh;
+        for (std::size_t v: vertices) mesh.vertices.push_back(points[v]);
+        for (const auto &t: triangles) {
+            std::array<std::size_t, 3> triangle;
+            for (std::size_t k = 0; k < 3; ++k) {
+                triangle[k] = static_cast<std::size_t>(std::lower_bound(vertices.begin(), vertices.end(), t[k]) -
+                                                       vertices.begin());
+            }
+            mesh.triangles.push_back(triangle);
+        }
+        return mesh;
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,241 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <mesh.hpp>
+#include <median_dual.hpp>
+#include <parallel.hpp>
+#include <predicates.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    namespace detail {
+
+        /**
+         * For each local vertex i of a tetrahedron, the other three (j, k, l) such that (i, j, k, l) is an even
+         * permutation of (0, 1, 2, 3).
+         */
+        inline constexpr std::array<std::array<std::size_t, 3>, 4> tetrahedron_opposites = {{
+            {1, 2, 3}, {0, 3, 2}, {0, 1, 3}, {0, 2, 1}
+        }};
+
+        /**
+         * The local edge, in the order of tetrahedron_edges, joining two local vertices.
+         */
+        inline constexpr std::array<std::array<std::size_t, 4>, 4> tetrahedron_edge_index = {{
+            {6, 0, 1, 2}, {0, 6, 3, 4}, {1, 3, 6, 5}, {2, 4, 5, 6}
+        }};
+
+        /**
+         * The number of isosurface triangles in a tetrahedron, by the bit mask of its vertices above the isovalue.
+         */
+        inline constexpr std::array<std::size_t, 16> marching_tetrahedra_counts = {
+            0, 1, 1, 2, 1, 2, 2, 1, 1, 2, 2, 1, 2, 1, 1, 0
+        };
+
+    } // namespace detail
+
+    /**
+     * Extract isosurfaces of a vertex scalar field on a tetrahedral mesh by marching tetrahedra.
+     *
+     * A vertex is above an isovalue if its value is greater. Every mesh edge with one end above and one not carries
+     * one surface vertex, linearly interpolated from the lower to the upper vertex index, so that the surface
+     * vertex is computed and emitted once however many elements share the edge; the edges are those of the
+     * topology. An element with one vertex apart contributes a triangle, one with two on each side a quadrilateral
+     * split along its shorter diagonal. Triangles are wound so that their triangle_normal() points towards larger
+     * values, whatever the orientation of the element (decided by the exact orient3d()), and neighbouring
+     * triangles traverse their shared edge in opposite directions.
+     *
+     * The extraction is two-pass: the edges and then the elements are counted chunk by chunk in parallel, the counts
+     * summed into offsets, and the same chunks then write their vertices and triangles straight into their place in
+     * the output, so that nothing grows while emitting and the result does not depend on the number of threads. All
+     * isovalues are handled in the same passes, each element being loaded once.
+     * @param mesh the tetrahedral mesh.
+     * @param topology the topology of the mesh.
+     * @param values the field value at each vertex.
+     * @param isovalues the isovalues.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return one indexed surface per isovalue, in the same order.
+     */
+    template<typename Real>
+    std::vector<TriangleMesh<Real>> extract_isosurfaces(const TetrahedralMesh<Real> &mesh,
+                                                        const MedianDualTopology &topology,
+                                                        const std::vector<Real> &values,
+                                                        const std::vector<Real> &isovalues,
+                                                        std::size_t n_threads = 0) {
+
+        if (topology.n_elements() != mesh.n_tetrahedra() || topology.n_vertices() != mesh.n_vertices()) {
+            throw std::invalid_argument("extract_isosurfaces: the topology does not belong to the mesh");
+        }
+        if (values.size() != mesh.n_vertices()) {
+            throw std::invalid_argument("extract_isosurfaces: one value per vertex is required");
+        }
+
+        constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+        const std::size_t n_levels = isovalues.size();
+        const std::size_t n_edges = topology.n_edges();
+        const std::size_t n = mesh.n_tetrahedra();
+        if (n_threads == 0) n_threads = default_thread_count();
+
+        std::vector<TriangleMesh<Real>> surfaces(n_levels);
+        if (n_levels == 0) return surfaces;
+
+        // Exclusive prefix sums of per chunk counts, chunk major: offsets[c * n_levels + l].
+        auto prefix = [n_levels](std::vector<std::size_t> &offsets, std::vector<std::size_t> &totals) {
+            totals.assign(n_levels, 0);
+            for (std::size_t k = 0; k < offsets.size(); ++k) {
+                const std::size_t count = offsets[k];
+                offsets[k] = totals[k % n_levels];
+                totals[k % n_levels] += count;
+            }
+        };
+
+        // Edges: count the crossings, then number them and interpolate.
+        const auto &edges = topology.edges();
+        std::vector<std::size_t> offsets(n_threads * n_levels, 0), totals;
+        parallel_for(0, n_edges, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const Real &a = values[edges[i][0]], &b = values[edges[i][1]];
+                for (std::size_t l = 0; l < n_levels; ++l) {
+                    offsets[chunk * n_levels + l] += (a > isovalues[l]) != (b > isovalues[l]);
+                }
+            }
+        }, n_threads);
+        prefix(offsets, totals);
+        for (std::size_t l = 0; l < n_levels; ++l) surfaces[l].vertices.resize(totals[l]);
+
+        std::vector<std::size_t> edge_vertices(n_edges * n_levels, none);
+        parallel_for(0, n_edges, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const Real &a = values[edges[i][0]], &b = values[edges[i][1]];
+                const Vector3D<Real> ra = mesh.vertices[edges[i][0]], rb = mesh.vertices[edges[i][1]];
+                for (std::size_t l = 0; l < n_levels; ++l) {
+                    if ((a > isovalues[l]) == (b > isovalues[l])) continue;
+                    const std::size_t v = offsets[chunk * n_levels + l]++;
+                    surfaces[l].vertices.set(v, ra + ((isovalues[l] - a) / (b - a)) * (rb - ra));
+                    edge_vertices[i * n_levels + l] = v;
+                }
+            }
+        }, n_threads);
+
+        // Elements: count the triangles, then emit them.
+        auto mask = [&](const std::array<std::size_t, 4> &t, const Real &isovalue) {
+            std::size_t bits = 0;
+            for (std::size_t a = 0; a < 4; ++a) if (values[t[a]] > isovalue) bits |= std::size_t(1) << a;
+            return bits;
+        };
+
+        offsets.assign(n_threads * n_levels, 0);
+        parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            for (std::size_t e = begin; e < end; ++e) {
+                for (std::size_t l = 0; l < n_levels; ++l) {
+                    offsets[chunk * n_levels + l] +=
+                            detail::marching_tetrahedra_counts[mask(mesh.tetrahedra[e], isovalues[l])];
+                }
+            }
+        }, n_threads);
+        prefix(offsets, totals);
+        for (std::size_t l = 0; l < n_levels; ++l) surfaces[l].triangles.resize(totals[l]);
+
+        parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            for (std::size_t e = begin; e < end; ++e) {
+
+                const auto &t = mesh.tetrahedra[e];
+                const auto &element_edges = topology.element_edges()[e];
+                bool oriented = false, positive = true;
+
+                for (std::size_t l = 0; l < n_levels; ++l) {
+
+                    const std::size_t bits = mask(t, isovalues[l]);
+                    const std::size_t count = detail::marching_tetrahedra_counts[bits];
+                    if (count == 0) continue;
+                    if (!oriented) {
+                        positive = orient3d(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]],
+                                            mesh.vertices[t[3]]) >= 0;
+                        oriented = true;
+                    }
+
+                    TriangleMesh<Real> &surface = surfaces[l];
+                    auto vertex = [&](std::size_t a, std::size_t b) {
+                        return edge_vertices[element_edges[detail::tetrahedron_edge_index[a][b]] * n_levels + l];
+                    };
+                    auto emit = [&](std::size_t p, std::size_t q, std::size_t r) {
+                        surface.triangles[offsets[chunk * n_levels + l]++] =
+                                positive ? std::array<std::size_t, 3>{p, q, r} : std::array<std::size_t, 3>{p, r, q};
+                    };
+
+                    if (count == 1) {
+                        // One vertex i apart: with (i, j, k, l) positive the triangle (ij, ik, il) faces away
+                        // from i, i.e. towards larger values if i is below.
+                        const std::size_t above = std::size_t(std::popcount(unsigned(bits)));
+                        std::size_t i = 0;
+                        while (((bits >> i & 1u) != 0) != (above == 1)) ++i;
+                        const auto &o = detail::tetrahedron_opposites[i];
+                        if (above == 1) {
+                            emit(vertex(i, o[0]), vertex(i, o[2]), vertex(i, o[1]));
+                        } else {
+                            emit(vertex(i, o[0]), vertex(i, o[1]), vertex(i, o[2]));
+                        }
+                    } else {
+                        // Two above: the edge (a, b) joining them, with (a, b, c, d) positive, gives the
+                        // quadrilateral (ac, bc, bd, ad) facing towards a and b.
+                        std::size_t k = 0;
+                        while (bits != ((std::size_t(1) << detail::tetrahedron_edges[k][0]) |
+                                        (std::size_t(1) << detail::tetrahedron_edges[k][1]))) {
+                            ++k;
+                        }
+                        const auto &p = detail::tetrahedron_edges[k];
+                        const std::size_t ac = vertex(p[0], p[2]), bc = vertex(p[1], p[2]);
+                        const std::size_t bd = vertex(p[1], p[3]), ad = vertex(p[0], p[3]);
+                        if (norm_squared(surface.vertices[ac] - surface.vertices[bd]) <=
+                            norm_squared(surface.vertices[bc] - surface.vertices[ad])) {
+                            emit(ac, bc, bd);
+                            emit(ac, bd, ad);
+                        } else {
+                            emit(ac, bc, ad);
+                            emit(bc, bd, ad);
+                        }
+                    }
+
+                }
+
+            }
+        }, n_threads);
+
+        return surfaces;
+
+    }
+
+    /**
+     * Extract the isosurface of a vertex scalar field on a tetrahedral mesh by marching tetrahedra, as
+     * extract_isosurfaces().
+     * @param mesh the tetrahedral mesh.
+     * @param topology the topology of the mesh.
+     * @param values the field value at each vertex.
+     * @param isovalue the isovalue.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the indexed surface.
+     */
+    template<typename Real>
+    TriangleMesh<Real> extract_isosurface(const TetrahedralMesh<Real> &mesh, const MedianDualTopology &topology,
+                                          const std::vector<Real> &values, const Real &isovalue,
+                                          std::size_t n_threads = 0) {
+
+        return std::move(extract_isosurfaces(mesh, topology, values, std::vector<Real>{isovalue}, n_threads)[0]);
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,494 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * A node of a k-d tree: a contiguous range of the tree's permutation, split at the median along one axis.
+     */
+    struct KdNode {
+
+        /** Marks a missing child. */
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /** The first position of the node in the permutation. */
+        std::size_t begin = 0;
+
+        /** One past the last position of the node in the permutation. */
+        std::size_t end = 0;
+
+        /** The split axis: 0, 1 or 2 for x, y or z. */
+        std::size_t axis = 0;
+
+        /** The split coordinate: the left son's points lie at or below it, the right son's at or above. */
+        double split = 0.0;
+
+        /** The two sons, or `none` for a leaf. */
+        std::array<std::size_t, 2> children = {none, none};
+
+        /**
+         * Retrieve the number of points in the node.
+         * @return the node size.
+         */
+        [[nodiscard]] inline std::size_t size() const { return end - begin; }
+
+        /**
+         * Test whether the node is a leaf.
+         * @return true if the node has no sons.
+         */
+        [[nodiscard]] inline bool is_leaf() const { return children[0] == none; }
+
+    };
+
+    /**
+     * A static k-d tree over a point cloud for k-nearest neighbour and radius queries.
+     *
+     * The tree is built by splitting every node at the median (std::nth_element) along the axis of widest extent, so
+     * that it is balanced and its shape depends on the number of points alone: the nodes are stored in pre-order and
+     * the position of every subtree is known up front, which lets the subtrees below the top levels be built in
+     * parallel straight into the node table. The points are stored in tree order.
+     *
+     * The search runs in double precision. For other types (e.g. mpreal) the tree keeps the exact coordinates as well:
+     * the double search collects every candidate that could be a result once the rounding of the coordinates is
+     * allowed for, and the candidates are then ranked by their exact distances.
+     *
+     * The batch queries write into caller provided buffers and only allocate per thread, never per query.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class KdTree {
+
+    public:
+
+        /**
+         * Build a k-d tree.
+         * @param points the points.
+         * @param leaf_size the maximum number of points in a leaf.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        explicit KdTree(const Vector3DSoA<Real> &points, std::size_t leaf_size = 16, std::size_t n_threads = 0)
+                : _leaf_size(std::max<std::size_t>(1, leaf_size)) {
+
+            const std::size_t n = points.size();
+            if (n_threads == 0) n_threads = default_thread_count();
+
+            _permutation.resize(n);
+            std::iota(_permutation.begin(), _permutation.end(), std::size_t(0));
+
+            // Double precision copies in input order for the build, reordered afterwards.
+            Vector3DSoA<double> coordinates(n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    coordinates.x()[i] = static_cast<double>(points.x()[i]);
+                    coordinates.y()[i] = static_cast<double>(points.y()[i]);
+                    coordinates.z()[i] = static_cast<double>(points.z()[i]);
+                }
+            }, n_threads);
+            for (std::size_t i = 0; i < n; ++i) {
+                _scale = std::max({_scale, std::fabs(coordinates.x()[i]), std::fabs(coordinates.y()[i]),
+                                   std::fabs(coordinates.z()[i])});
+            }
+
+            if (n > 0) {
+
+                std::map<std::size_t, std::size_t> sizes;
+                _nodes.resize(subtree_nodes(n, sizes));
+
+                // The top levels serially, then the subtrees below them in parallel.
+                std::size_t depth = 0;
+                while ((std::size_t(1) << depth) < 4 * n_threads && depth < 32) ++depth;
+                std::vector<std::array<std::size_t, 3>> subtrees;
+                build(coordinates, 0, 0, n, depth, sizes, &subtrees);
+                parallel_for(0, subtrees.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                    std::map<std::size_t, std::size_t> own = sizes;
+                    for (std::size_t s = begin; s < end; ++s) {
+                        build(coordinates, subtrees[s][0], subtrees[s][1], subtrees[s][2], 0, own, nullptr);
+                    }
+                }, n_threads, 1);
+
+            }
+
+            _coordinates.resize(n);
+            if constexpr (exact) _points.resize(n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t p = begin; p < end; ++p) {
+                    const std::size_t i = _permutation[p];
+                    _coordinates.x()[p] = coordinates.x()[i];
+                    _coordinates.y()[p] = coordinates.y()[i];
+                    _coordinates.z()[p] = coordinates.z()[i];
+                    if constexpr (exact) _points.set(p, points[i]);
+                }
+            }, n_threads);
+
+        }
+
+        /**
+         * Retrieve the number of points.
+         * @return the number of points.
+         */
+        [[nodiscard]] inline std::size_t size() const { return _permutation.size(); }
+
+        /**
+         * Retrieve the nodes in pre-order; node zero is the root (if there are points).
+         * @return the nodes.
+         */
+        [[nodiscard]] inline const std::vector<KdNode> &nodes() const { return _nodes; }
+
+        /**
+         * Retrieve the permutation: position p of the tree order holds original point permutation()[p].
+         * @return the permutation.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &permutation() const { return _permutation; }
+
+        /**
+         * Find the k points nearest to a query point.
+         * @param point the query point.
+         * @param k the number of neighbours.
+         * @return the original indices of the neighbours by increasing distance (ties by index), at most size().
+         */
+        [[nodiscard]] std::vector<std::size_t> nearest(const Vector3D<Real> &point, std::size_t k) const {
+            k = std::min(k, size());
+            std::vector<std::size_t> indices(k);
+            std::vector<Real> distances(k);
+            Scratch scratch;
+            nearest_into(point, k, indices.data(), distances.data(), scratch);
+            return indices;
+        }
+
+        /**
+         * Find the k points nearest to each of a batch of query points.
+         * @param queries the query points.
+         * @param k the number of neighbours, at most size().
+         * @param indices the original indices of the neighbours, k per query by increasing distance (ties by index).
+         * @param distances the distances to the neighbours, k per query.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void nearest(const Vector3DSoA<Real> &queries, std::size_t k, std::size_t *indices, Real *distances,
+                     std::size_t n_threads = 0) const {
+            if (k > size()) throw std::invalid_argument("KdTree: more neighbours requested than points");
+            parallel_for(0, queries.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                Scratch scratch;
+                for (std::size_t q = begin; q < end; ++q) {
+                    nearest_into(queries[q], k, indices + q * k, distances + q * k, scratch);
+                }
+            }, n_threads, 64);
+        }
+
+        /**
+         * Find the points within a distance of a query point.
+         * @param centre the query point.
+         * @param radius the distance.
+         * @return the original indices of the points with |p - centre| <= radius, ascending.
+         */
+        [[nodiscard]] std::vector<std::size_t> within_radius(const Vector3D<Real> &centre, const Real &radius) const {
+            std::vector<std::size_t> result;
+            radius_visit(centre, radius, [&](std::size_t i) { result.push_back(i); });
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        /**
+         * Count the points within a distance of each of a batch of query points, to size the buffers of
+         * within_radius().
+         * @param queries the query points.
+         * @param radius the distance.
+         * @param counts the number of points with |p - q| <= radius, one per query.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void count_within_radius(const Vector3DSoA<Real> &queries, const Real &radius, std::size_t *counts,
+                                 std::size_t n_threads = 0) const {
+            parallel_for(0, queries.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t q = begin; q < end; ++q) {
+                    std::size_t count = 0;
+                    radius_visit(queries[q], radius, [&count](std::size_t) { ++count; });
+                    counts[q] = count;
+                }
+            }, n_threads, 64);
+        }
+
+        /**
+         * Find the points within a distance of each of a batch of query points.
+         * @param queries the query points.
+         * @param radius the distance.
+         * @param offsets the start of each query's results in `indices`, queries.size() + 1 entries, e.g. the prefix
+         * sums of count_within_radius().
+         * @param indices the original indices of the points with |p - q| <= radius, ascending per query.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void within_radius(const Vector3DSoA<Real> &queries, const Real &radius, const std::size_t *offsets,
+                           std::size_t *indices, std::size_t n_threads = 0) const {
+            parallel_for(0, queries.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t q = begin; q < end; ++q) {
+                    std::size_t *out = indices + offsets[q];
+                    std::size_t *last = indices + offsets[q + 1];
+                    radius_visit(queries[q], radius, [&](std::size_t i) {
+                        if (out == last) throw std::length_error("KdTree: radius query buffer too small");
+                        *out++ = i;
+                    });
+                    std::sort(indices + offsets[q], out);
+                }
+            }, n_threads, 64);
+        }
+
+    private:
+
+        static constexpr bool exact = !std::is_same_v<Real, double>;
+
+        /**
+         * Per-thread working storage of the queries, reused across queries.
+         */
+        struct Scratch {
+            std::vector<std::pair<double, std::size_t>> best;
+            std::vector<std::size_t> candidates;
+            std::vector<std::pair<Real, std::size_t>> ranked;
+        };
+
+        std::size_t _leaf_size;
+        double _scale = 0.0;
+
+        std::vector<KdNode> _nodes;
+        std::vector<std::size_t> _permutation;
+        Vector3DSoA<double> _coordinates;
+        Vector3DSoA<Real> _points;
+
+        /**
+         * The number of nodes of the subtree over n points, memoised (a level has at most two distinct sizes).
+         */
+        std::size_t subtree_nodes(std::size_t n, std::map<std::size_t, std::size_t> &sizes) const {
+            if (n <= _leaf_size) return 1;
+            auto it = sizes.find(n);
+            if (it != sizes.end()) return it->second;
+            const std::size_t count = 1 + subtree_nodes(n / 2, sizes) + subtree_nodes(n - n / 2, sizes);
+            sizes.emplace(n, count);
+            return count;
+        }
+
+        /**
+         * Build the subtree over [begin, end) of the permutation at node `index`, handing the subtrees `depth` levels
+         * down to `deferred` (if given) instead of building them.
+         */
+        void build(const Vector3DSoA<double> &coordinates, std::size_t index, std::size_t begin, std::size_t end,
+                   std::size_t depth, std::map<std::size_t, std::size_t> &sizes,
+                   std::vector<std::array<std::size_t, 3>> *deferred) {
+
+            KdNode &node = _nodes[index];
+            node.begin = begin;
+            node.end = end;
+            if (end - begin <= _leaf_size) return;
+            if (deferred && depth == 0) {
+                deferred->push_back({index, begin, end});
+                return;
+            }
+
+            std::array<double, 3> lower, upper;
+            for (std::size_t a = 0; a < 3; ++a) {
+                lower[a] = std::numeric_limits<double>::max();
+                upper[a] = std::numeric_limits<double>::lowest();
+            }
+            const double *axes[3] = {coordinates.x(), coordinates.y(), coordinates.z()};
+            for (std::size_t p = begin; p < end; ++p) {
+                for (std::size_t a = 0; a < 3; ++a) {
+                    lower[a] = std::min(lower[a], axes[a][_permutation[p]]);
+                    upper[a] = std::max(upper[a], axes[a][_permutation[p]]);
+                }
+            }
+            std::size_t axis = 0;
+            for (std::size_t a = 1; a < 3; ++a) if (upper[a] - lower[a] > upper[axis] - lower[axis]) axis = a;
+
+            const double *coordinate = axes[axis];
+            const std::size_t middle = begin + (end - begin) / 2;
+            std::nth_element(_permutation.begin() + static_cast<std::ptrdiff_t>(begin),
+                             _permutation.begin() + static_cast<std::ptrdiff_t>(middle),
+                             _permutation.begin() + static_cast<std::ptrdiff_t>(end),
+                             [coordinate](std::size_t a, std::size_t b) { return coordinate[a] < coordinate[b]; });
+
+            node.axis = axis;
+            node.split = coordinate[_permutation[middle]];
+            node.children = {index + 1, index + 1 + subtree_nodes(middle - begin, sizes)};
+
+            const std::array<std::size_t, 2> children = node.children;
+            build(coordinates, children[0], begin, middle, depth - (deferred ? 1 : 0), sizes, deferred);
+            build(coordinates, children[1], middle, end, depth - (deferred ? 1 : 0), sizes, deferred);
+
+        }
+
+        /**
+         * A bound on the error of a double precision distance from a query point, allowing for the rounding of the
+         * coordinates and of the arithmetic.
+         */
+        double margin(const std::array<double, 3> &q, double distance) const {
+            const double extent = _scale + std::max({std::fabs(q[0]), std::fabs(q[1]), std::fabs(q[2])});
+            return 16.0 * std::numeric_limits<double>::epsilon() * (extent + distance);
+        }
+
+        static std::array<double, 3> rounded(const Vector3D<Real> &point) {
+            return {static_cast<double>(point.x()), static_cast<double>(point.y()), static_cast<double>(point.z())};
+        }
+
+        double distance2(const std::array<double, 3> &q, std::size_t p) const {
+            const double dx = _coordinates.x()[p] - q[0];
+            const double dy = _coordinates.y()[p] - q[1];
+            const double dz = _coordinates.z()[p] - q[2];
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        Real exact_distance2(const Vector3D<Real> &q, std::size_t p) const {
+            const Real dx = _points.x()[p] - q.x();
+            const Real dy = _points.y()[p] - q.y();
+            const Real dz = _points.z()[p] - q.z();
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        /**
+         * Descend nearer son first, keeping the per-axis offsets of the query from the node's cell so that the
+         * squared distance to the cell is updated incrementally (Arya and Mount).
+         */
+        void search_nearest(const std::array<double, 3> &q, std::size_t k, std::size_t index, double cell2,
+                            std::array<double, 3> &offsets, std::vector<std::pair<double, std::size_t>> &best) const {
+
+            const KdNode &node = _nodes[index];
+            if (node.is_leaf()) {
+                for (std::size_t p = node.begin; p < node.end; ++p) {
+                    const std::pair<double, std::size_t> candidate(distance2(q, p), _permutation[p]);
+                    if (best.size() < k) {
+                        best.push_back(candidate);
+                        std::push_heap(best.begin(), best.end());
+                    } else if (candidate < best.front()) {
+                        std::pop_heap(best.begin(), best.end());
+                        best.back() = candidate;
+                        std::push_heap(best.begin(), best.end());
+                    }
+                }
+                return;
+            }
+
+            const double difference = q[node.axis] - node.split;
+            const std::size_t near = difference < 0.0 ? 0 : 1;
+            search_nearest(q, k, node.children[near], cell2, offsets, best);
+
+            const double previous = offsets[node.axis];
+            const double far2 = cell2 - previous * previous + difference * difference;
+            if (best.size() < k || far2 <= best.front().first) {
+                offsets[node.axis] = difference;
+                search_nearest(q, k, node.children[1 - near], far2, offsets, best);
+                offsets[node.axis] = previous;
+            }
+
+        }
+
+        /**
+         * Call `fn` with the tree position of every point within sqrt(radius2) of a query point (double precision).
+         */
+        template<typename Fn>
+        void search_radius(const std::array<double, 3> &q, double radius2, std::size_t index, double cell2,
+                           std::array<double, 3> &offsets, Fn &fn) const {
+
+            const KdNode &node = _nodes[index];
+            if (node.is_leaf()) {
+                for (std::size_t p = node.begin; p < node.end; ++p) if (distance2(q, p) <= radius2) fn(p);
+                return;
+            }
+
+            const double difference = q[node.axis] - node.split;
+            const std::size_t near = difference < 0.0 ? 0 : 1;
+            search_radius(q, radius2, node.children[near], cell2, offsets, fn);
+
+            const double previous = offsets[node.axis];
+            const double far2 = cell2 - previous * previous + difference * difference;
+            if (far2 <= radius2) {
+                offsets[node.axis] = difference;
+                search_radius(q, radius2, node.children[1 - near], far2, offsets, fn);
+                offsets[node.axis] = previous;
+            }
+
+        }
+
+        void nearest_into(const Vector3D<Real> &point, std::size_t k, std::size_t *indices, Real *distances,
+                          Scratch &scratch) const {
+
+            using std::sqrt;
+
+            if (k == 0) return;
+
+            const std::array<double, 3> q = rounded(point);
+            std::array<double, 3> offsets = {0.0, 0.0, 0.0};
+            scratch.best.clear();
+            search_nearest(q, k, 0, 0.0, offsets, scratch.best);
+
+            if constexpr (!exact) {
+                std::sort_heap(scratch.best.begin(), scratch.best.end());
+                for (std::size_t i = 0; i < k; ++i) {
+                    indices[i] = scratch.best[i].second;
+                    distances[i] = sqrt(scratch.best[i].first);
+                }
+            } else {
+                // Every exact k-nearest neighbour lies within the double k-th distance plus twice the error bound.
+                const double dk = std::sqrt(scratch.best.front().first);
+                const double radius = dk + 2.0 * margin(q, dk);
+                scratch.candidates.clear();
+                auto collect = [&scratch](std::size_t p) { scratch.candidates.push_back(p); };
+                offsets = {0.0, 0.0, 0.0};
+                search_radius(q, radius * radius, 0, 0.0, offsets, collect);
+
+                scratch.ranked.resize(scratch.candidates.size());
+                for (std::size_t c = 0; c < scratch.candidates.size(); ++c) {
+                    const std::size_t p = scratch.candidates[c];
+                    scratch.ranked[c] = {exact_distance2(point, p), _permutation[p]};
+                }
+                std::partial_sort(scratch.ranked.begin(), scratch.ranked.begin() + static_cast<std::ptrdiff_t>(k),
+                                  scratch.ranked.end());
+                for (std::size_t i = 0; i < k; ++i) {
+                    indices[i] = scratch.ranked[i].second;
+                    distances[i] = sqrt(scratch.ranked[i].first);
+                }
+            }
+
+        }
+
+        /**
+         * Call `fn` with the original index of every point within a distance of a query point; with exact
+         * refinement the double search is widened by the error bound and its candidates are tested exactly.
+         */
+        template<typename Fn>
+        void radius_visit(const Vector3D<Real> &centre, const Real &radius, Fn fn) const {
+
+            if (_nodes.empty() || radius < Real(0)) return;
+
+            const std::array<double, 3> q = rounded(centre);
+            std::array<double, 3> offsets = {0.0, 0.0, 0.0};
+
+            if constexpr (!exact) {
+                auto report = [&](std::size_t p) { fn(_permutation[p]); };
+                search_radius(q, radius * radius, 0, 0.0, offsets, report);
+            } else {
+                const double r = static_cast<double>(radius);
+                const double widened = r + 2.0 * margin(q, r);
+                const Real radius2 = radius * radius;
+                auto report = [&](std::size_t p) { if (exact_distance2(centre, p) <= radius2) fn(_permutation[p]); };
+                search_radius(q, widened * widened, 0, 0.0, offsets, report);
+            }
+
+        }
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
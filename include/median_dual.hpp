@@ -0,0 +1,298 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+#include <colouring.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    namespace detail {
+
+        /**
+         * The six edges of a tetrahedron as (a, b, c, d) with (a, b) the edge and (a, b, c, d) an even permutation of
+         * (0, 1, 2, 3), so that the tetrahedron (r_a, r_b, r_c, r_d) has the orientation of the element.
+         */
+        inline constexpr std::array<std::array<std::size_t, 4>, 6> tetrahedron_edges = {{
+            {0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 2, 0, 3}, {1, 3, 2, 0}, {2, 3, 0, 1}
+        }};
+
+    } // namespace detail
+
+    /**
+     * The connectivity needed for the median-dual geometry of a tetrahedral mesh: the unique edges, the edges of each
+     * element, the boundary faces (faces belonging to a single element) and an element colouring for race-free
+     * accumulation. It depends only on the connectivity and is reused after the vertices move.
+     */
+    class MedianDualTopology {
+
+    public:
+
+        /**
+         * Build the topology of a tetrahedral mesh.
+         * @param tetrahedra the four vertex indices of each tetrahedron.
+         * @param n_vertices the number of vertices.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        MedianDualTopology(const std::vector<std::array<std::size_t, 4>> &tetrahedra, std::size_t n_vertices,
+                           std::size_t n_threads = 0)
+                : _n_vertices(n_vertices), _colouring(tetrahedra, n_vertices, true, n_threads) {
+
+            const std::size_t n = tetrahedra.size();
+
+            // Unique edges by sorting (lower vertex, upper vertex, element slot) keys.
+            std::vector<std::array<std::size_t, 3>> keys(6 * n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t e = begin; e < end; ++e) {
+                    for (std::size_t k = 0; k < 6; ++k) {
+                        const std::size_t i = tetrahedra[e][detail::tetrahedron_edges[k][0]];
+                        const std::size_t j = tetrahedra[e][detail::tetrahedron_edges[k][1]];
+                        keys[6 * e + k] = {std::min(i, j), std::max(i, j), 6 * e + k};
+                    }
+                }
+            }, n_threads);
+            std::sort(keys.begin(), keys.end());
+            _element_edges.resize(n);
+            for (std::size_t k = 0; k < keys.size(); ++k) {
+                if (k == 0 || keys[k][0] != keys[k - 1][0] || keys[k][1] != keys[k - 1][1]) {
+                    _edges.push_back({keys[k][0], keys[k][1]});
+                }
+                _element_edges[keys[k][2] / 6][keys[k][2] % 6] = _edges.size() - 1;
+            }
+
+            // Boundary faces by sorting (sorted face vertices, element slot) keys; face f is opposite vertex f.
+            std::vector<std::array<std::size_t, 4>> faces(4 * n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t e = begin; e < end; ++e) {
+                    for (std::size_t f = 0; f < 4; ++f) {
+                        std::array<std::size_t, 4> key = {tetrahedra[e][(f + 1) % 4], tetrahedra[e][(f + 2) % 4],
+                                                          tetrahedra[e][(f + 3) % 4], 4 * e + f};
+                        std::sort(key.begin(), key.begin() + 3);
+                        faces[4 * e + f] = key;
+                    }
+                }
+            }, n_threads);
+            std::sort(faces.begin(), faces.end());
+            _boundary_masks.assign(n, 0);
+            auto same = [&](std::size_t k, std::size_t l) {
+                return faces[k][0] == faces[l][0] && faces[k][1] == faces[l][1] && faces[k][2] == faces[l][2];
+            };
+            for (std::size_t k = 0; k < faces.size(); ++k) {
+                if ((k > 0 && same(k, k - 1)) || (k + 1 < faces.size() && same(k, k + 1))) continue;
+                _boundary_faces.push_back({faces[k][3] / 4, faces[k][3] % 4});
+                _boundary_masks[faces[k][3] / 4] |= static_cast<std::uint8_t>(1u << (faces[k][3] % 4));
+            }
+
+        }
+
+        /**
+         * Retrieve the number of vertices.
+         * @return the number of vertices.
+         */
+        [[nodiscard]] inline std::size_t n_vertices() const { return _n_vertices; }
+
+        /**
+         * Retrieve the number of elements.
+         * @return the number of elements.
+         */
+        [[nodiscard]] inline std::size_t n_elements() const { return _element_edges.size(); }
+
+        /**
+         * Retrieve the number of unique edges.
+         * @return the number of edges.
+         */
+        [[nodiscard]] inline std::size_t n_edges() const { return _edges.size(); }
+
+        /**
+         * Retrieve the unique edges, each with its lower vertex index first.
+         * @return the edges.
+         */
+        [[nodiscard]] inline const std::vector<std::array<std::size_t, 2>> &edges() const { return _edges; }
+
+        /**
+         * Retrieve the edge indices of each element, in the order (0, 1), (0, 2), (0, 3), (1, 2), (1, 3), (2, 3) of
+         * local vertices.
+         * @return the element edges.
+         */
+        [[nodiscard]] inline const std::vector<std::array<std::size_t, 6>> &element_edges() const {
+            return _element_edges;
+        }
+
+        /**
+         * Retrieve the boundary faces as (element, local face) pairs, local face f being opposite local vertex f.
+         * @return the boundary faces.
+         */
+        [[nodiscard]] inline const std::vector<std::array<std::size_t, 2>> &boundary_faces() const {
+            return _boundary_faces;
+        }
+
+        /**
+         * Retrieve, for each element, a bit mask of its local faces lying on the boundary.
+         * @return the boundary masks.
+         */
+        [[nodiscard]] inline const std::vector<std::uint8_t> &boundary_masks() const { return _boundary_masks; }
+
+        /**
+         * Retrieve the element colouring used for race-free accumulation.
+         * @return the colouring.
+         */
+        [[nodiscard]] inline const ElementColouring &colouring() const { return _colouring; }
+
+    private:
+
+        std::size_t _n_vertices;
+
+        std::vector<std::array<std::size_t, 2>> _edges;
+        std::vector<std::array<std::size_t, 6>> _element_edges;
+        std::vector<std::array<std::size_t, 2>> _boundary_faces;
+        std::vector<std::uint8_t> _boundary_masks;
+
+        ElementColouring _colouring;
+
+    };
+
+    /**
+     * The median-dual geometry of a tetrahedral mesh.
+     * @tparam Storage the type the results are stored in - usually 'double' or 'mpreal'.
+     */
+    template<typename Storage>
+    struct MedianDualGeometry {
+
+        /** The lumped volume of each vertex, a quarter of the volume of every incident tetrahedron. */
+        std::vector<Storage> vertex_volumes;
+
+        /** The boundary area of each vertex, a third of the area of every incident boundary face. */
+        std::vector<Storage> boundary_areas;
+
+        /** The outward boundary area vector of each vertex, a third of that of every incident boundary face. */
+        Vector3DSoA<Storage> boundary_normals;
+
+        /**
+         * The area vector of the dual face of each edge, pointing from its lower to its upper vertex. For every
+         * vertex the face vectors pointing away from it and its boundary area vector sum to zero.
+         */
+        Vector3DSoA<Storage> face_vectors;
+
+    };
+
+    /**
+     * Compute the median-dual geometry of a tetrahedral mesh in one fused pass over the elements. For each element
+     * the volume, the centre and the six dual face pieces (each spanned by the edge centre, the centres of the two
+     * faces containing the edge and the element centre) are evaluated once, together with the areas of any boundary
+     * faces, and accumulated into the vertices and edges. The elements are processed colour by colour, so that
+     * concurrently processed elements share neither vertices nor edges and the accumulation needs no atomics.
+     * Computation is carried out in Real and the results are stored in Storage.
+     * @param mesh the tetrahedral mesh.
+     * @param topology the topology of the mesh.
+     * @param geometry the output, resized as needed.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    template<typename Real, typename Storage>
+    void median_dual_geometry(const TetrahedralMesh<Real> &mesh, const MedianDualTopology &topology,
+                              MedianDualGeometry<Storage> &geometry, std::size_t n_threads = 0) {
+
+        if (topology.n_elements() != mesh.n_tetrahedra() || topology.n_vertices() != mesh.n_vertices()) {
+            throw std::invalid_argument("median_dual_geometry: the topology does not belong to the mesh");
+        }
+
+        const std::size_t n_vertices = mesh.n_vertices();
+        const std::size_t n_edges = topology.n_edges();
+
+        geometry.vertex_volumes.assign(n_vertices, Storage(0));
+        geometry.boundary_areas.assign(n_vertices, Storage(0));
+        geometry.boundary_normals = Vector3DSoA<Storage>(n_vertices);
+        geometry.face_vectors = Vector3DSoA<Storage>(n_edges);
+
+        Storage *volumes = geometry.vertex_volumes.data();
+        Storage *areas = geometry.boundary_areas.data();
+        Storage *nx = geometry.boundary_normals.x();
+        Storage *ny = geometry.boundary_normals.y();
+        Storage *nz = geometry.boundary_normals.z();
+        Storage *fx = geometry.face_vectors.x();
+        Storage *fy = geometry.face_vectors.y();
+        Storage *fz = geometry.face_vectors.z();
+
+        const ElementColouring &colouring = topology.colouring();
+
+        parallel_for_coloured(colouring, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t k = begin; k < end; ++k) {
+
+                const std::size_t e = colouring.elements()[k];
+                const auto &t = mesh.tetrahedra[e];
+                const Vector3D<Real> r[4] = {mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                             mesh.vertices[t[2]], mesh.vertices[t[3]]};
+
+                const Real volume = tetrahedron_volume(r[0], r[1], r[2], r[3]);
+                const bool negative = volume < Real(0);
+                const Storage quarter = static_cast<Storage>((negative ? Real(-1) * volume : volume) / Real(4));
+                for (std::size_t a = 0; a < 4; ++a) volumes[t[a]] += quarter;
+
+                // The dual face piece of edge (a, b) is the pair of triangles (m, f_c, c) and (m, c, f_d), whose area
+                // vector is (f_c - f_d) x (c - m) / 2; for a positively oriented element it points from a to b.
+                const Vector3D<Real> centre = tetrahedron_center(r[0], r[1], r[2], r[3]);
+                for (std::size_t j = 0; j < 6; ++j) {
+                    const auto &p = detail::tetrahedron_edges[j];
+                    const Vector3D<Real> m = edge_center(r[p[0]], r[p[1]]);
+                    const Vector3D<Real> fc = triangle_center(r[p[0]], r[p[1]], r[p[2]]);
+                    const Vector3D<Real> fd = triangle_center(r[p[0]], r[p[1]], r[p[3]]);
+                    Vector3D<Real> s = cross(fc - fd, centre - m) / Real(2);
+                    if (negative != (t[p[0]] > t[p[1]])) s = Real(-1) * s;
+                    const std::size_t edge = topology.element_edges()[e][j];
+                    fx[edge] += static_cast<Storage>(s.x());
+                    fy[edge] += static_cast<Storage>(s.y());
+                    fz[edge] += static_cast<Storage>(s.z());
+                }
+
+                const std::uint8_t mask = topology.boundary_masks()[e];
+                if (mask == 0) continue;
+                for (std::size_t f = 0; f < 4; ++f) {
+                    if (!((mask >> f) & 1)) continue;
+                    const std::size_t i1 = (f + 1) % 4, i2 = (f + 2) % 4, i3 = (f + 3) % 4;
+                    Vector3D<Real> normal = cross(r[i2] - r[i1], r[i3] - r[i1]) / Real(6);
+                    if (dot(normal, r[f] - r[i1]) > Real(0)) normal = Real(-1) * normal;
+                    const Storage third = static_cast<Storage>(triangle_area(r[i1], r[i2], r[i3]) / Real(3));
+                    for (std::size_t i: {t[i1], t[i2], t[i3]}) {
+                        areas[i] += third;
+                        nx[i] += static_cast<Storage>(normal.x());
+                        ny[i] += static_cast<Storage>(normal.y());
+                        nz[i] += static_cast<Storage>(normal.z());
+                    }
+                }
+
+            }
+        }, n_threads);
+
+    }
+
+    /**
+     * Compute the median-dual geometry of a tetrahedral mesh in one fused pass, see the overload above.
+     * @param mesh the tetrahedral mesh.
+     * @param topology the topology of the mesh.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the median-dual geometry.
+     */
+    template<typename Real, typename Storage = Real>
+    MedianDualGeometry<Storage> median_dual_geometry(const TetrahedralMesh<Real> &mesh,
+                                                     const MedianDualTopology &topology, std::size_t n_threads = 0) {
+
+        MedianDualGeometry<Storage> geometry;
+        median_dual_geometry(mesh, topology, geometry, n_threads);
+        return geometry;
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,72 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * A tetrahedral mesh: vertex positions held in structure-of-arrays form together with the tetrahedron
+     * connectivity (four vertex indices per element).
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct TetrahedralMesh {
+
+        /** The vertex positions. */
+        Vector3DSoA<Real> vertices;
+
+        /** The four vertex indices of each tetrahedron. */
+        std::vector<std::array<std::size_t, 4>> tetrahedra;
+
+        /**
+         * Retrieve the number of vertices.
+         * @return the number of vertices.
+         */
+        [[nodiscard]] inline std::size_t n_vertices() const { return vertices.size(); }
+
+        /**
+         * Retrieve the number of tetrahedra.
+         * @return the number of tetrahedra.
+         */
+        [[nodiscard]] inline std::size_t n_tetrahedra() const { return tetrahedra.size(); }
+
+    };
+
+    /**
+     * A triangulated surface mesh: vertex positions held in structure-of-arrays form together with the triangle
+     * connectivity (three vertex indices per element, wound as for triangle_normal()).
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct TriangleMesh {
+
+        /** The vertex positions. */
+        Vector3DSoA<Real> vertices;
+
+        /** The three vertex indices of each triangle. */
+        std::vector<std::array<std::size_t, 3>> triangles;
+
+        /**
+         * Retrieve the number of vertices.
+         * @return the number of vertices.
+         */
+        [[nodiscard]] inline std::size_t n_vertices() const { return vertices.size(); }
+
+        /**
+         * Retrieve the number of triangles.
+         * @return the number of triangles.
+         */
+        [[nodiscard]] inline std::size_t n_triangles() const { return triangles.size(); }
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
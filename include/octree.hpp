@@ -0,0 +1,665 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /** The number of bits per axis of a Morton code; three axes give a 63-bit code. */
+    constexpr std::size_t morton_bits = 21;
+
+    namespace detail {
+
+        /**
+         * Spread the low 21 bits of a value so that two zero bits separate each of them.
+         */
+        constexpr std::uint64_t morton_spread(std::uint64_t x) {
+            x &= 0x1fffffu;
+            x = (x | (x << 32)) & 0x001f00000000ffffull;
+            x = (x | (x << 16)) & 0x001f0000ff0000ffull;
+            x = (x | (x << 8)) & 0x100f00f00f00f00full;
+            x = (x | (x << 4)) & 0x10c30c30c30c30c3ull;
+            x = (x | (x << 2)) & 0x1249249249249249ull;
+            return x;
+        }
+
+        /**
+         * Gather every third bit of a value, the inverse of morton_spread().
+         */
+        constexpr std::uint64_t morton_compact(std::uint64_t x) {
+            x &= 0x1249249249249249ull;
+            x = (x | (x >> 2)) & 0x10c30c30c30c30c3ull;
+            x = (x | (x >> 4)) & 0x100f00f00f00f00full;
+            x = (x | (x >> 8)) & 0x001f0000ff0000ffull;
+            x = (x | (x >> 16)) & 0x001f00000000ffffull;
+            x = (x | (x >> 32)) & 0x1fffffull;
+            return x;
+        }
+
+    }
+
+    /**
+     * Interleave three 21-bit cell coordinates into a 63-bit Morton (Z-order) code, x in the lowest bit.
+     * @param i the x cell coordinate.
+     * @param j the y cell coordinate.
+     * @param k the z cell coordinate.
+     * @return the Morton code.
+     */
+    constexpr std::uint64_t morton_encode(std::uint32_t i, std::uint32_t j, std::uint32_t k) {
+        return detail::morton_spread(i) | (detail::morton_spread(j) << 1) | (detail::morton_spread(k) << 2);
+    }
+
+    /**
+     * Split a 63-bit Morton code into its three cell coordinates.
+     * @param code the Morton code.
+     * @return the x, y and z cell coordinates.
+     */
+    constexpr std::array<std::uint32_t, 3> morton_decode(std::uint64_t code) {
+        return {static_cast<std::uint32_t>(detail::morton_compact(code)),
+                static_cast<std::uint32_t>(detail::morton_compact(code >> 1)),
+                static_cast<std::uint32_t>(detail::morton_compact(code >> 2))};
+    }
+
+    /**
+     * Sort keys together with their values by a parallel least significant digit radix sort on 11-bit digits. Every
+     * thread histograms and then scatters its own contiguous chunk, so the sort is stable; passes over a digit that
+     * all keys share are skipped.
+     * @param keys the keys, sorted on return.
+     * @param values the values, permuted with the keys.
+     * @param key_bits the number of significant low bits of the keys.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     */
+    inline void radix_sort(std::vector<std::uint64_t> &keys, std::vector<std::size_t> &values,
+                           std::size_t key_bits = 64, std::size_t n_threads = 0) {
+
+        constexpr std::size_t digit_bits = 11;
+        constexpr std::size_t radix = std::size_t(1) << digit_bits;
+
+        const std::size_t n = keys.size();
+        if (values.size() != n) throw std::invalid_argument("radix_sort: keys and values differ in size");
+        if (n < 2) return;
+
+        if (n_threads == 0) n_threads = default_thread_count();
+        const std::size_t n_chunks = std::max<std::size_t>(1, std::min(n_threads, n / 16384));
+        const std::size_t chunk = (n + n_chunks - 1) / n_chunks;
+
+        std::vector<std::uint64_t> key_scratch(n);
+        std::vector<std::size_t> value_scratch(n);
+        std::vector<std::size_t> counts(n_chunks * radix);
+
+        for (std::size_t shift = 0; shift < key_bits; shift += digit_bits) {
+
+            std::fill(counts.begin(), counts.end(), 0);
+            parallel_for(0, n_chunks, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t c = begin; c < end; ++c) {
+                    std::size_t *count = counts.data() + c * radix;
+                    for (std::size_t i = c * chunk; i < std::min(n, (c + 1) * chunk); ++i) {
+                        ++count[(keys[i] >> shift) & (radix - 1)];
+                    }
+                }
+            }, n_chunks, 1);
+
+            // Digit-major, chunk-minor exclusive prefix sums give each chunk its scatter positions.
+            std::size_t sum = 0;
+            bool trivial = false;
+            for (std::size_t d = 0; d < radix; ++d) {
+                const std::size_t first = sum;
+                for (std::size_t c = 0; c < n_chunks; ++c) {
+                    const std::size_t count = counts[c * radix + d];
+                    counts[c * radix + d] = sum;
+                    sum += count;
+                }
+                trivial = trivial || sum - first == n;
+            }
+            if (trivial) continue;
+
+            parallel_for(0, n_chunks, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t c = begin; c < end; ++c) {
+                    std::size_t *position = counts.data() + c * radix;
+                    for (std::size_t i = c * chunk; i < std::min(n, (c + 1) * chunk); ++i) {
+                        const std::size_t p = position[(keys[i] >> shift) & (radix - 1)]++;
+                        key_scratch[p] = keys[i];
+                        value_scratch[p] = values[i];
+                    }
+                }
+            }, n_chunks, 1);
+
+            keys.swap(key_scratch);
+            values.swap(value_scratch);
+
+        }
+
+    }
+
+    /**
+     * A node of a linear octree: the points whose Morton codes share the node's prefix, a contiguous range of the
+     * sorted order, together with the position of its non-empty children in the node table.
+     */
+    struct OctreeNode {
+
+        /** Marks a missing node. */
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /** The depth of the node, zero for the root. */
+        std::size_t level = 0;
+
+        /** The Morton prefix of the node, 3 * level bits. */
+        std::uint64_t key = 0;
+
+        /** The first position of the node in the sorted order. */
+        std::size_t begin = 0;
+
+        /** One past the last position of the node in the sorted order. */
+        std::size_t end = 0;
+
+        /** The index of the first child in the node table, or `none` for a leaf. */
+        std::size_t first_child = none;
+
+        /** The number of (non-empty) children, stored consecutively in Morton order. */
+        std::size_t n_children = 0;
+
+        /**
+         * Retrieve the number of points in the node.
+         * @return the node size.
+         */
+        [[nodiscard]] inline std::size_t size() const { return end - begin; }
+
+        /**
+         * Test whether the node is a leaf.
+         * @return true if the node has no children.
+         */
+        [[nodiscard]] inline bool is_leaf() const { return n_children == 0; }
+
+    };
+
+    /**
+     * A linear octree over a set of points. The points are quantised on a 2^21 grid over their bounding cube, mapped
+     * to 63-bit Morton codes and radix sorted; the hierarchy is implicit in the sorted codes, a node at depth l being
+     * the range of codes sharing their top 3 l bits. Nodes holding more than the leaf size are split, and the
+     * resulting nodes are tabulated once after the sort (the top levels serially, the subtrees below them in
+     * parallel) so that queries never have to search the codes.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class LinearOctree {
+
+    public:
+
+        /** Marks a missing point. */
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * Build a linear octree.
+         * @param points the points.
+         * @param leaf_size the largest node that queries scan rather than split.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        explicit LinearOctree(const Vector3DSoA<Real> &points, std::size_t leaf_size = 32, std::size_t n_threads = 0)
+                : _leaf_size(std::max<std::size_t>(1, leaf_size)) {
+
+            const std::size_t n = points.size();
+            if (n == 0) return;
+            if (n_threads == 0) n_threads = default_thread_count();
+
+            // Bounding cube; the per-chunk boxes start as the first point, so that a chunk which does not run adds
+            // nothing to the reduction.
+            const std::array<Real, 6> first = {points.x()[0], points.y()[0], points.z()[0],
+                                               points.x()[0], points.y()[0], points.z()[0]};
+            std::vector<std::array<Real, 6>> bounds(n_threads, first);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t thread) {
+                std::array<Real, 6> b = {points.x()[begin], points.y()[begin], points.z()[begin],
+                                         points.x()[begin], points.y()[begin], points.z()[begin]};
+                for (std::size_t i = begin + 1; i < end; ++i) {
+                    b[0] = std::min(b[0], points.x()[i]); b[3] = std::max(b[3], points.x()[i]);
+                    b[1] = std::min(b[1], points.y()[i]); b[4] = std::max(b[4], points.y()[i]);
+                    b[2] = std::min(b[2], points.z()[i]); b[5] = std::max(b[5], points.z()[i]);
+                }
+                bounds[thread] = b;
+            }, n_threads);
+            std::array<Real, 6> b = first;
+            for (std::size_t t = 0; t < bounds.size(); ++t) {
+                for (std::size_t a = 0; a < 3; ++a) {
+                    b[a] = std::min(b[a], bounds[t][a]);
+                    b[a + 3] = std::max(b[a + 3], bounds[t][a + 3]);
+                }
+            }
+            Real extent = std::max(b[3] - b[0], std::max(b[4] - b[1], b[5] - b[2]));
+            if (!(extent > Real(0))) extent = Real(1);
+            _lower = Vector3D<Real>(b[0], b[1], b[2]);
+            _cell = extent / Real(double(std::uint64_t(1) << morton_bits));
+
+            // Node boxes are padded to absorb the rounding of the quantisation.
+            _pad = extent * Real(1E-12);
+
+            // Codes.
+            const double scale = double(std::uint64_t(1) << morton_bits) / static_cast<double>(extent);
+            const double top = double((std::uint64_t(1) << morton_bits) - 1);
+            _codes.resize(n);
+            _permutation.resize(n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                auto quantise = [&](const Real &x, const Real &lo) {
+                    return static_cast<std::uint32_t>(std::clamp(std::floor(static_cast<double>(x - lo) * scale),
+                                                                 0.0, top));
+                };
+                for (std::size_t i = begin; i < end; ++i) {
+                    _codes[i] = morton_encode(quantise(points.x()[i], b[0]), quantise(points.y()[i], b[1]),
+                                              quantise(points.z()[i], b[2]));
+                    _permutation[i] = i;
+                }
+            }, n_threads);
+
+            radix_sort(_codes, _permutation, 3 * morton_bits, n_threads);
+
+            _points.resize(n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t p = begin; p < end; ++p) {
+                    const std::size_t i = _permutation[p];
+                    _points.x()[p] = points.x()[i];
+                    _points.y()[p] = points.y()[i];
+                    _points.z()[p] = points.z()[i];
+                }
+            }, n_threads);
+
+            build_nodes(n_threads);
+
+        }
+
+        /**
+         * Retrieve the number of points.
+         * @return the number of points.
+         */
+        [[nodiscard]] inline std::size_t size() const { return _codes.size(); }
+
+        /**
+         * Retrieve the largest node that queries scan rather than split.
+         * @return the leaf size.
+         */
+        [[nodiscard]] inline std::size_t leaf_size() const { return _leaf_size; }
+
+        /**
+         * Retrieve the sorted Morton codes.
+         * @return the codes.
+         */
+        [[nodiscard]] inline const std::vector<std::uint64_t> &codes() const { return _codes; }
+
+        /**
+         * Retrieve the permutation: position p of the sorted order holds original point permutation()[p].
+         * @return the permutation.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &permutation() const { return _permutation; }
+
+        /**
+         * Retrieve the points in sorted order.
+         * @return the sorted points.
+         */
+        [[nodiscard]] inline const Vector3DSoA<Real> &points() const { return _points; }
+
+        /**
+         * Retrieve the node table; node zero is the root (if there are points).
+         * @return the nodes.
+         */
+        [[nodiscard]] inline const std::vector<OctreeNode> &nodes() const { return _nodes; }
+
+        /**
+         * Find the node of a given depth and Morton prefix.
+         * @param level the depth.
+         * @param key the Morton prefix, 3 * level bits.
+         * @return the index of the node, or OctreeNode::none if no point has the prefix or it lies below a leaf.
+         */
+        [[nodiscard]] std::size_t find(std::size_t level, std::uint64_t key) const {
+            if (level > morton_bits) throw std::out_of_range("LinearOctree: level out of range");
+            if (_nodes.empty()) return OctreeNode::none;
+            std::size_t current = 0;
+            while (_nodes[current].level < level) {
+                const OctreeNode &node = _nodes[current];
+                const std::uint64_t prefix = key >> (3 * (level - node.level - 1));
+                std::size_t next = OctreeNode::none;
+                for (std::size_t c = node.first_child; c < node.first_child + node.n_children; ++c) {
+                    if (_nodes[c].key == prefix) next = c;
+                }
+                if (next == OctreeNode::none) return OctreeNode::none;
+                current = next;
+            }
+            return current;
+        }
+
+        /**
+         * Retrieve the lower corner of a node's cell.
+         * @param node the node.
+         * @return the lower corner.
+         */
+        [[nodiscard]] Vector3D<Real> lower_corner(const OctreeNode &node) const {
+            const auto anchor = morton_decode(node.key << (3 * (morton_bits - node.level)));
+            return Vector3D<Real>(_lower.x() + Real(double(anchor[0])) * _cell - _pad,
+                                  _lower.y() + Real(double(anchor[1])) * _cell - _pad,
+                                  _lower.z() + Real(double(anchor[2])) * _cell - _pad);
+        }
+
+        /**
+         * Retrieve the upper corner of a node's cell.
+         * @param node the node.
+         * @return the upper corner.
+         */
+        [[nodiscard]] Vector3D<Real> upper_corner(const OctreeNode &node) const {
+            const auto anchor = morton_decode(node.key << (3 * (morton_bits - node.level)));
+            const double width = double(std::uint64_t(1) << (morton_bits - node.level));
+            return Vector3D<Real>(_lower.x() + Real(double(anchor[0]) + width) * _cell + _pad,
+                                  _lower.y() + Real(double(anchor[1]) + width) * _cell + _pad,
+                                  _lower.z() + Real(double(anchor[2]) + width) * _cell + _pad);
+        }
+
+        /**
+         * Find the k points nearest to a query point.
+         * @param point the query point.
+         * @param k the number of neighbours.
+         * @return the original indices of the neighbours by increasing distance (ties by index), at most size().
+         */
+        [[nodiscard]] std::vector<std::size_t> nearest(const Vector3D<Real> &point, std::size_t k) const {
+            k = std::min(k, size());
+            std::vector<std::size_t> indices(k);
+            std::vector<Real> distances(k);
+            Scratch scratch;
+            nearest_into(point, k, indices.data(), distances.data(), scratch);
+            return indices;
+        }
+
+        /**
+         * Find the k points nearest to each of a batch of query points.
+         * @param queries the query points.
+         * @param k the number of neighbours, at most size().
+         * @param indices the original indices of the neighbours, k per query by increasing distance.
+         * @param distances the distances to the neighbours, k per query, or nullptr.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void nearest(const Vector3DSoA<Real> &queries, std::size_t k, std::size_t *indices,
+                     Real *distances = nullptr, std::size_t n_threads = 0) const {
+            if (k > size()) throw std::invalid_argument("LinearOctree: more neighbours requested than points");
+            parallel_for(0, queries.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                Scratch scratch;
+                std::vector<Real> own(distances ? 0 : k);
+                for (std::size_t q = begin; q < end; ++q) {
+                    nearest_into(queries[q], k, indices + q * k, distances ? distances + q * k : own.data(), scratch);
+                }
+            }, n_threads, 64);
+        }
+
+        /**
+         * Find the points within a distance of a query point.
+         * @param centre the query point.
+         * @param radius the distance.
+         * @return the original indices of the points with |p - centre| <= radius, ascending.
+         */
+        [[nodiscard]] std::vector<std::size_t> within_radius(const Vector3D<Real> &centre, const Real &radius) const {
+            std::vector<std::size_t> result;
+            if (size() == 0) return result;
+            const Real r2 = radius * radius;
+            visit([&](const OctreeNode &node) {
+                const Vector3D<Real> lo = lower_corner(node), hi = upper_corner(node);
+                if (box_distance2(centre, lo, hi) > r2) return false;
+                if (box_farthest2(centre, lo, hi) <= r2) {
+                    append(node, result);
+                    return false;
+                }
+                if (!node.is_leaf()) return true;
+                for (std::size_t p = node.begin; p < node.end; ++p) {
+                    if (distance2(centre, p) <= r2) result.push_back(_permutation[p]);
+                }
+                return false;
+            });
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        /**
+         * Find the points inside an axis aligned box.
+         * @param lower the lower corner of the box.
+         * @param upper the upper corner of the box.
+         * @return the original indices of the points with lower <= p <= upper, ascending.
+         */
+        [[nodiscard]] std::vector<std::size_t> within_box(const Vector3D<Real> &lower,
+                                                          const Vector3D<Real> &upper) const {
+            std::vector<std::size_t> result;
+            if (size() == 0) return result;
+            visit([&](const OctreeNode &node) {
+                const Vector3D<Real> lo = lower_corner(node), hi = upper_corner(node);
+                if (hi.x() < lower.x() || hi.y() < lower.y() || hi.z() < lower.z() ||
+                    lo.x() > upper.x() || lo.y() > upper.y() || lo.z() > upper.z()) {
+                    return false;
+                }
+                if (lower.x() <= lo.x() && lower.y() <= lo.y() && lower.z() <= lo.z() &&
+                    hi.x() <= upper.x() && hi.y() <= upper.y() && hi.z() <= upper.z()) {
+                    append(node, result);
+                    return false;
+                }
+                if (!node.is_leaf()) return true;
+                for (std::size_t p = node.begin; p < node.end; ++p) {
+                    const Real x = _points.x()[p], y = _points.y()[p], z = _points.z()[p];
+                    if (lower.x() <= x && x <= upper.x() && lower.y() <= y && y <= upper.y() &&
+                        lower.z() <= z && z <= upper.z()) {
+                        result.push_back(_permutation[p]);
+                    }
+                }
+                return false;
+            });
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+    private:
+
+        /**
+         * Per-query working storage of the nearest neighbour search, reused across the queries of a thread.
+         */
+        struct Scratch {
+            std::vector<std::pair<Real, std::size_t>> nodes;
+            std::vector<std::pair<Real, std::size_t>> best;
+        };
+
+        std::size_t _leaf_size;
+
+        Vector3D<Real> _lower;
+        Real _cell = Real(0);
+        Real _pad = Real(0);
+
+        std::vector<std::uint64_t> _codes;
+        std::vector<std::size_t> _permutation;
+        Vector3DSoA<Real> _points;
+        std::vector<OctreeNode> _nodes;
+
+        /**
+         * Append the non-empty children of a node (more than leaf size points above the deepest level) to a table.
+         */
+        std::size_t split(const OctreeNode &parent, std::vector<OctreeNode> &nodes) const {
+            const std::size_t level = parent.level + 1;
+            const std::size_t shift = 3 * (morton_bits - level);
+            std::size_t count = 0;
+            auto first = _codes.begin() + static_cast<std::ptrdiff_t>(parent.begin);
+            auto end = _codes.begin() + static_cast<std::ptrdiff_t>(parent.end);
+            while (first != end) {
+                const std::uint64_t key = *first >> shift;
+                auto last = std::lower_bound(first, end, (key + 1) << shift);
+                OctreeNode child;
+                child.level = level;
+                child.key = key;
+                child.begin = static_cast<std::size_t>(first - _codes.begin());
+                child.end = static_cast<std::size_t>(last - _codes.begin());
+                nodes.push_back(child);
+                ++count;
+                first = last;
+            }
+            return count;
+        }
+
+        bool splittable(const OctreeNode &node) const {
+            return node.size() > _leaf_size && node.level < morton_bits;
+        }
+
+        /**
+         * Split the nodes of a table breadth first, appending the children, down to (not below) depth `stop`.
+         */
+        void expand(std::vector<OctreeNode> &nodes, std::size_t stop) const {
+            for (std::size_t i = 0; i < nodes.size(); ++i) {
+                if (!splittable(nodes[i]) || nodes[i].level >= stop) continue;
+                const OctreeNode parent = nodes[i];
+                const std::size_t first = nodes.size();
+                nodes[i].n_children = split(parent, nodes);
+                nodes[i].first_child = first;
+            }
+        }
+
+        void build_nodes(std::size_t n_threads) {
+
+            OctreeNode root;
+            root.end = size();
+            _nodes = {root};
+
+            // The top levels serially, until there are enough subtrees to keep the threads busy.
+            std::size_t top = 1;
+            while ((std::size_t(1) << (3 * top)) < 8 * n_threads && top < morton_bits) ++top;
+            expand(_nodes, top);
+
+            std::vector<std::size_t> roots;
+            for (std::size_t i = 0; i < _nodes.size(); ++i) {
+                if (_nodes[i].level == top && splittable(_nodes[i])) roots.push_back(i);
+            }
+
+            // Each subtree below is built into its own table with local child indices, then appended.
+            std::vector<std::vector<OctreeNode>> subtrees(roots.size());
+            std::vector<std::size_t> counts(roots.size());
+            parallel_for(0, roots.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t r = begin; r < end; ++r) {
+                    counts[r] = split(_nodes[roots[r]], subtrees[r]);
+                    expand(subtrees[r], morton_bits);
+                }
+            }, n_threads, 1);
+
+            for (std::size_t r = 0; r < roots.size(); ++r) {
+                const std::size_t base = _nodes.size();
+                _nodes[roots[r]].first_child = base;
+                _nodes[roots[r]].n_children = counts[r];
+                for (OctreeNode node: subtrees[r]) {
+                    if (!node.is_leaf()) node.first_child += base;
+                    _nodes.push_back(node);
+                }
+            }
+
+        }
+
+        /**
+         * Depth-first traversal from the root; `fn` returns whether to descend into the children of a node.
+         */
+        template<typename Fn>
+        void visit(Fn fn) const {
+            std::vector<std::size_t> stack = {0};
+            while (!stack.empty()) {
+                const OctreeNode &node = _nodes[stack.back()];
+                stack.pop_back();
+                if (!fn(node)) continue;
+                for (std::size_t c = node.first_child + node.n_children; c-- > node.first_child;) stack.push_back(c);
+            }
+        }
+
+        void append(const OctreeNode &node, std::vector<std::size_t> &result) const {
+            result.insert(result.end(), _permutation.begin() + static_cast<std::ptrdiff_t>(node.begin),
+                          _permutation.begin() + static_cast<std::ptrdiff_t>(node.end));
+        }
+
+        Real distance2(const Vector3D<Real> &point, std::size_t p) const {
+            const Real dx = _points.x()[p] - point.x();
+            const Real dy = _points.y()[p] - point.y();
+            const Real dz = _points.z()[p] - point.z();
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        static Real box_distance2(const Vector3D<Real> &point, const Vector3D<Real> &lo, const Vector3D<Real> &hi) {
+            auto axis = [](const Real &x, const Real &l, const Real &h) {
+                const Real d = x < l ? l - x : (x > h ? x - h : Real(0));
+                return d * d;
+            };
+            return axis(point.x(), lo.x(), hi.x()) + axis(point.y(), lo.y(), hi.y()) + axis(point.z(), lo.z(), hi.z());
+        }
+
+        static Real box_farthest2(const Vector3D<Real> &point, const Vector3D<Real> &lo, const Vector3D<Real> &hi) {
+            auto axis = [](const Real &x, const Real &l, const Real &h) {
+                const Real d = std::max(x - l, h - x);
+                return d * d;
+            };
+            return axis(point.x(), lo.x(), hi.x()) + axis(point.y(), lo.y(), hi.y()) + axis(point.z(), lo.z(), hi.z());
+        }
+
+        /**
+         * Best-first search: nodes are expanded in order of their distance from the query point while a max-heap
+         * keeps the k best candidates, until the nearest unexpanded node is farther than the k-th candidate.
+         */
+        void nearest_into(const Vector3D<Real> &point, std::size_t k, std::size_t *indices, Real *distances,
+                          Scratch &scratch) const {
+
+            using std::sqrt;
+
+            if (k == 0) return;
+
+            auto farther = [](const auto &a, const auto &b) { return a.first > b.first; };
+            auto &nodes = scratch.nodes;
+            auto &best = scratch.best;
+            nodes.clear();
+            best.clear();
+
+            nodes.emplace_back(Real(0), 0);
+            while (!nodes.empty()) {
+
+                std::pop_heap(nodes.begin(), nodes.end(), farther);
+                const auto [d2, index] = nodes.back();
+                nodes.pop_back();
+                if (best.size() == k && d2 > best.front().first) break;
+
+                const OctreeNode &node = _nodes[index];
+                if (node.is_leaf()) {
+                    for (std::size_t p = node.begin; p < node.end; ++p) {
+                        const std::pair<Real, std::size_t> candidate(distance2(point, p), _permutation[p]);
+                        if (best.size() < k) {
+                            best.push_back(candidate);
+                            std::push_heap(best.begin(), best.end());
+                        } else if (candidate < best.front()) {
+                            std::pop_heap(best.begin(), best.end());
+                            best.back() = candidate;
+                            std::push_heap(best.begin(), best.end());
+                        }
+                    }
+                    continue;
+                }
+
+                for (std::size_t c = node.first_child; c < node.first_child + node.n_children; ++c) {
+                    const Real cd2 = box_distance2(point, lower_corner(_nodes[c]), upper_corner(_nodes[c]));
+                    if (best.size() == k && cd2 > best.front().first) continue;
+                    nodes.emplace_back(cd2, c);
+                    std::push_heap(nodes.begin(), nodes.end(), farther);
+                }
+
+            }
+
+            std::sort_heap(best.begin(), best.end());
+            for (std::size_t i = 0; i < k; ++i) {
+                indices[i] = best[i].second;
+                distances[i] = sqrt(best[i].first);
+            }
+
+        }
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
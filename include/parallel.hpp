@@ -0,0 +1,88 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Retrieve the number of threads used by batch kernels when the caller does not specify one.
+     * @return the number of hardware threads (at least one).
+     */
+    inline std::size_t default_thread_count() {
+
+        unsigned int n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : static_cast<std::size_t>(n);
+
+    }
+
+    /**
+     * Split the index range [begin, end) into (at most) `n_threads` contiguous chunks and process each chunk on its
+     * own thread. The callable receives the chunk bounds and the index of the chunk so that it can address
+     * per-thread scratch or accumulation storage; the calling thread processes the first chunk itself. If any chunk
+     * throws, the first exception is re-thrown once all threads have joined.
+     * @tparam Fn callable with signature void(std::size_t chunk_begin, std::size_t chunk_end, std::size_t thread).
+     * @param begin the first index.
+     * @param end one past the last index.
+     * @param fn the callable.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @param min_chunk the minimum number of indices per thread, small ranges run on fewer threads.
+     * @return the number of chunks (i.e. threads) actually used.
+     */
+    template<typename Fn>
+    std::size_t parallel_for(std::size_t begin, std::size_t end, Fn fn, std::size_t n_threads = 0,
+                             std::size_t min_chunk = 1024) {
+
+        if (end <= begin) return 0;
+
+        const std::size_t n = end - begin;
+        if (n_threads == 0) n_threads = default_thread_count();
+        n_threads = std::max<std::size_t>(1, std::min(n_threads, (n + min_chunk - 1) / std::max<std::size_t>(1, min_chunk)));
+
+        if (n_threads == 1) {
+            fn(begin, end, std::size_t(0));
+            return 1;
+        }
+
+        const std::size_t chunk = (n + n_threads - 1) / n_threads;
+
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto guarded = [&](std::size_t b, std::size_t e, std::size_t t) {
+            try {
+                fn(b, e, t);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(n_threads - 1);
+        for (std::size_t t = 1; t < n_threads; ++t) {
+            std::size_t b = begin + t * chunk;
+            std::size_t e = std::min(end, b + chunk);
+            if (b >= e) break;
+            threads.emplace_back(guarded, b, e, t);
+        }
+
+        guarded(begin, std::min(end, begin + chunk), 0);
+
+        for (std::thread &thread: threads) thread.join();
+
+        if (error) std::rethrow_exception(error);
+
+        return threads.size() + 1;
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
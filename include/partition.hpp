@@ -0,0 +1,761 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * An undirected graph in compressed sparse row form with vertex and edge weights; every edge is stored in both
+     * directions.
+     */
+    struct CsrGraph {
+
+        /** The start of each vertex's adjacency in `adjacency` and `edge_weights`, n_vertices() + 1 entries. */
+        std::vector<std::size_t> offsets;
+
+        /** The neighbours of each vertex. */
+        std::vector<std::size_t> adjacency;
+
+        /** The weight of each vertex. */
+        std::vector<std::size_t> vertex_weights;
+
+        /** The weight of each stored edge. */
+        std::vector<std::size_t> edge_weights;
+
+        /**
+         * Retrieve the number of vertices.
+         * @return the number of vertices.
+         */
+        [[nodiscard]] inline std::size_t n_vertices() const { return vertex_weights.size(); }
+
+        /**
+         * Retrieve the total vertex weight.
+         * @return the sum of the vertex weights.
+         */
+        [[nodiscard]] inline std::size_t total_weight() const {
+            return std::accumulate(vertex_weights.begin(), vertex_weights.end(), std::size_t(0));
+        }
+
+    };
+
+    /**
+     * Build the dual graph of a tetrahedral mesh: one graph vertex per element and one unit weight edge between every
+     * pair of elements sharing a face.
+     * @param tetrahedra the four vertex indices of each tetrahedron.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the dual graph.
+     */
+    inline CsrGraph element_dual_graph(const std::vector<std::array<std::size_t, 4>> &tetrahedra,
+                                       std::size_t n_threads = 0) {
+
+        const std::size_t n = tetrahedra.size();
+
+        // Interior faces appear twice among the sorted (face vertices, element) keys.
+        std::vector<std::array<std::size_t, 4>> faces(4 * n);
+        parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t e = begin; e < end; ++e) {
+                for (std::size_t f = 0; f < 4; ++f) {
+                    std::array<std::size_t, 4> key = {tetrahedra[e][(f + 1) % 4], tetrahedra[e][(f + 2) % 4],
+                                                      tetrahedra[e][(f + 3) % 4], e};
+                    std::sort(key.begin(), key.begin() + 3);
+                    faces[4 * e + f] = key;
+                }
+            }
+        }, n_threads);
+        std::sort(faces.begin(), faces.end());
+
+        CsrGraph graph;
+        graph.offsets.assign(n + 1, 0);
+        std::vector<std::array<std::size_t, 2>> pairs;
+        for (std::size_t k = 0; k + 1 < faces.size(); ++k) {
+            if (faces[k][0] == faces[k + 1][0] && faces[k][1] == faces[k + 1][1] && faces[k][2] == faces[k + 1][2]) {
+                pairs.push_back({faces[k][3], faces[k + 1][3]});
+                ++graph.offsets[faces[k][3] + 1];
+                ++graph.offsets[faces[k + 1][3] + 1];
+                ++k;
+            }
+        }
+        for (std::size_t e = 0; e < n; ++e) graph.offsets[e + 1] += graph.offsets[e];
+        graph.adjacency.resize(graph.offsets[n]);
+        std::vector<std::size_t> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+        for (const auto &p: pairs) {
+            graph.adjacency[fill[p[0]]++] = p[1];
+            graph.adjacency[fill[p[1]]++] = p[0];
+        }
+        graph.vertex_weights.assign(n, 1);
+        graph.edge_weights.assign(graph.adjacency.size(), 1);
+        return graph;
+
+    }
+
+    /**
+     * Options of the multilevel k-way partitioner.
+     */
+    struct PartitionOptions {
+
+        /** The largest permitted ratio of a part's weight to the average part weight. */
+        double imbalance = 1.03;
+
+        /** Coarsening stops once the graph has at most this many vertices per part. */
+        std::size_t coarsest_vertices_per_part = 20;
+
+        /** The maximum number of refinement passes per level. */
+        std::size_t refinement_passes = 10;
+
+    };
+
+    namespace detail {
+
+        /**
+         * A fixed pseudo random visiting order, so that partitions are reproducible.
+         */
+        inline std::vector<std::size_t> partition_visit_order(std::size_t n) {
+            std::vector<std::size_t> order(n);
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+            for (std::size_t i = n; i > 1; --i) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                std::swap(order[i - 1], order[state % i]);
+            }
+            return order;
+        }
+
+        /**
+         * Contract a graph by heavy-edge matching: every unmatched vertex, visited in a fixed random order, is merged
+         * with the unmatched neighbour joined to it by the heaviest edge.
+         * @param graph the fine graph.
+         * @param map the output coarse vertex of each fine vertex.
+         * @return the coarse graph, whose edge weights are the sums of the fine edges between merged vertices.
+         */
+        inline CsrGraph heavy_edge_contraction(const CsrGraph &graph, std::vector<std::size_t> &map) {
+
+            const std::size_t n = graph.n_vertices();
+            constexpr std::size_t unmatched = std::numeric_limits<std::size_t>::max();
+
+            std::vector<std::size_t> match(n, unmatched);
+            for (std::size_t u: partition_visit_order(n)) {
+                if (match[u] != unmatched) continue;
+                std::size_t best = u, best_weight = 0;
+                for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+                    const std::size_t v = graph.adjacency[k];
+                    if (match[v] == unmatched && v != u && graph.edge_weights[k] > best_weight) {
+                        best = v;
+                        best_weight = graph.edge_weights[k];
+                    }
+                }
+                match[u] = best;
+                match[best] = u;
+            }
+
+            map.assign(n, unmatched);
+            std::size_t n_coarse = 0;
+            for (std::size_t u = 0; u < n; ++u) {
+                if (map[u] != unmatched) continue;
+                map[u] = n_coarse;
+                map[match[u]] = n_coarse;
+                ++n_coarse;
+            }
+
+            CsrGraph coarse;
+            coarse.offsets.assign(n_coarse + 1, 0);
+            coarse.vertex_weights.assign(n_coarse, 0);
+            std::vector<std::size_t> members(2 * n_coarse, unmatched);
+            for (std::size_t u = 0; u < n; ++u) {
+                coarse.vertex_weights[map[u]] += graph.vertex_weights[u];
+                members[2 * map[u] + (members[2 * map[u]] == unmatched ? 0 : 1)] = u;
+            }
+
+            // Merge the adjacency of the members, summing parallel edges and dropping the internal one.
+            std::vector<std::size_t> position(n_coarse, unmatched);
+            for (std::size_t c = 0; c < n_coarse; ++c) {
+                const std::size_t first = coarse.adjacency.size();
+                for (std::size_t m = 0; m < 2; ++m) {
+                    const std::size_t u = members[2 * c + m];
+                    if (u == unmatched) continue;
+                    for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+                        const std::size_t d = map[graph.adjacency[k]];
+                        if (d == c) continue;
+                        if (position[d] == unmatched || position[d] < first) {
+                            position[d] = coarse.adjacency.size();
+                            coarse.adjacency.push_back(d);
+                            coarse.edge_weights.push_back(graph.edge_weights[k]);
+                        } else {
+                            coarse.edge_weights[position[d]] += graph.edge_weights[k];
+                        }
+                    }
+                }
+                coarse.offsets[c + 1] = coarse.adjacency.size();
+            }
+
+            return coarse;
+
+        }
+
+        /**
+         * Split the vertices carrying label `part` into labels `part` and `part + left_parts` by greedy graph
+         * growing: starting from a pseudo-peripheral vertex the region grows, always by the boundary vertex most
+         * strongly connected to it, until it holds the share of the weight of `left_parts` out of `parts`. Then
+         * recurse on both sides.
+         */
+        inline void recursive_bisection(const CsrGraph &graph, std::vector<std::size_t> &labels,
+                                        const std::vector<std::size_t> &vertices, std::size_t first_part,
+                                        std::size_t parts) {
+
+            if (parts <= 1 || vertices.empty()) {
+                for (std::size_t v: vertices) labels[v] = first_part;
+                return;
+            }
+
+            const std::size_t left_parts = parts / 2;
+            std::size_t total = 0;
+            for (std::size_t v: vertices) {
+                labels[v] = first_part;
+                total += graph.vertex_weights[v];
+            }
+            const std::size_t target = (total * left_parts + parts / 2) / parts;
+
+            // A pseudo-peripheral start: the last vertex reached by a breadth first search within the set.
+            auto farthest = [&](std::size_t start) {
+                std::vector<std::size_t> queue = {start};
+                std::vector<char> seen(graph.n_vertices(), 0);
+                seen[start] = 1;
+                for (std::size_t q = 0; q < queue.size(); ++q) {
+                    const std::size_t u = queue[q];
+                    for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+                        const std::size_t v = graph.adjacency[k];
+                        if (!seen[v] && labels[v] == first_part) {
+                            seen[v] = 1;
+                            queue.push_back(v);
+                        }
+                    }
+                }
+                return queue.back();
+            };
+            const std::size_t start = farthest(farthest(vertices.front()));
+
+            // Grow the left region by the largest connectivity to it; disconnected sets restart anywhere. The region
+            // is marked with a label no part uses.
+            const std::size_t left = std::numeric_limits<std::size_t>::max();
+            std::vector<std::size_t> connectivity(graph.n_vertices(), 0);
+            std::vector<std::size_t> frontier;
+            std::size_t grown = 0, next_seed = 0;
+            auto add = [&](std::size_t u) {
+                labels[u] = left;
+                grown += graph.vertex_weights[u];
+                for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+                    const std::size_t v = graph.adjacency[k];
+                    if (labels[v] != first_part) continue;
+                    if (connectivity[v] == 0) frontier.push_back(v);
+                    connectivity[v] += graph.edge_weights[k];
+                }
+            };
+            add(start);
+            while (grown < target) {
+                std::size_t best = graph.n_vertices(), best_index = 0;
+                for (std::size_t f = 0; f < frontier.size(); ++f) {
+                    const std::size_t v = frontier[f];
+                    if (labels[v] != first_part) continue;
+                    if (best == graph.n_vertices() || connectivity[v] > connectivity[best]) {
+                        best = v;
+                        best_index = f;
+                    }
+                }
+                if (best == graph.n_vertices()) {
+                    while (next_seed < vertices.size() && labels[vertices[next_seed]] != first_part) ++next_seed;
+                    if (next_seed == vertices.size()) break;
+                    best = vertices[next_seed];
+                } else {
+                    frontier[best_index] = frontier.back();
+                    frontier.pop_back();
+                }
+                add(best);
+            }
+
+            std::vector<std::size_t> lower, upper;
+            for (std::size_t v: vertices) {
+                if (labels[v] == left) {
+                    labels[v] = first_part;
+                    lower.push_back(v);
+                } else {
+                    labels[v] = first_part + left_parts;
+                    upper.push_back(v);
+                }
+            }
+            recursive_bisection(graph, labels, lower, first_part, left_parts);
+            recursive_bisection(graph, labels, upper, first_part + left_parts, parts - left_parts);
+
+        }
+
+        /**
+         * Greedy k-way refinement: boundary vertices move to the neighbouring part with the largest reduction of the
+         * edge cut, provided the balance constraint allows; vertices of over-weight parts may also move with zero or
+         * negative gain to restore balance.
+         */
+        inline void kway_refinement(const CsrGraph &graph, std::vector<std::size_t> &parts, std::size_t n_parts,
+                                    const PartitionOptions &options) {
+
+            const std::size_t n = graph.n_vertices();
+            std::vector<std::size_t> weights(n_parts, 0);
+            for (std::size_t v = 0; v < n; ++v) weights[parts[v]] += graph.vertex_weights[v];
+            const double average = static_cast<double>(graph.total_weight()) / static_cast<double>(n_parts);
+            std::size_t max_weight = static_cast<std::size_t>(std::floor(options.imbalance * average));
+            max_weight = std::max(max_weight, static_cast<std::size_t>(std::ceil(average)));
+
+            std::vector<std::size_t> connection(n_parts, 0);
+            std::vector<std::size_t> touched;
+            const std::vector<std::size_t> order = partition_visit_order(n);
+
+            for (std::size_t pass = 0; pass < options.refinement_passes; ++pass) {
+                std::size_t moves = 0;
+                for (std::size_t u: order) {
+                    const std::size_t own = parts[u];
+                    touched.clear();
+                    for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+                        const std::size_t p = parts[graph.adjacency[k]];
+                        if (connection[p] == 0) touched.push_back(p);
+                        connection[p] += graph.edge_weights[k];
+                    }
+                    const std::size_t w = graph.vertex_weights[u];
+                    const bool overweight = weights[own] > max_weight;
+                    std::size_t best = own;
+                    long best_gain = 0;
+                    for (std::size_t p: touched) {
+                        if (p == own || weights[p] + w > max_weight) continue;
+                        const long gain = static_cast<long>(connection[p]) - static_cast<long>(connection[own]);
+                        bool better;
+                        if (best == own) {
+                            better = gain > 0 || (gain == 0 && weights[p] + w < weights[own]) || overweight;
+                        } else {
+                            better = gain > best_gain || (gain == best_gain && weights[p] < weights[best]);
+                        }
+                        if (better) {
+                            best = p;
+                            best_gain = gain;
+                        }
+                    }
+                    for (std::size_t p: touched) connection[p] = 0;
+                    if (best == own) continue;
+                    parts[u] = best;
+                    weights[own] -= w;
+                    weights[best] += w;
+                    ++moves;
+                }
+                if (moves == 0) break;
+            }
+
+            // Parts that are still over-weight shed vertices to the lightest part, if need be off the boundary.
+            for (std::size_t u: order) {
+                const std::size_t own = parts[u];
+                if (weights[own] <= max_weight) continue;
+                const std::size_t lightest = static_cast<std::size_t>(
+                        std::min_element(weights.begin(), weights.end()) - weights.begin());
+                const std::size_t w = graph.vertex_weights[u];
+                if (weights[lightest] + w > max_weight) continue;
+                parts[u] = lightest;
+                weights[own] -= w;
+                weights[lightest] += w;
+            }
+
+        }
+
+        /**
+         * A k-way Fiduccia-Mattheyses pass with hill climbing: boundary vertices are moved one at a time, always the
+         * unlocked vertex with the largest gain, even when the gain is negative, as long as the balance constraint
+         * holds; each vertex moves at most once per pass. The pass stops after a run of moves without improvement
+         * and is rolled back to the prefix of moves with the smallest cut. Passes repeat while they improve the cut.
+         */
+        inline void kway_fm_refinement(const CsrGraph &graph, std::vector<std::size_t> &parts, std::size_t n_parts,
+                                       const PartitionOptions &options) {
+
+            const std::size_t n = graph.n_vertices();
+            std::vector<std::size_t> weights(n_parts, 0);
+            for (std::size_t v = 0; v < n; ++v) weights[parts[v]] += graph.vertex_weights[v];
+            const double average = static_cast<double>(graph.total_weight()) / static_cast<double>(n_parts);
+            std::size_t max_weight = static_cast<std::size_t>(std::floor(options.imbalance * average));
+            max_weight = std::max(max_weight, static_cast<std::size_t>(std::ceil(average)));
+            const std::size_t patience = std::max<std::size_t>(50, n / 100);
+
+            std::vector<long> connection(n_parts, 0);
+            std::vector<std::size_t> touched;
+
+            // The best admissible move of u as (gain, target), target == n_parts if there is none.
+            auto best_move = [&](std::size_t u) {
+                const std::size_t own = parts[u];
+                touched.clear();
+                for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+                    const std::size_t p = parts[graph.adjacency[k]];
+                    if (connection[p] == 0) touched.push_back(p);
+                    connection[p] += static_cast<long>(graph.edge_weights[k]);
+                }
+                long best_gain = 0;
+                std::size_t target = n_parts;
+                for (std::size_t p: touched) {
+                    if (p == own || weights[p] + graph.vertex_weights[u] > max_weight) continue;
+                    const long gain = connection[p] - connection[own];
+                    if (target == n_parts || gain > best_gain || (gain == best_gain && weights[p] < weights[target])) {
+                        best_gain = gain;
+                        target = p;
+                    }
+                }
+                connection[own] = 0;
+                for (std::size_t p: touched) connection[p] = 0;
+                return std::make_pair(best_gain, target);
+            };
+
+            std::vector<char> locked(n);
+            std::vector<std::size_t> version(n);
+            std::vector<std::pair<std::size_t, std::size_t>> log;
+
+            for (std::size_t pass = 0; pass < options.refinement_passes; ++pass) {
+
+                std::fill(locked.begin(), locked.end(), 0);
+                std::priority_queue<std::tuple<long, std::size_t, std::size_t>> heap;
+                for (std::size_t u = 0; u < n; ++u) {
+                    auto [gain, target] = best_move(u);
+                    if (target != n_parts) heap.emplace(gain, version[u], u);
+                }
+
+                log.clear();
+                long total = 0, best_total = 0;
+                std::size_t best_length = 0;
+                while (!heap.empty()) {
+                    auto [queued_gain, queued_version, u] = heap.top();
+                    heap.pop();
+                    if (locked[u] || queued_version != version[u]) continue;
+                    auto [gain, target] = best_move(u);
+                    if (target == n_parts) continue;
+                    if (gain != queued_gain) {
+                        heap.emplace(gain, ++version[u], u);
+                        continue;
+                    }
+
+                    log.emplace_back(u, parts[u]);
+                    weights[parts[u]] -= graph.vertex_weights[u];
+                    weights[target] += graph.vertex_weights[u];
+                    parts[u] = target;
+                    locked[u] = 1;
+                    total += gain;
+                    if (total > best_total) {
+                        best_total = total;
+                        best_length = log.size();
+                    } else if (log.size() - best_length > patience) {
+                        break;
+                    }
+
+                    for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+                        const std::size_t v = graph.adjacency[k];
+                        if (locked[v]) continue;
+                        auto [v_gain, v_target] = best_move(v);
+                        ++version[v];
+                        if (v_target != n_parts) heap.emplace(v_gain, version[v], v);
+                    }
+                }
+
+                while (log.size() > best_length) {
+                    const auto [u, from] = log.back();
+                    log.pop_back();
+                    weights[parts[u]] -= graph.vertex_weights[u];
+                    weights[from] += graph.vertex_weights[u];
+                    parts[u] = from;
+                }
+                if (best_total == 0) break;
+
+            }
+
+        }
+
+    } // namespace detail
+
+    /**
+     * Partition a graph into k parts of (nearly) equal weight with few cut edges by the multilevel scheme: the graph
+     * is coarsened by heavy-edge matching, the coarsest graph is partitioned by recursive greedy graph growing and
+     * the partition is projected back level by level. At each level a greedy pass first restores the balance and
+     * takes the moves of positive gain, then k-way Fiduccia-Mattheyses passes climb out of local minima. The result
+     * is reproducible.
+     * @param graph the graph.
+     * @param n_parts the number of parts.
+     * @param options the partitioner options.
+     * @return the part of each graph vertex.
+     */
+    inline std::vector<std::size_t> partition_graph(const CsrGraph &graph, std::size_t n_parts,
+                                                    const PartitionOptions &options = PartitionOptions()) {
+
+        if (n_parts == 0) throw std::invalid_argument("partition_graph: the number of parts must be positive");
+        if (n_parts == 1) return std::vector<std::size_t>(graph.n_vertices(), 0);
+
+        std::vector<CsrGraph> levels;
+        std::vector<std::vector<std::size_t>> maps;
+        const CsrGraph *current = &graph;
+        const std::size_t coarsest = std::max<std::size_t>(n_parts * options.coarsest_vertices_per_part, 2 * n_parts);
+        while (current->n_vertices() > coarsest) {
+            std::vector<std::size_t> map;
+            CsrGraph coarse = detail::heavy_edge_contraction(*current, map);
+            if (10 * coarse.n_vertices() > 9 * current->n_vertices()) break;
+            maps.push_back(std::move(map));
+            levels.push_back(std::move(coarse));
+            current = &levels.back();
+        }
+
+        std::vector<std::size_t> parts(current->n_vertices(), 0);
+        std::vector<std::size_t> all(current->n_vertices());
+        std::iota(all.begin(), all.end(), std::size_t(0));
+        detail::recursive_bisection(*current, parts, all, 0, n_parts);
+        detail::kway_refinement(*current, parts, n_parts, options);
+        detail::kway_fm_refinement(*current, parts, n_parts, options);
+
+        for (std::size_t level = levels.size(); level-- > 0;) {
+            const CsrGraph &fine = level == 0 ? graph : levels[level - 1];
+            std::vector<std::size_t> projected(fine.n_vertices());
+            for (std::size_t v = 0; v < fine.n_vertices(); ++v) projected[v] = parts[maps[level][v]];
+            parts.swap(projected);
+            detail::kway_refinement(fine, parts, n_parts, options);
+            detail::kway_fm_refinement(fine, parts, n_parts, options);
+        }
+
+        return parts;
+
+    }
+
+    /**
+     * Partition the elements of a tetrahedral mesh by recursive coordinate bisection of their centres (from
+     * tetrahedron_center()): each set is split across its longest extent, at the element count proportional to the
+     * number of parts on either side. Cheap and robust, but with larger interfaces than partition_mesh().
+     * @param mesh the tetrahedral mesh.
+     * @param n_parts the number of parts.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the part of each element.
+     */
+    template<typename Real>
+    std::vector<std::size_t> coordinate_bisection(const TetrahedralMesh<Real> &mesh, std::size_t n_parts,
+                                                  std::size_t n_threads = 0) {
+
+        if (n_parts == 0) throw std::invalid_argument("coordinate_bisection: the number of parts must be positive");
+
+        const std::size_t n = mesh.n_tetrahedra();
+        Vector3DSoA<Real> centres(n);
+        parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t e = begin; e < end; ++e) {
+                const auto &t = mesh.tetrahedra[e];
+                centres.set(e, tetrahedron_center(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                                  mesh.vertices[t[2]], mesh.vertices[t[3]]));
+            }
+        }, n_threads);
+
+        std::vector<std::size_t> order(n);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::vector<std::size_t> parts(n, 0);
+        const Real *coordinates[3] = {centres.x(), centres.y(), centres.z()};
+
+        auto bisect = [&](auto &&self, std::size_t begin, std::size_t end, std::size_t first_part,
+                          std::size_t count) -> void {
+            if (count == 1 || end - begin <= 1) {
+                for (std::size_t k = begin; k < end; ++k) parts[order[k]] = first_part;
+                return;
+            }
+            std::size_t axis = 0;
+            Real best_extent = Real(-1);
+            for (std::size_t a = 0; a < 3; ++a) {
+                Real lo = coordinates[a][order[begin]], hi = lo;
+                for (std::size_t k = begin; k < end; ++k) {
+                    const Real c = coordinates[a][order[k]];
+                    if (c < lo) lo = c;
+                    if (c > hi) hi = c;
+                }
+                if (hi - lo > best_extent) {
+                    best_extent = hi - lo;
+                    axis = a;
+                }
+            }
+            const std::size_t left_parts = count / 2;
+            const std::size_t middle = begin + ((end - begin) * left_parts + count / 2) / count;
+            std::nth_element(order.begin() + static_cast<std::ptrdiff_t>(begin),
+                             order.begin() + static_cast<std::ptrdiff_t>(middle),
+                             order.begin() + static_cast<std::ptrdiff_t>(end),
+                             [&](std::size_t a, std::size_t b) { return coordinates[axis][a] < coordinates[axis][b]; });
+            self(self, begin, middle, first_part, left_parts);
+            self(self, middle, end, first_part + left_parts, count - left_parts);
+        };
+        bisect(bisect, 0, n, 0, n_parts);
+
+        return parts;
+
+    }
+
+    /**
+     * Partition the elements of a tetrahedral mesh with the multilevel k-way partitioner applied to its dual graph.
+     * @param mesh the tetrahedral mesh.
+     * @param n_parts the number of parts.
+     * @param options the partitioner options.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the part of each element.
+     */
+    template<typename Real>
+    std::vector<std::size_t> partition_mesh(const TetrahedralMesh<Real> &mesh, std::size_t n_parts,
+                                            const PartitionOptions &options = PartitionOptions(),
+                                            std::size_t n_threads = 0) {
+
+        return partition_graph(element_dual_graph(mesh.tetrahedra, n_threads), n_parts, options);
+
+    }
+
+    /**
+     * Compute the edge cut of a partition, i.e. the total weight of the edges joining different parts.
+     * @param graph the graph.
+     * @param parts the part of each graph vertex.
+     * @return the edge cut.
+     */
+    inline std::size_t edge_cut(const CsrGraph &graph, const std::vector<std::size_t> &parts) {
+
+        std::size_t cut = 0;
+        for (std::size_t u = 0; u < graph.n_vertices(); ++u) {
+            for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+                if (parts[u] != parts[graph.adjacency[k]]) cut += graph.edge_weights[k];
+            }
+        }
+        return cut / 2;
+
+    }
+
+    /**
+     * The elements of one part of a partitioned tetrahedral mesh together with its ghost layers, as a self-contained
+     * mesh with local numbering: the owned elements come first and the ghost elements follow layer by layer; the
+     * vertices of owned elements come first and the vertices only touched by ghost elements follow.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct Subdomain {
+
+        /** The local mesh. */
+        TetrahedralMesh<Real> mesh;
+
+        /** The global index of each local element. */
+        std::vector<std::size_t> global_elements;
+
+        /** The global index of each local vertex. */
+        std::vector<std::size_t> global_vertices;
+
+        /** The number of owned elements, the leading entries of the local mesh. */
+        std::size_t n_owned_elements = 0;
+
+        /** The number of vertices of owned elements, the leading local vertices. */
+        std::size_t n_interior_vertices = 0;
+
+    };
+
+    /**
+     * Collect the ghost layers of one part: the first layer holds the elements of other parts sharing a vertex with
+     * the part, each further layer the elements sharing a vertex with the previous layers.
+     * @param tetrahedra the four vertex indices of each tetrahedron.
+     * @param n_vertices the number of vertices.
+     * @param parts the part of each element.
+     * @param part the part.
+     * @param layers the number of ghost layers.
+     * @return the ghost elements, layer by layer in ascending order within each layer.
+     */
+    inline std::vector<std::size_t> halo_elements(const std::vector<std::array<std::size_t, 4>> &tetrahedra,
+                                                  std::size_t n_vertices, const std::vector<std::size_t> &parts,
+                                                  std::size_t part, std::size_t layers = 1) {
+
+        std::vector<std::size_t> offsets(n_vertices + 1, 0);
+        for (const auto &t: tetrahedra) for (std::size_t v: t) ++offsets[v + 1];
+        for (std::size_t i = 0; i < n_vertices; ++i) offsets[i + 1] += offsets[i];
+        std::vector<std::size_t> incidence(offsets[n_vertices]);
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t e = 0; e < tetrahedra.size(); ++e) for (std::size_t v: tetrahedra[e]) incidence[fill[v]++] = e;
+
+        std::vector<char> in_set(tetrahedra.size(), 0), marked(n_vertices, 0);
+        std::vector<std::size_t> front;
+        for (std::size_t e = 0; e < tetrahedra.size(); ++e) {
+            if (parts[e] == part) {
+                in_set[e] = 1;
+                front.push_back(e);
+            }
+        }
+
+        std::vector<std::size_t> halo;
+        for (std::size_t layer = 0; layer < layers; ++layer) {
+            std::vector<std::size_t> next;
+            for (std::size_t e: front) {
+                for (std::size_t v: tetrahedra[e]) {
+                    if (marked[v]) continue;
+                    marked[v] = 1;
+                    for (std::size_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+                        if (!in_set[incidence[k]]) {
+                            in_set[incidence[k]] = 1;
+                            next.push_back(incidence[k]);
+                        }
+                    }
+                }
+            }
+            std::sort(next.begin(), next.end());
+            halo.insert(halo.end(), next.begin(), next.end());
+            front.swap(next);
+        }
+        return halo;
+
+    }
+
+    /**
+     * Extract one part of a partitioned tetrahedral mesh together with its ghost layers.
+     * @param mesh the tetrahedral mesh.
+     * @param parts the part of each element.
+     * @param part the part.
+     * @param layers the number of ghost layers.
+     * @return the subdomain.
+     */
+    template<typename Real>
+    Subdomain<Real> extract_subdomain(const TetrahedralMesh<Real> &mesh, const std::vector<std::size_t> &parts,
+                                      std::size_t part, std::size_t layers = 1) {
+
+        Subdomain<Real> subdomain;
+        for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) {
+            if (parts[e] == part) subdomain.global_elements.push_back(e);
+        }
+        subdomain.n_owned_elements = subdomain.global_elements.size();
+        const std::vector<std::size_t> halo = halo_elements(mesh.tetrahedra, mesh.n_vertices(), parts, part, layers);
+        subdomain.global_elements.insert(subdomain.global_elements.end(), halo.begin(), halo.end());
+
+        constexpr std::size_t absent = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> local(mesh.n_vertices(), absent);
+        for (std::size_t k = 0; k < subdomain.global_elements.size(); ++k) {
+            if (k == subdomain.n_owned_elements) subdomain.n_interior_vertices = subdomain.global_vertices.size();
+            std::array<std::size_t, 4> t = mesh.tetrahedra[subdomain.global_elements[k]];
+            for (std::size_t &v: t) {
+                if (local[v] == absent) {
+                    local[v] = subdomain.global_vertices.size();
+                    subdomain.global_vertices.push_back(v);
+                    subdomain.mesh.vertices.push_back(mesh.vertices[v]);
+                }
+                v = local[v];
+            }
+            subdomain.mesh.tetrahedra.push_back(t);
+        }
+        if (halo.empty()) subdomain.n_interior_vertices = subdomain.global_vertices.size();
+        return subdomain;
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
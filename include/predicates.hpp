@@ -0,0 +1,316 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <vector3d.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    namespace detail {
+
+        /**
+         * Exact arithmetic on expansions: sums of non-overlapping doubles ordered by increasing magnitude, with zero
+         * components eliminated (Shewchuk, Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+         * Predicates, 1997). Products are formed with fused multiply-adds instead of Dekker's splitting.
+         */
+        using Expansion = std::vector<double>;
+
+        inline void two_sum(double a, double b, double &x, double &y) {
+            x = a + b;
+            const double b_virtual = x - a;
+            const double a_virtual = x - b_virtual;
+            y = (a - a_virtual) + (b - b_virtual);
+        }
+
+        inline void fast_two_sum(double a, double b, double &x, double &y) {
+            x = a + b;
+            y = b - (x - a);
+        }
+
+        inline Expansion exact_difference(double a, double b) {
+            double x, y;
+            two_sum(a, -b, x, y);
+            Expansion e;
+            if (y != 0.0) e.push_back(y);
+            if (x != 0.0) e.push_back(x);
+            return e;
+        }
+
+        /**
+         * The sum of two expansions (fast_expansion_sum_zeroelim).
+         */
+        inline Expansion expansion_sum(const Expansion &e, const Expansion &f) {
+
+            if (e.empty()) return f;
+            if (f.empty()) return e;
+
+            Expansion h;
+            h.reserve(e.size() + f.size());
+            std::size_t i = 0, j = 0;
+            double q, q_new, h_component;
+            auto next = [&]() {
+                return (j >= f.size() || (i < e.size() && std::fabs(e[i]) < std::fabs(f[j]))) ? e[i++] : f[j++];
+            };
+            q = next();
+            if (i < e.size() || j < f.size()) {
+                fast_two_sum(next(), q, q_new, h_component);
+                q = q_new;
+                if (h_component != 0.0) h.push_back(h_component);
+                while (i < e.size() || j < f.size()) {
+                    two_sum(q, next(), q_new, h_component);
+                    q = q_new;
+                    if (h_component != 0.0) h.push_back(h_component);
+                }
+            }
+            if (q != 0.0 || h.empty()) h.push_back(q);
+            if (h.size() == 1 && h[0] == 0.0) h.clear();
+            return h;
+
+        }
+
+        inline Expansion expansion_negate(Expansion e) {
+            for (double &x: e) x = -x;
+            return e;
+        }
+
+        inline Expansion expansion_difference(const Expansion &e, const Expansion &f) {
+            return expansion_sum(e, expansion_negate(f));
+        }
+
+        /**
+         * The product of an expansion and a double (scale_expansion_zeroelim).
+         */
+        inline Expansion expansion_scale(const Expansion &e, double b) {
+
+            Expansion h;
+            if (e.empty() || b == 0.0) return h;
+            h.reserve(2 * e.size());
+            double q = e[0] * b;
+            double h_component = std::fma(e[0], b, -q);
+            if (h_component != 0.0) h.push_back(h_component);
+            for (std::size_t i = 1; i < e.size(); ++i) {
+                const double product = e[i] * b;
+                const double product_error = std::fma(e[i], b, -product);
+                double sum;
+                two_sum(q, product_error, sum, h_component);
+                if (h_component != 0.0) h.push_back(h_component);
+                fast_two_sum(product, sum, q, h_component);
+                if (h_component != 0.0) h.push_back(h_component);
+            }
+            if (q != 0.0) h.push_back(q);
+            return h;
+
+        }
+
+        inline Expansion expansion_product(const Expansion &e, const Expansion &f) {
+            Expansion h;
+            for (double x: f) h = expansion_sum(h, expansion_scale(e, x));
+            return h;
+        }
+
+        /**
+         * The sign of an expansion: that of its largest component.
+         */
+        inline int expansion_sign(const Expansion &e) {
+            if (e.empty()) return 0;
+            return e.back() > 0.0 ? 1 : (e.back() < 0.0 ? -1 : 0);
+        }
+
+        /**
+         * Shewchuk's orient3d determinant, in exact arithmetic.
+         */
+        inline int orient3d_exact(const Vector3D<double> &a, const Vector3D<double> &b, const Vector3D<double> &c,
+                                  const Vector3D<double> &d) {
+
+            const Expansion adx = exact_difference(a.x(), d.x()), ady = exact_difference(a.y(), d.y());
+            const Expansion adz = exact_difference(a.z(), d.z());
+            const Expansion bdx = exact_difference(b.x(), d.x()), bdy = exact_difference(b.y(), d.y());
+            const Expansion bdz = exact_difference(b.z(), d.z());
+            const Expansion cdx = exact_difference(c.x(), d.x()), cdy = exact_difference(c.y(), d.y());
+            const Expansion cdz = exact_difference(c.z(), d.z());
+
+            const Expansion bc = expansion_difference(expansion_product(bdx, cdy), expansion_product(cdx, bdy));
+            const Expansion ca = expansion_difference(expansion_product(cdx, ady), expansion_product(adx, cdy));
+            const Expansion ab = expansion_difference(expansion_product(adx, bdy), expansion_product(bdx, ady));
+
+            return expansion_sign(expansion_sum(expansion_sum(expansion_product(adz, bc), expansion_product(bdz, ca)),
+                                                expansion_product(cdz, ab)));
+
+        }
+
+        /**
+         * Shewchuk's insphere determinant, in exact arithmetic.
+         */
+        inline int insphere_exact(const Vector3D<double> &a, const Vector3D<double> &b, const Vector3D<double> &c,
+                                  const Vector3D<double> &d, const Vector3D<double> &e) {
+
+            const Expansion aex = exact_difference(a.x(), e.x()), aey = exact_difference(a.y(), e.y());
+            const Expansion aez = exact_difference(a.z(), e.z());
+            const Expansion bex = exact_difference(b.x(), e.x()), bey = exact_difference(b.y(), e.y());
+            const Expansion bez = exact_difference(b.z(), e.z());
+            const Expansion cex = exact_difference(c.x(), e.x()), cey = exact_difference(c.y(), e.y());
+            const Expansion cez = exact_difference(c.z(), e.z());
+            const Expansion dex = exact_difference(d.x(), e.x()), dey = exact_difference(d.y(), e.y());
+            const Expansion dez = exact_difference(d.z(), e.z());
+
+            auto minor = [](const Expansion &px, const Expansion &py, const Expansion &qx, const Expansion &qy) {
+                return expansion_difference(expansion_product(px, qy), expansion_product(qx, py));
+            };
+            const Expansion ab = minor(aex, aey, bex, bey), bc = minor(bex, bey, cex, cey);
+            const Expansion cd = minor(cex, cey, dex, dey), da = minor(dex, dey, aex, aey);
+            const Expansion ac = minor(aex, aey, cex, cey), bd = minor(bex, bey, dex, dey);
+
+            const Expansion abc = expansion_sum(expansion_difference(expansion_product(aez, bc),
+                                                                     expansion_product(bez, ac)),
+                                                expansion_product(cez, ab));
+            const Expansion bcd = expansion_sum(expansion_difference(expansion_product(bez, cd),
+                                                                     expansion_product(cez, bd)),
+                                                expansion_product(dez, bc));
+            const Expansion cda = expansion_sum(expansion_sum(expansion_product(cez, da), expansion_product(dez, ac)),
+                                                expansion_product(aez, cd));
+            const Expansion dab = expansion_sum(expansion_sum(expansion_product(dez, ab), expansion_product(aez, bd)),
+                                                expansion_product(bez, da));
+
+            auto lift = [](const Expansion &x, const Expansion &y, const Expansion &z) {
+                return expansion_sum(expansion_sum(expansion_product(x, x), expansion_product(y, y)),
+                                     expansion_product(z, z));
+            };
+            const Expansion alift = lift(aex, aey, aez), blift = lift(bex, bey, bez);
+            const Expansion clift = lift(cex, cey, cez), dlift = lift(dex, dey, dez);
+
+            return expansion_sign(expansion_sum(
+                    expansion_difference(expansion_product(dlift, abc), expansion_product(clift, dab)),
+                    expansion_difference(expansion_product(blift, cda), expansion_product(alift, bcd))));
+
+        }
+
+    } // namespace detail
+
+    /**
+     * Return the exact orientation of four points: +1 if tetrahedron_volume(a, b, c, d) is positive, i.e. d lies on
+     * the side of the plane through a, b and c to which triangle_normal(a, b, c) points, -1 if it is negative and 0
+     * if the points are coplanar. The determinant is evaluated in double precision and accepted when it exceeds
+     * Shewchuk's forward error bound; only nearly degenerate configurations are re-evaluated in exact arithmetic.
+     * @param a vector representing a point.
+     * @param b vector representing a point.
+     * @param c vector representing a point.
+     * @param d vector representing a point.
+     * @return the orientation.
+     */
+    inline int orient3d(const Vector3D<double> &a, const Vector3D<double> &b, const Vector3D<double> &c,
+                        const Vector3D<double> &d) {
+
+        constexpr double u = std::numeric_limits<double>::epsilon() / 2.0;
+        constexpr double bound = (7.0 + 56.0 * u) * u;
+
+        const double adx = a.x() - d.x(), ady = a.y() - d.y(), adz = a.z() - d.z();
+        const double bdx = b.x() - d.x(), bdy = b.y() - d.y(), bdz = b.z() - d.z();
+        const double cdx = c.x() - d.x(), cdy = c.y() - d.y(), cdz = c.z() - d.z();
+
+        const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        const double cdxady = cdx * ady, adxcdy = adx * cdy;
+        const double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+        const double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+        const double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz) +
+                                 (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz) +
+                                 (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+
+        // Shewchuk's determinant has the opposite sign to tetrahedron_volume().
+        if (det > bound * permanent) return -1;
+        if (-det > bound * permanent) return 1;
+        return -detail::orient3d_exact(a, b, c, d);
+
+    }
+
+    /**
+     * Return the orientation of four points, as orient3d() for doubles, evaluating the determinant in the arithmetic
+     * of Real. With 'mpreal' at a precision that holds the products of the coordinate differences (about 3 x 53 bits
+     * plus the spread of the exponents for coordinates given in double precision) the result is exact, which makes
+     * this the reference for validating the floating point predicates.
+     * @param a vector representing a point.
+     * @param b vector representing a point.
+     * @param c vector representing a point.
+     * @param d vector representing a point.
+     * @return the orientation.
+     */
+    template<typename Real>
+    int orient3d(const Vector3D<Real> &a, const Vector3D<Real> &b, const Vector3D<Real> &c, const Vector3D<Real> &d) {
+
+        const Real det = dot(cross(b - a, c - a), d - a);
+        return (det > Real(0)) - (det < Real(0));
+
+    }
+
+    /**
+     * Return the exact position of e relative to the sphere through a, b, c and d, which must have
+     * orient3d(a, b, c, d) > 0: +1 if e lies inside the sphere, -1 if it lies outside and 0 if it lies on it. As for
+     * orient3d(), the determinant is only re-evaluated in exact arithmetic when it is within its error bound.
+     * @param a vector representing a point.
+     * @param b vector representing a point.
+     * @param c vector representing a point.
+     * @param d vector representing a point.
+     * @param e the query point.
+     * @return the position of e.
+     */
+    inline int insphere(const Vector3D<double> &a, const Vector3D<double> &b, const Vector3D<double> &c,
+                        const Vector3D<double> &d, const Vector3D<double> &e) {
+
+        constexpr double u = std::numeric_limits<double>::epsilon() / 2.0;
+        constexpr double bound = (16.0 + 224.0 * u) * u;
+
+        const double aex = a.x() - e.x(), aey = a.y() - e.y(), aez = a.z() - e.z();
+        const double bex = b.x() - e.x(), bey = b.y() - e.y(), bez = b.z() - e.z();
+        const double cex = c.x() - e.x(), cey = c.y() - e.y(), cez = c.z() - e.z();
+        const double dex = d.x() - e.x(), dey = d.y() - e.y(), dez = d.z() - e.z();
+
+        const double aexbey = aex * bey, bexaey = bex * aey;
+        const double bexcey = bex * cey, cexbey = cex * bey;
+        const double cexdey = cex * dey, dexcey = dex * cey;
+        const double dexaey = dex * aey, aexdey = aex * dey;
+        const double aexcey = aex * cey, cexaey = cex * aey;
+        const double bexdey = bex * dey, dexbey = dex * bey;
+
+        const double ab = aexbey - bexaey, bc = bexcey - cexbey, cd = cexdey - dexcey;
+        const double da = dexaey - aexdey, ac = aexcey - cexaey, bd = bexdey - dexbey;
+
+        const double abc = aez * bc - bez * ac + cez * ab;
+        const double bcd = bez * cd - cez * bd + dez * bc;
+        const double cda = cez * da + dez * ac + aez * cd;
+        const double dab = dez * ab + aez * bd + bez * da;
+
+        const double alift = aex * aex + aey * aey + aez * aez;
+        const double blift = bex * bex + bey * bey + bez * bez;
+        const double clift = cex * cex + cey * cey + cez * cez;
+        const double dlift = dex * dex + dey * dey + dez * dez;
+
+        const double det = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+        const double permanent = ((std::fabs(cexdey) + std::fabs(dexcey)) * std::fabs(bez) +
+                                  (std::fabs(dexbey) + std::fabs(bexdey)) * std::fabs(cez) +
+                                  (std::fabs(bexcey) + std::fabs(cexbey)) * std::fabs(dez)) * alift +
+                                 ((std::fabs(dexaey) + std::fabs(aexdey)) * std::fabs(cez) +
+                                  (std::fabs(aexcey) + std::fabs(cexaey)) * std::fabs(dez) +
+                                  (std::fabs(cexdey) + std::fabs(dexcey)) * std::fabs(aez)) * blift +
+                                 ((std::fabs(aexbey) + std::fabs(bexaey)) * std::fabs(dez) +
+                                  (std::fabs(bexdey) + std::fabs(dexbey)) * std::fabs(aez) +
+                                  (std::fabs(dexaey) + std::fabs(aexdey)) * std::fabs(bez)) * clift +
+                                 ((std::fabs(bexcey) + std::fabs(cexbey)) * std::fabs(aez) +
+                                  (std::fabs(cexaey) + std::fabs(aexcey)) * std::fabs(bez) +
+                                  (std::fabs(aexbey) + std::fabs(bexaey)) * std::fabs(cez)) * dlift;
+
+        // Shewchuk's determinant is positive inside for his orientation, which is opposite to orient3d()'s.
+        if (det > bound * permanent) return -1;
+        if (-det > bound * permanent) return 1;
+        return -detail::insphere_exact(a, b, c, d, e);
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,416 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    namespace detail {
+
+        constexpr std::size_t binomial(std::size_t n, std::size_t k) {
+
+            std::size_t result = 1;
+            for (std::size_t i = 1; i <= k; ++i) result = result * (n - k + i) / i;
+            return result;
+
+        }
+
+        /**
+         * The number of points of the Grundmann-Moeller rule with parameter s on the Dim-simplex.
+         */
+        constexpr std::size_t grundmann_moeller_size(std::size_t dim, std::size_t s) {
+
+            std::size_t n = 0;
+            for (std::size_t i = 0; i <= s; ++i) n += binomial(s - i + dim, dim);
+            return n;
+
+        }
+
+        /**
+         * A quadrature point on the Dim-simplex: barycentric coordinates and a weight (the weights of a rule sum to
+         * one, i.e. they are relative to the simplex volume).
+         */
+        template<typename Real, std::size_t Dim>
+        struct SimplexPoint {
+            std::array<Real, Dim + 1> barycentric;
+            Real weight;
+        };
+
+        /**
+         * The Grundmann-Moeller rule of degree 2s + 1 on the Dim-simplex. Points and weights are rational, so the
+         * rule is evaluated exactly in the arithmetic of Real and is a constant expression for floating point types:
+         * \f[
+         *     w_i = (-1)^i\, 2^{-2s} \frac{(d + n - 2i)^d\, n!}{i!\, (d + n - i)!}, \qquad
+         *     \lambda_j = \frac{2 \beta_j + 1}{d + n - 2i}, \quad |\beta| = s - i, \quad i = 0, \ldots, s.
+         * \f]
+         */
+        template<typename Real, std::size_t Dim, std::size_t S>
+        constexpr std::array<SimplexPoint<Real, Dim>, grundmann_moeller_size(Dim, S)> grundmann_moeller() {
+
+            constexpr std::size_t n = Dim;
+            constexpr std::size_t d = 2 * S + 1;
+
+            std::array<SimplexPoint<Real, Dim>, grundmann_moeller_size(Dim, S)> rule{};
+            std::size_t count = 0;
+
+            for (std::size_t i = 0; i <= S; ++i) {
+
+                const std::size_t denominator = d + n - 2 * i;
+
+                // (-1)^i 2^(-2s) (d + n - 2i)^d n! / (i! (d + n - i)!)
+                Real weight = Real(1);
+                for (std::size_t k = 0; k < d; ++k) weight = weight * Real(denominator);
+                for (std::size_t k = 0; k < 2 * S; ++k) weight = weight / Real(2);
+                for (std::size_t k = 2; k <= n; ++k) weight = weight * Real(k);
+                for (std::size_t k = 2; k <= i; ++k) weight = weight / Real(k);
+                for (std::size_t k = 2; k <= d + n - i; ++k) weight = weight / Real(k);
+                if (i % 2 == 1) weight = Real(-1) * weight;
+
+                // Enumerate the compositions beta of s - i into n + 1 non-negative parts.
+                const std::size_t m = S - i;
+                std::array<std::size_t, Dim + 1> beta{};
+                beta[0] = m;
+                while (true) {
+
+                    SimplexPoint<Real, Dim> &point = rule[count++];
+                    for (std::size_t j = 0; j <= n; ++j) {
+                        point.barycentric[j] = Real(2 * beta[j] + 1) / Real(denominator);
+                    }
+                    point.weight = weight;
+
+                    // Next composition: move one unit from the first non-zero part (other than the last) rightwards.
+                    std::size_t j = 0;
+                    while (j < n && beta[j] == 0) ++j;
+                    if (j == n) break;
+                    const std::size_t carry = beta[j] - 1;
+                    beta[j] = 0;
+                    beta[j + 1] += 1;
+                    beta[0] = carry;
+
+                }
+
+            }
+
+            return rule;
+
+        }
+
+        template<std::size_t Dim, std::size_t... S>
+        constexpr auto grundmann_moeller_tables(std::index_sequence<S...>) {
+            return std::make_tuple(grundmann_moeller<double, Dim, S>()...);
+        }
+
+    } // namespace detail
+
+    /**
+     * The highest quadrature order for which pre-computed tables are provided.
+     */
+    constexpr std::size_t max_quadrature_order = 8;
+
+    /**
+     * Compile time quadrature tables for triangles (Dim = 2) and tetrahedra (Dim = 3) in double precision, indexed by
+     * the Grundmann-Moeller parameter s (degree 2s + 1); s = 0, ..., 4 covers orders one to nine.
+     */
+    template<std::size_t Dim>
+    inline constexpr auto quadrature_tables = detail::grundmann_moeller_tables<Dim>(std::make_index_sequence<5>());
+
+    /**
+     * A quadrature rule on a simplex in structure-of-arrays form: barycentric coordinates (three for triangles,
+     * four for tetrahedra) and weights relative to the element measure, so that
+     * \f$\int_T f \approx |T| \sum_q w_q f(x_q)\f$.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct QuadratureRule {
+
+        /** The polynomial degree integrated exactly. */
+        std::size_t degree = 0;
+
+        /** The number of barycentric coordinates per point (dimension plus one). */
+        std::size_t n_barycentric = 0;
+
+        /** The barycentric coordinates, point-major (point q has coordinates [q * n_barycentric, ...)). */
+        std::vector<Real> barycentric;
+
+        /** The weights; they sum to one. */
+        std::vector<Real> weights;
+
+        /**
+         * Retrieve the number of points.
+         * @return the number of points.
+         */
+        [[nodiscard]] inline std::size_t size() const { return weights.size(); }
+
+    };
+
+    namespace detail {
+
+        template<typename Real, std::size_t Dim, typename Table>
+        void append_rule(QuadratureRule<Real> &rule, const Table &table) {
+
+            for (const auto &point: table) {
+                for (std::size_t j = 0; j <= Dim; ++j) rule.barycentric.push_back(Real(point.barycentric[j]));
+                rule.weights.push_back(Real(point.weight));
+            }
+
+        }
+
+        template<typename Real, std::size_t Dim>
+        QuadratureRule<Real> simplex_quadrature(std::size_t order) {
+
+            if (order < 1 || order > max_quadrature_order) {
+                throw std::invalid_argument("quadrature order must be between 1 and 8");
+            }
+
+            // The smallest odd degree 2s + 1 >= order.
+            const std::size_t s = order / 2;
+
+            QuadratureRule<Real> rule;
+            rule.degree = 2 * s + 1;
+            rule.n_barycentric = Dim + 1;
+
+            if constexpr (std::is_same_v<Real, double>) {
+                // Copy the compile time tables.
+                switch (s) {
+                    case 0: append_rule<Real, Dim>(rule, std::get<0>(quadrature_tables<Dim>)); break;
+                    case 1: append_rule<Real, Dim>(rule, std::get<1>(quadrature_tables<Dim>)); break;
+                    case 2: append_rule<Real, Dim>(rule, std::get<2>(quadrature_tables<Dim>)); break;
+                    case 3: append_rule<Real, Dim>(rule, std::get<3>(quadrature_tables<Dim>)); break;
+                    default: append_rule<Real, Dim>(rule, std::get<4>(quadrature_tables<Dim>)); break;
+                }
+            } else {
+                // Evaluate the rational formulae in the working precision.
+                switch (s) {
+                    case 0: append_rule<Real, Dim>(rule, grundmann_moeller<Real, Dim, 0>()); break;
+                    case 1: append_rule<Real, Dim>(rule, grundmann_moeller<Real, Dim, 1>()); break;
+                    case 2: append_rule<Real, Dim>(rule, grundmann_moeller<Real, Dim, 2>()); break;
+                    case 3: append_rule<Real, Dim>(rule, grundmann_moeller<Real, Dim, 3>()); break;
+                    default: append_rule<Real, Dim>(rule, grundmann_moeller<Real, Dim, 4>()); break;
+                }
+            }
+
+            return rule;
+
+        }
+
+    } // namespace detail
+
+    /**
+     * Retrieve a quadrature rule for triangles that integrates polynomials of (at least) the given order exactly.
+     * Grundmann-Moeller rules are used: their points and weights are rational, so the double precision rules come
+     * from compile time tables while other types (e.g. mpreal) evaluate them exactly in the working precision.
+     * @param order the polynomial order, 1 to 8.
+     * @return the quadrature rule.
+     */
+    template<typename Real>
+    QuadratureRule<Real> triangle_quadrature(std::size_t order) {
+
+        return detail::simplex_quadrature<Real, 2>(order);
+
+    }
+
+    /**
+     * Retrieve a quadrature rule for tetrahedra that integrates polynomials of (at least) the given order exactly.
+     * @param order the polynomial order, 1 to 8.
+     * @return the quadrature rule.
+     */
+    template<typename Real>
+    QuadratureRule<Real> tetrahedron_quadrature(std::size_t order) {
+
+        return detail::simplex_quadrature<Real, 3>(order);
+
+    }
+
+    /**
+     * A block of quadrature points handed to a batch integrand: the physical position of one quadrature point in
+     * each of a contiguous range of elements, in structure-of-arrays form.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct QuadratureBlock {
+
+        /** The index of the first element of the block. */
+        std::size_t first_element;
+
+        /** The number of elements in the block. */
+        std::size_t n_elements;
+
+        /** The index of the quadrature point within the rule. */
+        std::size_t point;
+
+        /** The barycentric coordinates of the quadrature point. */
+        const Real *barycentric;
+
+        /** The physical coordinates, one per element. */
+        const Real *x;
+        const Real *y;
+        const Real *z;
+
+        /** Receives the integrand value, one per element. */
+        Real *values;
+
+    };
+
+    namespace detail {
+
+        template<typename Real, std::size_t NV, typename Measure, typename F>
+        std::vector<Real> integrate_elements(const Vector3DSoA<Real> &vertices,
+                                             const std::vector<std::array<std::size_t, NV>> &elements,
+                                             const QuadratureRule<Real> &rule, Measure measure, F f,
+                                             std::size_t n_threads) {
+
+            constexpr std::size_t block = 128;
+
+            if (rule.n_barycentric != NV) {
+                throw std::invalid_argument("quadrature rule does not match the element type");
+            }
+
+            const std::size_t n = elements.size();
+            const std::size_t nq = rule.size();
+            std::vector<Real> result(n, Real(0));
+
+            const Real *vx = vertices.x(), *vy = vertices.y(), *vz = vertices.z();
+
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+
+                // Gathered vertex coordinates (vertex-major), mapped points and integrand values for one block.
+                std::vector<Real> gx(NV * block), gy(NV * block), gz(NV * block);
+                std::vector<Real> px(block), py(block), pz(block), values(block), sum(block);
+
+                for (std::size_t b = begin; b < end; b += block) {
+
+                    const std::size_t m = std::min(block, end - b);
+
+                    for (std::size_t k = 0; k < m; ++k) {
+                        const auto &e = elements[b + k];
+                        for (std::size_t j = 0; j < NV; ++j) {
+                            gx[j * block + k] = vx[e[j]];
+                            gy[j * block + k] = vy[e[j]];
+                            gz[j * block + k] = vz[e[j]];
+                        }
+                        sum[k] = Real(0);
+                    }
+
+                    for (std::size_t q = 0; q < nq; ++q) {
+
+                        const Real *lambda = rule.barycentric.data() + q * NV;
+                        for (std::size_t k = 0; k < m; ++k) {
+                            Real x = lambda[0] * gx[k], y = lambda[0] * gy[k], z = lambda[0] * gz[k];
+                            for (std::size_t j = 1; j < NV; ++j) {
+                                x = x + lambda[j] * gx[j * block + k];
+                                y = y + lambda[j] * gy[j * block + k];
+                                z = z + lambda[j] * gz[j * block + k];
+                            }
+                            px[k] = x;
+                            py[k] = y;
+                            pz[k] = z;
+                        }
+
+                        f(QuadratureBlock<Real>{b, m, q, lambda, px.data(), py.data(), pz.data(), values.data()});
+
+                        const Real w = rule.weights[q];
+                        for (std::size_t k = 0; k < m; ++k) sum[k] = sum[k] + w * values[k];
+
+                    }
+
+                    for (std::size_t k = 0; k < m; ++k) {
+                        const auto &e = elements[b + k];
+                        result[b + k] = measure(e) * sum[k];
+                    }
+
+                }
+
+            }, n_threads, 256);
+
+            return result;
+
+        }
+
+        template<typename Real, typename F>
+        auto pointwise(F f) {
+            return [f](const QuadratureBlock<Real> &block) {
+                for (std::size_t k = 0; k < block.n_elements; ++k) {
+                    block.values[k] = f(Vector3D<Real>(block.x[k], block.y[k], block.z[k]));
+                }
+            };
+        }
+
+    } // namespace detail
+
+    /**
+     * Integrate a function over every element of a tetrahedral mesh. Elements are processed in blocks: the vertex
+     * coordinates of a block are gathered once, each quadrature point is mapped to all elements of the block in
+     * structure-of-arrays form and handed to the integrand in one call, and weighted sums are accumulated per
+     * element. Blocks are distributed over threads.
+     * @tparam F callable with signature void(const QuadratureBlock<Real> &) filling `values`, or Real(const
+     *           Vector3D<Real> &) for a pointwise integrand.
+     * @param mesh the tetrahedral mesh.
+     * @param rule a tetrahedron quadrature rule.
+     * @param f the integrand.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the integral over each element.
+     */
+    template<typename Real, typename F>
+    std::vector<Real> integrate(const TetrahedralMesh<Real> &mesh, const QuadratureRule<Real> &rule, F f,
+                                std::size_t n_threads = 0) {
+
+        auto measure = [&mesh](const std::array<std::size_t, 4> &t) {
+            Real v = tetrahedron_volume(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]],
+                                        mesh.vertices[t[3]]);
+            return v < Real(0) ? Real(-1) * v : v;
+        };
+
+        if constexpr (std::invocable<F, const Vector3D<Real> &>) {
+            return detail::integrate_elements(mesh.vertices, mesh.tetrahedra, rule, measure,
+                                              detail::pointwise<Real>(f), n_threads);
+        } else {
+            return detail::integrate_elements(mesh.vertices, mesh.tetrahedra, rule, measure, f, n_threads);
+        }
+
+    }
+
+    /**
+     * Integrate a function over every triangle of a surface mesh, see the tetrahedral version.
+     * @tparam F callable with signature void(const QuadratureBlock<Real> &) filling `values`, or Real(const
+     *           Vector3D<Real> &) for a pointwise integrand.
+     * @param mesh the triangle mesh.
+     * @param rule a triangle quadrature rule.
+     * @param f the integrand.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the integral over each triangle.
+     */
+    template<typename Real, typename F>
+    std::vector<Real> integrate(const TriangleMesh<Real> &mesh, const QuadratureRule<Real> &rule, F f,
+                                std::size_t n_threads = 0) {
+
+        auto measure = [&mesh](const std::array<std::size_t, 3> &t) {
+            return triangle_area(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]]);
+        };
+
+        if constexpr (std::invocable<F, const Vector3D<Real> &>) {
+            return detail::integrate_elements(mesh.vertices, mesh.triangles, rule, measure,
+                                              detail::pointwise<Real>(f), n_threads);
+        } else {
+            return detail::integrate_elements(mesh.vertices, mesh.triangles, rule, measure, f, n_threads);
+        }
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
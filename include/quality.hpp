@@ -0,0 +1,294 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Quality metrics of a single tetrahedron. Every metric except the dihedral angle is normalised so that the
+     * regular tetrahedron scores one.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct TetrahedronQuality {
+
+        /** The signed volume, as given by tetrahedron_volume(). */
+        Real volume;
+
+        /** The radius ratio \f$3 r_{in} / r_{circ}\f$, in [0, 1]. */
+        Real radius_ratio;
+
+        /** The aspect ratio \f$l_{max} / (2\sqrt{6}\, r_{in})\f$, in [1, inf). */
+        Real aspect_ratio;
+
+        /** The minimum dihedral angle in radians (the regular tetrahedron has \f$\arccos(1/3)\f$). */
+        Real min_dihedral_angle;
+
+        /** The mean ratio \f$12 (3|V|)^{2/3} / \sum l_{ij}^2\f$, in [0, 1]. */
+        Real mean_ratio;
+
+        /** The edge length ratio \f$l_{min} / l_{max}\f$, in (0, 1]. */
+        Real edge_length_ratio;
+
+    };
+
+    /**
+     * Compute all quality metrics of a tetrahedron in one fused pass. The six edge vectors and the three independent
+     * face area vectors (the fourth follows from their sum vanishing) are computed once and shared between all
+     * metrics, so the whole evaluation costs three cross products. Edge lengths and face areas use the regularised
+     * norm(), consistent with edge_length() and triangle_area().
+     * @param r1 vector representing a point on the tetrahedron.
+     * @param r2 vector representing a point on the tetrahedron.
+     * @param r3 vector representing a point on the tetrahedron.
+     * @param r4 vector representing a point on the tetrahedron.
+     * @return the tetrahedron quality metrics.
+     */
+    template<typename Real>
+    TetrahedronQuality<Real> tetrahedron_quality(const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                                                 const Vector3D<Real> &r3, const Vector3D<Real> &r4) {
+
+        using std::acos;
+        using std::cbrt;
+        using std::sqrt;
+
+        // Edge vectors.
+        const Vector3D<Real> e12 = r2 - r1;
+        const Vector3D<Real> e13 = r3 - r1;
+        const Vector3D<Real> e14 = r4 - r1;
+        const Vector3D<Real> e23 = r3 - r2;
+        const Vector3D<Real> e24 = r4 - r2;
+        const Vector3D<Real> e34 = r4 - r3;
+
+        // Face area vectors (twice the area, outward for positively oriented elements), indexed by opposite vertex.
+        const Vector3D<Real> n4 = cross(e13, e12);
+        const Vector3D<Real> n3 = cross(e12, e14);
+        const Vector3D<Real> n2 = cross(e14, e13);
+        const Vector3D<Real> n1 = Real(-1) * ((n2 + n3) + n4);
+
+        const Real six_volume = Real(-1) * dot(e12, n2);
+        const Real abs_six_volume = six_volume < Real(0) ? Real(-1) * six_volume : six_volume;
+
+        // Squared and regularised edge lengths.
+        const Real sq[6] = {dot(e12, e12), dot(e13, e13), dot(e14, e14), dot(e23, e23), dot(e24, e24), dot(e34, e34)};
+        const Real eps_squared = Vector3D<Real>::eps_squared();
+        Real l_min = sqrt(sq[0] + eps_squared);
+        Real l_max = l_min;
+        Real sq_sum = sq[0];
+        for (int k = 1; k < 6; ++k) {
+            Real l = sqrt(sq[k] + eps_squared);
+            if (l < l_min) l_min = l;
+            if (l > l_max) l_max = l;
+            sq_sum = sq_sum + sq[k];
+        }
+
+        // Twice the face areas.
+        const Real a1 = norm(n1), a2 = norm(n2), a3 = norm(n3), a4 = norm(n4);
+        const Real area_sum = ((a1 + a2) + a3) + a4;
+
+        // Circumradius numerator |a^2 (b x c) + b^2 (c x a) + c^2 (a x b)| with a, b, c the edges from r1.
+        const Vector3D<Real> circ = Real(-1) * ((sq[0] * n2 + sq[1] * n3) + sq[2] * n4);
+        const Real circ_norm = sqrt(dot(circ, circ));
+
+        TetrahedronQuality<Real> q;
+
+        q.volume = six_volume / Real(6);
+
+        // r_in = 3|V| / sum(A) = |6V| / sum(2A) and r_circ = |circ| / (2 |6V|), so 3 r_in / r_circ simplifies to the
+        // expression below which tends smoothly to zero for degenerate elements.
+        q.radius_ratio = Real(6) * abs_six_volume * abs_six_volume / (area_sum * circ_norm);
+
+        // l_max / (2 sqrt(6) r_in) with r_in = |6V| / sum(2A).
+        q.aspect_ratio = l_max * area_sum / (Real(2) * sqrt(Real(6)) * abs_six_volume);
+
+        // The interior dihedral angle between two faces is pi minus the angle between their outward normals, the
+        // smallest dihedral angle therefore belongs to the largest -cos(normal angle).
+        const Vector3D<Real> *normals[4] = {&n1, &n2, &n3, &n4};
+        const Real areas[4] = {a1, a2, a3, a4};
+        Real max_cos = Real(-1);
+        for (int i = 0; i < 4; ++i) {
+            for (int j = i + 1; j < 4; ++j) {
+                Real c = Real(-1) * dot(*normals[i], *normals[j]) / (areas[i] * areas[j]);
+                if (c > max_cos) max_cos = c;
+            }
+        }
+        if (max_cos > Real(1)) max_cos = Real(1);
+        q.min_dihedral_angle = acos(max_cos);
+
+        // 12 (3|V|)^(2/3) / sum(l^2) with 3|V| = |6V| / 2.
+        q.mean_ratio = Real(12) * cbrt(abs_six_volume * abs_six_volume / Real(4)) / sq_sum;
+
+        q.edge_length_ratio = l_min / l_max;
+
+        return q;
+
+    }
+
+    /**
+     * Quality metrics of every element of a tetrahedral mesh, in structure-of-arrays form.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct TetrahedronQualityArrays {
+
+        std::vector<Real> volume;
+        std::vector<Real> radius_ratio;
+        std::vector<Real> aspect_ratio;
+        std::vector<Real> min_dihedral_angle;
+        std::vector<Real> mean_ratio;
+        std::vector<Real> edge_length_ratio;
+
+    };
+
+    /**
+     * Compute the quality metrics of every element of a tetrahedral mesh using the fused kernel
+     * tetrahedron_quality(), in parallel over contiguous element ranges.
+     * @param mesh the tetrahedral mesh.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the per-element quality metrics.
+     */
+    template<typename Real>
+    TetrahedronQualityArrays<Real> tetrahedron_quality(const TetrahedralMesh<Real> &mesh, std::size_t n_threads = 0) {
+
+        const std::size_t n = mesh.n_tetrahedra();
+
+        TetrahedronQualityArrays<Real> result;
+        result.volume.resize(n);
+        result.radius_ratio.resize(n);
+        result.aspect_ratio.resize(n);
+        result.min_dihedral_angle.resize(n);
+        result.mean_ratio.resize(n);
+        result.edge_length_ratio.resize(n);
+
+        parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto &t = mesh.tetrahedra[i];
+                TetrahedronQuality<Real> q = tetrahedron_quality(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                                                 mesh.vertices[t[2]], mesh.vertices[t[3]]);
+                result.volume[i] = q.volume;
+                result.radius_ratio[i] = q.radius_ratio;
+                result.aspect_ratio[i] = q.aspect_ratio;
+                result.min_dihedral_angle[i] = q.min_dihedral_angle;
+                result.mean_ratio[i] = q.mean_ratio;
+                result.edge_length_ratio[i] = q.edge_length_ratio;
+            }
+        }, n_threads);
+
+        return result;
+
+    }
+
+    /**
+     * A histogram with equal width bins over [lower, upper); values outside the range are counted separately.
+     */
+    struct Histogram {
+
+        /** The lower edge of the first bin. */
+        double lower = 0.0;
+
+        /** The upper edge of the last bin. */
+        double upper = 1.0;
+
+        /** The count in each bin. */
+        std::vector<std::size_t> counts;
+
+        /** The number of values below `lower`. */
+        std::size_t underflow = 0;
+
+        /** The number of values at or above `upper` (or NaN). */
+        std::size_t overflow = 0;
+
+        /**
+         * Retrieve the width of a bin.
+         * @return the bin width.
+         */
+        [[nodiscard]] inline double bin_width() const { return (upper - lower) / static_cast<double>(counts.size()); }
+
+    };
+
+    /**
+     * Build a histogram of a set of values in parallel; each thread fills a private histogram which are then merged.
+     * @param values the values.
+     * @param n the number of values.
+     * @param lower the lower edge of the first bin.
+     * @param upper the upper edge of the last bin.
+     * @param n_bins the number of bins.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the histogram.
+     * @throws std::invalid_argument if there are no bins or the range is empty.
+     */
+    inline Histogram histogram(const double *values, std::size_t n, double lower, double upper, std::size_t n_bins,
+                               std::size_t n_threads = 0) {
+
+        if (n_bins == 0) throw std::invalid_argument("histogram: at least one bin is required");
+        if (!(upper > lower) || !std::isfinite(upper - lower)) {
+            throw std::invalid_argument("histogram: the upper edge must be finitely above the lower edge");
+        }
+
+        if (n_threads == 0) n_threads = default_thread_count();
+
+        std::vector<Histogram> partial(n_threads);
+        for (Histogram &h: partial) {
+            h.lower = lower;
+            h.upper = upper;
+            h.counts.assign(n_bins, 0);
+        }
+
+        const double scale = static_cast<double>(n_bins) / (upper - lower);
+
+        parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t t) {
+            Histogram &h = partial[t];
+            for (std::size_t i = begin; i < end; ++i) {
+                const double v = values[i];
+                if (v < lower) {
+                    h.underflow++;
+                } else if (v >= upper || v != v) {
+                    h.overflow++;
+                } else {
+                    std::size_t bin = static_cast<std::size_t>((v - lower) * scale);
+                    h.counts[std::min(bin, n_bins - 1)]++;
+                }
+            }
+        }, n_threads);
+
+        Histogram result = partial[0];
+        for (std::size_t t = 1; t < partial.size(); ++t) {
+            for (std::size_t b = 0; b < n_bins; ++b) result.counts[b] += partial[t].counts[b];
+            result.underflow += partial[t].underflow;
+            result.overflow += partial[t].overflow;
+        }
+
+        return result;
+
+    }
+
+    /**
+     * Build a histogram of a set of values in parallel.
+     * @param values the values.
+     * @param lower the lower edge of the first bin.
+     * @param upper the upper edge of the last bin.
+     * @param n_bins the number of bins.
+     * @param n_threads the number of threads, zero selects default_thread_count().
+     * @return the histogram.
+     * @throws std::invalid_argument if there are no bins or the range is empty.
+     */
+    inline Histogram histogram(const std::vector<double> &values, double lower, double upper, std::size_t n_bins,
+                               std::size_t n_threads = 0) {
+
+        return histogram(values.data(), values.size(), lower, upper, n_bins, n_threads);
+
+    }
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,651 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /** The number of rays traversed together by the packet queries: eight doubles, one AVX-512 register. */
+    constexpr std::size_t ray_packet_width = 8;
+
+    /**
+     * The result of a ray cast against triangles.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct RayHit {
+
+        /** Marks a miss. */
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /** The index of the triangle hit, or `none`. */
+        std::size_t triangle = none;
+
+        /** The ray parameter of the hit: the hit point is origin + t direction. */
+        Real t = Real(0);
+
+        /** The barycentric weight of the triangle's second vertex at the hit point. */
+        Real u = Real(0);
+
+        /** The barycentric weight of the triangle's third vertex at the hit point. */
+        Real v = Real(0);
+
+        /** Whether the ray arrives from the side triangle_normal() points to. */
+        bool front_facing = false;
+
+        /**
+         * Test whether the ray hit a triangle.
+         * @return true for a hit.
+         */
+        [[nodiscard]] inline bool hit() const { return triangle != none; }
+
+    };
+
+    namespace detail {
+
+        /**
+         * Per-ray data of the triangle test: the direction and the two directions in which the ray is notionally
+         * displaced when it passes exactly through an edge or a vertex.
+         */
+        template<typename Real>
+        struct RayFrame {
+
+            Vector3D<Real> origin;
+            Vector3D<Real> direction;
+            Vector3D<Real> w1;
+            Vector3D<Real> w2;
+
+            RayFrame() = default;
+
+            RayFrame(const Vector3D<Real> &o, const Vector3D<Real> &d) : origin(o), direction(d) {
+                using std::fabs;
+                // Displace along the two axes least aligned with the direction, so that d, e1 and e2 are independent.
+                std::array<std::size_t, 3> axes = {0, 1, 2};
+                const std::array<Real, 3> magnitude = {fabs(d.x()), fabs(d.y()), fabs(d.z())};
+                std::sort(axes.begin(), axes.end(), [&](std::size_t a, std::size_t b) {
+                    return magnitude[a] < magnitude[b] || (magnitude[a] == magnitude[b] && a < b);
+                });
+                auto axis = [](std::size_t a) {
+                    return Vector3D<Real>(Real(a == 0 ? 1 : 0), Real(a == 1 ? 1 : 0), Real(a == 2 ? 1 : 0));
+                };
+                w1 = cross(d, axis(axes[0]));
+                w2 = cross(d, axis(axes[1]));
+            }
+
+        };
+
+        template<typename Real>
+        bool lexicographic_less(const Vector3D<Real> &a, const Vector3D<Real> &b) {
+            if (a.x() != b.x()) return a.x() < b.x();
+            if (a.y() != b.y()) return a.y() < b.y();
+            return a.z() < b.z();
+        }
+
+        /**
+         * The edge function of the directed edge a -> b seen from the ray: the signed volume spanned by the
+         * direction and the edge's end points relative to the origin, together with its sign. The value is always
+         * computed with the end points in lexicographic order and negated for the reverse direction, so the two
+         * triangles sharing an edge obtain exactly opposite values whatever the rounding (or fused multiply-adds).
+         * A zero value, a ray through the edge, is given the sign it takes once the origin is displaced by
+         * e1 epsilon + e2 epsilon^2, which is again the same for both triangles.
+         */
+        template<typename Real>
+        std::pair<Real, int> edge_function(const RayFrame<Real> &ray, const Vector3D<Real> &a,
+                                           const Vector3D<Real> &b) {
+            const bool flip = lexicographic_less(b, a);
+            const Vector3D<Real> &p = flip ? b : a;
+            const Vector3D<Real> &q = flip ? a : b;
+            const Real w = dot(ray.direction, cross(p - ray.origin, q - ray.origin));
+            int sign = w > Real(0) ? 1 : (w < Real(0) ? -1 : 0);
+            if (sign == 0) {
+                const Vector3D<Real> e = p - q;
+                const Real s1 = dot(e, ray.w1);
+                sign = s1 > Real(0) ? 1 : (s1 < Real(0) ? -1 : 0);
+                if (sign == 0) {
+                    const Real s2 = dot(e, ray.w2);
+                    sign = s2 > Real(0) ? 1 : (s2 < Real(0) ? -1 : 0);
+                }
+            }
+            return flip ? std::make_pair(-w, -sign) : std::make_pair(w, sign);
+        }
+
+        template<typename Real>
+        bool ray_triangle(const RayFrame<Real> &ray, const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                          const Vector3D<Real> &r3, const Real &t_min, const Real &t_max, RayHit<Real> &hit) {
+
+            const auto [w3, s3] = edge_function(ray, r1, r2);
+            const auto [w1, s1] = edge_function(ray, r2, r3);
+            if (s1 != s3 || s1 == 0) return false;
+            const auto [w2, s2] = edge_function(ray, r3, r1);
+            if (s2 != s3) return false;
+
+            const Vector3D<Real> n = cross(r2 - r1, r3 - r1);
+            const Real denominator = dot(ray.direction, n);
+            if (denominator == Real(0)) return false;
+            const Real t = dot(r1 - ray.origin, n) / denominator;
+            if (!(t > t_min && t <= t_max)) return false;
+
+            const Real sum = w1 + w2 + w3;
+            hit.t = t;
+            hit.u = sum != Real(0) ? w2 / sum : Real(0);
+            hit.v = sum != Real(0) ? w3 / sum : Real(0);
+            hit.front_facing = denominator < Real(0);
+            return true;
+
+        }
+
+    } // namespace detail
+
+    /**
+     * Intersect a ray with a triangle. The test is Möller-Trumbore in edge function form: the three edge functions
+     * (signed volumes of the direction with each edge seen from the origin) are the barycentric weights of the hit
+     * point scaled by the determinant. Each edge function is evaluated identically for the two triangles sharing an
+     * edge, and rays passing exactly through an edge or vertex are resolved by a consistent symbolic displacement,
+     * so a ray crossing a closed surface at a shared edge or vertex hits exactly one of the triangles meeting there
+     * (watertight). Degenerate and edge-on triangles are never hit.
+     * @param origin the ray origin.
+     * @param direction the ray direction (need not be normalised).
+     * @param r1 the first vertex of the triangle.
+     * @param r2 the second vertex of the triangle.
+     * @param r3 the third vertex of the triangle.
+     * @param t_min hits must have t > t_min.
+     * @param t_max hits must have t <= t_max.
+     * @return the hit (with triangle set to zero) or a miss.
+     */
+    template<typename Real>
+    RayHit<Real> ray_triangle_intersection(const Vector3D<Real> &origin, const Vector3D<Real> &direction,
+                                           const Vector3D<Real> &r1, const Vector3D<Real> &r2,
+                                           const Vector3D<Real> &r3, const Real &t_min = Real(0),
+                                           const Real &t_max = std::numeric_limits<Real>::infinity()) {
+
+        RayHit<Real> hit;
+        if (detail::ray_triangle(detail::RayFrame<Real>(origin, direction), r1, r2, r3, t_min, t_max, hit)) {
+            hit.triangle = 0;
+        }
+        return hit;
+
+    }
+
+    /**
+     * A node of a triangle bounding volume hierarchy: a contiguous range of the hierarchy's triangle order with a
+     * double precision bounding box (padded to contain the triangles whatever their type).
+     */
+    struct BvhNode {
+
+        /** Marks a missing child. */
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /** The lower corner of the bounding box. */
+        std::array<double, 3> lower = {0.0, 0.0, 0.0};
+
+        /** The upper corner of the bounding box. */
+        std::array<double, 3> upper = {0.0, 0.0, 0.0};
+
+        /** The first position of the node in the triangle order. */
+        std::size_t begin = 0;
+
+        /** One past the last position of the node in the triangle order. */
+        std::size_t end = 0;
+
+        /** The two sons, or `none` for a leaf. */
+        std::array<std::size_t, 2> children = {none, none};
+
+        /** The axis along which the sons were separated; rays travelling along it visit the first son first. */
+        std::size_t axis = 0;
+
+        /**
+         * Test whether the node is a leaf.
+         * @return true if the node has no sons.
+         */
+        [[nodiscard]] inline bool is_leaf() const { return children[0] == none; }
+
+    };
+
+    /**
+     * A bounding volume hierarchy over the triangles of a surface mesh for ray casting, built top down with the
+     * surface area heuristic over binned centroids. The triangle vertices are copied in hierarchy order.
+     *
+     * Single rays, streams of rays and inside/outside classification of points are supported; the streams are cut
+     * into packets of ray_packet_width consecutive rays which traverse the hierarchy together, testing the boxes of
+     * a node against all rays of the packet at once, so coherent rays share the node fetches.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class TriangleBvh {
+
+    public:
+
+        /**
+         * Build the hierarchy.
+         * @param mesh the surface mesh.
+         * @param leaf_size the maximum number of triangles in a leaf.
+         */
+        explicit TriangleBvh(const TriangleMesh<Real> &mesh, std::size_t leaf_size = 4) {
+
+            const std::size_t n = mesh.n_triangles();
+            leaf_size = std::max<std::size_t>(1, leaf_size);
+
+            std::vector<std::array<double, 9>> corners(n);
+            std::vector<std::array<double, 3>> centroids(n);
+            double extent = 0.0;
+            for (std::size_t t = 0; t < n; ++t) {
+                for (std::size_t a = 0; a < 3; ++a) {
+                    const Vector3D<Real> r = mesh.vertices[mesh.triangles[t][a]];
+                    corners[t][3 * a] = static_cast<double>(r.x());
+                    corners[t][3 * a + 1] = static_cast<double>(r.y());
+                    corners[t][3 * a + 2] = static_cast<double>(r.z());
+                    extent = std::max({extent, std::fabs(corners[t][3 * a]), std::fabs(corners[t][3 * a + 1]),
+                                       std::fabs(corners[t][3 * a + 2])});
+                }
+                for (std::size_t c = 0; c < 3; ++c) {
+                    centroids[t][c] = (corners[t][c] + corners[t][3 + c] + corners[t][6 + c]) / 3.0;
+                }
+            }
+            _pad = 1E-12 * std::max(extent, 1.0);
+
+            _triangles.resize(n);
+            std::iota(_triangles.begin(), _triangles.end(), std::size_t(0));
+            if (n > 0) build(corners, centroids, leaf_size);
+
+            _r1.resize(n);
+            _r2.resize(n);
+            _r3.resize(n);
+            for (std::size_t p = 0; p < n; ++p) {
+                const auto &t = mesh.triangles[_triangles[p]];
+                _r1.set(p, mesh.vertices[t[0]]);
+                _r2.set(p, mesh.vertices[t[1]]);
+                _r3.set(p, mesh.vertices[t[2]]);
+            }
+
+        }
+
+        /**
+         * Retrieve the nodes; node zero is the root (if there are triangles).
+         * @return the nodes.
+         */
+        [[nodiscard]] inline const std::vector<BvhNode> &nodes() const { return _nodes; }
+
+        /**
+         * Retrieve the triangle order: position p of the hierarchy holds triangle triangles()[p].
+         * @return the triangle order.
+         */
+        [[nodiscard]] inline const std::vector<std::size_t> &triangles() const { return _triangles; }
+
+        /**
+         * Find the first triangle hit by a ray.
+         * @param origin the ray origin.
+         * @param direction the ray direction.
+         * @param t_max the largest ray parameter considered.
+         * @return the nearest hit with t > 0, or a miss.
+         */
+        [[nodiscard]] RayHit<Real> intersect(const Vector3D<Real> &origin, const Vector3D<Real> &direction,
+                                             const Real &t_max = std::numeric_limits<Real>::infinity()) const {
+            RayHit<Real> hit;
+            trace(&origin, &direction, 1, &hit, nullptr, t_max);
+            return hit;
+        }
+
+        /**
+         * Count the triangles crossed by a ray.
+         * @param origin the ray origin.
+         * @param direction the ray direction.
+         * @return the number of hits with t > 0.
+         */
+        [[nodiscard]] std::size_t count_crossings(const Vector3D<Real> &origin, const Vector3D<Real> &direction) const {
+            std::size_t count = 0;
+            trace(&origin, &direction, 1, nullptr, &count, std::numeric_limits<Real>::infinity());
+            return count;
+        }
+
+        /**
+         * Find the first triangle hit by each of a stream of rays, in packets.
+         * @param origins the ray origins.
+         * @param directions the ray directions.
+         * @param hits the nearest hit with t > 0 of each ray, or a miss.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void intersect(const Vector3DSoA<Real> &origins, const Vector3DSoA<Real> &directions, RayHit<Real> *hits,
+                       std::size_t n_threads = 0) const {
+            stream(origins, directions, hits, nullptr, n_threads);
+        }
+
+        /**
+         * Count the triangles crossed by each of a stream of rays, in packets.
+         * @param origins the ray origins.
+         * @param directions the ray directions.
+         * @param counts the number of hits with t > 0 of each ray.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void count_crossings(const Vector3DSoA<Real> &origins, const Vector3DSoA<Real> &directions,
+                             std::size_t *counts, std::size_t n_threads = 0) const {
+            stream(origins, directions, nullptr, counts, n_threads);
+        }
+
+        /**
+         * Classify points as inside or outside a closed surface by the parity of the crossings of a ray from each
+         * point. All rays share one direction, so neighbouring points give coherent packets. Points on the surface
+         * may be classified either way.
+         * @param points the points.
+         * @param inside receives 1 for points inside the surface and 0 otherwise, one per point.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void inside(const Vector3DSoA<Real> &points, char *inside, std::size_t n_threads = 0) const {
+            const Vector3D<Real> direction(Real(0.5773502691896258), Real(0.6324555320336759),
+                                           Real(0.5163977794943222));
+            parallel_for(0, points.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::array<Vector3D<Real>, ray_packet_width> o, d;
+                std::array<std::size_t, ray_packet_width> counts;
+                for (std::size_t b = begin; b < end; b += ray_packet_width) {
+                    const std::size_t m = std::min(ray_packet_width, end - b);
+                    for (std::size_t l = 0; l < m; ++l) {
+                        o[l] = points[b + l];
+                        d[l] = direction;
+                    }
+                    trace(o.data(), d.data(), m, nullptr, counts.data(), std::numeric_limits<Real>::infinity());
+                    for (std::size_t l = 0; l < m; ++l) inside[b + l] = static_cast<char>(counts[l] % 2);
+                }
+            }, n_threads, 4 * ray_packet_width);
+        }
+
+    private:
+
+        double _pad = 0.0;
+
+        std::vector<BvhNode> _nodes;
+        std::vector<std::size_t> _triangles;
+        Vector3DSoA<Real> _r1;
+        Vector3DSoA<Real> _r2;
+        Vector3DSoA<Real> _r3;
+
+        /**
+         * Top-down build: each node is split at the best of the bin boundaries (by the surface area heuristic) along
+         * the axis of widest centroid extent, or kept as a leaf when no split is cheaper than the leaf.
+         */
+        void build(const std::vector<std::array<double, 9>> &corners,
+                   const std::vector<std::array<double, 3>> &centroids, std::size_t leaf_size) {
+
+            constexpr std::size_t n_bins = 16;
+
+            // Beyond this depth nodes are split at the centroid median, which bounds the traversal stack.
+            constexpr std::size_t max_sah_depth = 96;
+
+            struct Box {
+                std::array<double, 3> lower = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                                               std::numeric_limits<double>::max()};
+                std::array<double, 3> upper = {std::numeric_limits<double>::lowest(),
+                                               std::numeric_limits<double>::lowest(),
+                                               std::numeric_limits<double>::lowest()};
+                void grow(const std::array<double, 3> &l, const std::array<double, 3> &u) {
+                    for (std::size_t a = 0; a < 3; ++a) {
+                        lower[a] = std::min(lower[a], l[a]);
+                        upper[a] = std::max(upper[a], u[a]);
+                    }
+                }
+                [[nodiscard]] double area() const {
+                    if (lower[0] > upper[0]) return 0.0;
+                    const double dx = upper[0] - lower[0], dy = upper[1] - lower[1], dz = upper[2] - lower[2];
+                    return dx * dy + dy * dz + dz * dx;
+                }
+            };
+
+            auto bounds = [&](std::size_t t) {
+                std::array<double, 3> l, u;
+                for (std::size_t a = 0; a < 3; ++a) {
+                    l[a] = std::min({corners[t][a], corners[t][3 + a], corners[t][6 + a]});
+                    u[a] = std::max({corners[t][a], corners[t][3 + a], corners[t][6 + a]});
+                }
+                return std::make_pair(l, u);
+            };
+
+            auto make_node = [&](std::size_t begin, std::size_t end) {
+                Box box;
+                for (std::size_t p = begin; p < end; ++p) {
+                    const auto [l, u] = bounds(_triangles[p]);
+                    box.grow(l, u);
+                }
+                BvhNode node;
+                node.begin = begin;
+                node.end = end;
+                for (std::size_t a = 0; a < 3; ++a) {
+                    node.lower[a] = box.lower[a] - _pad;
+                    node.upper[a] = box.upper[a] + _pad;
+                }
+                return node;
+            };
+
+            _nodes.push_back(make_node(0, _triangles.size()));
+            std::vector<std::pair<std::size_t, std::size_t>> stack = {{0, 0}};
+            while (!stack.empty()) {
+
+                const auto [current, depth] = stack.back();
+                stack.pop_back();
+                const std::size_t begin = _nodes[current].begin, end = _nodes[current].end;
+                if (end - begin <= leaf_size) continue;
+
+                Box centres;
+                for (std::size_t p = begin; p < end; ++p) {
+                    centres.grow(centroids[_triangles[p]], centroids[_triangles[p]]);
+                }
+                std::size_t axis = 0;
+                for (std::size_t a = 1; a < 3; ++a) {
+                    if (centres.upper[a] - centres.lower[a] > centres.upper[axis] - centres.lower[axis]) axis = a;
+                }
+                const double lo = centres.lower[axis], width = centres.upper[axis] - centres.lower[axis];
+
+                std::size_t split = begin + (end - begin) / 2;
+                if (depth >= max_sah_depth) {
+                    std::nth_element(_triangles.begin() + static_cast<std::ptrdiff_t>(begin),
+                                     _triangles.begin() + static_cast<std::ptrdiff_t>(split),
+                                     _triangles.begin() + static_cast<std::ptrdiff_t>(end),
+                                     [&](std::size_t a, std::size_t b) {
+                                         return centroids[a][axis] < centroids[b][axis];
+                                     });
+                } else if (width > 0.0) {
+
+                    auto bin = [&](std::size_t t) {
+                        return std::min(n_bins - 1, static_cast<std::size_t>(
+                                double(n_bins) * (centroids[t][axis] - lo) / width));
+                    };
+
+                    std::array<Box, n_bins> boxes;
+                    std::array<std::size_t, n_bins> counts = {};
+                    for (std::size_t p = begin; p < end; ++p) {
+                        const std::size_t b = bin(_triangles[p]);
+                        const auto [l, u] = bounds(_triangles[p]);
+                        boxes[b].grow(l, u);
+                        ++counts[b];
+                    }
+
+                    // Sweep from the right for the suffix areas, then from the left for the cost of each boundary.
+                    std::array<double, n_bins> right_area = {};
+                    std::array<std::size_t, n_bins> right_count = {};
+                    Box right;
+                    std::size_t count = 0;
+                    for (std::size_t b = n_bins; b-- > 1;) {
+                        right.grow(boxes[b].lower, boxes[b].upper);
+                        count += counts[b];
+                        right_area[b] = right.area();
+                        right_count[b] = count;
+                    }
+                    Box left;
+                    count = 0;
+                    double best = std::numeric_limits<double>::max();
+                    std::size_t best_bin = 0;
+                    for (std::size_t b = 1; b < n_bins; ++b) {
+                        left.grow(boxes[b - 1].lower, boxes[b - 1].upper);
+                        count += counts[b - 1];
+                        if (count == 0 || right_count[b] == 0) continue;
+                        const double cost = left.area() * double(count) + right_area[b] * double(right_count[b]);
+                        if (cost < best) {
+                            best = cost;
+                            best_bin = b;
+                        }
+                    }
+
+                    Box all;
+                    all.grow(boxes[0].lower, boxes[0].upper);
+                    all.grow(right.lower, right.upper);
+                    const double leaf_cost = all.area() * double(end - begin);
+                    if (best_bin > 0) {
+                        if (end - begin <= 4 * leaf_size && best >= leaf_cost) continue;
+                        auto middle = std::partition(_triangles.begin() + static_cast<std::ptrdiff_t>(begin),
+                                                     _triangles.begin() + static_cast<std::ptrdiff_t>(end),
+                                                     [&](std::size_t t) { return bin(t) < best_bin; });
+                        split = static_cast<std::size_t>(middle - _triangles.begin());
+                    }
+
+                }
+                if (split == begin || split == end) {
+                    // Coincident centroids: split by index.
+                    split = begin + (end - begin) / 2;
+                }
+
+                const std::size_t left = _nodes.size();
+                _nodes.push_back(make_node(begin, split));
+                _nodes.push_back(make_node(split, end));
+                _nodes[current].children = {left, left + 1};
+                _nodes[current].axis = axis;
+                stack.emplace_back(left, depth + 1);
+                stack.emplace_back(left + 1, depth + 1);
+
+            }
+
+        }
+
+        /**
+         * The octant of a direction, by the signs of its components.
+         */
+        static inline int octant(const Vector3D<Real> &d) {
+            return (d.x() < 0 ? 1 : 0) | (d.y() < 0 ? 2 : 0) | (d.z() < 0 ? 4 : 0);
+        }
+
+        /**
+         * Cut a stream of rays into packets and trace them in parallel; packets whose rays do not share a direction
+         * octant are traced ray by ray.
+         */
+        void stream(const Vector3DSoA<Real> &origins, const Vector3DSoA<Real> &directions, RayHit<Real> *hits,
+                    std::size_t *counts, std::size_t n_threads) const {
+            parallel_for(0, origins.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::array<Vector3D<Real>, ray_packet_width> o, d;
+                for (std::size_t b = begin; b < end; b += ray_packet_width) {
+                    const std::size_t m = std::min(ray_packet_width, end - b);
+                    bool coherent = true;
+                    for (std::size_t l = 0; l < m; ++l) {
+                        o[l] = origins[b + l];
+                        d[l] = directions[b + l];
+                        coherent = coherent && octant(d[l]) == octant(d[0]);
+                    }
+                    if (coherent) {
+                        trace(o.data(), d.data(), m, hits ? hits + b : nullptr, counts ? counts + b : nullptr,
+                              std::numeric_limits<Real>::infinity());
+                        continue;
+                    }
+                    // Rays heading into different octants share few nodes: trace them one at a time.
+                    for (std::size_t l = 0; l < m; ++l) {
+                        trace(&o[l], &d[l], 1, hits ? hits + b + l : nullptr, counts ? counts + b + l : nullptr,
+                              std::numeric_limits<Real>::infinity());
+                    }
+                }
+            }, n_threads, 4 * ray_packet_width);
+        }
+
+        /**
+         * Trace a packet of at most ray_packet_width rays through the hierarchy, either finding the nearest hit of
+         * each ray (`hits`) or counting all of its hits (`counts`). The slab tests run over the lanes of the packet
+         * in double precision; a node is entered if any lane's ray meets its box, and the triangles of a leaf are only
+         * tested against the lanes that meet it.
+         */
+        void trace(const Vector3D<Real> *origins, const Vector3D<Real> *directions, std::size_t m,
+                   RayHit<Real> *hits, std::size_t *counts, const Real &t_max) const {
+
+            constexpr std::size_t W = ray_packet_width;
+
+            std::array<double, W> ox = {}, oy = {}, oz = {}, ix = {}, iy = {}, iz = {}, far = {};
+            auto inverse = [](double d) { return 1.0 / (d == 0.0 ? std::copysign(1E-300, d) : d); };
+            std::array<detail::RayFrame<Real>, W> frames;
+            std::array<Real, W> limit;
+            for (std::size_t l = 0; l < m; ++l) {
+                ox[l] = static_cast<double>(origins[l].x());
+                oy[l] = static_cast<double>(origins[l].y());
+                oz[l] = static_cast<double>(origins[l].z());
+                ix[l] = inverse(static_cast<double>(directions[l].x()));
+                iy[l] = inverse(static_cast<double>(directions[l].y()));
+                iz[l] = inverse(static_cast<double>(directions[l].z()));
+                far[l] = std::numeric_limits<double>::infinity();
+                frames[l] = detail::RayFrame<Real>(origins[l], directions[l]);
+                limit[l] = t_max;
+                if (hits) hits[l] = RayHit<Real>();
+                if (counts) counts[l] = 0;
+            }
+
+            if (_nodes.empty()) return;
+
+            std::array<std::size_t, 256> stack;
+            std::size_t top = 0;
+            stack[top++] = 0;
+            while (top > 0) {
+
+                const BvhNode &node = _nodes[stack[--top]];
+
+                // Slab test of every lane; only the lanes that meet the box test its triangles.
+                std::array<char, W> active;
+                bool any = false;
+                for (std::size_t l = 0; l < m; ++l) {
+                    const double tx0 = (node.lower[0] - ox[l]) * ix[l], tx1 = (node.upper[0] - ox[l]) * ix[l];
+                    const double ty0 = (node.lower[1] - oy[l]) * iy[l], ty1 = (node.upper[1] - oy[l]) * iy[l];
+                    const double tz0 = (node.lower[2] - oz[l]) * iz[l], tz1 = (node.upper[2] - oz[l]) * iz[l];
+                    const double entry = std::max({std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), 0.0});
+                    const double exit = std::min({std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1),
+                                                  far[l]});
+                    active[l] = entry <= exit;
+                    any = any || active[l];
+                }
+                if (!any) continue;
+
+                if (!node.is_leaf()) {
+                    const double leading = node.axis == 0 ? ix[0] : (node.axis == 1 ? iy[0] : iz[0]);
+                    const std::size_t first = leading < 0.0 ? 1 : 0;
+                    stack[top++] = node.children[1 - first];
+                    stack[top++] = node.children[first];
+                    continue;
+                }
+
+                for (std::size_t p = node.begin; p < node.end; ++p) {
+                    const Vector3D<Real> r1 = _r1[p], r2 = _r2[p], r3 = _r3[p];
+                    for (std::size_t l = 0; l < m; ++l) {
+                        RayHit<Real> hit;
+                        if (!active[l]) continue;
+                        if (!detail::ray_triangle(frames[l], r1, r2, r3, Real(0), limit[l], hit)) continue;
+                        if (counts) {
+                            ++counts[l];
+                        } else {
+                            hit.triangle = _triangles[p];
+                            hits[l] = hit;
+                            limit[l] = hit.t;
+                            far[l] = static_cast<double>(hit.t) * (1.0 + 1E-12) + _pad;
+                        }
+                    }
+                }
+
+            }
+
+        }
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,496 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Conforming local refinement and coarsening of a tetrahedral mesh by longest-edge bisection.
+     *
+     * An element is bisected through the midpoint (edge_center()) of its longest edge (edge_length(), ties broken
+     * by vertex index so that every element sharing an edge agrees on it). Bisecting an element leaves a hanging
+     * vertex on the elements around its longest edge; those are bisected in turn, each by its own longest edge,
+     * until no element has a split edge (Rivara's closure). The midpoints are shared through a hash table keyed by
+     * the edge, so an edge is split once however many elements see it.
+     *
+     * Refinement proceeds in rounds. The midpoints of a round are created first; after that the bisections of the
+     * round are independent - each reads the midpoint table and writes only its own element and children - and run
+     * in parallel, as do the conformity checks that gather the next round.
+     *
+     * The refiner keeps the caller's mesh current: the tetrahedra are always the leaves of the bisection forest,
+     * one child taking the slot of its parent and the other appended, and new vertices are appended. The forest,
+     * the vertex stars and the volume and longest edge of every element are updated incrementally, so the cost of a
+     * call is proportional to the elements it changes. coarsen() reverses bisections: a midpoint is removed, and the
+     * elements around it merged with their siblings, once every element around it is marked. Removed midpoints
+     * leave unreferenced vertex slots (see is_vertex_used()) that later refinement reuses, so vertex indices stay
+     * stable across calls.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class MeshRefiner {
+
+    public:
+
+        /** The index standing for no element or vertex. */
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * Make each element of a mesh the root of a bisection tree.
+         * @param mesh the mesh, which refine() and coarsen() modify; it must outlive the refiner and not be changed
+         *             by anything else.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        explicit MeshRefiner(TetrahedralMesh<Real> &mesh, std::size_t n_threads = 0)
+                : _mesh(mesh), _n_threads(n_threads) {
+
+            const std::size_t n_vertices = mesh.n_vertices();
+            const std::size_t n = mesh.n_tetrahedra();
+            if (n_vertices > max_vertices) throw std::length_error("MeshRefiner: too many vertices");
+
+            _nodes.resize(n);
+            _slots.resize(n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t e = begin; e < end; ++e) {
+                    _nodes[e].vertices = mesh.tetrahedra[e];
+                    _nodes[e].slot = e;
+                    _slots[e] = e;
+                    update_geometry(_nodes[e]);
+                }
+            }, _n_threads);
+
+            _stars.resize(n_vertices);
+            for (std::size_t e = 0; e < n; ++e) for (std::size_t v: _nodes[e].vertices) _stars[v].push_back(e);
+            _origins.resize(n_vertices);
+            for (std::size_t v = 0; v < n_vertices; ++v) _origins[v] = {v, v};
+
+        }
+
+        /**
+         * Retrieve the number of bisections between an element and the original element containing it.
+         * @param e the element.
+         * @return the refinement level, zero for original elements.
+         */
+        [[nodiscard]] std::size_t level(std::size_t e) const {
+            return _nodes[_slots[e]].level;
+        }
+
+        /**
+         * Retrieve the cached tetrahedron_volume() of an element.
+         * @param e the element.
+         * @return the volume.
+         */
+        [[nodiscard]] Real volume(std::size_t e) const {
+            return _nodes[_slots[e]].volume;
+        }
+
+        /**
+         * Retrieve the cached edge_length() of the longest edge of an element, the one its bisection splits.
+         * @param e the element.
+         * @return the longest edge length.
+         */
+        [[nodiscard]] Real longest_edge_length(std::size_t e) const {
+            return _nodes[_slots[e]].longest;
+        }
+
+        /**
+         * Retrieve the endpoints of the edge whose midpoint a vertex is, e.g. to interpolate vertex fields onto a
+         * refined mesh.
+         * @param v the vertex.
+         * @return the endpoints, or {v, v} for an original or unused vertex.
+         */
+        [[nodiscard]] std::array<std::size_t, 2> parent_vertices(std::size_t v) const {
+            return _origins[v];
+        }
+
+        /**
+         * Test whether a vertex belongs to an element; coarsening leaves the slots of removed midpoints unused.
+         * @param v the vertex.
+         * @return true if some element has the vertex.
+         */
+        [[nodiscard]] bool is_vertex_used(std::size_t v) const {
+            return !_stars[v].empty();
+        }
+
+        /**
+         * Bisect the marked elements and as many others as needed to keep the mesh conforming.
+         * @param marked one flag per element of the mesh, non-zero to bisect the element.
+         * @return the number of bisections performed.
+         */
+        std::size_t refine(const std::vector<char> &marked) {
+
+            if (marked.size() != _mesh.n_tetrahedra()) {
+                throw std::invalid_argument("MeshRefiner: one marker per element is required");
+            }
+
+            std::vector<std::size_t> split;
+            for (std::size_t e = 0; e < marked.size(); ++e) if (marked[e]) split.push_back(_slots[e]);
+
+            std::size_t n_bisections = 0;
+            std::vector<std::uint64_t> keys;
+            std::vector<std::size_t> children, candidates;
+            std::vector<char> hanging;
+            while (!split.empty()) {
+
+                // One midpoint per edge, however many elements of the round share it.
+                keys.resize(split.size());
+                for (std::size_t i = 0; i < split.size(); ++i) keys[i] = longest_edge_key(_nodes[split[i]]);
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+                for (std::uint64_t key: keys) {
+                    if (_midpoints.find(key) == _midpoints.end()) _midpoints.emplace(key, add_midpoint(key));
+                }
+
+                children.resize(2 * split.size());
+                for (std::size_t &child: children) child = add_node();
+                const std::size_t first_slot = _mesh.n_tetrahedra();
+                _mesh.tetrahedra.resize(first_slot + split.size());
+                _slots.resize(first_slot + split.size());
+                parallel_for(0, split.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        bisect(split[i], children[2 * i], children[2 * i + 1], first_slot + i);
+                    }
+                }, _n_threads);
+                for (std::size_t i = 0; i < split.size(); ++i) {
+                    for (std::size_t v: _nodes[split[i]].vertices) remove_from_star(v, split[i]);
+                    for (std::size_t k = 2 * i; k < 2 * i + 2; ++k) {
+                        for (std::size_t v: _nodes[children[k]].vertices) _stars[v].push_back(children[k]);
+                    }
+                }
+                n_bisections += split.size();
+
+                // The children may have edges split earlier, and the elements around the split edges now have a
+                // hanging midpoint.
+                candidates = children;
+                for (std::size_t p: split) {
+                    const Node &parent = _nodes[p];
+                    const std::size_t a = parent.vertices[edges[parent.edge][0]];
+                    const std::size_t b = parent.vertices[edges[parent.edge][1]];
+                    for (std::size_t node: _stars[a]) {
+                        const auto &t = _nodes[node].vertices;
+                        if (std::find(t.begin(), t.end(), b) != t.end()) candidates.push_back(node);
+                    }
+                }
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+                hanging.assign(candidates.size(), 0);
+                parallel_for(0, candidates.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t i = begin; i < end; ++i) hanging[i] = has_split_edge(_nodes[candidates[i]]);
+                }, _n_threads);
+                split.clear();
+                for (std::size_t i = 0; i < candidates.size(); ++i) if (hanging[i]) split.push_back(candidates[i]);
+
+            }
+
+            return n_bisections;
+
+        }
+
+        /**
+         * Undo bisections among the marked elements: a midpoint is removed, and every element around it merged
+         * with its sibling, if all those elements are marked and were created by splitting the midpoint's edge.
+         * Merging reverses one level; call again to coarsen further. Elements are renumbered.
+         * @param marked one flag per element of the mesh, non-zero if the element may be merged.
+         * @return the number of merges performed.
+         */
+        std::size_t coarsen(const std::vector<char> &marked) {
+
+            if (marked.size() != _mesh.n_tetrahedra()) {
+                throw std::invalid_argument("MeshRefiner: one marker per element is required");
+            }
+
+            // Merging moves elements between slots, so carry the markers on the forest.
+            std::vector<char> flagged(_nodes.size(), 0);
+            std::vector<std::size_t> midpoints;
+            for (std::size_t e = 0; e < marked.size(); ++e) {
+                if (!marked[e]) continue;
+                const Node &node = _nodes[_slots[e]];
+                flagged[_slots[e]] = 1;
+                if (node.parent != none) midpoints.push_back(_nodes[node.parent].midpoint);
+            }
+            std::sort(midpoints.begin(), midpoints.end());
+            midpoints.erase(std::unique(midpoints.begin(), midpoints.end()), midpoints.end());
+
+            // A removable midpoint's elements are all children of its own bisections, so the groups of different
+            // midpoints are disjoint and can be decided independently.
+            std::vector<char> removable(midpoints.size(), 0);
+            parallel_for(0, midpoints.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) removable[i] = is_removable(midpoints[i], flagged);
+            }, _n_threads);
+
+            std::size_t n_merges = 0;
+            for (std::size_t i = 0; i < midpoints.size(); ++i) {
+                if (!removable[i]) continue;
+                const std::size_t m = midpoints[i];
+                std::vector<std::size_t> parents;
+                for (std::size_t node: _stars[m]) parents.push_back(_nodes[node].parent);
+                std::sort(parents.begin(), parents.end());
+                parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+                for (std::size_t p: parents) merge(p);
+                n_merges += parents.size();
+                _midpoints.erase(edge_key(_origins[m][0], _origins[m][1]));
+                _origins[m] = {m, m};
+                _free_vertices.push_back(m);
+            }
+
+            return n_merges;
+
+        }
+
+    private:
+
+        /** The largest vertex count for which an edge packs into a 64 bit key. */
+        static constexpr std::size_t max_vertices = std::size_t(1) << 32;
+
+        /** The local vertex pairs of the six edges of a tetrahedron. */
+        static constexpr std::array<std::array<std::size_t, 2>, 6> edges = {{{0, 1}, {0, 2}, {0, 3},
+                                                                               {1, 2}, {1, 3}, {2, 3}}};
+
+        /**
+         * An element of the bisection forest: a leaf is an element of the mesh.
+         */
+        struct Node {
+
+            /** The vertices. */
+            std::array<std::size_t, 4> vertices = {0, 0, 0, 0};
+
+            /** The element this one was bisected from. */
+            std::size_t parent = none;
+
+            /** The two halves, if this element was bisected. */
+            std::array<std::size_t, 2> children = {none, none};
+
+            /** The vertex this element was bisected at. */
+            std::size_t midpoint = none;
+
+            /** The slot in the mesh if this is a leaf. */
+            std::size_t slot = none;
+
+            /** The number of bisections from the root. */
+            std::size_t level = 0;
+
+            /** The cached tetrahedron volume. */
+            Real volume = Real(0);
+
+            /** The cached length of the longest edge. */
+            Real longest = Real(0);
+
+            /** The local index of the longest edge. */
+            std::size_t edge = 0;
+
+        };
+
+        /**
+         * Pack an edge into a hash key, independent of its direction.
+         */
+        static std::uint64_t edge_key(std::size_t a, std::size_t b) {
+            if (a > b) std::swap(a, b);
+            return std::uint64_t(a) << 32 | std::uint64_t(b);
+        }
+
+        std::uint64_t longest_edge_key(const Node &node) const {
+            return edge_key(node.vertices[edges[node.edge][0]], node.vertices[edges[node.edge][1]]);
+        }
+
+        /**
+         * Cache the volume and the longest edge of an element; among edges of equal length the one with the larger
+         * key wins, so neighbours agree.
+         */
+        void update_geometry(Node &node) const {
+
+            std::array<Vector3D<Real>, 4> r;
+            for (std::size_t k = 0; k < 4; ++k) r[k] = _mesh.vertices[node.vertices[k]];
+            node.volume = tetrahedron_volume(r[0], r[1], r[2], r[3]);
+            node.edge = 0;
+            node.longest = edge_length(r[0], r[1]);
+            for (std::size_t k = 1; k < 6; ++k) {
+                const Real length = edge_length(r[edges[k][0]], r[edges[k][1]]);
+                if (length > node.longest ||
+                    (length == node.longest && edge_key(node.vertices[edges[k][0]], node.vertices[edges[k][1]]) >
+                                               longest_edge_key(node))) {
+                    node.edge = k;
+                    node.longest = length;
+                }
+            }
+
+        }
+
+        /**
+         * Test whether an element has an edge with a midpoint, i.e. a hanging vertex.
+         */
+        bool has_split_edge(const Node &node) const {
+
+            for (const auto &edge: edges) {
+                const std::uint64_t key = edge_key(node.vertices[edge[0]], node.vertices[edge[1]]);
+                if (_midpoints.find(key) != _midpoints.end()) return true;
+            }
+            return false;
+
+        }
+
+        /**
+         * Create the midpoint vertex of an edge, reusing the slot of a removed one if there is any.
+         */
+        std::size_t add_midpoint(std::uint64_t key) {
+
+            const std::size_t a = key >> 32, b = key & 0xFFFFFFFFu;
+            const Vector3D<Real> r = edge_center(_mesh.vertices[a], _mesh.vertices[b]);
+            if (!_free_vertices.empty()) {
+                const std::size_t v = _free_vertices.back();
+                _free_vertices.pop_back();
+                _mesh.vertices.set(v, r);
+                _origins[v] = {a, b};
+                return v;
+            }
+            const std::size_t v = _mesh.n_vertices();
+            if (v >= max_vertices) throw std::length_error("MeshRefiner: too many vertices");
+            _mesh.vertices.push_back(r);
+            _origins.push_back({a, b});
+            _stars.emplace_back();
+            return v;
+
+        }
+
+        std::size_t add_node() {
+
+            if (!_free_nodes.empty()) {
+                const std::size_t node = _free_nodes.back();
+                _free_nodes.pop_back();
+                return node;
+            }
+            _nodes.emplace_back();
+            return _nodes.size() - 1;
+
+        }
+
+        /**
+         * Split an element at the midpoint of its longest edge: the first child replaces the far endpoint of the
+         * edge by the midpoint, the second the near one, so both keep the orientation of the parent.
+         */
+        void bisect(std::size_t p, std::size_t first, std::size_t second, std::size_t slot) {
+
+            Node &parent = _nodes[p];
+            const std::size_t i = edges[parent.edge][0], j = edges[parent.edge][1];
+            const std::size_t m = _midpoints.find(longest_edge_key(parent))->second;
+
+            std::array<std::size_t, 2> halves = {first, second};
+            std::array<std::size_t, 2> slots = {parent.slot, slot};
+            for (std::size_t h = 0; h < 2; ++h) {
+                Node &child = _nodes[halves[h]];
+                child.vertices = parent.vertices;
+                child.vertices[h == 0 ? j : i] = m;
+                child.parent = p;
+                child.children = {none, none};
+                child.midpoint = none;
+                child.slot = slots[h];
+                child.level = parent.level + 1;
+                update_geometry(child);
+                _mesh.tetrahedra[child.slot] = child.vertices;
+                _slots[child.slot] = halves[h];
+            }
+            parent.children = halves;
+            parent.midpoint = m;
+            parent.slot = none;
+
+        }
+
+        /**
+         * Test whether every element around a midpoint is a marked child of a bisection at it whose sibling is a
+         * marked element too.
+         */
+        bool is_removable(std::size_t m, const std::vector<char> &flagged) const {
+
+            if (_stars[m].empty()) return false;
+            for (std::size_t node: _stars[m]) {
+                const std::size_t p = _nodes[node].parent;
+                if (p == none || _nodes[p].midpoint != m) return false;
+                for (std::size_t child: _nodes[p].children) {
+                    if (_nodes[child].slot == none || !flagged[child]) return false;
+                }
+            }
+            return true;
+
+        }
+
+        /**
+         * Replace the two children of an element by the element: it takes the slot of the first child, and the
+         * last element of the mesh fills the slot of the second.
+         */
+        void merge(std::size_t p) {
+
+            Node &parent = _nodes[p];
+            for (std::size_t child: parent.children) {
+                for (std::size_t v: _nodes[child].vertices) remove_from_star(v, child);
+            }
+            parent.slot = _nodes[parent.children[0]].slot;
+            _mesh.tetrahedra[parent.slot] = parent.vertices;
+            _slots[parent.slot] = p;
+
+            const std::size_t slot = _nodes[parent.children[1]].slot, last = _mesh.n_tetrahedra() - 1;
+            if (slot != last) {
+                _mesh.tetrahedra[slot] = _mesh.tetrahedra[last];
+                _slots[slot] = _slots[last];
+                _nodes[_slots[slot]].slot = slot;
+            }
+            _mesh.tetrahedra.pop_back();
+            _slots.pop_back();
+
+            for (std::size_t child: parent.children) {
+                _nodes[child] = Node();
+                _free_nodes.push_back(child);
+            }
+            parent.children = {none, none};
+            parent.midpoint = none;
+            for (std::size_t v: parent.vertices) _stars[v].push_back(p);
+
+        }
+
+        void remove_from_star(std::size_t v, std::size_t node) {
+
+            std::vector<std::size_t> &star = _stars[v];
+            auto it = std::find(star.begin(), star.end(), node);
+            *it = star.back();
+            star.pop_back();
+
+        }
+
+        TetrahedralMesh<Real> &_mesh;
+        std::size_t _n_threads;
+
+        /** The bisection forest, with free slots reused. */
+        std::vector<Node> _nodes;
+        std::vector<std::size_t> _free_nodes;
+
+        /** The forest node of each element of the mesh. */
+        std::vector<std::size_t> _slots;
+
+        /** The leaves around each vertex. */
+        std::vector<std::vector<std::size_t>> _stars;
+
+        /** The endpoints of the edge each vertex is the midpoint of. */
+        std::vector<std::array<std::size_t, 2>> _origins;
+        std::vector<std::size_t> _free_vertices;
+
+        /** The midpoint of each split edge. */
+        std::unordered_map<std::uint64_t, std::size_t> _midpoints;
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
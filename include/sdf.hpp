@@ -0,0 +1,485 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+#include <raycast.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * The part of a triangle on which a closest point lies.
+     */
+    enum class TriangleFeature : std::uint8_t {
+        vertex1, vertex2, vertex3, edge12, edge23, edge31, face
+    };
+
+    /**
+     * The closest point of a triangle to a query point, and the feature it lies on.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct ClosestPoint {
+
+        /** The closest point. */
+        Vector3D<Real> point;
+
+        /** The vertex, edge or interior of the triangle containing the point. */
+        TriangleFeature feature = TriangleFeature::face;
+
+    };
+
+    /**
+     * Return the point of a triangle closest to a query point, by classifying the query point against the Voronoi
+     * regions of the triangle's vertices, edges and face (Ericson, Real-Time Collision Detection, 5.1.5).
+     * @param p the query point.
+     * @param r1 vector representing a point on the triangle.
+     * @param r2 vector representing a point on the triangle.
+     * @param r3 vector representing a point on the triangle.
+     * @return the closest point and its feature.
+     */
+    template<typename Real>
+    ClosestPoint<Real> closest_point_on_triangle(const Vector3D<Real> &p, const Vector3D<Real> &r1,
+                                                 const Vector3D<Real> &r2, const Vector3D<Real> &r3) {
+
+        const Vector3D<Real> e12 = r2 - r1, e13 = r3 - r1;
+
+        const Vector3D<Real> p1 = p - r1;
+        const Real d1 = dot(e12, p1), d2 = dot(e13, p1);
+        if (d1 <= Real(0) && d2 <= Real(0)) return {r1, TriangleFeature::vertex1};
+
+        const Vector3D<Real> p2 = p - r2;
+        const Real d3 = dot(e12, p2), d4 = dot(e13, p2);
+        if (d3 >= Real(0) && d4 <= d3) return {r2, TriangleFeature::vertex2};
+
+        const Real v3 = d1 * d4 - d3 * d2;
+        if (v3 <= Real(0) && d1 >= Real(0) && d3 <= Real(0)) {
+            return {r1 + (d1 / (d1 - d3)) * e12, TriangleFeature::edge12};
+        }
+
+        const Vector3D<Real> p3 = p - r3;
+        const Real d5 = dot(e12, p3), d6 = dot(e13, p3);
+        if (d6 >= Real(0) && d5 <= d6) return {r3, TriangleFeature::vertex3};
+
+        const Real v2 = d5 * d2 - d1 * d6;
+        if (v2 <= Real(0) && d2 >= Real(0) && d6 <= Real(0)) {
+            return {r1 + (d2 / (d2 - d6)) * e13, TriangleFeature::edge31};
+        }
+
+        const Real v1 = d3 * d6 - d5 * d4;
+        if (v1 <= Real(0) && d4 - d3 >= Real(0) && d5 - d6 >= Real(0)) {
+            return {r2 + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (r3 - r2), TriangleFeature::edge23};
+        }
+
+        const Real total = v1 + v2 + v3;
+        if (total == Real(0)) return {r1, TriangleFeature::vertex1};
+        return {r1 + (v2 / total) * e12 + (v3 / total) * e13, TriangleFeature::face};
+
+    }
+
+    /**
+     * A regular grid of points origin + spacing (i, j, k), numbered with i fastest.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct RegularGrid {
+
+        /** The position of point (0, 0, 0). */
+        Vector3D<Real> origin;
+
+        /** The distance between neighbouring points. */
+        Real spacing = Real(1);
+
+        /** The number of points along x. */
+        std::size_t nx = 0;
+
+        /** The number of points along y. */
+        std::size_t ny = 0;
+
+        /** The number of points along z. */
+        std::size_t nz = 0;
+
+        /**
+         * Retrieve the number of points.
+         * @return the number of points.
+         */
+        [[nodiscard]] inline std::size_t size() const { return nx * ny * nz; }
+
+        /**
+         * Retrieve the index of a point.
+         * @return the index of point (i, j, k).
+         */
+        [[nodiscard]] inline std::size_t index(std::size_t i, std::size_t j, std::size_t k) const {
+            return i + nx * (j + ny * k);
+        }
+
+        /**
+         * Retrieve the position of a point.
+         * @return the position of point (i, j, k).
+         */
+        [[nodiscard]] inline Vector3D<Real> point(std::size_t i, std::size_t j, std::size_t k) const {
+            return origin + Vector3D<Real>(Real(i) * spacing, Real(j) * spacing, Real(k) * spacing);
+        }
+
+    };
+
+    /**
+     * The nearest point of a surface to a query point.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct SurfacePoint {
+
+        /** Marks an empty surface. */
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        /** The triangle containing the nearest point, or `none`. */
+        std::size_t triangle = none;
+
+        /** The nearest point. */
+        Vector3D<Real> point;
+
+        /** The signed distance to the nearest point: negative inside the surface, positive outside. */
+        Real distance = std::numeric_limits<Real>::infinity();
+
+    };
+
+    /**
+     * Signed distances to a closed, consistently wound triangle surface whose triangle_normal()s point outwards.
+     *
+     * The distance is that to the nearest point of the surface, found through a bounding volume hierarchy. The sign
+     * comes from the angle-weighted pseudo-normal of the feature containing the nearest point (Baerentzen & Aanaes):
+     * the face normal inside a triangle, the sum of the two face normals on an edge and the sum of the incident face
+     * normals weighted by their angles at a vertex. Unlike the face normal alone, this gives the correct sign also
+     * when the nearest point is a vertex or lies on an edge.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class SignedDistanceField {
+
+    public:
+
+        /**
+         * Build the hierarchy and the pseudo-normals.
+         * @param mesh the surface mesh; shared vertices must be shared indices.
+         * @param leaf_size the maximum number of triangles in a leaf of the hierarchy.
+         */
+        explicit SignedDistanceField(const TriangleMesh<Real> &mesh, std::size_t leaf_size = 4)
+                : _bvh(mesh, leaf_size) {
+
+            using std::acos;
+
+            const std::size_t n = mesh.n_triangles();
+
+            std::vector<Vector3D<Real>> face_normals(n);
+            std::vector<Vector3D<Real>> vertex_normals(mesh.n_vertices(), Vector3D<Real>(Real(0), Real(0), Real(0)));
+            for (std::size_t t = 0; t < n; ++t) {
+                const auto &tri = mesh.triangles[t];
+                face_normals[t] = triangle_normal(mesh.vertices[tri[0]], mesh.vertices[tri[1]],
+                                                  mesh.vertices[tri[2]]);
+                for (std::size_t a = 0; a < 3; ++a) {
+                    const Vector3D<Real> r = mesh.vertices[tri[a]];
+                    const Vector3D<Real> u = normalised(mesh.vertices[tri[(a + 1) % 3]] - r);
+                    const Vector3D<Real> v = normalised(mesh.vertices[tri[(a + 2) % 3]] - r);
+                    const Real c = std::clamp(dot(u, v), Real(-1), Real(1));
+                    vertex_normals[tri[a]] = vertex_normals[tri[a]] + acos(c) * face_normals[t];
+                }
+            }
+
+            // The triangles sharing an edge are adjacent once the directed edges are sorted by their end points.
+            std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> edges;
+            edges.reserve(3 * n);
+            for (std::size_t t = 0; t < n; ++t) {
+                const auto &tri = mesh.triangles[t];
+                for (std::size_t e = 0; e < 3; ++e) {
+                    const std::size_t a = tri[e], b = tri[(e + 1) % 3];
+                    edges.emplace_back(std::min(a, b), std::max(a, b), 3 * t + e);
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+            std::vector<Vector3D<Real>> edge_normals(3 * n);
+            for (std::size_t first = 0, last = 0; first < edges.size(); first = last) {
+                Vector3D<Real> sum(Real(0), Real(0), Real(0));
+                for (last = first; last < edges.size() && std::get<0>(edges[last]) == std::get<0>(edges[first]) &&
+                                   std::get<1>(edges[last]) == std::get<1>(edges[first]); ++last) {
+                    sum = sum + face_normals[std::get<2>(edges[last]) / 3];
+                }
+                for (std::size_t e = first; e < last; ++e) edge_normals[std::get<2>(edges[e])] = sum;
+            }
+
+            // Copy everything in hierarchy order.
+            const std::vector<std::size_t> &order = _bvh.triangles();
+            _r1.resize(n);
+            _r2.resize(n);
+            _r3.resize(n);
+            _normals.resize(7 * n);
+            for (std::size_t p = 0; p < n; ++p) {
+                const std::size_t t = order[p];
+                const auto &tri = mesh.triangles[t];
+                _r1.set(p, mesh.vertices[tri[0]]);
+                _r2.set(p, mesh.vertices[tri[1]]);
+                _r3.set(p, mesh.vertices[tri[2]]);
+                // Indexed as TriangleFeature: vertex1, vertex2, vertex3, edge12, edge23, edge31, face.
+                for (std::size_t a = 0; a < 3; ++a) {
+                    _normals.set(7 * p + a, vertex_normals[tri[a]]);
+                    _normals.set(7 * p + 3 + a, edge_normals[3 * t + a]);
+                }
+                _normals.set(7 * p + 6, face_normals[t]);
+            }
+
+        }
+
+        /**
+         * Find the nearest point of the surface.
+         * @param point the query point.
+         * @return the nearest point, its triangle and the signed distance.
+         */
+        [[nodiscard]] inline SurfacePoint<Real> nearest(const Vector3D<Real> &point) const {
+            std::size_t position;
+            return search(point, position);
+        }
+
+        /**
+         * Return the signed distance of a point to the surface.
+         * @param point the query point.
+         * @return the signed distance: negative inside the surface, positive outside.
+         */
+        [[nodiscard]] inline Real distance(const Vector3D<Real> &point) const { return nearest(point).distance; }
+
+        /**
+         * Evaluate the signed distances of a batch of points.
+         * @param points the query points.
+         * @param distances the signed distance of each point.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void distance(const Vector3DSoA<Real> &points, Real *distances, std::size_t n_threads = 0) const {
+            parallel_for(0, points.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) distances[i] = nearest(points[i]).distance;
+            }, n_threads, 64);
+        }
+
+        /**
+         * Evaluate the signed distances of the points of a regular grid.
+         *
+         * Points within `band` grid spacings of a triangle's bounding box are evaluated exactly. The nearest
+         * triangles are then propagated outwards by fast sweeping: sweeps along each axis in both directions offer
+         * every point the nearest triangle of its predecessor, keeping it when it is nearer than the point's
+         * current one, until a round of sweeps changes nothing. The sign is propagated along with the triangle;
+         * since two neighbouring points on opposite sides of the surface are both within one spacing of it, the
+         * sign only ever changes inside the exactly evaluated band. Away from the band the distances are those to
+         * the best triangle found: never less than the exact distance and, unlike the O(spacing) error of fast
+         * marching, usually exact, with the largest errors a fraction of the spacing on smooth curved surfaces.
+         * @param grid the grid.
+         * @param band the width of the exactly evaluated band, in grid spacings (at least one).
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         * @return the signed distance of each grid point, indexed by grid.index().
+         */
+        [[nodiscard]] std::vector<Real> distance(const RegularGrid<Real> &grid, std::size_t band = 1,
+                                                 std::size_t n_threads = 0) const {
+
+            using std::fabs;
+            using std::sqrt;
+
+            const std::size_t n = grid.size();
+            std::vector<Real> distances(n, std::numeric_limits<Real>::infinity());
+            std::vector<std::size_t> nearest_triangle(n, SurfacePoint<Real>::none);
+            std::vector<char> exact(n, 0);
+            if (n == 0 || _r1.size() == 0) return distances;
+            band = std::max<std::size_t>(1, band);
+
+            // Mark the band around the bounding box of each triangle.
+            const std::array<double, 3> origin = {static_cast<double>(grid.origin.x()),
+                                                  static_cast<double>(grid.origin.y()),
+                                                  static_cast<double>(grid.origin.z())};
+            const double h = static_cast<double>(grid.spacing);
+            const std::array<std::size_t, 3> extent = {grid.nx, grid.ny, grid.nz};
+            for (std::size_t p = 0; p < _r1.size(); ++p) {
+                std::array<std::size_t, 3> first, last;
+                bool outside = false;
+                for (std::size_t a = 0; a < 3; ++a) {
+                    const double c1 = static_cast<double>(a == 0 ? _r1.x()[p] : (a == 1 ? _r1.y()[p] : _r1.z()[p]));
+                    const double c2 = static_cast<double>(a == 0 ? _r2.x()[p] : (a == 1 ? _r2.y()[p] : _r2.z()[p]));
+                    const double c3 = static_cast<double>(a == 0 ? _r3.x()[p] : (a == 1 ? _r3.y()[p] : _r3.z()[p]));
+                    const double lo = std::floor((std::min({c1, c2, c3}) - origin[a]) / h) - double(band);
+                    const double hi = std::ceil((std::max({c1, c2, c3}) - origin[a]) / h) + double(band);
+                    if (hi < 0.0 || lo > double(extent[a] - 1)) outside = true;
+                    first[a] = static_cast<std::size_t>(std::max(lo, 0.0));
+                    last[a] = static_cast<std::size_t>(std::min(hi, double(extent[a] - 1)));
+                }
+                if (outside) continue;
+                for (std::size_t k = first[2]; k <= last[2]; ++k) {
+                    for (std::size_t j = first[1]; j <= last[1]; ++j) {
+                        for (std::size_t i = first[0]; i <= last[0]; ++i) exact[grid.index(i, j, k)] = 1;
+                    }
+                }
+            }
+
+            std::vector<signed char> signs(n, 1);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t c = begin; c < end; ++c) {
+                    if (!exact[c]) continue;
+                    const std::size_t i = c % grid.nx, j = (c / grid.nx) % grid.ny, k = c / (grid.nx * grid.ny);
+                    const SurfacePoint<Real> s = search(grid.point(i, j, k), nearest_triangle[c]);
+                    distances[c] = fabs(s.distance);
+                    signs[c] = s.distance < Real(0) ? -1 : 1;
+                }
+            }, n_threads, 64);
+
+            // Fast sweeping. Each line along the sweep axis is independent, so the lines run in parallel. A point only
+            // ever takes a strictly nearer triangle, so the rounds terminate.
+            for (bool any = true; any;) {
+                std::atomic<bool> changed = false;
+                for (std::size_t axis = 0; axis < 3; ++axis) {
+                    const std::size_t length = extent[axis];
+                    const std::size_t stride = axis == 0 ? 1 : (axis == 1 ? grid.nx : grid.nx * grid.ny);
+                    const std::size_t n_lines = n / length;
+                    for (int direction: {1, -1}) {
+                        parallel_for(0, n_lines, [&](std::size_t begin, std::size_t end, std::size_t) {
+                            bool local = false;
+                            for (std::size_t line = begin; line < end; ++line) {
+                                // The first point of the line: split the line number into the two other indices.
+                                const std::size_t start = axis == 0 ? line * grid.nx :
+                                                          (axis == 1 ? (line % grid.nx) +
+                                                                       (line / grid.nx) * grid.nx * grid.ny : line);
+                                for (std::size_t s = 1; s < length; ++s) {
+                                    const std::size_t step = direction > 0 ? s : length - 1 - s;
+                                    const std::size_t c = start + step * stride;
+                                    const std::size_t previous = direction > 0 ? c - stride : c + stride;
+                                    const std::size_t p = nearest_triangle[previous];
+                                    if (exact[c] || p == SurfacePoint<Real>::none || p == nearest_triangle[c]) {
+                                        continue;
+                                    }
+                                    const std::size_t i = c % grid.nx, j = (c / grid.nx) % grid.ny;
+                                    const std::size_t k = c / (grid.nx * grid.ny);
+                                    const Vector3D<Real> r = grid.point(i, j, k);
+                                    const Real d = sqrt(norm_squared(r - closest_point_on_triangle(
+                                            r, _r1[p], _r2[p], _r3[p]).point));
+                                    if (d < distances[c]) {
+                                        distances[c] = d;
+                                        nearest_triangle[c] = p;
+                                        signs[c] = signs[previous];
+                                        local = true;
+                                    }
+                                }
+                            }
+                            if (local) changed = true;
+                        }, n_threads, 16);
+                    }
+                }
+                any = changed;
+            }
+
+            for (std::size_t c = 0; c < n; ++c) if (signs[c] < 0) distances[c] = -distances[c];
+            return distances;
+
+        }
+
+    private:
+
+        TriangleBvh<Real> _bvh;
+        Vector3DSoA<Real> _r1;
+        Vector3DSoA<Real> _r2;
+        Vector3DSoA<Real> _r3;
+
+        /** The pseudo-normals of the seven features of each triangle, in hierarchy order. */
+        Vector3DSoA<Real> _normals;
+
+        /**
+         * Find the nearest point of the surface and the hierarchy position of its triangle.
+         */
+        SurfacePoint<Real> search(const Vector3D<Real> &point, std::size_t &position) const {
+
+            using std::sqrt;
+
+            SurfacePoint<Real> result;
+            position = SurfacePoint<Real>::none;
+            const std::vector<BvhNode> &nodes = _bvh.nodes();
+            if (nodes.empty()) return result;
+
+            const std::array<double, 3> q = {static_cast<double>(point.x()), static_cast<double>(point.y()),
+                                             static_cast<double>(point.z())};
+            auto box_distance = [&](const BvhNode &node) {
+                double d2 = 0.0;
+                for (std::size_t a = 0; a < 3; ++a) {
+                    const double d = std::max({node.lower[a] - q[a], q[a] - node.upper[a], 0.0});
+                    d2 += d * d;
+                }
+                return d2;
+            };
+
+            std::size_t best = SurfacePoint<Real>::none;
+            ClosestPoint<Real> best_point;
+            Real best_d2 = std::numeric_limits<Real>::infinity();
+            double bound = std::numeric_limits<double>::infinity();
+
+            std::array<std::pair<std::size_t, double>, 256> stack;
+            std::size_t top = 0;
+            stack[top++] = {0, box_distance(nodes[0])};
+            while (top > 0) {
+
+                const auto [current, lower] = stack[--top];
+                if (lower > bound) continue;
+                const BvhNode &node = nodes[current];
+
+                if (node.is_leaf()) {
+                    for (std::size_t p = node.begin; p < node.end; ++p) {
+                        const ClosestPoint<Real> c = closest_point_on_triangle(point, _r1[p], _r2[p], _r3[p]);
+                        const Real d2 = norm_squared(point - c.point);
+                        if (d2 < best_d2) {
+                            best_d2 = d2;
+                            best = p;
+                            best_point = c;
+                            bound = static_cast<double>(d2) * (1.0 + 1E-12);
+                        }
+                    }
+                    continue;
+                }
+
+                // Visit the nearer child first.
+                const std::size_t a = node.children[0], b = node.children[1];
+                const double da = box_distance(nodes[a]), db = box_distance(nodes[b]);
+                if (da <= db) {
+                    stack[top++] = {b, db};
+                    stack[top++] = {a, da};
+                } else {
+                    stack[top++] = {a, da};
+                    stack[top++] = {b, db};
+                }
+
+            }
+
+            position = best;
+            result.triangle = _bvh.triangles()[best];
+            result.point = best_point.point;
+            result.distance = sign(best, best_point, point) * sqrt(best_d2);
+            return result;
+
+        }
+
+        /**
+         * The sign of the distance from the nearest point on a feature of the triangle at position p.
+         */
+        Real sign(std::size_t p, const ClosestPoint<Real> &nearest, const Vector3D<Real> &point) const {
+            const Vector3D<Real> normal = _normals[7 * p + static_cast<std::size_t>(nearest.feature)];
+            return dot(point - nearest.point, normal) < Real(0) ? Real(-1) : Real(1);
+        }
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,476 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+#include <predicates.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * The vertex relocation rule of a MeshSmoother.
+     */
+    enum class SmoothingMethod {
+
+        /** Move each vertex towards the centroid of its neighbours, whatever the quality. */
+        Laplacian,
+
+        /** Move towards the centroid only if the worst element around the vertex does not get worse. */
+        SmartLaplacian,
+
+        /** Descend along the gradient of the sum of the inverse mean ratios of the elements around the vertex. */
+        Gradient
+
+    };
+
+    /**
+     * Options of MeshSmoother::smooth().
+     */
+    struct SmoothingOptions {
+
+        /** The relocation rule. */
+        SmoothingMethod method = SmoothingMethod::SmartLaplacian;
+
+        /** The maximum number of sweeps over the vertices. */
+        std::size_t max_sweeps = 10;
+
+        /** The fraction of the way to the centroid that the Laplacian methods move a vertex. */
+        double relaxation = 1.0;
+
+        /** A vertex moving by less than this fraction of its mean edge length is not revisited until a neighbour
+         *  moves. */
+        double tolerance = 1E-4;
+
+    };
+
+    /**
+     * What a call to MeshSmoother::smooth() did.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    struct SmoothingStatistics {
+
+        /** The number of sweeps performed. */
+        std::size_t n_sweeps = 0;
+
+        /** The number of vertex moves accepted. */
+        std::size_t n_moves = 0;
+
+        /** The number of vertex moves rejected because an element would have inverted or lost quality. */
+        std::size_t n_rejected = 0;
+
+        /** The smallest element mean ratio before and after smoothing. */
+        Real min_quality_before = Real(0);
+        Real min_quality_after = Real(0);
+
+        /** The average element mean ratio before and after smoothing. */
+        Real mean_quality_before = Real(0);
+        Real mean_quality_after = Real(0);
+
+    };
+
+    /**
+     * Return the mean ratio of a tetrahedron, as tetrahedron_quality(), signed by its orientation: positive for
+     * positively oriented elements (orient3d(r1, r2, r3, r4) > 0), negative for inverted and zero for flat ones.
+     * @param r1 vector representing a point on the tetrahedron.
+     * @param r2 vector representing a point on the tetrahedron.
+     * @param r3 vector representing a point on the tetrahedron.
+     * @param r4 vector representing a point on the tetrahedron.
+     * @return the signed mean ratio, in [-1, 1].
+     */
+    template<typename Real>
+    Real signed_mean_ratio(const Vector3D<Real> &r1, const Vector3D<Real> &r2, const Vector3D<Real> &r3,
+                           const Vector3D<Real> &r4) {
+
+        using std::cbrt;
+
+        const int orientation = orient3d(r1, r2, r3, r4);
+        if (orientation == 0) return Real(0);
+        Real six_volume = dot(cross(r2 - r1, r3 - r1), r4 - r1);
+        if (six_volume < Real(0)) six_volume = -six_volume;
+        const Real sq_sum = norm_squared(r2 - r1) + norm_squared(r3 - r1) + norm_squared(r4 - r1) +
+                            norm_squared(r3 - r2) + norm_squared(r4 - r2) + norm_squared(r4 - r3);
+        const Real ratio = Real(12) * cbrt(six_volume * six_volume / Real(4)) / sq_sum;
+        return orientation > 0 ? ratio : -ratio;
+
+    }
+
+    /**
+     * Smoothing of the interior vertices of a tetrahedral mesh to improve the mean ratio of its elements.
+     *
+     * Vertices on the boundary (on a face belonging to a single element) stay fixed, as do vertices pinned with
+     * fix(). The free vertices are coloured so that no two vertices of one colour share an element; a sweep visits
+     * the colours in turn and relocates the vertices of a colour in parallel, each touching only its own star of
+     * elements. The mean ratio of every element is cached and updated only for the stars of moved vertices, and a
+     * vertex is revisited only if it or one of its neighbours moved in the previous sweep.
+     *
+     * No move is ever accepted that makes a positively oriented element flat or inverted, as decided by the exact
+     * orient3d(): a Laplacian step that would is halved until it does not, or abandoned.
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class MeshSmoother {
+
+    public:
+
+        /**
+         * Build the vertex stars, the boundary and the colouring of a mesh.
+         * @param mesh the mesh, whose vertices smooth() moves; it must outlive the smoother and keep its topology.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        explicit MeshSmoother(TetrahedralMesh<Real> &mesh, std::size_t n_threads = 0)
+                : _mesh(mesh), _n_threads(n_threads) {
+
+            const std::size_t n_vertices = mesh.n_vertices();
+            const std::size_t n = mesh.n_tetrahedra();
+
+            // The elements around each vertex.
+            _star_offsets.assign(n_vertices + 1, 0);
+            for (const auto &t: mesh.tetrahedra) for (std::size_t v: t) ++_star_offsets[v + 1];
+            for (std::size_t v = 0; v < n_vertices; ++v) _star_offsets[v + 1] += _star_offsets[v];
+            _stars.resize(_star_offsets[n_vertices]);
+            std::vector<std::size_t> fill(_star_offsets.begin(), _star_offsets.end() - 1);
+            for (std::size_t e = 0; e < n; ++e) for (std::size_t v: mesh.tetrahedra[e]) _stars[fill[v]++] = e;
+
+            // The vertices sharing an element with each vertex.
+            std::vector<std::vector<std::size_t>> neighbours(n_vertices);
+            parallel_for(0, n_vertices, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t v = begin; v < end; ++v) {
+                    for (std::size_t s = _star_offsets[v]; s < _star_offsets[v + 1]; ++s) {
+                        for (std::size_t w: _mesh.tetrahedra[_stars[s]]) if (w != v) neighbours[v].push_back(w);
+                    }
+                    std::sort(neighbours[v].begin(), neighbours[v].end());
+                    neighbours[v].erase(std::unique(neighbours[v].begin(), neighbours[v].end()), neighbours[v].end());
+                }
+            }, _n_threads);
+            _adjacency_offsets.assign(n_vertices + 1, 0);
+            for (std::size_t v = 0; v < n_vertices; ++v) {
+                _adjacency_offsets[v + 1] = _adjacency_offsets[v] + neighbours[v].size();
+            }
+            _adjacency.reserve(_adjacency_offsets[n_vertices]);
+            for (const auto &list: neighbours) _adjacency.insert(_adjacency.end(), list.begin(), list.end());
+
+            // Boundary faces appear once among the sorted faces; vertices without elements stay put too.
+            _fixed.assign(n_vertices, 0);
+            std::vector<std::array<std::size_t, 3>> faces(4 * n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t e = begin; e < end; ++e) {
+                    for (std::size_t f = 0; f < 4; ++f) {
+                        std::array<std::size_t, 3> key = {mesh.tetrahedra[e][(f + 1) % 4],
+                                                          mesh.tetrahedra[e][(f + 2) % 4],
+                                                          mesh.tetrahedra[e][(f + 3) % 4]};
+                        std::sort(key.begin(), key.end());
+                        faces[4 * e + f] = key;
+                    }
+                }
+            }, _n_threads);
+            std::sort(faces.begin(), faces.end());
+            for (std::size_t k = 0; k < faces.size();) {
+                std::size_t m = k + 1;
+                while (m < faces.size() && faces[m] == faces[k]) ++m;
+                if (m - k == 1) for (std::size_t v: faces[k]) _fixed[v] = 1;
+                k = m;
+            }
+            for (std::size_t v = 0; v < n_vertices; ++v) if (_star_offsets[v] == _star_offsets[v + 1]) _fixed[v] = 1;
+
+            colour();
+
+            _quality.resize(n);
+            parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t e = begin; e < end; ++e) _quality[e] = element_quality(e);
+            }, _n_threads);
+
+        }
+
+        /**
+         * Keep a vertex where it is.
+         * @param v the vertex.
+         */
+        void fix(std::size_t v) {
+            _fixed[v] = 1;
+        }
+
+        /**
+         * Test whether a vertex is kept where it is.
+         * @param v the vertex.
+         * @return true if the vertex is on the boundary or was fixed.
+         */
+        [[nodiscard]] bool is_fixed(std::size_t v) const {
+            return _fixed[v] != 0;
+        }
+
+        /**
+         * Retrieve the number of colours of the free vertices, i.e. the number of parallel phases of a sweep.
+         * @return the number of colours.
+         */
+        [[nodiscard]] std::size_t n_colours() const {
+            return _colour_offsets.size() - 1;
+        }
+
+        /**
+         * Retrieve the cached signed_mean_ratio() of every element.
+         * @return the element qualities.
+         */
+        [[nodiscard]] const std::vector<Real> &quality() const {
+            return _quality;
+        }
+
+        /**
+         * Smooth the mesh.
+         * @param options the method and its parameters.
+         * @return what was done.
+         */
+        SmoothingStatistics<Real> smooth(const SmoothingOptions &options = SmoothingOptions()) {
+
+            SmoothingStatistics<Real> statistics;
+            summarise(statistics.min_quality_before, statistics.mean_quality_before);
+
+            const std::size_t n_vertices = _mesh.n_vertices();
+            std::vector<char> active(n_vertices, 1), moved(n_vertices, 0);
+            const std::size_t n_threads = _n_threads == 0 ? default_thread_count() : _n_threads;
+            std::vector<std::size_t> moves(n_threads), rejected(n_threads);
+
+            for (std::size_t sweep = 0; sweep < options.max_sweeps; ++sweep) {
+
+                std::fill(moved.begin(), moved.end(), 0);
+                for (std::size_t c = 0; c + 1 < _colour_offsets.size(); ++c) {
+                    parallel_for(_colour_offsets[c], _colour_offsets[c + 1],
+                                 [&](std::size_t begin, std::size_t end, std::size_t thread) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            const std::size_t v = _coloured[i];
+                            if (_fixed[v] || !active[v]) continue;
+                            const int outcome = relocate(v, options);
+                            if (outcome > 0) {
+                                moved[v] = 1;
+                                ++moves[thread];
+                            } else if (outcome < 0) {
+                                ++rejected[thread];
+                            }
+                        }
+                    }, n_threads, 256);
+                }
+                ++statistics.n_sweeps;
+
+                // Revisit the vertices that moved and their neighbours.
+                bool any = false;
+                for (std::size_t v = 0; v < n_vertices; ++v) {
+                    char a = moved[v];
+                    for (std::size_t k = _adjacency_offsets[v]; k < _adjacency_offsets[v + 1] && !a; ++k) {
+                        a = moved[_adjacency[k]];
+                    }
+                    active[v] = a;
+                    any = any || a;
+                }
+                if (!any) break;
+
+            }
+
+            for (std::size_t t = 0; t < n_threads; ++t) {
+                statistics.n_moves += moves[t];
+                statistics.n_rejected += rejected[t];
+            }
+            summarise(statistics.min_quality_after, statistics.mean_quality_after);
+            return statistics;
+
+        }
+
+    private:
+
+        TetrahedralMesh<Real> &_mesh;
+        std::size_t _n_threads;
+
+        std::vector<std::size_t> _star_offsets;
+        std::vector<std::size_t> _stars;
+        std::vector<std::size_t> _adjacency_offsets;
+        std::vector<std::size_t> _adjacency;
+        std::vector<char> _fixed;
+
+        /** The vertices grouped by colour, and the start of each colour. */
+        std::vector<std::size_t> _coloured;
+        std::vector<std::size_t> _colour_offsets;
+
+        std::vector<Real> _quality;
+
+        [[nodiscard]] Real element_quality(std::size_t e) const {
+            const auto &t = _mesh.tetrahedra[e];
+            return signed_mean_ratio(_mesh.vertices[t[0]], _mesh.vertices[t[1]], _mesh.vertices[t[2]],
+                                     _mesh.vertices[t[3]]);
+        }
+
+        /**
+         * Greedy colouring of the vertices in index order: each takes the smallest colour none of its coloured
+         * neighbours has.
+         */
+        void colour() {
+
+            const std::size_t n_vertices = _mesh.n_vertices();
+            const std::size_t none = std::numeric_limits<std::size_t>::max();
+            std::vector<std::size_t> colours(n_vertices, none), taken;
+            std::size_t n_colours = 0;
+            for (std::size_t v = 0; v < n_vertices; ++v) {
+                taken.assign(n_colours + 1, 0);
+                for (std::size_t k = _adjacency_offsets[v]; k < _adjacency_offsets[v + 1]; ++k) {
+                    const std::size_t c = colours[_adjacency[k]];
+                    if (c != none) taken[c] = 1;
+                }
+                std::size_t c = 0;
+                while (taken[c]) ++c;
+                colours[v] = c;
+                n_colours = std::max(n_colours, c + 1);
+            }
+
+            _colour_offsets.assign(n_colours + 1, 0);
+            for (std::size_t c: colours) ++_colour_offsets[c + 1];
+            for (std::size_t c = 0; c < n_colours; ++c) _colour_offsets[c + 1] += _colour_offsets[c];
+            _coloured.resize(n_vertices);
+            std::vector<std::size_t> fill(_colour_offsets.begin(), _colour_offsets.end() - 1);
+            for (std::size_t v = 0; v < n_vertices; ++v) _coloured[fill[colours[v]]++] = v;
+
+        }
+
+        void summarise(Real &min_quality, Real &mean_quality) const {
+            min_quality = _quality.empty() ? Real(0) : _quality[0];
+            Real sum = Real(0);
+            for (const Real &q: _quality) {
+                min_quality = std::min(min_quality, q);
+                sum += q;
+            }
+            mean_quality = _quality.empty() ? Real(0) : sum / Real(double(_quality.size()));
+        }
+
+        /**
+         * Move vertex v to x if no positively oriented element of its star becomes flat or inverted, and, if
+         * `guard` is set, the worst element of the star does not get worse; write the new qualities to the cache.
+         */
+        bool try_move(std::size_t v, const Vector3D<Real> &x, bool guard) {
+
+            const Vector3D<Real> old = _mesh.vertices[v];
+            Real old_min = Real(1), new_min = Real(1);
+            _mesh.vertices.set(v, x);
+            for (std::size_t s = _star_offsets[v]; s < _star_offsets[v + 1]; ++s) {
+                const Real q = element_quality(_stars[s]);
+                const Real q_old = _quality[_stars[s]];
+                if (q_old > Real(0) && q <= Real(0)) {
+                    _mesh.vertices.set(v, old);
+                    return false;
+                }
+                old_min = std::min(old_min, q_old);
+                new_min = std::min(new_min, q);
+            }
+            if (guard && new_min < old_min) {
+                _mesh.vertices.set(v, old);
+                return false;
+            }
+            for (std::size_t s = _star_offsets[v]; s < _star_offsets[v + 1]; ++s) {
+                _quality[_stars[s]] = element_quality(_stars[s]);
+            }
+            return true;
+
+        }
+
+        /**
+         * The sum of the inverse mean ratios of the star of v and its gradient with respect to the position of v,
+         * or false if an element of the star is not positively oriented.
+         */
+        bool objective(std::size_t v, Real &f, Vector3D<Real> &gradient) const {
+
+            using std::cbrt;
+
+            // For the vertex in slot k, the opposite face in an order for which the volume is
+            // dot(cross(b - a, c - a), x - a) / 6 with the sign of tetrahedron_volume().
+            static constexpr std::size_t opposite[4][3] = {{1, 3, 2}, {0, 2, 3}, {0, 3, 1}, {0, 1, 2}};
+
+            const Vector3D<Real> x = _mesh.vertices[v];
+            f = Real(0);
+            gradient = Vector3D<Real>(Real(0), Real(0), Real(0));
+            for (std::size_t s = _star_offsets[v]; s < _star_offsets[v + 1]; ++s) {
+                const auto &t = _mesh.tetrahedra[_stars[s]];
+                const std::size_t k = static_cast<std::size_t>(std::find(t.begin(), t.end(), v) - t.begin());
+                const Vector3D<Real> a = _mesh.vertices[t[opposite[k][0]]];
+                const Vector3D<Real> b = _mesh.vertices[t[opposite[k][1]]];
+                const Vector3D<Real> c = _mesh.vertices[t[opposite[k][2]]];
+                if (orient3d(a, b, c, x) <= 0) return false;
+
+                const Vector3D<Real> n = cross(b - a, c - a);
+                const Real six_volume = dot(n, x - a);
+                const Real sq_sum = norm_squared(x - a) + norm_squared(x - b) + norm_squared(x - c) +
+                                    norm_squared(b - a) + norm_squared(c - a) + norm_squared(c - b);
+                const Real inverse = sq_sum / (Real(12) * cbrt(six_volume * six_volume / Real(4)));
+
+                // d(1/q) = (1/q) (dL / L - (2/3) dV / V), with dV / V = n / (6V) and dL = 2 (3x - a - b - c).
+                const Vector3D<Real> d_sq_sum = Real(2) * (Real(3) * x - a - b - c);
+                f += inverse;
+                gradient = gradient + inverse * (d_sq_sum / sq_sum - (Real(2) / Real(3)) * n / six_volume);
+            }
+            return true;
+
+        }
+
+        /**
+         * Relocate a vertex: 1 if it moved by more than the tolerance, 0 if it stayed (nearly) put and -1 if the
+         * move was rejected.
+         */
+        int relocate(std::size_t v, const SmoothingOptions &options) {
+
+            using std::sqrt;
+
+            const Vector3D<Real> old = _mesh.vertices[v];
+            const std::size_t degree = _adjacency_offsets[v + 1] - _adjacency_offsets[v];
+            Vector3D<Real> centroid(Real(0), Real(0), Real(0));
+            Real length = Real(0);
+            for (std::size_t k = _adjacency_offsets[v]; k < _adjacency_offsets[v + 1]; ++k) {
+                const Vector3D<Real> w = _mesh.vertices[_adjacency[k]];
+                centroid = centroid + w;
+                length += sqrt(norm_squared(w - old));
+            }
+            centroid = centroid / Real(double(degree));
+            length /= Real(double(degree));
+            const Real tolerance = Real(options.tolerance) * length;
+
+            if (options.method != SmoothingMethod::Gradient) {
+                Vector3D<Real> step = Real(options.relaxation) * (centroid - old);
+                const bool guard = options.method == SmoothingMethod::SmartLaplacian;
+                for (std::size_t attempt = 0; attempt < 4; ++attempt, step = step / Real(2)) {
+                    if (sqrt(norm_squared(step)) <= tolerance) return 0;
+                    if (try_move(v, old + step, guard)) return 1;
+                    if (guard) break;
+                }
+                return -1;
+            }
+
+            // Backtracking line search along the steepest descent direction, starting at a tenth of an edge.
+            Real f;
+            Vector3D<Real> gradient;
+            if (!objective(v, f, gradient)) return -1;
+            const Real g = sqrt(norm_squared(gradient));
+            if (g == Real(0)) return 0;
+            Vector3D<Real> step = (Real(0.1) * length / g) * gradient;
+            for (std::size_t attempt = 0; attempt < 12; ++attempt, step = step / Real(2)) {
+                if (sqrt(norm_squared(step)) <= tolerance) return 0;
+                _mesh.vertices.set(v, old - step);
+                Real f_new;
+                Vector3D<Real> unused;
+                const bool valid = objective(v, f_new, unused);
+                _mesh.vertices.set(v, old);
+                if (valid && f_new < f && try_move(v, old - step, false)) return 1;
+            }
+            return -1;
+
+        }
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,127 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <vector3d.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * A structure-of-arrays container of three dimensional vectors. The x, y & z components are held in three separate
+     * contiguous arrays so that batch kernels may stream over them with unit stride.
+     * @tparam T the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename T>
+    class Vector3DSoA {
+
+    public:
+
+        /**
+         * Create an empty structure-of-arrays vector container.
+         */
+        Vector3DSoA() = default;
+
+        /**
+         * Create a structure-of-arrays vector container holding `n` zero-vectors.
+         * @param n the number of vectors.
+         */
+        explicit Vector3DSoA(std::size_t n) : _x(n, T(0)), _y(n, T(0)), _z(n, T(0)) {}
+
+        /**
+         * Retrieve the number of vectors held by the container.
+         * @return the number of vectors.
+         */
+        [[nodiscard]] inline std::size_t size() const { return _x.size(); }
+
+        /**
+         * Reserve storage for at least `n` vectors.
+         * @param n the number of vectors to reserve storage for.
+         */
+        void reserve(std::size_t n) {
+
+            _x.reserve(n);
+            _y.reserve(n);
+            _z.reserve(n);
+
+        }
+
+        /**
+         * Resize the container to hold `n` vectors, new vectors are zero-vectors.
+         * @param n the new number of vectors.
+         */
+        void resize(std::size_t n) {
+
+            _x.resize(n, T(0));
+            _y.resize(n, T(0));
+            _z.resize(n, T(0));
+
+        }
+
+        /**
+         * Append a vector to the end of the container.
+         * @param v the vector to append.
+         */
+        void push_back(const Vector3D<T> &v) {
+
+            _x.push_back(v.x());
+            _y.push_back(v.y());
+            _z.push_back(v.z());
+
+        }
+
+        /**
+         * Retrieve the vector at the given index.
+         * @param i the index of the vector.
+         * @return the vector at index `i`.
+         */
+        [[nodiscard]] inline Vector3D<T> operator[](std::size_t i) const { return {_x[i], _y[i], _z[i]}; }
+
+        /**
+         * Overwrite the vector at the given index.
+         * @param i the index of the vector.
+         * @param v the new value of the vector.
+         */
+        inline void set(std::size_t i, const Vector3D<T> &v) {
+
+            _x[i] = v.x();
+            _y[i] = v.y();
+            _z[i] = v.z();
+
+        }
+
+        /**
+         * Retrieve the contiguous x-component array.
+         * @return a pointer to the first x-component.
+         */
+        [[nodiscard]] inline T *x() { return _x.data(); }
+        [[nodiscard]] inline const T *x() const { return _x.data(); }
+
+        /**
+         * Retrieve the contiguous y-component array.
+         * @return a pointer to the first y-component.
+         */
+        [[nodiscard]] inline T *y() { return _y.data(); }
+        [[nodiscard]] inline const T *y() const { return _y.data(); }
+
+        /**
+         * Retrieve the contiguous z-component array.
+         * @return a pointer to the first z-component.
+         */
+        [[nodiscard]] inline T *z() { return _z.data(); }
+        [[nodiscard]] inline const T *z() const { return _z.data(); }
+
+    private:
+
+        std::vector<T> _x;
+        std::vector<T> _y;
+        std::vector<T> _z;
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
@@ -0,0 +1,226 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <vector3d.hpp>
+#include <vector3d_soa.hpp>
+#include <geometry.hpp>
+#include <mesh.hpp>
+#include <parallel.hpp>
+#include <bem.hpp>
+#include <raycast.hpp>
+
+namespace org::lesleisnagy::geomlib {
+
+    /**
+     * Return the generalised winding number of a triangle surface at a point: the sum of the solid_angle()s of the
+     * triangles divided by \f$4\pi\f$. For a closed surface with outward triangle_normal()s it is one inside and
+     * zero outside; for surfaces with holes, cracks or overlaps it varies smoothly and thresholding it at one half
+     * still classifies points robustly (Jacobson, Kavan & Sorkine-Hornung 2013). This evaluates every triangle.
+     * @param point the point.
+     * @param mesh the surface mesh.
+     * @return the winding number.
+     */
+    template<typename Real>
+    Real winding_number(const Vector3D<Real> &point, const TriangleMesh<Real> &mesh) {
+
+        using std::acos;
+
+        Real sum = Real(0);
+        for (const auto &t: mesh.triangles) {
+            sum += solid_angle(point, mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]]);
+        }
+        return sum / (Real(4) * acos(Real(-1)));
+
+    }
+
+    /**
+     * Hierarchical evaluation of generalised winding numbers (Barill et al. 2018).
+     *
+     * Each node of a TriangleBvh stores the dipole of its triangles: the sum N of their area-weighted normals placed
+     * at their area-weighted centre c. Seen from a point r with |c - r| > accuracy times the radius of the node, the
+     * node's solid angle is replaced by the dipole term \f$N \cdot (c - r) / |c - r|^3\f$; nearer nodes are opened
+     * and the solid angles of the triangles in near leaves are summed exactly. Classifying many points thus takes
+     * logarithmic time per point away from the surface.
+     *
+     * The expansion stops at the dipole term, without the higher-order corrections for the spread of the normals
+     * within a node, and its error falls roughly as 1 / accuracy^2. On a sphere of a few thousand triangles the
+     * winding numbers are within 0.04 of the exact sums at the default ratio of two and within 0.007 at four: far
+     * inside the margin of the one-half threshold of inside(), but not accurate values. A ratio larger than any
+     * distance over node radius never uses the dipole terms and reproduces winding_number().
+     * @tparam Real the underlying data type for the calculation - usually 'double' or 'mpreal'.
+     */
+    template<typename Real>
+    class WindingNumber {
+
+    public:
+
+        /**
+         * Build the hierarchy and the node dipoles.
+         * @param mesh the surface mesh, wound so that triangle_normal()s point outwards.
+         * @param accuracy the ratio of distance to node radius beyond which the dipole term is used; larger is more
+         *                 accurate and slower.
+         * @param leaf_size the maximum number of triangles in a leaf of the hierarchy.
+         */
+        explicit WindingNumber(const TriangleMesh<Real> &mesh, const Real &accuracy = Real(2),
+                               std::size_t leaf_size = 8)
+                : _bvh(mesh, leaf_size), _accuracy(accuracy) {
+
+            using std::sqrt;
+
+            const std::size_t n = mesh.n_triangles();
+            const std::vector<std::size_t> &order = _bvh.triangles();
+            _r1.resize(n);
+            _r2.resize(n);
+            _r3.resize(n);
+            for (std::size_t p = 0; p < n; ++p) {
+                const auto &t = mesh.triangles[order[p]];
+                _r1.set(p, mesh.vertices[t[0]]);
+                _r2.set(p, mesh.vertices[t[1]]);
+                _r3.set(p, mesh.vertices[t[2]]);
+            }
+
+            // Children are created after their parents, so a reverse sweep sees the children first.
+            const std::vector<BvhNode> &nodes = _bvh.nodes();
+            const Vector3D<Real> zero(Real(0), Real(0), Real(0));
+            std::vector<Real> areas(nodes.size(), Real(0));
+            std::vector<Vector3D<Real>> moments(nodes.size(), zero);
+            _dipoles.resize(nodes.size());
+            _centres.resize(nodes.size());
+            _radii_squared.resize(nodes.size());
+            for (std::size_t c = nodes.size(); c-- > 0;) {
+                const BvhNode &node = nodes[c];
+                Vector3D<Real> dipole = zero;
+                if (node.is_leaf()) {
+                    for (std::size_t p = node.begin; p < node.end; ++p) {
+                        const Vector3D<Real> r1 = _r1[p], r2 = _r2[p], r3 = _r3[p];
+                        const Vector3D<Real> normal = cross(r2 - r1, r3 - r1) / Real(2);
+                        const Real area = sqrt(norm_squared(normal));
+                        dipole = dipole + normal;
+                        areas[c] += area;
+                        moments[c] = moments[c] + area * triangle_center(r1, r2, r3);
+                    }
+                } else {
+                    for (std::size_t child: node.children) {
+                        dipole = dipole + _dipoles[child];
+                        areas[c] += areas[child];
+                        moments[c] = moments[c] + moments[child];
+                    }
+                }
+                Vector3D<Real> centre(Real((node.lower[0] + node.upper[0]) / 2.0),
+                                      Real((node.lower[1] + node.upper[1]) / 2.0),
+                                      Real((node.lower[2] + node.upper[2]) / 2.0));
+                if (areas[c] > Real(0)) centre = moments[c] / areas[c];
+
+                // The farthest box corner bounds the distance of every triangle point from the centre.
+                Real radius_squared = Real(0);
+                for (std::size_t corner = 0; corner < 8; ++corner) {
+                    const Vector3D<Real> r(Real(corner & 1 ? node.upper[0] : node.lower[0]),
+                                           Real(corner & 2 ? node.upper[1] : node.lower[1]),
+                                           Real(corner & 4 ? node.upper[2] : node.lower[2]));
+                    radius_squared = std::max(radius_squared, norm_squared(r - centre));
+                }
+                _dipoles.set(c, dipole);
+                _centres.set(c, centre);
+                _radii_squared[c] = radius_squared;
+            }
+
+        }
+
+        /**
+         * Evaluate the winding number at a point.
+         * @param point the point.
+         * @return the winding number: about one inside and zero outside a closed surface.
+         */
+        [[nodiscard]] Real operator()(const Vector3D<Real> &point) const {
+
+            using std::acos;
+            using std::sqrt;
+
+            const std::vector<BvhNode> &nodes = _bvh.nodes();
+            if (nodes.empty()) return Real(0);
+            const Real accuracy_squared = _accuracy * _accuracy;
+
+            Real sum = Real(0);
+            std::array<std::size_t, 256> stack;
+            std::size_t top = 0;
+            stack[top++] = 0;
+            while (top > 0) {
+
+                const std::size_t current = stack[--top];
+                const Vector3D<Real> d = _centres[current] - point;
+                const Real d2 = norm_squared(d);
+                if (d2 > accuracy_squared * _radii_squared[current]) {
+                    sum += dot(_dipoles[current], d) / (d2 * sqrt(d2));
+                    continue;
+                }
+
+                const BvhNode &node = nodes[current];
+                if (node.is_leaf()) {
+                    for (std::size_t p = node.begin; p < node.end; ++p) {
+                        sum += solid_angle(point, _r1[p], _r2[p], _r3[p]);
+                    }
+                    continue;
+                }
+                stack[top++] = node.children[0];
+                stack[top++] = node.children[1];
+
+            }
+            return sum / (Real(4) * acos(Real(-1)));
+
+        }
+
+        /**
+         * Evaluate the winding numbers of a batch of points.
+         * @param points the points.
+         * @param winding_numbers the winding number of each point.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void operator()(const Vector3DSoA<Real> &points, Real *winding_numbers, std::size_t n_threads = 0) const {
+            parallel_for(0, points.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) winding_numbers[i] = (*this)(points[i]);
+            }, n_threads, 64);
+        }
+
+        /**
+         * Classify points as inside or outside the surface by thresholding the winding number at one half.
+         * @param points the points.
+         * @param inside receives 1 for points inside the surface and 0 otherwise, one per point.
+         * @param n_threads the number of threads, zero selects default_thread_count().
+         */
+        void inside(const Vector3DSoA<Real> &points, char *inside, std::size_t n_threads = 0) const {
+            parallel_for(0, points.size(), [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) inside[i] = static_cast<char>((*this)(points[i]) > Real(0.5));
+            }, n_threads, 64);
+        }
+
+    private:
+
+        TriangleBvh<Real> _bvh;
+        Real _accuracy;
+
+        Vector3DSoA<Real> _r1;
+        Vector3DSoA<Real> _r2;
+        Vector3DSoA<Real> _r3;
+
+        /** The sum of the area-weighted normals of the triangles below each node. */
+        Vector3DSoA<Real> _dipoles;
+
+        /** The area-weighted centre of the triangles below each node. */
+        Vector3DSoA<Real> _centres;
+
+        /** The squared radius about the centre of a sphere containing the triangles below each node. */
+        std::vector<Real> _radii_squared;
+
+    };
+
+} // namespace org::lesleisnagy::geomlib
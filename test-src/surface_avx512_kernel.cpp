@@ -0,0 +1,27 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+// This translation unit alone is compiled with -mavx512f, so that test_surface_avx512_dblprec can check the CPU
+// before anything built for AVX-512 runs.
+
+#if !defined(__AVX512F__)
+#error "surface_avx512_kernel.cpp must be compiled with AVX-512 enabled (-mavx512f)."
+#endif // __AVX512F__
+
+#include "surface.hpp"
+
+/**
+ * Forward to the double precision triangle normal & area kernel, i.e. to its AVX-512 branch.
+ */
+void avx512_triangle_normals_areas_kernel(std::size_t n,
+                                          const double *x1, const double *y1, const double *z1,
+                                          const double *x2, const double *y2, const double *z2,
+                                          const double *x3, const double *y3, const double *z3,
+                                          double *nx, double *ny, double *nz, double *area,
+                                          double eps_squared) {
+
+    org::lesleisnagy::geomlib::detail::triangle_normals_areas_kernel(n, x1, y1, z1, x2, y2, z2, x3, y3, z3,
+                                                                     nx, ny, nz, area, eps_squared);
+
+}
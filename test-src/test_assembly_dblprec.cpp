@@ -0,0 +1,135 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "colouring.hpp"
+#include "assembly.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+
+TEST_CASE("Test barycentric_gradients() function for 'double' type.", "Assembly") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const Vec3D r[4] = {Vec3D(0.1, 0.2, -0.3), Vec3D(1.2, 0.1, 0.2), Vec3D(0.3, 0.9, 0.1), Vec3D(0.2, 0.4, 1.1)};
+
+    // Both orientations give the same gradients: grad(lambda_a) . (r_b - r_1) = delta_ab - delta_a1.
+    for (bool swap: {false, true}) {
+        auto g = swap ? barycentric_gradients(r[0], r[2], r[1], r[3]) : barycentric_gradients(r[0], r[1], r[2], r[3]);
+        if (swap) std::swap(g[1], g[2]);
+        for (std::size_t a = 0; a < 4; ++a) {
+            for (std::size_t b = 1; b < 4; ++b) {
+                const double expected = (a == b ? 1.0 : 0.0) - (a == 0 ? 1.0 : 0.0);
+                REQUIRE( fabs(dot(g[a], r[b] - r[0]) - expected) < 1E-13 );
+            }
+        }
+    }
+
+}
+
+TEST_CASE("Test assemble_stiffness() and assemble_mass() functions for 'double' type.", "Assembly") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = unit_cube(8);
+    const std::size_t n = mesh.n_vertices();
+
+    AssemblyPattern pattern(mesh.tetrahedra, n, 3);
+
+    // The pattern is symmetric, holds the diagonal and every element's slots address its own vertex pairs.
+    REQUIRE( pattern.n_rows() == n );
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) {
+        const auto &t = mesh.tetrahedra[e];
+        for (std::size_t a = 0; a < 4; ++a) {
+            for (std::size_t b = 0; b < 4; ++b) {
+                const std::size_t slot = pattern.element_slots()[16 * e + 4 * a + b];
+                REQUIRE( pattern.columns()[slot] == t[b] );
+                REQUIRE( slot >= pattern.row_offsets()[t[a]] );
+                REQUIRE( slot < pattern.row_offsets()[t[a] + 1] );
+            }
+        }
+    }
+
+    CsrMatrix<double> stiffness = pattern.matrix<double>();
+    CsrMatrix<double> threaded = pattern.matrix<double>();
+    CsrMatrix<double> mass = pattern.matrix<double>();
+    assemble_stiffness(mesh, pattern, stiffness, nullptr, 1);
+    assemble_stiffness(mesh, pattern, threaded, nullptr, 3);
+    assemble_mass(mesh, pattern, mass, nullptr, 2);
+
+    // The row gather is deterministic.
+    for (std::size_t k = 0; k < pattern.n_nonzeros(); ++k) REQUIRE( stiffness.values[k] == threaded.values[k] );
+
+    std::vector<double> ones(n, 1.0), x(n), y(n);
+    for (std::size_t i = 0; i < n; ++i) x[i] = mesh.vertices[i].x() + 2.0 * mesh.vertices[i].y();
+
+    // Constants lie in the kernel, symmetry holds and the mass matrix integrates the volume.
+    stiffness.multiply(ones.data(), y.data(), 2);
+    for (std::size_t i = 0; i < n; ++i) REQUIRE( fabs(y[i]) < 1E-12 );
+    for (std::size_t i = 0; i < n; i += 13) {
+        for (std::size_t k = stiffness.row_offsets[i]; k < stiffness.row_offsets[i + 1]; ++k) {
+            REQUIRE( stiffness.values[k] == stiffness(stiffness.columns[k], i) );
+        }
+    }
+    double volume = 0.0;
+    for (double m: mass.values) volume += m;
+    REQUIRE( fabs(volume - 1.0) < 1E-12 );
+
+    // Energy of u = x + 2y is int |grad u|^2 = 5.
+    stiffness.multiply(x.data(), y.data());
+    double energy = 0.0;
+    for (std::size_t i = 0; i < n; ++i) energy += x[i] * y[i];
+    REQUIRE( fabs(energy - 5.0) < 1E-11 );
+
+    // After the vertices move the pattern is reused and the result matches a fresh assembly.
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dist(-0.02, 0.02);
+    for (std::size_t i = 0; i < n; ++i) {
+        mesh.vertices.set(i, mesh.vertices[i] + Vector3D<double>(dist(gen), dist(gen), dist(gen)));
+    }
+    std::vector<double> coefficients(mesh.n_tetrahedra());
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) coefficients[e] = 1.0 + 0.5 * static_cast<double>(e % 3);
+    assemble_stiffness(mesh, pattern, stiffness, coefficients.data(), 2);
+
+    AssemblyPattern fresh(mesh.tetrahedra, n, 1);
+    CsrMatrix<double> reference = fresh.matrix<double>();
+    assemble_stiffness(mesh, fresh, reference, coefficients.data(), 1);
+    for (std::size_t k = 0; k < pattern.n_nonzeros(); ++k) REQUIRE( stiffness.values[k] == reference.values[k] );
+
+    stiffness.multiply(ones.data(), y.data());
+    for (std::size_t i = 0; i < n; ++i) REQUIRE( fabs(y[i]) < 1E-12 );
+
+    // Scattering by colour agrees with the row gather up to the summation order.
+    ElementColouring colouring(mesh.tetrahedra, n, true, 3);
+    CsrMatrix<double> coloured = pattern.matrix<double>();
+    assemble_stiffness(mesh, pattern, colouring, coloured, coefficients.data(), 3);
+    for (std::size_t k = 0; k < pattern.n_nonzeros(); ++k) {
+        REQUIRE( fabs(coloured.values[k] - stiffness.values[k]) < 1E-13 );
+    }
+    assemble_mass(mesh, pattern, colouring, coloured, nullptr, 2);
+    assemble_mass(mesh, pattern, mass, nullptr, 2);
+    for (std::size_t k = 0; k < pattern.n_nonzeros(); ++k) REQUIRE( fabs(coloured.values[k] - mass.values[k]) < 1E-15 );
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| vertices        | " << n                                                  << std::endl;
+    std::cout << "| tetrahedra      | " << mesh.n_tetrahedra()                                << std::endl;
+    std::cout << "| non zeros       | " << pattern.n_nonzeros()                               << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+}
@@ -0,0 +1,221 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "bem.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+
+/**
+ * Brute force integral of f(r', phi_1, phi_2, phi_3) over a triangle using the centroid rule on n^2 sub-triangles.
+ */
+template<typename F>
+double brute_force(const Vector3D<double> &r1, const Vector3D<double> &r2, const Vector3D<double> &r3,
+                   std::size_t n, F f) {
+
+    const double area = org::lesleisnagy::geomlib::triangle_area(r1, r2, r3) / double(n * n);
+
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; i + j < n; ++j) {
+            // Upward sub-triangle.
+            double a = (i + 1.0 / 3.0) / n, b = (j + 1.0 / 3.0) / n;
+            sum += f((1.0 - a - b) * r1 + a * r2 + b * r3, 1.0 - a - b, a, b);
+            // Downward sub-triangle.
+            if (i + j + 1 < n) {
+                a = (i + 2.0 / 3.0) / n;
+                b = (j + 2.0 / 3.0) / n;
+                sum += f((1.0 - a - b) * r1 + a * r2 + b * r3, 1.0 - a - b, a, b);
+            }
+        }
+    }
+
+    return sum * area;
+
+}
+
+TEST_CASE("Test solid_angle() function on a closed surface for 'double' type.", "BEM") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    // A tetrahedron with outward wound faces.
+    Vec3D r1(0.0, 0.0, 0.0);
+    Vec3D r2(1.0, 0.0, 0.0);
+    Vec3D r3(0.0, 1.0, 0.0);
+    Vec3D r4(0.0, 0.0, 1.0);
+
+    auto total = [&](const Vec3D &r) {
+        return solid_angle(r, r1, r3, r2) + solid_angle(r, r1, r2, r4) +
+               solid_angle(r, r1, r4, r3) + solid_angle(r, r2, r3, r4);
+    };
+
+    double eps = 1E-12;
+
+    REQUIRE( fabs(total(Vec3D(0.1, 0.2, 0.3)) - 4.0 * M_PI) < eps );
+    REQUIRE( fabs(total(Vec3D(0.25, 0.25, 0.25)) - 4.0 * M_PI) < eps );
+    REQUIRE( fabs(total(Vec3D(1.0, 1.0, 1.0))) < eps );
+    REQUIRE( fabs(total(Vec3D(-3.0, 0.5, 7.0))) < eps );
+
+    // An observer just behind the face centre sees (almost) a hemisphere.
+    Vec3D c = triangle_center(r1, r3, r2);
+    REQUIRE( fabs(solid_angle(c + Vec3D(0.0, 0.0, 1E-10), r1, r3, r2) - 2.0 * M_PI) < 1E-8 );
+    REQUIRE( fabs(solid_angle(c - Vec3D(0.0, 0.0, 1E-10), r1, r3, r2) + 2.0 * M_PI) < 1E-8 );
+
+}
+
+TEST_CASE("Test single_layer() and linear layer functions against quadrature for 'double' type.", "BEM") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    Vec3D r1(0.0, 0.0, 0.0);
+    Vec3D r2(1.0, 0.2, 0.1);
+    Vec3D r3(0.3, 0.9, -0.2);
+
+    const Vec3D n = triangle_normal(r1, r2, r3);
+    const std::size_t n_sub = 400;
+
+    const Vec3D observers[] = {Vec3D(0.4, 0.3, 0.6), Vec3D(2.0, -1.0, 0.5), Vec3D(0.5, 0.4, -0.3),
+                               Vec3D(-0.7, 0.2, 0.05)};
+
+    for (const Vec3D &r: observers) {
+
+        const double s0 = single_layer(r, r1, r2, r3);
+        const double omega = solid_angle(r, r1, r2, r3);
+        const auto sl = single_layer_linear(r, r1, r2, r3);
+        const auto dl = double_layer_linear(r, r1, r2, r3);
+
+        const double s0_ref = brute_force(r1, r2, r3, n_sub, [&](const Vec3D &x, double, double, double) {
+            return 1.0 / norm(x - r);
+        });
+        const double omega_ref = brute_force(r1, r2, r3, n_sub, [&](const Vec3D &x, double, double, double) {
+            const double d = norm(x - r);
+            return dot(n, x - r) / (d * d * d);
+        });
+
+        std::array<double, 3> sl_ref{}, dl_ref{};
+        for (std::size_t i = 0; i < 3; ++i) {
+            sl_ref[i] = brute_force(r1, r2, r3, n_sub, [&](const Vec3D &x, double p1, double p2, double p3) {
+                const double phi[3] = {p1, p2, p3};
+                return phi[i] / norm(x - r);
+            });
+            dl_ref[i] = brute_force(r1, r2, r3, n_sub, [&](const Vec3D &x, double p1, double p2, double p3) {
+                const double phi[3] = {p1, p2, p3};
+                const double d = norm(x - r);
+                return phi[i] * dot(n, x - r) / (d * d * d);
+            });
+        }
+
+#ifdef DEBUG_MESSAGES
+        std::cout.precision(15);
+        std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+        std::cout << "| observer        | " << r                                                 << std::endl;
+        std::cout << "| single layer    | " << s0 << " (quadrature " << s0_ref << ")"            << std::endl;
+        std::cout << "| solid angle     | " << omega << " (quadrature " << omega_ref << ")"      << std::endl;
+        std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+        double eps = 1E-4;
+
+        REQUIRE( fabs(s0 - s0_ref) < eps );
+        REQUIRE( fabs(omega - omega_ref) < eps );
+        for (std::size_t i = 0; i < 3; ++i) {
+            REQUIRE( fabs(sl[i] - sl_ref[i]) < eps );
+            REQUIRE( fabs(dl[i] - dl_ref[i]) < eps );
+        }
+
+        // The basis functions form a partition of unity.
+        REQUIRE( fabs(sl[0] + sl[1] + sl[2] - s0) < 1E-12 );
+        REQUIRE( fabs(dl[0] + dl[1] + dl[2] - omega) < 1E-12 );
+
+    }
+
+    // Observers in the plane of the triangle: outside it the double layer vanishes, on it the single layer stays
+    // finite.
+    const Vec3D in_plane = r1 + 1.2 * (r2 - r1) + 0.3 * (r3 - r1);
+    const auto dl = double_layer_linear(in_plane, r1, r2, r3);
+    for (std::size_t i = 0; i < 3; ++i) REQUIRE( fabs(dl[i]) < 1E-12 );
+    REQUIRE( std::isfinite(single_layer(r1, r1, r2, r3)) );
+    REQUIRE( std::isfinite(single_layer(0.5 * (r1 + r2), r1, r2, r3)) );
+
+}
+
+TEST_CASE("Test bem_matrix() and solid_angles() batch functions for 'double' type.", "BEM") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    // An outward wound octahedron.
+    TriangleMesh<double> mesh;
+    mesh.vertices.push_back(Vec3D(1.0, 0.0, 0.0));
+    mesh.vertices.push_back(Vec3D(-1.0, 0.0, 0.0));
+    mesh.vertices.push_back(Vec3D(0.0, 1.0, 0.0));
+    mesh.vertices.push_back(Vec3D(0.0, -1.0, 0.0));
+    mesh.vertices.push_back(Vec3D(0.0, 0.0, 1.0));
+    mesh.vertices.push_back(Vec3D(0.0, 0.0, -1.0));
+    mesh.triangles = {{0, 2, 4}, {2, 1, 4}, {1, 3, 4}, {3, 0, 4},
+                      {2, 0, 5}, {1, 2, 5}, {3, 1, 5}, {0, 3, 5}};
+
+    Vector3DSoA<double> targets;
+    for (int i = 0; i < 50; ++i) {
+        const double t = 0.1 * i;
+        targets.push_back(Vec3D(0.3 * std::sin(t), 0.2 * std::cos(3.0 * t), 0.1 * t - 2.5));
+    }
+
+    auto omega = bem_matrix(targets, mesh, BemKernel::SolidAngle, 1);
+    auto omega_threaded = bem_matrix(targets, mesh, BemKernel::SolidAngle, 4);
+    auto dl = bem_matrix(targets, mesh, BemKernel::DoubleLayerLinear, 3);
+    auto sl = bem_matrix(targets, mesh, BemKernel::SingleLayerLinear, 2);
+    auto s0 = bem_matrix(targets, mesh, BemKernel::SingleLayer, 2);
+
+    Vector3DSoA<double> r1, r2, r3;
+    for (const auto &t: mesh.triangles) {
+        r1.push_back(mesh.vertices[t[0]]);
+        r2.push_back(mesh.vertices[t[1]]);
+        r3.push_back(mesh.vertices[t[2]]);
+    }
+    std::vector<double> omega_soa(targets.size() * mesh.n_triangles());
+    solid_angles(targets, r1, r2, r3, omega_soa.data(), 3);
+
+    const std::size_t n_t = mesh.n_triangles();
+    const std::size_t n_v = mesh.n_vertices();
+
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+
+        const Vec3D r = targets[i];
+        const bool inside = fabs(r.x()) + fabs(r.y()) + fabs(r.z()) < 1.0;
+
+        double omega_sum = 0.0, dl_sum = 0.0, sl_sum = 0.0, s0_sum = 0.0;
+        for (std::size_t j = 0; j < n_t; ++j) {
+            const auto &t = mesh.triangles[j];
+            REQUIRE( omega[i * n_t + j] == omega_threaded[i * n_t + j] );
+            REQUIRE( fabs(omega[i * n_t + j] - omega_soa[i * n_t + j]) < 1E-14 );
+            REQUIRE( omega[i * n_t + j] ==
+                     solid_angle(r, mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]]) );
+            omega_sum += omega[i * n_t + j];
+            s0_sum += s0[i * n_t + j];
+        }
+        for (std::size_t v = 0; v < n_v; ++v) {
+            dl_sum += dl[i * n_v + v];
+            sl_sum += sl[i * n_v + v];
+        }
+
+        REQUIRE( fabs(omega_sum - (inside ? 4.0 * M_PI : 0.0)) < 1E-12 );
+        REQUIRE( fabs(dl_sum - omega_sum) < 1E-12 );
+        REQUIRE( fabs(sl_sum - s0_sum) < 1E-12 );
+
+    }
+
+}
@@ -0,0 +1,74 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "mpreal.h"
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "bem.hpp"
+
+TEST_CASE("Test BEM potential kernels for 'multiprecision' type.", "BEM") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+    using Vec3D = Vector3D<double>;
+    using Vec3M = Vector3D<mpreal>;
+
+    const int digits = 50;
+    mpreal::set_default_prec(mpfr::digits2bits(digits));
+    Vec3M::set_eps(mpreal("1E-40"));
+
+    Vec3D r1(0.0, 0.0, 0.0);
+    Vec3D r2(1.0, 0.2, 0.1);
+    Vec3D r3(0.3, 0.9, -0.2);
+
+    Vec3M m1(mpreal(0.0), mpreal(0.0), mpreal(0.0));
+    Vec3M m2(mpreal(1.0), mpreal(0.2), mpreal(0.1));
+    Vec3M m3(mpreal(0.3), mpreal(0.9), mpreal(-0.2));
+
+    // The double precision kernels agree with the multiprecision reference to near machine precision, also for an
+    // observer close to the plane of the triangle.
+    const double observers[][3] = {{0.4, 0.3, 0.6}, {2.0, -1.0, 0.5}, {0.5, 0.4, 1E-6}};
+
+    for (const auto &o: observers) {
+
+        Vec3D r(o[0], o[1], o[2]);
+        Vec3M m{mpreal(o[0]), mpreal(o[1]), mpreal(o[2])};
+
+        mpreal omega = solid_angle(m, m1, m2, m3);
+        mpreal s0 = single_layer(m, m1, m2, m3);
+        auto dl = double_layer_linear(m, m1, m2, m3);
+        auto sl = single_layer_linear(m, m1, m2, m3);
+
+#ifdef DEBUG_MESSAGES
+        std::cout.precision(digits);
+        std::cout << "| solid angle     | " << omega                                              << std::endl;
+        std::cout << "| single layer    | " << s0                                                 << std::endl;
+#endif // DEBUG_MESSAGES
+
+        // Partition of unity holds to the working precision.
+        REQUIRE( abs(dl[0] + dl[1] + dl[2] - omega) < mpreal("1E-45") );
+        REQUIRE( abs(sl[0] + sl[1] + sl[2] - s0) < mpreal("1E-45") );
+
+        double eps = 1E-12;
+
+        REQUIRE( fabs(solid_angle(r, r1, r2, r3) - omega.toDouble()) < eps );
+        REQUIRE( fabs(single_layer(r, r1, r2, r3) - s0.toDouble()) < eps );
+        auto dl_double = double_layer_linear(r, r1, r2, r3);
+        auto sl_double = single_layer_linear(r, r1, r2, r3);
+        for (std::size_t i = 0; i < 3; ++i) {
+            REQUIRE( fabs(dl_double[i] - dl[i].toDouble()) < eps );
+            REQUIRE( fabs(sl_double[i] - sl[i].toDouble()) < eps );
+        }
+
+    }
+
+}
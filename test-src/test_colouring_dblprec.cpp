@@ -0,0 +1,128 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "colouring.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+
+/**
+ * Check that no two elements of the same colour share a vertex and that the buckets are consistent.
+ */
+template<std::size_t N>
+void check_colouring(const org::lesleisnagy::geomlib::ElementColouring &colouring,
+                     const std::vector<std::array<std::size_t, N>> &elements, std::size_t n_vertices) {
+
+    REQUIRE( colouring.n_elements() == elements.size() );
+    REQUIRE( colouring.colour_offsets().back() == elements.size() );
+
+    std::vector<std::size_t> owner(n_vertices);
+    for (std::size_t c = 0; c < colouring.n_colours(); ++c) {
+        std::fill(owner.begin(), owner.end(), elements.size());
+        for (std::size_t k = colouring.colour_offsets()[c]; k < colouring.colour_offsets()[c + 1]; ++k) {
+            const std::size_t e = colouring.elements()[k];
+            REQUIRE( colouring.colours()[e] == c );
+            if (k > colouring.colour_offsets()[c]) REQUIRE( colouring.elements()[k - 1] < e );
+            for (std::size_t v: elements[e]) {
+                REQUIRE( owner[v] == elements.size() );
+                owner[v] = e;
+            }
+        }
+    }
+
+}
+
+TEST_CASE("Test ElementColouring class on a tetrahedral mesh for 'double' type.", "Colouring") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = unit_cube(10);
+
+    ElementColouring greedy(mesh.tetrahedra, mesh.n_vertices(), false, 1);
+    ElementColouring balanced(mesh.tetrahedra, mesh.n_vertices(), true, 1);
+    ElementColouring threaded(mesh.tetrahedra, mesh.n_vertices(), true, 3);
+
+    check_colouring(greedy, mesh.tetrahedra, mesh.n_vertices());
+    check_colouring(balanced, mesh.tetrahedra, mesh.n_vertices());
+
+    // Threads may colour differently, but equally validly.
+    check_colouring(threaded, mesh.tetrahedra, mesh.n_vertices());
+
+    auto spread = [](const ElementColouring &colouring) {
+        std::size_t smallest = colouring.n_elements(), largest = 0;
+        for (std::size_t c = 0; c < colouring.n_colours(); ++c) {
+            smallest = std::min(smallest, colouring.colour_size(c));
+            largest = std::max(largest, colouring.colour_size(c));
+        }
+        return std::make_pair(smallest, largest);
+    };
+    auto [greedy_min, greedy_max] = spread(greedy);
+    auto [balanced_min, balanced_max] = spread(balanced);
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| tetrahedra      | " << mesh.n_tetrahedra()                                << std::endl;
+    std::cout << "| colours         | " << greedy.n_colours()                                 << std::endl;
+    std::cout << "| greedy sizes    | " << greedy_min << " - " << greedy_max                  << std::endl;
+    std::cout << "| balanced sizes  | " << balanced_min << " - " << balanced_max              << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    // Balancing keeps the number of colours and narrows the spread of the bucket sizes.
+    REQUIRE( balanced.n_colours() == greedy.n_colours() );
+    REQUIRE( balanced_max <= greedy_max );
+    REQUIRE( balanced_max - balanced_min < greedy_max - greedy_min );
+
+    // A race-free scatter: lumped vertex volumes accumulated colour by colour match the serial sum.
+    std::vector<double> serial(mesh.n_vertices(), 0.0), coloured(mesh.n_vertices(), 0.0);
+    for (const auto &t: mesh.tetrahedra) {
+        const double v = fabs(tetrahedron_volume(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                                 mesh.vertices[t[2]], mesh.vertices[t[3]])) / 4.0;
+        for (std::size_t i: t) serial[i] += v;
+    }
+    parallel_for_coloured(balanced, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t k = begin; k < end; ++k) {
+            const auto &t = mesh.tetrahedra[balanced.elements()[k]];
+            const double v = fabs(tetrahedron_volume(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                                     mesh.vertices[t[2]], mesh.vertices[t[3]])) / 4.0;
+            for (std::size_t i: t) coloured[i] += v;
+        }
+    }, 3, 16);
+    for (std::size_t i = 0; i < mesh.n_vertices(); ++i) REQUIRE( fabs(serial[i] - coloured[i]) < 1E-15 );
+
+}
+
+TEST_CASE("Test ElementColouring class on a random triangle set for 'double' type.", "Colouring") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<std::size_t> dist(0, 499);
+
+    std::vector<std::array<std::size_t, 3>> triangles;
+    while (triangles.size() < 3000) {
+        std::array<std::size_t, 3> t = {dist(gen), dist(gen), dist(gen)};
+        if (t[0] != t[1] && t[1] != t[2] && t[0] != t[2]) triangles.push_back(t);
+    }
+
+    ElementColouring colouring(triangles, 500, true, 2);
+    check_colouring(colouring, triangles, 500);
+
+    REQUIRE_THROWS_AS( ElementColouring(triangles, 400), std::out_of_range );
+
+    triangles[1234][2] = triangles[1234][0];
+    REQUIRE_THROWS_AS( ElementColouring(triangles, 500), std::invalid_argument );
+
+}
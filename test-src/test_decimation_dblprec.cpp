@@ -0,0 +1,235 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "decimation.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TriangleMesh;
+
+/**
+ * The unit sphere as an octahedron whose faces are split into n x n triangles, projected outwards; the triangles
+ * wind counter-clockwise seen from outside.
+ */
+TriangleMesh<double> sphere(std::size_t n) {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TriangleMesh<double> mesh;
+    std::map<std::array<long, 3>, std::size_t> index;
+    auto vertex = [&](const std::array<long, 3> &key) {
+        auto it = index.find(key);
+        if (it != index.end()) return it->second;
+        const Vector3D<double> r(static_cast<double>(key[0]), static_cast<double>(key[1]), static_cast<double>(key[2]));
+        mesh.vertices.push_back(r / sqrt(norm_squared(r)));
+        return index[key] = mesh.vertices.size() - 1;
+    };
+
+    const long m = long(n);
+    for (long sx: {-1, 1}) {
+        for (long sy: {-1, 1}) {
+            for (long sz: {-1, 1}) {
+                // Lattice points (i, j, m - i - j) of the face in the octant (sx, sy, sz).
+                auto point = [&](long i, long j) { return vertex({sx * i, sy * j, sz * (m - i - j)}); };
+                const bool flip = sx * sy * sz < 0;
+                auto add = [&](std::size_t a, std::size_t b, std::size_t c) {
+                    mesh.triangles.push_back(flip ? std::array<std::size_t, 3>{a, c, b}
+                                                  : std::array<std::size_t, 3>{a, b, c});
+                };
+                for (long i = 0; i < m; ++i) {
+                    for (long j = 0; i + j < m; ++j) {
+                        add(point(i, j), point(i + 1, j), point(i, j + 1));
+                        if (i + j + 2 <= m) add(point(i + 1, j), point(i + 1, j + 1), point(i, j + 1));
+                    }
+                }
+            }
+        }
+    }
+    return mesh;
+
+}
+
+/**
+ * The unit square split into n x n cells of two triangles, facing +z.
+ */
+TriangleMesh<double> square(std::size_t n) {
+
+    TriangleMesh<double> mesh;
+    for (std::size_t j = 0; j <= n; ++j) {
+        for (std::size_t i = 0; i <= n; ++i) mesh.vertices.push_back(Vector3D<double>(double(i) / n, double(j) / n, 0));
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t a = j * (n + 1) + i, b = a + 1, c = a + n + 1, d = c + 1;
+            mesh.triangles.push_back({a, b, d});
+            mesh.triangles.push_back({a, d, c});
+        }
+    }
+    return mesh;
+
+}
+
+/**
+ * The cube [-1, 1]^3 with each face split into n x n cells of two triangles, wound counter-clockwise seen from
+ * outside.
+ */
+TriangleMesh<double> cube(std::size_t n) {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TriangleMesh<double> mesh;
+    std::map<std::array<long, 3>, std::size_t> index;
+    auto vertex = [&](const std::array<long, 3> &key) {
+        auto it = index.find(key);
+        if (it != index.end()) return it->second;
+        mesh.vertices.push_back(Vector3D<double>(static_cast<double>(key[0]) / double(n),
+                                                 static_cast<double>(key[1]) / double(n),
+                                                 static_cast<double>(key[2]) / double(n)));
+        return index[key] = mesh.vertices.size() - 1;
+    };
+
+    const long m = long(n);
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        for (long side: {-1, 1}) {
+            // Lattice points of the face: (i, j) along the two other axes, in the order that makes them right
+            // handed with the outward normal.
+            const std::size_t a = (axis + 1) % 3, b = (axis + 2) % 3;
+            auto point = [&](long i, long j) {
+                std::array<long, 3> key;
+                key[axis] = side * m;
+                key[a] = i;
+                key[b] = j;
+                return vertex(key);
+            };
+            for (long i = -m; i < m; i += 2) {
+                for (long j = -m; j < m; j += 2) {
+                    std::size_t p00 = point(i, j), p10 = point(i + 2, j), p01 = point(i, j + 2);
+                    const std::size_t p11 = point(i + 2, j + 2);
+                    if (side < 0) std::swap(p10, p01);
+                    mesh.triangles.push_back({p00, p10, p11});
+                    mesh.triangles.push_back({p00, p11, p01});
+                }
+            }
+        }
+    }
+    return mesh;
+
+}
+
+TEST_CASE("Test SurfaceDecimator decimate() function on a sphere for 'double' type.", "Decimation") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    const TriangleMesh<double> original = sphere(32);
+    REQUIRE( check_wound(original) == 0 );
+
+    SurfaceDecimator<double> decimator(original);
+    const DecimationStatistics<double> statistics = decimator.decimate(1000);
+    REQUIRE( decimator.n_triangles() <= 1000 );
+    REQUIRE( decimator.n_triangles() >= 998 );
+    REQUIRE( statistics.n_collapses > 0 );
+    REQUIRE( statistics.n_parallel_collapses == 0 );
+
+    const TriangleMesh<double> mesh = decimator.mesh();
+    REQUIRE( mesh.n_triangles() == decimator.n_triangles() );
+    REQUIRE( check_wound(mesh) == 0 );
+    REQUIRE( mesh.n_vertices() == mesh.n_triangles() / 2 + 2 );
+    for (std::size_t v = 0; v < mesh.n_vertices(); ++v) {
+        REQUIRE( fabs(sqrt(norm_squared(mesh.vertices[v])) - 1.0) < 0.02 );
+    }
+    const double volume = enclosed_volume(mesh);
+    REQUIRE( volume > 0.98 * enclosed_volume(original) );
+    REQUIRE( volume < 4.0 * M_PI / 3.0 );
+
+    // Further levels of detail continue from the current surface.
+    decimator.decimate(100);
+    REQUIRE( decimator.n_triangles() <= 100 );
+    REQUIRE( check_wound(decimator.mesh()) == 0 );
+    REQUIRE( enclosed_volume(decimator.mesh()) > 0.0 );
+
+}
+
+TEST_CASE("Test SurfaceDecimator decimate() function on boundaries and features for 'double' type.", "Decimation") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    SECTION("boundary") {
+        const TriangleMesh<double> mesh = decimate(square(30), 20);
+        REQUIRE( mesh.n_triangles() <= 20 );
+        REQUIRE( check_wound(mesh) > 0 );
+
+        // The square keeps its corners, its area and its orientation, and its vertices stay on the plane.
+        double area = 0.0;
+        for (const auto &t: mesh.triangles) {
+            const Vector3D<double> n = cross(mesh.vertices[t[1]] - mesh.vertices[t[0]],
+                                             mesh.vertices[t[2]] - mesh.vertices[t[0]]);
+            REQUIRE( n.z() > 0.0 );
+            area += 0.5 * n.z();
+        }
+        REQUIRE( fabs(area - 1.0) < 1E-12 );
+        std::size_t n_corners = 0;
+        for (std::size_t v = 0; v < mesh.n_vertices(); ++v) {
+            const double x = mesh.vertices.x()[v], y = mesh.vertices.y()[v];
+            REQUIRE( mesh.vertices.z()[v] == 0.0 );
+            if ((x == 0.0 || x == 1.0) && (y == 0.0 || y == 1.0)) ++n_corners;
+        }
+        REQUIRE( n_corners == 4 );
+    }
+
+    SECTION("features") {
+        const TriangleMesh<double> mesh = decimate(cube(16), 100);
+        REQUIRE( mesh.n_triangles() <= 100 );
+        REQUIRE( check_wound(mesh) == 0 );
+
+        // The creases hold the vertices on the cube: its eight corners among them.
+        std::size_t n_corners = 0;
+        for (std::size_t v = 0; v < mesh.n_vertices(); ++v) {
+            const Vector3D<double> r = mesh.vertices[v];
+            const std::array<double, 3> a = {fabs(r.x()), fabs(r.y()), fabs(r.z())};
+            REQUIRE( fabs(std::max({a[0], a[1], a[2]}) - 1.0) < 1E-9 );
+            if (fabs(a[0] - 1.0) < 1E-9 && fabs(a[1] - 1.0) < 1E-9 && fabs(a[2] - 1.0) < 1E-9) ++n_corners;
+        }
+        REQUIRE( n_corners == 8 );
+        REQUIRE( fabs(enclosed_volume(mesh) - 8.0) < 1E-9 );
+    }
+
+}
+
+TEST_CASE("Test parallel SurfaceDecimator decimate() function for 'double' type.", "Decimation") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    const TriangleMesh<double> original = sphere(96);
+    DecimationOptions options;
+    options.block_triangles = 8192;
+
+    SurfaceDecimator<double> serial(original, options, 1), parallel(original, options, 4);
+    const DecimationStatistics<double> statistics = serial.decimate(5000);
+    parallel.decimate(5000);
+    REQUIRE( statistics.n_parallel_collapses > 0 );
+    REQUIRE( statistics.n_parallel_collapses < statistics.n_collapses );
+
+    // The blocks do not depend on the threads.
+    const TriangleMesh<double> mesh = parallel.mesh(), reference = serial.mesh();
+    REQUIRE( mesh.triangles == reference.triangles );
+    REQUIRE( mesh.n_triangles() <= 5000 );
+    REQUIRE( check_wound(mesh) == 0 );
+    for (std::size_t v = 0; v < mesh.n_vertices(); ++v) {
+        REQUIRE( mesh.vertices.x()[v] == reference.vertices.x()[v] );
+        REQUIRE( fabs(sqrt(norm_squared(mesh.vertices[v])) - 1.0) < 0.01 );
+    }
+
+}
@@ -0,0 +1,168 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "predicates.hpp"
+#include "delaunay.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::Vector3DSoA;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+
+/**
+ * Random points in the unit cube.
+ */
+Vector3DSoA<double> random_points(std::size_t n, unsigned seed) {
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    Vector3DSoA<double> points;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double x = uniform(generator), y = uniform(generator), z = uniform(generator);
+        points.push_back(Vector3D<double>(x, y, z));
+    }
+    return points;
+
+}
+
+/**
+ * Check that every tetrahedron is positive, that interior faces are shared by exactly two tetrahedra with opposite
+ * orientation and return the total volume.
+ */
+double check_mesh(const TetrahedralMesh<double> &mesh) {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    std::map<std::array<std::size_t, 3>, int> faces;
+    double volume = 0.0;
+    for (const auto &t: mesh.tetrahedra) {
+        REQUIRE( orient3d(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]], mesh.vertices[t[3]]) > 0 );
+        volume += tetrahedron_volume(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]],
+                                     mesh.vertices[t[3]]);
+        for (std::size_t i = 0; i < 4; ++i) {
+            std::array<std::size_t, 3> f;
+            for (std::size_t m = 0, k = 0; m < 4; ++m) if (m != i) f[k++] = t[m];
+            std::sort(f.begin(), f.end());
+            ++faces[f];
+        }
+    }
+    for (const auto &[f, count]: faces) REQUIRE( count <= 2 );
+    return volume;
+
+}
+
+TEST_CASE("Test orient3d() and insphere() functions for 'double' type.", "Predicates") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const Vec3D a(0.0, 0.0, 0.0), b(1.0, 0.0, 0.0), c(0.0, 1.0, 0.0), d(0.0, 0.0, 1.0);
+
+    // Same sign as tetrahedron_volume().
+    REQUIRE( orient3d(a, b, c, d) == 1 );
+    REQUIRE( orient3d(b, a, c, d) == -1 );
+    REQUIRE( orient3d(a, b, c, Vec3D(0.3, 0.7, 0.0)) == 0 );
+
+    // Nearly coplanar points beyond the reach of floating point evaluation.
+    const double t = 1.0 + std::ldexp(1.0, -52);
+    REQUIRE( orient3d(Vec3D(t, t, t), Vec3D(2.0 * t, 2.0 * t, 2.0 * t), Vec3D(0.5, 0.5, 0.5), d) == 0 );
+
+    REQUIRE( insphere(a, b, c, d, Vec3D(0.25, 0.25, 0.25)) == 1 );
+    REQUIRE( insphere(a, b, c, d, Vec3D(2.0, 2.0, 2.0)) == -1 );
+    REQUIRE( insphere(a, b, c, d, Vec3D(1.0, 1.0, 0.0)) == 0 );
+    REQUIRE( insphere(a, b, c, d, Vec3D(1.0, 1.0, 1.0)) == 0 );
+
+    // Points moved off the sphere by far less than the rounding error of the determinant.
+    for (int k = -2; k <= 2; ++k) {
+        const Vec3D e(1.0, 1.0, k * std::ldexp(1.0, -60));
+        REQUIRE( insphere(a, b, c, d, e) == (k > 0) - (k < 0) );
+    }
+
+}
+
+TEST_CASE("Test delaunay_tetrahedralisation() function for 'double' type.", "Delaunay") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    const Vector3DSoA<double> points = random_points(200, 1);
+    const TetrahedralMesh<double> mesh = delaunay_tetrahedralisation(points, 1);
+
+    REQUIRE( mesh.n_vertices() == points.size() );
+    REQUIRE( mesh.n_tetrahedra() > 0 );
+    const double volume = check_mesh(mesh);
+    REQUIRE( volume > 0.5 );
+    REQUIRE( volume < 1.0 );
+
+    // No point lies strictly inside a circumsphere.
+    for (const auto &t: mesh.tetrahedra) {
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            REQUIRE( insphere(points[t[0]], points[t[1]], points[t[2]], points[t[3]], points[p]) <= 0 );
+        }
+    }
+
+}
+
+TEST_CASE("Test delaunay_tetrahedralisation() function on degenerate input for 'double' type.", "Delaunay") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    // A lattice: every cube of eight points is cospherical and every face of four coplanar.
+    const std::size_t n = 6;
+    Vector3DSoA<double> points;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t k = 0; k < n; ++k) points.push_back(Vector3D<double>(double(i), double(j), double(k)));
+        }
+    }
+    // Duplicates are left out.
+    points.push_back(Vector3D<double>(1.0, 2.0, 3.0));
+
+    const TetrahedralMesh<double> mesh = delaunay_tetrahedralisation(points, 1);
+    REQUIRE( fabs(check_mesh(mesh) - double((n - 1) * (n - 1) * (n - 1))) < 1E-9 );
+    for (const auto &t: mesh.tetrahedra) {
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            REQUIRE( insphere(points[t[0]], points[t[1]], points[t[2]], points[t[3]], points[p]) <= 0 );
+        }
+    }
+
+    // Coplanar points have no tetrahedralisation.
+    Vector3DSoA<double> plane;
+    for (std::size_t i = 0; i < 10; ++i) plane.push_back(Vector3D<double>(double(i % 3), double(i / 3), 0.0));
+    REQUIRE( delaunay_tetrahedralisation(plane, 1).n_tetrahedra() == 0 );
+
+}
+
+TEST_CASE("Test parallel delaunay_tetrahedralisation() function for 'double' type.", "Delaunay") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    // Random points are in general position, so their Delaunay tetrahedralisation is unique.
+    const Vector3DSoA<double> points = random_points(50000, 2);
+    const TetrahedralMesh<double> serial = delaunay_tetrahedralisation(points, 1);
+    const TetrahedralMesh<double> parallel = delaunay_tetrahedralisation(points, 4);
+
+    REQUIRE( parallel.n_tetrahedra() == serial.n_tetrahedra() );
+    REQUIRE( fabs(check_mesh(parallel) - check_mesh(serial)) < 1E-9 );
+
+    auto sorted = [](const TetrahedralMesh<double> &mesh) {
+        std::vector<std::array<std::size_t, 4>> tetrahedra = mesh.tetrahedra;
+        for (auto &t: tetrahedra) std::sort(t.begin(), t.end());
+        std::sort(tetrahedra.begin(), tetrahedra.end());
+        return tetrahedra;
+    };
+    REQUIRE( sorted(parallel) == sorted(serial) );
+
+}
@@ -0,0 +1,200 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <thread>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "partition.hpp"
+#include "distributed.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+
+/**
+ * Run one callable per rank on its own thread, each with the rank's transport endpoint.
+ */
+template<typename Fn>
+void run_ranks(std::size_t n_ranks, Fn fn) {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    SharedMemoryNetwork network(n_ranks);
+    std::vector<std::thread> threads;
+    for (std::size_t r = 0; r < n_ranks; ++r) {
+        threads.emplace_back([&network, &fn, r] {
+            SharedMemoryTransport transport(network, r);
+            fn(transport);
+        });
+    }
+    for (auto &thread: threads) thread.join();
+
+}
+
+TEST_CASE("Test DistributedMesh::distribute() function for 'double' type.", "Distributed") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = box(8, 6, 5);
+    const std::size_t n_ranks = 4;
+    std::vector<std::size_t> parts = partition_mesh(mesh, n_ranks);
+    std::vector<DistributedMesh<double>> ranks = DistributedMesh<double>::distribute(mesh, parts, n_ranks, 1);
+
+    std::vector<std::size_t> owned_vertices(mesh.n_vertices(), 0), owned_elements(mesh.n_tetrahedra(), 0);
+    for (const auto &d: ranks) {
+
+        // Owned entities first, and every vertex and element is owned exactly once overall.
+        for (std::size_t k = 0; k < d.n_owned_elements(); ++k) ++owned_elements[d.global_elements()[k]];
+        for (std::size_t k = 0; k < d.n_owned_vertices(); ++k) ++owned_vertices[d.global_vertices()[k]];
+        for (std::size_t k = 0; k < d.global_elements().size(); ++k) {
+            REQUIRE( (parts[d.global_elements()[k]] == d.rank()) == (k < d.n_owned_elements()) );
+            REQUIRE( d.local_element(d.global_elements()[k]) == k );
+        }
+
+        // The local mesh reproduces the global one and the interior elements read only owned vertices.
+        for (std::size_t k = 0; k < d.mesh().n_tetrahedra(); ++k) {
+            for (std::size_t a = 0; a < 4; ++a) {
+                REQUIRE( d.global_vertices()[d.mesh().tetrahedra[k][a]] == mesh.tetrahedra[d.global_elements()[k]][a] );
+            }
+        }
+        REQUIRE( d.interior_elements().size() + d.boundary_elements().size() == d.n_owned_elements() );
+        for (std::size_t k: d.interior_elements()) {
+            for (std::size_t v: d.mesh().tetrahedra[k]) REQUIRE( v < d.n_owned_vertices() );
+        }
+
+        // Every ghost is received exactly once and what one rank sends its neighbour receives.
+        for (const ExchangePlan *plan: {&d.vertex_plan(), &d.element_plan()}) {
+            const std::size_t n_owned = plan == &d.vertex_plan() ? d.n_owned_vertices() : d.n_owned_elements();
+            const std::size_t n_local = plan == &d.vertex_plan() ? d.global_vertices().size()
+                                                                 : d.global_elements().size();
+            REQUIRE( plan->receive_indices.size() == n_local - n_owned );
+            for (std::size_t k = 0; k < plan->neighbours.size(); ++k) {
+                const auto &other = ranks[plan->neighbours[k]];
+                const ExchangePlan &back = plan == &d.vertex_plan() ? other.vertex_plan() : other.element_plan();
+                const auto &here = plan == &d.vertex_plan() ? d.global_vertices() : d.global_elements();
+                const auto &there = plan == &d.vertex_plan() ? other.global_vertices() : other.global_elements();
+                const std::size_t j = static_cast<std::size_t>(
+                        std::find(back.neighbours.begin(), back.neighbours.end(), d.rank()) - back.neighbours.begin());
+                REQUIRE( j < back.neighbours.size() );
+                REQUIRE( plan->receive_offsets[k + 1] - plan->receive_offsets[k] ==
+                         back.send_offsets[j + 1] - back.send_offsets[j] );
+                for (std::size_t i = 0; i < plan->receive_offsets[k + 1] - plan->receive_offsets[k]; ++i) {
+                    REQUIRE( here[plan->receive_indices[plan->receive_offsets[k] + i]] ==
+                             there[back.send_indices[back.send_offsets[j] + i]] );
+                }
+            }
+        }
+
+    }
+    for (std::size_t count: owned_vertices) REQUIRE( count == 1 );
+    for (std::size_t count: owned_elements) REQUIRE( count == 1 );
+
+}
+
+TEST_CASE("Test begin_exchange() and finish_exchange() functions for 'double' type.", "Distributed") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = box(10, 8, 6);
+    const std::size_t n_ranks = 5;
+    std::vector<std::size_t> parts = partition_mesh(mesh, n_ranks);
+    std::vector<DistributedMesh<double>> ranks = DistributedMesh<double>::distribute(mesh, parts, n_ranks, 2);
+
+    // Lumped vertex volumes over the whole mesh.
+    std::vector<double> reference(mesh.n_vertices(), 0.0);
+    for (const auto &t: mesh.tetrahedra) {
+        const double v = fabs(tetrahedron_volume(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]],
+                                                 mesh.vertices[t[3]]));
+        for (std::size_t a: t) reference[a] += v / 4.0;
+    }
+
+    std::vector<char> ok(n_ranks, 0);
+    run_ranks(n_ranks, [&](SharedMemoryTransport &transport) {
+
+        const DistributedMesh<double> &d = ranks[transport.rank()];
+        const TetrahedralMesh<double> &local = d.mesh();
+
+        // The owned vertex sums are complete since one ghost layer holds every element around an owned vertex.
+        std::vector<double> volumes(local.n_vertices(), -1.0);
+        std::fill(volumes.begin(), volumes.begin() + static_cast<std::ptrdiff_t>(d.n_owned_vertices()), 0.0);
+        for (const auto &t: local.tetrahedra) {
+            const double v = fabs(tetrahedron_volume(local.vertices[t[0]], local.vertices[t[1]], local.vertices[t[2]],
+                                                     local.vertices[t[3]]));
+            for (std::size_t a: t) if (a < d.n_owned_vertices()) volumes[a] += v / 4.0;
+        }
+        begin_exchange(d.vertex_plan(), transport, volumes.data(), 1);
+
+        // An element exchange in flight at the same time, kept apart by its tag.
+        std::vector<std::size_t> labels(local.n_tetrahedra(), 0);
+        for (std::size_t k = 0; k < d.n_owned_elements(); ++k) labels[k] = d.global_elements()[k] + 1;
+        begin_exchange(d.element_plan(), transport, labels.data(), 2);
+
+        finish_exchange(d.vertex_plan(), transport, volumes.data(), 1);
+        finish_exchange(d.element_plan(), transport, labels.data(), 2);
+
+        bool valid = true;
+        for (std::size_t k = 0; k < local.n_vertices(); ++k) {
+            valid = valid && fabs(volumes[k] - reference[d.global_vertices()[k]]) < 1E-12;
+        }
+        for (std::size_t k = 0; k < local.n_tetrahedra(); ++k) valid = valid && labels[k] == d.global_elements()[k] + 1;
+        ok[transport.rank()] = valid;
+
+    });
+
+    for (char valid: ok) REQUIRE( valid );
+
+}
+
+TEST_CASE("Test exchange_and_compute() function for 'double' type.", "Distributed") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = box(12, 10, 8);
+    const std::size_t n_ranks = 3;
+    std::vector<std::size_t> parts = partition_mesh(mesh, n_ranks);
+    std::vector<DistributedMesh<double>> ranks = DistributedMesh<double>::distribute(mesh, parts, n_ranks);
+
+    // An element field of vertex averages, f(v) = x + 2 y + 3 z known only at the owned vertices.
+    auto f = [](const Vector3D<double> &r) { return r.x() + 2.0 * r.y() + 3.0 * r.z(); };
+
+    std::vector<char> ok(n_ranks, 0);
+    run_ranks(n_ranks, [&](SharedMemoryTransport &transport) {
+
+        const DistributedMesh<double> &d = ranks[transport.rank()];
+        const TetrahedralMesh<double> &local = d.mesh();
+
+        std::vector<double> values(local.n_vertices(), std::nan(""));
+        for (std::size_t k = 0; k < d.n_owned_vertices(); ++k) values[k] = f(local.vertices[k]);
+
+        std::vector<double> averages(d.n_owned_elements(), std::nan(""));
+        exchange_and_compute(d, transport, values.data(),
+                             [&](const std::size_t *elements, std::size_t count, std::size_t) {
+                                 for (std::size_t i = 0; i < count; ++i) {
+                                     const auto &t = local.tetrahedra[elements[i]];
+                                     averages[elements[i]] = (values[t[0]] + values[t[1]] + values[t[2]] +
+                                                              values[t[3]]) / 4.0;
+                                 }
+                             }, 0, 2);
+
+        bool valid = true;
+        for (std::size_t k = 0; k < d.n_owned_elements(); ++k) {
+            const auto &t = local.tetrahedra[k];
+            const double expected = f(tetrahedron_center(local.vertices[t[0]], local.vertices[t[1]],
+                                                         local.vertices[t[2]], local.vertices[t[3]]));
+            valid = valid && fabs(averages[k] - expected) < 1E-12;
+        }
+        ok[transport.rank()] = valid;
+
+    });
+
+    for (char valid: ok) REQUIRE( valid );
+
+}
@@ -0,0 +1,145 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "dual.hpp"
+
+TEST_CASE("Test dual number arithmetic for 'double' type.", "Dual") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using D2 = Dual<double, 2>;
+
+    D2 x = D2::variable(3.0, 0);
+    D2 y = D2::variable(4.0, 1);
+
+    // f(x, y) = sqrt(x^2 + y^2) / (x - y), evaluated at (3, 4).
+    D2 f = sqrt(x * x + y * y) / (x - y);
+
+    double eps = 1E-14;
+
+    REQUIRE( fabs(f.value() - (-5.0)) < eps );
+    // df/dx = x / (r (x - y)) - r / (x - y)^2 = 3/(5 * -1) - 5 = -5.6
+    REQUIRE( fabs(f.derivative(0) - (-5.6)) < eps );
+    // df/dy = y / (r (x - y)) + r / (x - y)^2 = 4/(5 * -1) + 5 = 4.2
+    REQUIRE( fabs(f.derivative(1) - 4.2) < eps );
+    REQUIRE( (-f).derivative(1) == -f.derivative(1) );
+
+}
+
+TEST_CASE("Test edge_length_gradient() function for 'double' type.", "Dual geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+    using D6 = Dual<double, 6>;
+
+    Vec3D::set_eps(1E-7);
+    Vector3D<D6>::set_eps(1E-7);
+
+    Vec3D u(1.0, 2.0, 3.0);
+    Vec3D v(4.0, 5.0, 7.0);
+
+    D6 automatic = edge_length(seed<6>(u, 0), seed<6>(v, 3));
+    auto analytic = edge_length_gradient(u, v);
+
+    double eps = 1E-14;
+
+    REQUIRE( fabs(automatic.value() - edge_length(u, v)) < eps );
+    for (std::size_t k = 0; k < 2; ++k) {
+        REQUIRE( fabs(automatic.derivative(3 * k + 0) - analytic[k].x()) < eps );
+        REQUIRE( fabs(automatic.derivative(3 * k + 1) - analytic[k].y()) < eps );
+        REQUIRE( fabs(automatic.derivative(3 * k + 2) - analytic[k].z()) < eps );
+    }
+
+}
+
+TEST_CASE("Test triangle_area_gradient() function for 'double' type.", "Dual geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+    using D9 = Dual<double, 9>;
+
+    Vec3D::set_eps(1E-7);
+    Vector3D<D9>::set_eps(1E-7);
+
+    Vec3D r1(1.0, 0.2, 0.0);
+    Vec3D r2(0.1, 1.0, 0.3);
+    Vec3D r3(0.0, 0.4, 1.0);
+
+    D9 automatic = triangle_area(seed<9>(r1, 0), seed<9>(r2, 3), seed<9>(r3, 6));
+    auto analytic = triangle_area_gradient(r1, r2, r3);
+
+    double eps = 1E-14;
+
+    REQUIRE( fabs(automatic.value() - triangle_area(r1, r2, r3)) < eps );
+    for (std::size_t k = 0; k < 3; ++k) {
+        REQUIRE( fabs(automatic.derivative(3 * k + 0) - analytic[k].x()) < eps );
+        REQUIRE( fabs(automatic.derivative(3 * k + 1) - analytic[k].y()) < eps );
+        REQUIRE( fabs(automatic.derivative(3 * k + 2) - analytic[k].z()) < eps );
+    }
+
+}
+
+TEST_CASE("Test tetrahedron_volume_gradient() function for 'double' type.", "Dual geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using std::string;
+    using Vec3D = Vector3D<double>;
+    using D12 = Dual<double, 12>;
+
+    Vec3D r1(1.0, 0.0, 0.2);
+    Vec3D r2(0.1, 1.0, 0.0);
+    Vec3D r3(0.0, 0.3, 1.0);
+    Vec3D r4(1.0, 1.2, 1.1);
+
+    D12 automatic = tetrahedron_volume(seed<12>(r1, 0), seed<12>(r2, 3), seed<12>(r3, 6), seed<12>(r4, 9));
+    auto analytic = tetrahedron_volume_gradient(r1, r2, r3, r4);
+
+    // Central finite differences as an independent check.
+    const std::array<Vec3D, 4> r = {r1, r2, r3, r4};
+    const double h = 1E-6;
+    auto volume = [](const std::array<Vec3D, 4> &p) { return tetrahedron_volume(p[0], p[1], p[2], p[3]); };
+    std::array<double, 12> finite{};
+    for (std::size_t k = 0; k < 12; ++k) {
+        std::array<Vec3D, 4> plus = r, minus = r;
+        Vec3D dh(k % 3 == 0 ? h : 0.0, k % 3 == 1 ? h : 0.0, k % 3 == 2 ? h : 0.0);
+        plus[k / 3] = plus[k / 3] + dh;
+        minus[k / 3] = minus[k / 3] - dh;
+        finite[k] = (volume(plus) - volume(minus)) / (2.0 * h);
+    }
+
+#ifdef DEBUG_MESSAGES
+    std::cout.precision(15);
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|                   tetrahedron volume gradient (double)                    |" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    for (std::size_t k = 0; k < 4; ++k) {
+        std::cout << "| analytic r" << k + 1 << "     | " << analytic[k]                    << std::endl;
+    }
+    std::cout << "| automatic       | " << automatic                                        << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    double eps = 1E-14;
+
+    REQUIRE( fabs(automatic.value() - tetrahedron_volume(r1, r2, r3, r4)) < eps );
+    for (std::size_t k = 0; k < 4; ++k) {
+        REQUIRE( fabs(automatic.derivative(3 * k + 0) - analytic[k].x()) < eps );
+        REQUIRE( fabs(automatic.derivative(3 * k + 1) - analytic[k].y()) < eps );
+        REQUIRE( fabs(automatic.derivative(3 * k + 2) - analytic[k].z()) < eps );
+        REQUIRE( fabs(finite[3 * k + 0] - analytic[k].x()) < 1E-8 );
+        REQUIRE( fabs(finite[3 * k + 1] - analytic[k].y()) < 1E-8 );
+        REQUIRE( fabs(finite[3 * k + 2] - analytic[k].z()) < 1E-8 );
+    }
+
+}
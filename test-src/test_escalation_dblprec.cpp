@@ -0,0 +1,214 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "double_double.hpp"
+#include "escalation.hpp"
+
+TEST_CASE("Test double-double arithmetic for 'double-double' type.", "DoubleDouble") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using DD = DoubleDouble;
+
+    // 1 + 2^-80 is not representable in double but is in double-double.
+    DD tiny(std::ldexp(1.0, -80));
+    DD sum = DD(1.0) + tiny;
+    DD diff = sum - DD(1.0);
+
+    REQUIRE( diff.hi() == std::ldexp(1.0, -80) );
+
+    DD third = DD(1.0) / DD(3.0);
+    DD one = third * DD(3.0);
+    REQUIRE( std::fabs((one - DD(1.0)).to_double()) < 1E-30 );
+
+    DD root2 = sqrt(DD(2.0));
+    REQUIRE( std::fabs((root2 * root2 - DD(2.0)).to_double()) < 1E-30 );
+
+}
+
+TEST_CASE("Test geometry functions for 'double-double' type.", "DoubleDouble geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using DD = DoubleDouble;
+    using Vec3DD = Vector3D<DD>;
+
+    Vec3DD::set_eps(1E-20);
+    Vec3DD r1(1.0, 0.0, 0.0);
+    Vec3DD r2(0.0, 1.0, 0.0);
+    Vec3DD r3(0.0, 0.0, 1.0);
+    Vec3DD r4(1.0, 1.0, 1.0);
+
+    REQUIRE( std::fabs((tetrahedron_volume(r1, r2, r3, r4) - DD(1.0) / DD(3.0)).to_double()) < 1E-30 );
+    REQUIRE( std::fabs((triangle_area(r1, r2, r3) - sqrt(DD(3.0)) / DD(2.0)).to_double()) < 1E-30 );
+    REQUIRE( std::fabs((edge_length(r1, r2) - sqrt(DD(2.0))).to_double()) < 1E-30 );
+
+}
+
+TEST_CASE("Test escalate_tetrahedron_volume() function for 'double' type.", "Escalation") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using std::string;
+    using Vec3D = Vector3D<double>;
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    const std::size_t n = 500;
+    Vector3DSoA<double> r1, r2, r3, r4;
+    for (std::size_t i = 0; i < n; ++i) {
+        r1.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r2.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r3.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r4.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+    }
+
+    // A nearly flat element: the fourth vertex is the (rounded) sum of the others, so the exact volume is tiny and
+    // dominated by double precision rounding.
+    Vec3D a(1.0 / 3.0, 2.0 / 3.0, 1.0 / 7.0);
+    Vec3D b(1.0 / 11.0, 5.0 / 13.0, 3.0 / 17.0);
+    r1.push_back(Vec3D(0.0, 0.0, 0.0));
+    r2.push_back(a);
+    r3.push_back(b);
+    r4.push_back(a + b);
+
+    // An exactly flat element in the plane z = x + y: no precision can certify the relative error of a zero volume, the
+    // exact orientation predicate certifies the zero instead.
+    r1.push_back(Vec3D(0.0, 0.0, 0.0));
+    r2.push_back(Vec3D(1.0, 0.0, 1.0));
+    r3.push_back(Vec3D(0.0, 1.0, 1.0));
+    r4.push_back(Vec3D(1.0, 1.0, 2.0));
+
+    ScalarEscalationResult result = escalate_tetrahedron_volume(r1, r2, r3, r4);
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|                   tetrahedron volume escalation (double)                  |" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| double          | " << result.statistics.n_double         << std::endl;
+    std::cout << "| double-double   | " << result.statistics.n_double_double  << std::endl;
+    std::cout << "| multiprecision  | " << result.statistics.n_multiprecision << std::endl;
+    std::cout << "| unresolved      | " << result.statistics.n_unresolved     << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE( result.precision[i] == Precision::Double );
+        REQUIRE( fabs(result.values[i] - tetrahedron_volume(r1[i], r2[i], r3[i], r4[i])) < 1E-14 );
+    }
+
+    REQUIRE( result.precision[n] == Precision::DoubleDouble );
+    REQUIRE( result.precision[n + 1] == Precision::Double );
+    REQUIRE( result.values[n + 1] == 0.0 );
+
+    // Cross check the escalated value against an explicit double-double evaluation.
+    using DD = DoubleDouble;
+    Vector3D<DD> a_dd(a.x(), a.y(), a.z());
+    Vector3D<DD> b_dd(b.x(), b.y(), b.z());
+    Vector3D<DD> c_dd(r4[n].x(), r4[n].y(), r4[n].z());
+    DD expected = dot(a_dd, cross(b_dd, c_dd)) / DD(6.0);
+    REQUIRE( fabs(result.values[n] - expected.to_double()) <= 1E-12 * fabs(expected.to_double()) );
+
+    REQUIRE( result.statistics.n_double == n + 1 );
+    REQUIRE( result.statistics.n_double + result.statistics.n_double_double + result.statistics.n_multiprecision
+             == n + 2 );
+    REQUIRE( result.statistics.n_unresolved == 0 );
+
+    // Under any tolerance, e.g. a translated copy of the flat element above and four collinear points.
+    Vector3DSoA<double> f1, f2, f3, f4;
+    const Vec3D shift(1048576.5, 0.125, -3.0);
+    f1.push_back(Vec3D(0.0, 0.0, 0.0) + shift);
+    f2.push_back(Vec3D(1.0, 0.0, 1.0) + shift);
+    f3.push_back(Vec3D(0.0, 1.0, 1.0) + shift);
+    f4.push_back(Vec3D(1.0, 1.0, 2.0) + shift);
+    f1.push_back(Vec3D(0.0, 0.0, 0.0));
+    f2.push_back(Vec3D(0.25, 0.5, 0.75));
+    f3.push_back(Vec3D(0.5, 1.0, 1.5));
+    f4.push_back(Vec3D(1.0, 2.0, 3.0));
+    EscalationOptions strict;
+    strict.relative_tolerance = 1E-30;
+    const ScalarEscalationResult flat = escalate_tetrahedron_volume(f1, f2, f3, f4, strict);
+    for (std::size_t i = 0; i < 2; ++i) {
+        REQUIRE( flat.values[i] == 0.0 );
+        REQUIRE( flat.precision[i] == Precision::Double );
+    }
+    REQUIRE( flat.statistics.n_double == 2 );
+    REQUIRE( flat.statistics.n_unresolved == 0 );
+
+}
+
+TEST_CASE("Test escalate_edge_length() function for 'double' type.", "Escalation") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    Vec3D::set_eps(1E-7);
+
+    Vector3DSoA<double> r1, r2;
+    r1.push_back(Vec3D(1.0, 2.0, 3.0));
+    r2.push_back(Vec3D(4.0, 5.0, 6.0));
+    r1.push_back(Vec3D(1E8, 1E8, 1E8));
+    r2.push_back(Vec3D(1E8 + 1.0, 1E8, 1E8));
+
+    ScalarEscalationResult result = escalate_edge_length(r1, r2);
+
+    REQUIRE( result.statistics.n_double == 2 );
+    REQUIRE( fabs(result.values[0] - edge_length(r1[0], r2[0])) < 1E-14 );
+    REQUIRE( fabs(result.values[1] - edge_length(r1[1], r2[1])) < 1E-14 );
+
+    // Asking for more than double precision can deliver forces escalation.
+    EscalationOptions strict;
+    strict.relative_tolerance = 1E-17;
+
+    ScalarEscalationResult strict_result = escalate_edge_length(r1, r2, strict);
+    REQUIRE( strict_result.statistics.n_double == 0 );
+    REQUIRE( strict_result.precision[0] == Precision::DoubleDouble );
+    REQUIRE( strict_result.statistics.n_unresolved == 0 );
+    REQUIRE( fabs(strict_result.values[0] - sqrt(27.0 + 1E-14)) < 1E-14 );
+
+}
+
+TEST_CASE("Test escalate_triangle_normal() function for 'double' type.", "Escalation") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    Vec3D::set_eps(1E-30);
+
+    Vector3DSoA<double> r1, r2, r3;
+    r1.push_back(Vec3D(1.0, 0.0, 0.0));
+    r2.push_back(Vec3D(0.0, 1.0, 0.0));
+    r3.push_back(Vec3D(0.0, 0.0, 1.0));
+
+    // A sliver triangle, r3 is within a few ulps of the line through r1 and r2.
+    r1.push_back(Vec3D(0.0, 0.0, 0.0));
+    r2.push_back(Vec3D(1.0, 1.0 / 3.0, 1.0 / 7.0));
+    r3.push_back(Vec3D(3.0, 1.0, std::nextafter(3.0 / 7.0, 1.0)));
+
+    VectorEscalationResult result = escalate_triangle_normal(r1, r2, r3);
+
+    Vec3D normal = result.values[0];
+    REQUIRE( result.precision[0] == Precision::Double );
+    REQUIRE( fabs(normal.x() - 1.0 / sqrt(3.0)) < 1E-14 );
+    REQUIRE( fabs(normal.y() - 1.0 / sqrt(3.0)) < 1E-14 );
+    REQUIRE( fabs(normal.z() - 1.0 / sqrt(3.0)) < 1E-14 );
+
+    REQUIRE( result.precision[1] != Precision::Double );
+    REQUIRE( fabs(norm_squared(result.values[1]) - 1.0) < 1E-12 );
+
+    Vec3D::set_eps(1E-7);
+
+}
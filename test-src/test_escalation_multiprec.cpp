@@ -0,0 +1,65 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "mpreal.h"
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "escalation.hpp"
+
+TEST_CASE("Test escalate_tetrahedron_volume() function for 'multiprecision' type.", "Escalation") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+    using Vec3D = Vector3D<double>;
+
+    const int digits = 50;
+    mpreal::set_default_prec(mpfr::digits2bits(digits));
+
+    Vector3DSoA<double> r1, r2, r3, r4;
+
+    // A regular element.
+    r1.push_back(Vec3D(1.0, 0.0, 0.0));
+    r2.push_back(Vec3D(0.0, 1.0, 0.0));
+    r3.push_back(Vec3D(0.0, 0.0, 1.0));
+    r4.push_back(Vec3D(1.0, 1.0, 1.0));
+
+    // An element lifted 2^-50 off the plane z = x + y.
+    r1.push_back(Vec3D(0.0, 0.0, 0.0));
+    r2.push_back(Vec3D(1.0, 0.0, 1.0));
+    r3.push_back(Vec3D(0.0, 1.0, 1.0));
+    r4.push_back(Vec3D(1.0, 1.0, 2.0 + std::ldexp(1.0, -50)));
+
+    // With the default tolerance the lifted element is resolved in double-double.
+    ScalarEscalationResult result = escalate_tetrahedron_volume(r1, r2, r3, r4);
+
+    REQUIRE( result.precision[0] == Precision::Double );
+    REQUIRE( result.precision[1] == Precision::DoubleDouble );
+    REQUIRE( result.statistics.n_multiprecision == 0 );
+
+    // A tolerance beyond double-double forces every element into multiprecision.
+    EscalationOptions options;
+    options.relative_tolerance = 1E-40;
+    options.multiprecision_bits = 512;
+
+    ScalarEscalationResult strict = escalate_tetrahedron_volume(r1, r2, r3, r4, options);
+
+    REQUIRE( strict.precision[0] == Precision::MultiPrecision );
+    REQUIRE( strict.precision[1] == Precision::MultiPrecision );
+    REQUIRE( strict.statistics.n_multiprecision == 2 );
+    REQUIRE( strict.statistics.n_unresolved == 0 );
+    REQUIRE( strict.values[0] == 1.0 / 3.0 );
+    REQUIRE( strict.values[1] == std::ldexp(1.0, -50) / 6.0 );
+
+    // The default precision must be restored.
+    REQUIRE( mpreal::get_default_prec() == mpfr::digits2bits(digits) );
+
+}
@@ -0,0 +1,181 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <map>
+#include <random>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "fmm.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::Vector3DSoA;
+using org::lesleisnagy::geomlib::TriangleMesh;
+
+/**
+ * Direct summation reference.
+ */
+std::vector<double> direct(const Vector3DSoA<double> &sources, const Vector3DSoA<double> &targets,
+                           const std::vector<double> &q) {
+
+    std::vector<double> phi(targets.size(), 0.0);
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+        for (std::size_t j = 0; j < sources.size(); ++j) {
+            const Vector3D<double> d = targets[i] - sources[j];
+            const double r2 = dot(d, d);
+            if (r2 > 0.0) phi[i] += q[j] / sqrt(r2);
+        }
+    }
+    return phi;
+
+}
+
+double relative_error(const std::vector<double> &a, const std::vector<double> &b) {
+
+    double error = 0.0, reference = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        error += (a[i] - b[i]) * (a[i] - b[i]);
+        reference += b[i] * b[i];
+    }
+    return sqrt(error / reference);
+
+}
+
+TEST_CASE("Test LaplaceFmm class against direct summation for 'double' type.", "FMM") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    Vector3DSoA<double> sources, targets;
+    std::vector<double> q1, q2;
+    for (std::size_t i = 0; i < 2000; ++i) {
+        sources.push_back(Vec3D(dist(gen), dist(gen), 0.2 * dist(gen)));
+        q1.push_back(dist(gen));
+        q2.push_back(dist(gen));
+    }
+    for (std::size_t i = 0; i < 1500; ++i) targets.push_back(Vec3D(dist(gen), dist(gen), 0.2 * dist(gen)));
+    // Some targets coincide with sources; those pairs are skipped.
+    for (std::size_t i = 0; i < 100; ++i) targets.push_back(sources[i]);
+
+    const std::vector<double> reference = direct(sources, targets, q1);
+
+    FmmOptions low;
+    low.order = 3;
+    low.leaf_size = 64;
+    FmmOptions high = low;
+    high.order = 7;
+
+    LaplaceFmm<double> fmm_low(sources, targets, low);
+    LaplaceFmm<double> fmm_high(sources, targets, high);
+
+    const std::vector<double> phi_low = fmm_low.evaluate(q1, 1);
+    const std::vector<double> phi_high = fmm_high.evaluate(q1, 1);
+    const std::vector<double> phi_threaded = fmm_high.evaluate(q1, 3);
+
+    const double error_low = relative_error(phi_low, reference);
+    const double error_high = relative_error(phi_high, reference);
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| cells           | " << fmm_high.n_cells()                                 << std::endl;
+    std::cout << "| M2L / P2P       | " << fmm_high.n_m2l() << " / " << fmm_high.n_p2p()       << std::endl;
+    std::cout << "| error (p = 3)   | " << error_low                                          << std::endl;
+    std::cout << "| error (p = 7)   | " << error_high                                         << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    REQUIRE( fmm_high.n_m2l() > 0 );
+    REQUIRE( error_low < 1E-2 );
+    REQUIRE( error_high < 1E-5 );
+    REQUIRE( error_high < error_low );
+    REQUIRE( relative_error(phi_threaded, phi_high) < 1E-13 );
+
+    // Repeated evaluations with new strengths reuse the pre-computed operators; the result is linear in them.
+    std::vector<double> q12(q1.size());
+    for (std::size_t i = 0; i < q1.size(); ++i) q12[i] = q1[i] + 2.0 * q2[i];
+    const std::vector<double> phi2 = fmm_high.evaluate(q2, 2);
+    const std::vector<double> phi12 = fmm_high.evaluate(q12, 2);
+    for (std::size_t i = 0; i < phi12.size(); ++i) REQUIRE( fabs(phi12[i] - (phi_high[i] + 2.0 * phi2[i])) < 1E-10 );
+
+    // Many more threads than separation groups leave some of the requested chunks empty.
+    FmmOptions fine;
+    fine.order = 2;
+    fine.leaf_size = 8;
+    LaplaceFmm<double> fmm_fine(sources, targets, fine);
+    const std::vector<double> phi_fine = fmm_fine.evaluate(q1, 1);
+    for (const std::size_t n_threads: {7, 64, 150, 300}) {
+        REQUIRE( relative_error(fmm_fine.evaluate(q1, n_threads), phi_fine) < 1E-13 );
+    }
+
+}
+
+TEST_CASE("Test LaplaceFmm class with triangle quadrature sources for 'double' type.", "FMM") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    // A unit sphere from a subdivided octahedron.
+    std::vector<Vec3D> vertices = {Vec3D(1.0, 0.0, 0.0), Vec3D(-1.0, 0.0, 0.0), Vec3D(0.0, 1.0, 0.0),
+                                   Vec3D(0.0, -1.0, 0.0), Vec3D(0.0, 0.0, 1.0), Vec3D(0.0, 0.0, -1.0)};
+    std::vector<std::array<std::size_t, 3>> triangles = {{0, 2, 4}, {2, 1, 4}, {1, 3, 4}, {3, 0, 4},
+                                                         {2, 0, 5}, {1, 2, 5}, {3, 1, 5}, {0, 3, 5}};
+    for (int level = 0; level < 4; ++level) {
+        std::map<std::pair<std::size_t, std::size_t>, std::size_t> midpoints;
+        auto midpoint = [&](std::size_t a, std::size_t b) {
+            auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = midpoints.find(key);
+            if (it != midpoints.end()) return it->second;
+            vertices.push_back(normalised(0.5 * (vertices[a] + vertices[b])));
+            midpoints[key] = vertices.size() - 1;
+            return vertices.size() - 1;
+        };
+        std::vector<std::array<std::size_t, 3>> refined;
+        for (const auto &t: triangles) {
+            std::size_t a = midpoint(t[0], t[1]), b = midpoint(t[1], t[2]), c = midpoint(t[2], t[0]);
+            refined.push_back({t[0], a, c});
+            refined.push_back({t[1], b, a});
+            refined.push_back({t[2], c, b});
+            refined.push_back({a, b, c});
+        }
+        triangles = refined;
+    }
+    TriangleMesh<double> mesh;
+    for (const auto &v: vertices) mesh.vertices.push_back(v);
+    mesh.triangles = triangles;
+
+    QuadratureSources<double> sources = triangle_quadrature_sources(mesh, 3);
+    REQUIRE( sources.points.size() == 3 * mesh.n_triangles() );
+
+    // Targets inside (potential 4 pi) and outside (potential 4 pi / |x|) a uniformly charged unit sphere.
+    std::mt19937 gen(99);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Vector3DSoA<double> targets;
+    for (std::size_t i = 0; i < 200; ++i) {
+        Vec3D d = normalised(Vec3D(dist(gen), dist(gen), dist(gen)));
+        targets.push_back((i % 2 == 0 ? 0.5 : 2.0) * d);
+    }
+
+    const std::vector<double> density(mesh.n_triangles(), 1.0);
+    const std::vector<double> q = sources.strengths(density);
+
+    LaplaceFmm<double> fmm(sources.points, targets);
+    const std::vector<double> phi = fmm.evaluate(q);
+
+    REQUIRE( relative_error(phi, direct(sources.points, targets, q)) < 1E-5 );
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+        const double exact = i % 2 == 0 ? 4.0 * M_PI : 4.0 * M_PI / 2.0;
+        REQUIRE( fabs(phi[i] - exact) < 1E-2 * exact );
+    }
+
+}
@@ -0,0 +1,172 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <map>
+#include <random>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "bem.hpp"
+#include "hmatrix.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TriangleMesh;
+
+/**
+ * Create an outward wound unit sphere by repeated subdivision of an octahedron.
+ */
+TriangleMesh<double> unit_sphere(int levels) {
+
+    using Vec3D = Vector3D<double>;
+
+    std::vector<Vec3D> vertices = {Vec3D(1.0, 0.0, 0.0), Vec3D(-1.0, 0.0, 0.0), Vec3D(0.0, 1.0, 0.0),
+                                   Vec3D(0.0, -1.0, 0.0), Vec3D(0.0, 0.0, 1.0), Vec3D(0.0, 0.0, -1.0)};
+    std::vector<std::array<std::size_t, 3>> triangles = {{0, 2, 4}, {2, 1, 4}, {1, 3, 4}, {3, 0, 4},
+                                                         {2, 0, 5}, {1, 2, 5}, {3, 1, 5}, {0, 3, 5}};
+
+    for (int level = 0; level < levels; ++level) {
+        std::map<std::pair<std::size_t, std::size_t>, std::size_t> midpoints;
+        auto midpoint = [&](std::size_t a, std::size_t b) {
+            auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = midpoints.find(key);
+            if (it != midpoints.end()) return it->second;
+            vertices.push_back(normalised(0.5 * (vertices[a] + vertices[b])));
+            midpoints[key] = vertices.size() - 1;
+            return vertices.size() - 1;
+        };
+        std::vector<std::array<std::size_t, 3>> refined;
+        for (const auto &t: triangles) {
+            std::size_t a = midpoint(t[0], t[1]), b = midpoint(t[1], t[2]), c = midpoint(t[2], t[0]);
+            refined.push_back({t[0], a, c});
+            refined.push_back({t[1], b, a});
+            refined.push_back({t[2], c, b});
+            refined.push_back({a, b, c});
+        }
+        triangles = refined;
+    }
+
+    TriangleMesh<double> mesh;
+    for (const auto &v: vertices) mesh.vertices.push_back(v);
+    mesh.triangles = triangles;
+    return mesh;
+
+}
+
+TEST_CASE("Test ClusterTree class for 'double' type.", "HMatrix") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    Vector3DSoA<double> points;
+    for (std::size_t i = 0; i < 1000; ++i) points.push_back(Vec3D(dist(gen), 0.5 * dist(gen), 0.1 * dist(gen)));
+
+    ClusterTree<double> tree(points, 16);
+
+    // The permutation is a permutation.
+    std::vector<std::size_t> sorted = tree.permutation();
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < sorted.size(); ++i) REQUIRE( sorted[i] == i );
+
+    // Leaves are small, sons partition their father and every point lies in its cluster's bounding box.
+    for (const auto &node: tree.nodes()) {
+        if (node.is_leaf()) {
+            REQUIRE( node.size() <= 16 );
+        } else {
+            const auto &left = tree.nodes()[node.children[0]];
+            const auto &right = tree.nodes()[node.children[1]];
+            REQUIRE( left.begin == node.begin );
+            REQUIRE( left.end == right.begin );
+            REQUIRE( right.end == node.end );
+        }
+        for (std::size_t p = node.begin; p < node.end; ++p) {
+            const Vec3D r = points[tree.permutation()[p]];
+            REQUIRE( r.x() >= node.lower.x() );
+            REQUIRE( r.x() <= node.upper.x() );
+            REQUIRE( r.y() >= node.lower.y() );
+            REQUIRE( r.y() <= node.upper.y() );
+            REQUIRE( r.z() >= node.lower.z() );
+            REQUIRE( r.z() <= node.upper.z() );
+        }
+    }
+
+}
+
+TEST_CASE("Test HMatrix class on a boundary-element double layer for 'double' type.", "HMatrix") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TriangleMesh<double> mesh = unit_sphere(4);
+
+    // Collocation at the vertices, slightly inside the surface to stay away from the singular diagonal.
+    Vector3DSoA<double> targets;
+    for (std::size_t i = 0; i < mesh.n_vertices(); ++i) targets.push_back(0.99 * mesh.vertices[i]);
+
+    BemInteraction<double> interaction(targets, mesh, BemKernel::DoubleLayerLinear);
+
+    HMatrixOptions options;
+    options.leaf_size = 24;
+    options.tolerance = 1E-6;
+
+    HMatrix<double> h(targets, interaction.column_points(), interaction, options, 2);
+
+    const std::vector<double> dense = bem_matrix(targets, mesh, BemKernel::DoubleLayerLinear);
+    const std::size_t n = mesh.n_vertices();
+
+    // Single entries agree with the dense assembly.
+    for (std::size_t i = 0; i < n; i += 37) {
+        for (std::size_t j = 0; j < n; j += 11) REQUIRE( fabs(interaction(i, j) - dense[i * n + j]) < 1E-13 );
+    }
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> x(n);
+    for (double &xi: x) xi = dist(gen);
+
+    std::vector<double> y_dense(n, 0.0);
+    for (std::size_t i = 0; i < n; ++i) for (std::size_t j = 0; j < n; ++j) y_dense[i] += dense[i * n + j] * x[j];
+
+    const std::vector<double> y = h.multiply(x, 1);
+    const std::vector<double> y_threaded = h.multiply(x, 3);
+
+    double error = 0.0, reference = 0.0, threaded = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        error += (y[i] - y_dense[i]) * (y[i] - y_dense[i]);
+        reference += y_dense[i] * y_dense[i];
+        threaded = std::max(threaded, fabs(y[i] - y_threaded[i]));
+    }
+
+    std::size_t n_low_rank = 0;
+    for (const auto &block: h.blocks()) n_low_rank += block.low_rank ? 1 : 0;
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| unknowns        | " << n                                                  << std::endl;
+    std::cout << "| blocks          | " << h.blocks().size() << " (" << n_low_rank << " low rank)" << std::endl;
+    std::cout << "| storage         | " << h.storage() << " / " << n * n                       << std::endl;
+    std::cout << "| relative error  | " << sqrt(error / reference)                              << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    REQUIRE( n_low_rank > 0 );
+    REQUIRE( h.storage() < n * n );
+    REQUIRE( sqrt(error / reference) < 1E-5 );
+    REQUIRE( threaded < 1E-12 );
+
+    // Many more threads than blocks leave some of the requested chunks empty.
+    const std::size_t n_blocks = h.blocks().size();
+    for (const std::size_t n_threads: {n_blocks - 1, n_blocks / 2 + 1, n_blocks + 1, 4 * n_blocks}) {
+        const std::vector<double> y_many = h.multiply(x, n_threads);
+        for (std::size_t i = 0; i < n; ++i) REQUIRE( fabs(y[i] - y_many[i]) < 1E-12 );
+    }
+
+}
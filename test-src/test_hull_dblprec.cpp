@@ -0,0 +1,146 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "predicates.hpp"
+#include "hull.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::Vector3DSoA;
+using org::lesleisnagy::geomlib::TriangleMesh;
+
+/**
+ * Check that a hull is closed, that every point lies on or behind every face and return its volume.
+ */
+double check_hull(const Vector3DSoA<double> &points, const std::vector<std::array<std::size_t, 3>> &triangles) {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    // Every directed edge appears once and its reverse once.
+    std::map<std::pair<std::size_t, std::size_t>, int> edges;
+    for (const auto &t: triangles) {
+        for (std::size_t k = 0; k < 3; ++k) ++edges[{t[k], t[(k + 1) % 3]}];
+    }
+    for (const auto &[e, count]: edges) {
+        REQUIRE( count == 1 );
+        REQUIRE( edges.count({e.second, e.first}) == 1 );
+    }
+
+    for (const auto &t: triangles) {
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            REQUIRE( orient3d(points[t[0]], points[t[1]], points[t[2]], points[p]) <= 0 );
+        }
+    }
+
+    // Outward triangles: the volume of the cone from any point is positive.
+    double volume = 0.0;
+    for (const auto &t: triangles) {
+        volume -= tetrahedron_volume(points[t[0]], points[t[1]], points[t[2]], points[0]);
+    }
+    return volume;
+
+}
+
+TEST_CASE("Test convex_hull_triangles() function for 'double' type.", "ConvexHull") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    // Points in a ball and on its sphere: the sphere points make up the hull.
+    Vector3DSoA<double> points;
+    for (std::size_t i = 0; i < 2000; ++i) {
+        const Vector3D<double> r(uniform(generator), uniform(generator), uniform(generator));
+        if (norm_squared(r) < 1.0) points.push_back(0.9 * r);
+    }
+    const std::size_t n_inside = points.size();
+    for (std::size_t i = 0; i < 300; ++i) {
+        const Vector3D<double> r(normal(generator), normal(generator), normal(generator));
+        points.push_back(r / sqrt(norm_squared(r)));
+    }
+
+    const std::vector<std::array<std::size_t, 3>> triangles = convex_hull_triangles(points, 1);
+    const double volume = check_hull(points, triangles);
+    REQUIRE( volume > 3.5 );
+    REQUIRE( volume < 4.0 * M_PI / 3.0 );
+
+    std::vector<std::size_t> vertices;
+    for (const auto &t: triangles) vertices.insert(vertices.end(), t.begin(), t.end());
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+    REQUIRE( vertices.size() == 300 );
+    REQUIRE( vertices.front() == n_inside );
+    REQUIRE( triangles.size() == 2 * vertices.size() - 4 );
+
+    // The compact mesh has the same triangles with outward triangle_normal()s.
+    const TriangleMesh<double> mesh = convex_hull(points, 1);
+    REQUIRE( mesh.n_vertices() == 300 );
+    REQUIRE( mesh.n_triangles() == triangles.size() );
+    for (const auto &t: mesh.triangles) {
+        const Vector3D<double> centre = triangle_center(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]]);
+        const Vector3D<double> n = triangle_normal(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]]);
+        REQUIRE( dot(n, centre) > 0.0 );
+    }
+
+}
+
+TEST_CASE("Test convex_hull_triangles() function on degenerate input for 'double' type.", "ConvexHull") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    // A lattice: many points on each face plane, with duplicates.
+    const std::size_t n = 6;
+    Vector3DSoA<double> points;
+    for (std::size_t copy = 0; copy < 2; ++copy) {
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    points.push_back(Vector3D<double>(double(i), double(j), double(k)));
+                }
+            }
+        }
+    }
+    REQUIRE( fabs(check_hull(points, convex_hull_triangles(points, 1)) - 125.0) < 1E-9 );
+
+    // Coplanar points have no hull.
+    Vector3DSoA<double> plane;
+    for (std::size_t i = 0; i < 10; ++i) plane.push_back(Vector3D<double>(double(i % 3), double(i / 3), 1.0));
+    REQUIRE( convex_hull_triangles(plane, 1).empty() );
+
+}
+
+TEST_CASE("Test parallel convex_hull_triangles() function for 'double' type.", "ConvexHull") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    std::mt19937 generator(5);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    Vector3DSoA<double> points;
+    for (std::size_t i = 0; i < 400000; ++i) {
+        points.push_back(Vector3D<double>(normal(generator), normal(generator), normal(generator)));
+    }
+
+    auto sorted = [](std::vector<std::array<std::size_t, 3>> triangles) {
+        for (auto &t: triangles) std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    };
+    const std::vector<std::array<std::size_t, 3>> serial = convex_hull_triangles(points, 1);
+    const std::vector<std::array<std::size_t, 3>> parallel = convex_hull_triangles(points, 4);
+    REQUIRE( sorted(parallel) == sorted(serial) );
+
+}
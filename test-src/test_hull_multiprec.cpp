@@ -0,0 +1,99 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <array>
+#include <random>
+
+#include "mpreal.h"
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "predicates.hpp"
+#include "hull.hpp"
+
+TEST_CASE("Test convex_hull_triangles() function for 'multiprecision' type.", "ConvexHull") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+    using Vec3M = Vector3D<mpreal>;
+
+    const int digits = 60;
+    mpreal::set_default_prec(mpfr::digits2bits(digits));
+    Vec3M::set_eps(mpreal("1E-70"));
+
+    // A cube with a point 1E-30 above the centre of its top face: a hull vertex that rounding to double precision
+    // puts on the face.
+    Vector3DSoA<mpreal> points;
+    for (std::size_t c = 0; c < 8; ++c) points.push_back(Vec3M(mpreal(c & 1), mpreal(c >> 1 & 1), mpreal(c >> 2 & 1)));
+    points.push_back(Vec3M(mpreal("0.5"), mpreal("0.5"), mpreal(1) + mpreal("1E-30")));
+
+    const std::vector<std::array<std::size_t, 3>> triangles = convex_hull_triangles(points, 1);
+    REQUIRE( triangles.size() == 14 );
+    for (const auto &t: triangles) {
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            REQUIRE( orient3d(points[t[0]], points[t[1]], points[t[2]], points[p]) <= 0 );
+        }
+    }
+
+    Vector3DSoA<double> rounded;
+    for (std::size_t p = 0; p < points.size(); ++p) {
+        rounded.push_back(Vector3D<double>(points.x()[p].toDouble(), points.y()[p].toDouble(),
+                                           points.z()[p].toDouble()));
+    }
+    REQUIRE( convex_hull_triangles(rounded, 1).size() == 12 );
+
+}
+
+TEST_CASE("Test convex_hull_triangles() function against 'multiprecision' reference.", "ConvexHull") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+
+    mpreal::set_default_prec(512);
+
+    // Nearly coplanar points: a grid on a plane through skewed coordinates, jittered by a few units in the last
+    // place, where floating point orientation tests would disagree with each other.
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> ulps(-3, 3);
+    Vector3DSoA<double> points;
+    for (std::size_t i = 0; i < 20; ++i) {
+        for (std::size_t j = 0; j < 20; ++j) {
+            const double x = 0.1 + 0.37 * double(i), y = 0.3 + 0.21 * double(j);
+            double z = 0.7 * x + 0.3 * y + 0.11;
+            for (int u = ulps(generator); u != 0; u += (u > 0 ? -1 : 1)) {
+                z = std::nextafter(z, u > 0 ? 10.0 : -10.0);
+            }
+            points.push_back(Vector3D<double>(x, y, z));
+        }
+    }
+    points.push_back(Vector3D<double>(3.0, 2.0, -5.0));
+
+    Vector3DSoA<mpreal> exact;
+    for (std::size_t p = 0; p < points.size(); ++p) {
+        exact.push_back(Vector3D<mpreal>(mpreal(points.x()[p]), mpreal(points.y()[p]), mpreal(points.z()[p])));
+    }
+
+    const std::vector<std::array<std::size_t, 3>> reference = convex_hull_triangles(exact, 1);
+    const std::vector<std::array<std::size_t, 3>> triangles = convex_hull_triangles(points, 1);
+    REQUIRE( !reference.empty() );
+
+    // The hulls may triangulate coplanar faces differently, so compare what they enclose: every point on or behind
+    // every face of both.
+    for (const auto &t: triangles) {
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            REQUIRE( orient3d(exact[t[0]], exact[t[1]], exact[t[2]], exact[p]) <= 0 );
+        }
+    }
+    for (const auto &t: reference) {
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            REQUIRE( orient3d(points[t[0]], points[t[1]], points[t[2]], points[p]) <= 0 );
+        }
+    }
+
+}
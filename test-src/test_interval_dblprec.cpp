@@ -0,0 +1,208 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "interval.hpp"
+
+TEST_CASE("Test interval arithmetic encloses exact results for 'double' type.", "Interval") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Ival = Interval<double>;
+
+    Ival a(0.1);
+    Ival b(0.2);
+    Ival c(0.3);
+
+    Ival sum = a + b;
+    Ival diff = sum - c;
+    Ival prod = a * b;
+    Ival quot = Ival(1.0) / Ival(3.0);
+
+    // 0.1 + 0.2 in binary is not 0.3, the interval must nevertheless contain the exact sum of the two doubles.
+    REQUIRE( sum.lower() < sum.upper() );
+    REQUIRE( sum.contains(0.1 + 0.2) );
+    REQUIRE( diff.contains_zero() );
+    REQUIRE( prod.contains(0.1 * 0.2) );
+    REQUIRE( quot.contains(1.0 / 3.0) );
+    REQUIRE( (-quot).contains(-1.0 / 3.0) );
+    REQUIRE( sqrt(Ival(2.0)).contains(std::sqrt(2.0)) );
+    REQUIRE( abs(Ival(-2.0, 1.0)).lower() == 0.0 );
+    REQUIRE( abs(Ival(-2.0, 1.0)).upper() == 2.0 );
+
+    Ival inf = Ival(1.0) / Ival(-1.0, 1.0);
+    REQUIRE( std::isinf(inf.lower()) );
+    REQUIRE( std::isinf(inf.upper()) );
+
+}
+
+TEST_CASE("Test edge_length() function for 'interval' type.", "Interval geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using std::string;
+    using Ival = Interval<double>;
+    using Vec3I = Vector3D<Ival>;
+
+    Vec3I::set_eps(1E-7);
+    Vec3I u(1.0, 2.0, 3.0);
+    Vec3I v(4.0, 5.0, 6.0);
+
+    double expected = sqrt(27.0 + 1E-14);
+    Ival actual = edge_length(u, v);
+
+#ifdef DEBUG_MESSAGES
+    std::cout.precision(50);
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|                          edge length (interval)                           |" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| variable        | value                                                   |" << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+    std::cout << "| expected        | " << expected                    << string( 1, ' ') << "|" << std::endl;
+    std::cout << "| actual          | " << actual                      << string( 1, ' ') << "|" << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    REQUIRE( actual.contains(expected) );
+    REQUIRE( actual.width() < 1E-13 );
+
+}
+
+TEST_CASE("Test triangle_normal() & triangle_area() functions for 'interval' type.", "Interval geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Ival = Interval<double>;
+    using Vec3I = Vector3D<Ival>;
+
+    Vec3I::set_eps(1E-7);
+    Vec3I r1(1.0, 0.0, 0.0);
+    Vec3I r2(0.0, 1.0, 0.0);
+    Vec3I r3(0.0, 0.0, 1.0);
+
+    Vec3I normal = triangle_normal(r1, r2, r3);
+    Ival area = triangle_area(r1, r2, r3);
+
+    REQUIRE( normal.x().contains(1.0 / sqrt(3.0 + 1E-14)) );
+    REQUIRE( normal.y().contains(1.0 / sqrt(3.0 + 1E-14)) );
+    REQUIRE( normal.z().contains(1.0 / sqrt(3.0 + 1E-14)) );
+    REQUIRE( area.contains(sqrt(3.0 + 1E-14) / 2.0) );
+    REQUIRE( area.width() < 1E-13 );
+
+}
+
+TEST_CASE("Test tetrahedron_volume() function for 'interval' type.", "Interval geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Ival = Interval<double>;
+    using Vec3I = Vector3D<Ival>;
+
+    Vec3I r1(1.0, 0.0, 0.0);
+    Vec3I r2(0.0, 1.0, 0.0);
+    Vec3I r3(0.0, 0.0, 1.0);
+    Vec3I r4(1.0, 1.0, 1.0);
+
+    Ival actual = tetrahedron_volume(r1, r2, r3, r4);
+    Vec3I center = tetrahedron_center(r1, r2, r3, r4);
+
+    REQUIRE( actual.contains(1.0 / 3.0) );
+    REQUIRE( actual.width() < 1E-13 );
+    REQUIRE( center.x().contains(0.5) );
+
+    // A flat tetrahedron has zero volume, the enclosure must admit this.
+    Vec3I r5(0.5, 0.5, 0.0);
+    Ival flat = tetrahedron_volume(r1, r2, r5, Vec3I(0.25, 0.75, 0.0));
+    REQUIRE( flat.contains_zero() );
+
+}
+
+TEST_CASE("Test batch tetrahedron_volume_enclosures() function for 'double' type.", "Interval geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+    using Ival = Interval<double>;
+    using Vec3I = Vector3D<Ival>;
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+
+    const std::size_t n = 1000;
+    Vector3DSoA<double> r1, r2, r3, r4;
+    for (std::size_t i = 0; i < n; ++i) {
+        r1.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r2.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r3.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r4.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+    }
+
+    // Append a degenerate (coplanar) element.
+    r1.push_back(Vec3D(0.1, 0.1, 0.3));
+    r2.push_back(Vec3D(0.7, 0.2, 0.3));
+    r3.push_back(Vec3D(0.3, 0.9, 0.3));
+    r4.push_back(Vec3D(0.4, 0.4, 0.3));
+
+    std::vector<double> lower(r1.size()), upper(r1.size());
+    tetrahedron_volume_enclosures(r1, r2, r3, r4, lower.data(), upper.data());
+
+    for (std::size_t i = 0; i < n; ++i) {
+
+        auto to_ival = [](const Vec3D &v) { return Vec3I(v.x(), v.y(), v.z()); };
+        Ival scalar = tetrahedron_volume(to_ival(r1[i]), to_ival(r2[i]), to_ival(r3[i]), to_ival(r4[i]));
+        double approx = tetrahedron_volume(r1[i], r2[i], r3[i], r4[i]);
+
+        REQUIRE( lower[i] <= upper[i] );
+        REQUIRE( lower[i] <= scalar.upper() );
+        REQUIRE( scalar.lower() <= upper[i] );
+        REQUIRE( std::fabs(approx - 0.5 * (lower[i] + upper[i])) <= (upper[i] - lower[i]) + 1E-12 );
+
+    }
+
+    REQUIRE( lower[n] <= 0.0 );
+    REQUIRE( 0.0 <= upper[n] );
+
+}
+
+TEST_CASE("Test batch triangle_area_enclosures() function for 'double' type.", "Interval geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    Vec3D::set_eps(1E-7);
+
+    std::mt19937 gen(4321);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+
+    const std::size_t n = 1000;
+    Vector3DSoA<double> r1, r2, r3;
+    for (std::size_t i = 0; i < n; ++i) {
+        r1.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r2.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r3.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+    }
+
+    std::vector<double> lower(n), upper(n);
+    triangle_area_enclosures(r1, r2, r3, lower.data(), upper.data());
+
+    for (std::size_t i = 0; i < n; ++i) {
+
+        double approx = triangle_area(r1[i], r2[i], r3[i]);
+
+        REQUIRE( lower[i] <= approx );
+        REQUIRE( approx <= upper[i] );
+        REQUIRE( (upper[i] - lower[i]) <= 1E-12 * approx );
+
+    }
+
+}
@@ -0,0 +1,110 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "mpreal.h"
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "interval.hpp"
+
+/**
+ * Copy a value to 400 bits, far beyond the working precision of the intervals, so that sums and products of the
+ * copies are exact and quotients and roots are accurate well below the width of the intervals.
+ */
+mpfr::mpreal reference(const mpfr::mpreal &x) {
+
+    mpfr::mpreal y(x);
+    y.setPrecision(400);
+    return y;
+
+}
+
+TEST_CASE("Test interval arithmetic encloses exact results for 'multiprecision' type.", "Interval") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+    using Ival = Interval<mpreal>;
+
+    mpreal::set_default_prec(100);
+
+    const mpreal x = mpreal(1) / 3, y = mpreal(1) / 7, z = mpreal(10) / 21;
+    const Ival a(x), b(y), c(z);
+
+    const Ival sum = a + b;
+    const Ival diff = sum - c;
+    const Ival prod = a * b;
+    const Ival quot = a / b;
+    const Ival root = sqrt(a);
+
+    // The end points are rounded to 100 bits, the enclosed values are those of the exactly represented inputs.
+    REQUIRE( sum.lower() < sum.upper() );
+    REQUIRE( sum.contains(reference(x) + reference(y)) );
+    REQUIRE( diff.contains(reference(x) + reference(y) - reference(z)) );
+    REQUIRE( prod.contains(reference(x) * reference(y)) );
+    REQUIRE( quot.contains(reference(x) / reference(y)) );
+    REQUIRE( (-quot).contains(-(reference(x) / reference(y))) );
+    REQUIRE( root.contains(sqrt(reference(x))) );
+    REQUIRE( abs(Ival(mpreal(-2), mpreal(1))).lower() == 0 );
+    REQUIRE( abs(Ival(mpreal(-2), mpreal(1))).upper() == 2 );
+
+    // Each operation widens by one unit in the last place of 100 bits.
+    for (const Ival *i: {&sum, &prod, &quot, &root}) {
+        REQUIRE( i->width() > 0 );
+        REQUIRE( i->width() < mpreal("1E-29") );
+    }
+
+    const Ival inf = Ival(mpreal(1)) / Ival(mpreal(-1), mpreal(1));
+    REQUIRE( isinf(inf.lower()) );
+    REQUIRE( isinf(inf.upper()) );
+
+}
+
+TEST_CASE("Test geometry functions for 'multiprecision interval' type.", "Interval geometry") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+    using Ival = Interval<mpreal>;
+    using Vec3I = Vector3D<Ival>;
+
+    mpreal::set_default_prec(100);
+    Vec3I::set_eps(Ival(mpreal("1E-20")));
+
+    const mpreal third = mpreal(1) / 3;
+    const Vec3I r1(Ival(third), Ival(0), Ival(0));
+    const Vec3I r2(Ival(0), Ival(1), Ival(0));
+    const Vec3I r3(Ival(0), Ival(0), Ival(1));
+    const Vec3I r4(Ival(1), Ival(1), Ival(1));
+
+    // The volume is a polynomial in the (exactly represented) coordinates: (1 + third) / 6 up to sign.
+    const Ival volume = tetrahedron_volume(r1, r2, r3, r4);
+    const mpreal exact_volume = (reference(third) + 1) / 6;
+    REQUIRE( (volume.contains(exact_volume) || volume.contains(-exact_volume)) );
+    REQUIRE( volume.width() < mpreal("1E-28") );
+
+    // The regularised length: sqrt(third^2 + 1 + eps^2).
+    const Ival length = edge_length(r1, r2);
+    const mpreal eps = reference(Vec3I::eps().lower());
+    const mpreal exact_length = sqrt(reference(third) * reference(third) + 1 + eps * eps);
+    REQUIRE( length.contains(exact_length) );
+    REQUIRE( length.width() < mpreal("1E-28") );
+
+    const Ival area = triangle_area(r2, r3, r4);
+    REQUIRE( area.lower() > 0 );
+    REQUIRE( area.width() < mpreal("1E-28") );
+
+#ifdef DEBUG_MESSAGES
+    std::cout.precision(40);
+    std::cout << "| volume          | " << volume                                             << std::endl;
+    std::cout << "| length          | " << length                                             << std::endl;
+#endif // DEBUG_MESSAGES
+
+}
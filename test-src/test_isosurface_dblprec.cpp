@@ -0,0 +1,140 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "predicates.hpp"
+#include "median_dual.hpp"
+#include "isosurface.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+using org::lesleisnagy::geomlib::TriangleMesh;
+
+/**
+ * Return the distance of each vertex of a mesh from the centre of the unit cube.
+ */
+std::vector<double> radii(const TetrahedralMesh<double> &mesh) {
+
+    std::vector<double> values(mesh.n_vertices());
+    for (std::size_t v = 0; v < mesh.n_vertices(); ++v) {
+        values[v] = sqrt(norm_squared(mesh.vertices[v] - Vector3D<double>(0.5, 0.5, 0.5)));
+    }
+    return values;
+
+}
+
+TEST_CASE("Test extract_isosurface() function on a sphere for 'double' type.", "Isosurface") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = kuhn_cube(12);
+    const std::vector<double> values = radii(mesh);
+    const double radius = 0.35;
+
+    const MedianDualTopology topology(mesh.tetrahedra, mesh.n_vertices());
+    const TriangleMesh<double> surface = extract_isosurface(mesh, topology, values, radius);
+
+    // A closed surface facing outwards, towards larger distances, with one vertex per crossed edge.
+    REQUIRE( surface.n_triangles() > 0 );
+    REQUIRE( check_wound(surface) == 0 );
+    const double volume = enclosed_volume(surface);
+    REQUIRE( volume > 0.95 * 4.0 * M_PI * radius * radius * radius / 3.0 );
+    REQUIRE( volume < 4.0 * M_PI * radius * radius * radius / 3.0 );
+    std::size_t n_crossed = 0;
+    for (const auto &e: topology.edges()) n_crossed += (values[e[0]] > radius) != (values[e[1]] > radius);
+    REQUIRE( surface.n_vertices() == n_crossed );
+    std::vector<std::array<double, 3>> positions;
+    for (std::size_t v = 0; v < surface.n_vertices(); ++v) {
+        const Vector3D<double> r = surface.vertices[v];
+        REQUIRE( fabs(sqrt(norm_squared(r - Vector3D<double>(0.5, 0.5, 0.5))) - radius) < 0.01 );
+        positions.push_back({r.x(), r.y(), r.z()});
+    }
+    std::sort(positions.begin(), positions.end());
+    REQUIRE( std::adjacent_find(positions.begin(), positions.end()) == positions.end() );
+
+    // The winding follows the field, not the orientation of the elements.
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); e += 3) std::swap(mesh.tetrahedra[e][0], mesh.tetrahedra[e][1]);
+    const MedianDualTopology swapped_topology(mesh.tetrahedra, mesh.n_vertices());
+    const TriangleMesh<double> swapped = extract_isosurface(mesh, swapped_topology, values, radius);
+    REQUIRE( swapped.n_triangles() == surface.n_triangles() );
+    REQUIRE( check_wound(swapped) == 0 );
+    REQUIRE( fabs(enclosed_volume(swapped) - volume) < 1E-12 );
+
+}
+
+TEST_CASE("Test extract_isosurface() function on a plane for 'double' type.", "Isosurface") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    const TetrahedralMesh<double> mesh = kuhn_cube(6);
+    const Vector3D<double> gradient(1.0, 2.0, 3.0);
+    std::vector<double> values(mesh.n_vertices());
+    for (std::size_t v = 0; v < mesh.n_vertices(); ++v) values[v] = dot(gradient, mesh.vertices[v]);
+
+    // A linear field is interpolated exactly: an open plane, facing along the gradient.
+    const MedianDualTopology topology(mesh.tetrahedra, mesh.n_vertices());
+    const TriangleMesh<double> surface = extract_isosurface(mesh, topology, values, 2.9);
+    REQUIRE( check_wound(surface) > 0 );
+    for (std::size_t v = 0; v < surface.n_vertices(); ++v) {
+        REQUIRE( fabs(dot(gradient, surface.vertices[v]) - 2.9) < 1E-12 );
+    }
+    double area = 0.0;
+    for (const auto &t: surface.triangles) {
+        const Vector3D<double> n = cross(surface.vertices[t[1]] - surface.vertices[t[0]],
+                                         surface.vertices[t[2]] - surface.vertices[t[0]]);
+        REQUIRE( dot(n, gradient) > 0.0 );
+        area += 0.5 * sqrt(norm_squared(n));
+    }
+    REQUIRE( area > 0.0 );
+
+    // Isovalues outside the field give empty surfaces.
+    REQUIRE( extract_isosurface(mesh, topology, values, -1.0).n_triangles() == 0 );
+    REQUIRE( extract_isosurface(mesh, topology, values, 7.0).n_vertices() == 0 );
+
+}
+
+TEST_CASE("Test parallel extract_isosurfaces() function for 'double' type.", "Isosurface") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    const TetrahedralMesh<double> mesh = kuhn_cube(16);
+    const std::vector<double> values = radii(mesh);
+    const std::vector<double> isovalues = {0.1, 0.25, 0.4, 0.6};
+    const MedianDualTopology topology(mesh.tetrahedra, mesh.n_vertices());
+
+    // All isovalues at once equal one at a time, and the output does not depend on the threads.
+    const std::vector<TriangleMesh<double>> serial = extract_isosurfaces(mesh, topology, values, isovalues, 1);
+    const std::vector<TriangleMesh<double>> parallel = extract_isosurfaces(mesh, topology, values, isovalues, 4);
+    REQUIRE( serial.size() == isovalues.size() );
+    REQUIRE( parallel.size() == isovalues.size() );
+    for (std::size_t l = 0; l < isovalues.size(); ++l) {
+        const TriangleMesh<double> single = extract_isosurface(mesh, topology, values, isovalues[l], 1);
+        REQUIRE( serial[l].triangles == single.triangles );
+        REQUIRE( parallel[l].triangles == single.triangles );
+        REQUIRE( parallel[l].n_vertices() == single.n_vertices() );
+        for (std::size_t v = 0; v < single.n_vertices(); ++v) {
+            REQUIRE( serial[l].vertices.x()[v] == single.vertices.x()[v] );
+            REQUIRE( parallel[l].vertices.x()[v] == single.vertices.x()[v] );
+            REQUIRE( parallel[l].vertices.z()[v] == single.vertices.z()[v] );
+        }
+    }
+
+    // The surfaces inside the cube are closed, the one cut by its faces is open.
+    REQUIRE( check_wound(parallel[0]) == 0 );
+    REQUIRE( check_wound(parallel[2]) == 0 );
+    REQUIRE( check_wound(parallel[3]) > 0 );
+    REQUIRE( enclosed_volume(parallel[1]) < enclosed_volume(parallel[2]) );
+
+}
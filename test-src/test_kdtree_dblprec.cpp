@@ -0,0 +1,144 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "kdtree.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::Vector3DSoA;
+
+/**
+ * Create a point cloud of uniform points with a dense cluster, points on a lattice (many equal distances) and a few
+ * exact duplicates.
+ */
+Vector3DSoA<double> cloud(std::size_t n, unsigned int seed) {
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> uniform(-2.0, 3.0);
+    std::normal_distribution<double> cluster(0.5, 0.01);
+
+    Vector3DSoA<double> points;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i % 4 == 0) points.push_back(Vector3D<double>(cluster(gen), cluster(gen), cluster(gen)));
+        else if (i % 5 == 0) points.push_back(Vector3D<double>(double(i % 7), double(i % 11), double(i % 3)) / 4.0);
+        else if (i % 97 == 1) points.push_back(points[i - 1]);
+        else points.push_back(Vector3D<double>(uniform(gen), uniform(gen), 0.5 * uniform(gen)));
+    }
+    return points;
+
+}
+
+TEST_CASE("Test KdTree construction for 'double' type.", "KdTree") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    Vector3DSoA<double> points = cloud(20000, 11);
+    KdTree<double> tree(points, 10, 4);
+    KdTree<double> serial(points, 10, 1);
+
+    REQUIRE( tree.permutation() == serial.permutation() );
+    REQUIRE( tree.nodes().size() == serial.nodes().size() );
+
+    std::vector<std::size_t> sorted = tree.permutation();
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < sorted.size(); ++i) REQUIRE( sorted[i] == i );
+
+    // The sons split their father at the median and lie on either side of the split plane.
+    std::size_t leaves = 0;
+    for (const KdNode &node: tree.nodes()) {
+        if (node.is_leaf()) {
+            REQUIRE( node.size() <= 10 );
+            ++leaves;
+            continue;
+        }
+        const KdNode &left = tree.nodes()[node.children[0]];
+        const KdNode &right = tree.nodes()[node.children[1]];
+        REQUIRE( left.begin == node.begin );
+        REQUIRE( left.end == right.begin );
+        REQUIRE( right.end == node.end );
+        REQUIRE( left.size() == node.size() / 2 );
+        for (std::size_t p = node.begin; p < node.end; ++p) {
+            const Vector3D<double> r = points[tree.permutation()[p]];
+            const double c = node.axis == 0 ? r.x() : (node.axis == 1 ? r.y() : r.z());
+            if (p < left.end) REQUIRE( c <= node.split );
+            else REQUIRE( c >= node.split );
+        }
+    }
+    REQUIRE( leaves > points.size() / 10 );
+
+}
+
+TEST_CASE("Test KdTree nearest() and within_radius() functions for 'double' type.", "KdTree") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    Vector3DSoA<double> points = cloud(5000, 3);
+    KdTree<double> tree(points, 8, 2);
+    Vector3DSoA<double> queries = cloud(300, 5);
+
+    auto distance2 = [&](const Vector3D<double> &q, std::size_t i) {
+        const Vector3D<double> d = points[i] - q;
+        return d.x() * d.x() + d.y() * d.y() + d.z() * d.z();
+    };
+
+    const std::size_t k = 9;
+    std::vector<std::size_t> indices(queries.size() * k);
+    std::vector<double> distances(queries.size() * k);
+    tree.nearest(queries, k, indices.data(), distances.data(), 3);
+
+    const double radius = 0.3;
+    std::vector<std::size_t> offsets(queries.size() + 1, 0);
+    tree.count_within_radius(queries, radius, offsets.data() + 1, 3);
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::size_t> in_radius(offsets.back());
+    tree.within_radius(queries, radius, offsets.data(), in_radius.data(), 3);
+
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+
+        const Vector3D<double> query = queries[q];
+
+        // Brute force k nearest, ties by index.
+        std::vector<std::size_t> order(points.size());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](std::size_t a, std::size_t b) {
+            return std::make_pair(distance2(query, a), a) < std::make_pair(distance2(query, b), b);
+        });
+        order.resize(k);
+        REQUIRE( tree.nearest(query, k) == order );
+        for (std::size_t i = 0; i < k; ++i) {
+            REQUIRE( indices[q * k + i] == order[i] );
+            REQUIRE( distances[q * k + i] == sqrt(distance2(query, order[i])) );
+        }
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (distance2(query, i) <= radius * radius) expected.push_back(i);
+        }
+        REQUIRE( tree.within_radius(query, radius) == expected );
+        const std::vector<std::size_t> batch(in_radius.begin() + static_cast<std::ptrdiff_t>(offsets[q]),
+                                             in_radius.begin() + static_cast<std::ptrdiff_t>(offsets[q + 1]));
+        REQUIRE( batch == expected );
+
+    }
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| nodes           | " << tree.nodes().size()                                << std::endl;
+    std::cout << "| radius hits     | " << in_radius.size()                                   << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    // Buffers sized for a smaller radius are reported rather than overrun.
+    REQUIRE_THROWS_AS( tree.within_radius(queries, 10.0, offsets.data(), in_radius.data(), 1), std::length_error );
+
+}
@@ -0,0 +1,82 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+#include "mpreal.h"
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "kdtree.hpp"
+
+TEST_CASE("Test KdTree nearest() and within_radius() functions for 'multiprecision' type.", "KdTree") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+    using Vec3M = Vector3D<mpreal>;
+
+    const int digits = 50;
+    mpreal::set_default_prec(mpfr::digits2bits(digits));
+    Vec3M::set_eps(mpreal("1E-60"));
+
+    // Clusters of points whose separations (1E-30) vanish when rounded to double precision.
+    const mpreal h("1E-30");
+    Vector3DSoA<mpreal> points;
+    for (std::size_t c = 0; c < 40; ++c) {
+        const Vec3M centre(mpreal(c % 5) / 3, mpreal(c % 7) / 5, mpreal(c % 3) / 2);
+        for (std::size_t i = 0; i < 12; ++i) {
+            points.push_back(centre + Vec3M(h * mpreal(i % 4), h * mpreal((7 * i) % 5), h * mpreal(i % 3)));
+        }
+    }
+    KdTree<mpreal> tree(points, 4, 2);
+
+    Vector3DSoA<mpreal> queries;
+    for (std::size_t c = 0; c < 40; c += 3) {
+        const Vec3M centre(mpreal(c % 5) / 3, mpreal(c % 7) / 5, mpreal(c % 3) / 2);
+        queries.push_back(centre + Vec3M(h * mpreal("1.3"), h * mpreal("2.2"), h * mpreal("0.9")));
+    }
+
+    auto distance2 = [&](const Vec3M &q, std::size_t i) {
+        const Vec3M d = points[i] - q;
+        return d.x() * d.x() + d.y() * d.y() + d.z() * d.z();
+    };
+
+    const std::size_t k = 5;
+    std::vector<std::size_t> indices(queries.size() * k);
+    std::vector<mpreal> distances(queries.size() * k);
+    tree.nearest(queries, k, indices.data(), distances.data(), 2);
+
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+
+        const Vec3M query = queries[q];
+
+        std::vector<std::size_t> order(points.size());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return std::make_pair(distance2(query, a), a) < std::make_pair(distance2(query, b), b);
+        });
+
+        for (std::size_t i = 0; i < k; ++i) {
+            REQUIRE( indices[q * k + i] == order[i] );
+            REQUIRE( fabs(distances[q * k + i] - sqrt(distance2(query, order[i]))) < mpreal("1E-45") );
+        }
+        REQUIRE( tree.nearest(query, k) == std::vector<std::size_t>(order.begin(), order.begin() + k) );
+
+        // A radius between the 6th and 7th nearest distances.
+        const mpreal radius = (sqrt(distance2(query, order[5])) + sqrt(distance2(query, order[6]))) / 2;
+        std::vector<std::size_t> expected(order.begin(), order.begin() + 6);
+        std::sort(expected.begin(), expected.end());
+        if (distance2(query, order[5]) < distance2(query, order[6])) {
+            REQUIRE( tree.within_radius(query, radius) == expected );
+        }
+
+    }
+
+}
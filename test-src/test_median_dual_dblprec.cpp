@@ -0,0 +1,121 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "median_dual.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+
+/**
+ * The largest violation of the closure of the dual cells: the face vectors pointing away from a vertex and its
+ * boundary area vector sum to zero.
+ */
+double closure_error(const org::lesleisnagy::geomlib::MedianDualTopology &topology,
+                     const org::lesleisnagy::geomlib::MedianDualGeometry<double> &geometry) {
+
+    using Vec3D = Vector3D<double>;
+
+    std::vector<Vec3D> sums(topology.n_vertices());
+    for (std::size_t i = 0; i < topology.n_vertices(); ++i) sums[i] = geometry.boundary_normals[i];
+    for (std::size_t k = 0; k < topology.n_edges(); ++k) {
+        sums[topology.edges()[k][0]] = sums[topology.edges()[k][0]] + geometry.face_vectors[k];
+        sums[topology.edges()[k][1]] = sums[topology.edges()[k][1]] - geometry.face_vectors[k];
+    }
+    double error = 0.0;
+    for (const Vec3D &s: sums) error = std::max(error, sqrt(dot(s, s)));
+    return error;
+
+}
+
+TEST_CASE("Test median_dual_geometry() function for 'double' type.", "MedianDual") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    // Every other element has its orientation reversed.
+    TetrahedralMesh<double> mesh = unit_cube(6);
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); e += 2) std::swap(mesh.tetrahedra[e][0], mesh.tetrahedra[e][1]);
+
+    MedianDualTopology topology(mesh.tetrahedra, mesh.n_vertices(), 1);
+
+    // Euler characteristic of the ball: V - E + F - T = 1, with 2 F = 4 T + F_boundary.
+    const std::size_t n_faces = (4 * mesh.n_tetrahedra() + topology.boundary_faces().size()) / 2;
+    REQUIRE( mesh.n_vertices() + n_faces == topology.n_edges() + mesh.n_tetrahedra() + 1 );
+    REQUIRE( topology.boundary_faces().size() == 6 * 2 * 6 * 6 );
+
+    MedianDualGeometry<double> geometry = median_dual_geometry(mesh, topology, 1);
+
+    double volume = 0.0, area = 0.0;
+    Vec3D normal;
+    for (std::size_t i = 0; i < mesh.n_vertices(); ++i) {
+        volume += geometry.vertex_volumes[i];
+        area += geometry.boundary_areas[i];
+        normal = normal + geometry.boundary_normals[i];
+    }
+    REQUIRE( fabs(volume - 1.0) < 1E-13 );
+    // triangle_area() is regularised by Vector3D::eps().
+    REQUIRE( fabs(area - 6.0) < 1E-10 );
+    REQUIRE( sqrt(dot(normal, normal)) < 1E-13 );
+    REQUIRE( closure_error(topology, geometry) < 1E-14 );
+
+    // Every element contributes sum_k s_k . (r_b - r_a) = 3 |V|.
+    double flux = 0.0;
+    for (std::size_t k = 0; k < topology.n_edges(); ++k) {
+        const auto &edge = topology.edges()[k];
+        flux += dot(geometry.face_vectors[k], mesh.vertices[edge[1]] - mesh.vertices[edge[0]]);
+    }
+    REQUIRE( fabs(flux - 3.0) < 1E-12 );
+
+    // The corner vertex at the origin lies on the diagonals of all three of its boundary cell faces, so it touches six
+    // boundary triangles and owns a third of each: h^2 in total.
+    const double h = 1.0 / 6.0;
+    REQUIRE( fabs(geometry.boundary_areas[0] - h * h) < 1E-12 );
+
+    // Move the vertices and recompute with the same topology, threaded.
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-0.03, 0.03);
+    for (std::size_t i = 0; i < mesh.n_vertices(); ++i) {
+        mesh.vertices.set(i, mesh.vertices[i] + Vec3D(dist(gen), dist(gen), dist(gen)));
+    }
+    MedianDualTopology threaded_topology(mesh.tetrahedra, mesh.n_vertices(), 3);
+    median_dual_geometry(mesh, topology, geometry, 1);
+    MedianDualGeometry<double> threaded = median_dual_geometry(mesh, threaded_topology, 3);
+
+    double moved_volume = 0.0;
+    for (const auto &t: mesh.tetrahedra) {
+        moved_volume += fabs(tetrahedron_volume(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                                mesh.vertices[t[2]], mesh.vertices[t[3]]));
+    }
+    volume = 0.0;
+    for (std::size_t i = 0; i < mesh.n_vertices(); ++i) {
+        volume += geometry.vertex_volumes[i];
+        REQUIRE( fabs(geometry.vertex_volumes[i] - threaded.vertex_volumes[i]) < 1E-15 );
+        REQUIRE( fabs(geometry.boundary_areas[i] - threaded.boundary_areas[i]) < 1E-15 );
+    }
+    REQUIRE( fabs(volume - moved_volume) < 1E-13 );
+    REQUIRE( closure_error(topology, geometry) < 1E-14 );
+    REQUIRE( closure_error(threaded_topology, threaded) < 1E-14 );
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| vertices        | " << mesh.n_vertices()                                  << std::endl;
+    std::cout << "| edges           | " << topology.n_edges()                                 << std::endl;
+    std::cout << "| boundary faces  | " << topology.boundary_faces().size()                   << std::endl;
+    std::cout << "| closure error   | " << closure_error(topology, geometry)                  << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+}
@@ -0,0 +1,60 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "mpreal.h"
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "median_dual.hpp"
+
+#include "test_meshes.hpp"
+
+TEST_CASE("Test median_dual_geometry() function for 'multiprecision' type.", "MedianDual") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+    using Vec3M = Vector3D<mpreal>;
+
+    const int digits = 50;
+    mpreal::set_default_prec(mpfr::digits2bits(digits));
+    Vec3M::set_eps(mpreal("1E-60"));
+
+    // The cube [0, 1]^3 split into 2 x 2 x 2 Kuhn cells, with the central vertex perturbed.
+    TetrahedralMesh<mpreal> mesh = unit_cube<mpreal>(2);
+    mesh.vertices.set(13, Vec3M(mpreal("0.53"), mpreal("0.47"), mpreal("0.51")));
+
+    MedianDualTopology topology(mesh.tetrahedra, mesh.n_vertices(), 2);
+
+    MedianDualGeometry<mpreal> exact = median_dual_geometry(mesh, topology, 2);
+    MedianDualGeometry<double> rounded = median_dual_geometry<mpreal, double>(mesh, topology, 2);
+
+    // Volume and closure of the dual cells hold to the working precision.
+    mpreal volume = 0;
+    std::vector<Vec3M> sums(mesh.n_vertices());
+    for (std::size_t i = 0; i < mesh.n_vertices(); ++i) {
+        volume += exact.vertex_volumes[i];
+        sums[i] = exact.boundary_normals[i];
+        REQUIRE( fabs(rounded.vertex_volumes[i] - exact.vertex_volumes[i].toDouble()) < 1E-16 );
+    }
+    for (std::size_t k = 0; k < topology.n_edges(); ++k) {
+        sums[topology.edges()[k][0]] = sums[topology.edges()[k][0]] + exact.face_vectors[k];
+        sums[topology.edges()[k][1]] = sums[topology.edges()[k][1]] - exact.face_vectors[k];
+    }
+
+#ifdef DEBUG_MESSAGES
+    std::cout.precision(digits);
+    std::cout << "| volume          | " << volume                                             << std::endl;
+#endif // DEBUG_MESSAGES
+
+    REQUIRE( abs(volume - 1) < mpreal("1E-45") );
+    for (const Vec3M &s: sums) REQUIRE( sqrt(dot(s, s)) < mpreal("1E-45") );
+
+}
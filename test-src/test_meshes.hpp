@@ -0,0 +1,123 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <utility>
+
+#include <catch/catch.hpp>
+
+#include "vector3d.hpp"
+#include "mesh.hpp"
+#include "predicates.hpp"
+
+/**
+ * Create the box [0, nx h] x [0, ny h] x [0, nz h] split into cells of width h of six tetrahedra each (a conforming
+ * Kuhn triangulation); the vertices are numbered x fastest and the six elements of a cell follow the six paths from
+ * its lowest to its highest corner.
+ */
+template<typename Real = double>
+org::lesleisnagy::geomlib::TetrahedralMesh<Real> box(std::size_t nx, std::size_t ny, std::size_t nz,
+                                                     const Real &h = Real(1)) {
+
+    using org::lesleisnagy::geomlib::Vector3D;
+
+    org::lesleisnagy::geomlib::TetrahedralMesh<Real> mesh;
+    for (std::size_t k = 0; k <= nz; ++k) {
+        for (std::size_t j = 0; j <= ny; ++j) {
+            for (std::size_t i = 0; i <= nx; ++i) {
+                mesh.vertices.push_back(Vector3D<Real>(Real(double(i)) * h, Real(double(j)) * h,
+                                                       Real(double(k)) * h));
+            }
+        }
+    }
+
+    const std::array<std::array<std::size_t, 4>, 6> kuhn = {{{0, 1, 3, 7}, {0, 1, 5, 7}, {0, 2, 3, 7},
+                                                            {0, 2, 6, 7}, {0, 4, 5, 7}, {0, 4, 6, 7}}};
+    auto index = [nx, ny](std::size_t i, std::size_t j, std::size_t k) { return i + (nx + 1) * (j + (ny + 1) * k); };
+    for (std::size_t k = 0; k < nz; ++k) {
+        for (std::size_t j = 0; j < ny; ++j) {
+            for (std::size_t i = 0; i < nx; ++i) {
+                std::size_t corners[8];
+                for (std::size_t c = 0; c < 8; ++c) corners[c] = index(i + (c & 1), j + ((c >> 1) & 1), k + (c >> 2));
+                for (const auto &t: kuhn) {
+                    mesh.tetrahedra.push_back({corners[t[0]], corners[t[1]], corners[t[2]], corners[t[3]]});
+                }
+            }
+        }
+    }
+    return mesh;
+
+}
+
+/**
+ * Create the unit cube split into n x n x n cells of six tetrahedra each, as box().
+ */
+template<typename Real = double>
+org::lesleisnagy::geomlib::TetrahedralMesh<Real> unit_cube(std::size_t n) {
+
+    return box<Real>(n, n, n, Real(1) / Real(double(n)));
+
+}
+
+/**
+ * Create the unit cube split into n x n x n cells of six tetrahedra each, as unit_cube(), with every element
+ * positively oriented by orient3d().
+ */
+template<typename Real = double>
+org::lesleisnagy::geomlib::TetrahedralMesh<Real> kuhn_cube(std::size_t n) {
+
+    using org::lesleisnagy::geomlib::orient3d;
+
+    org::lesleisnagy::geomlib::TetrahedralMesh<Real> mesh = unit_cube<Real>(n);
+    for (auto &t: mesh.tetrahedra) {
+        if (orient3d(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]], mesh.vertices[t[3]]) < 0) {
+            std::swap(t[0], t[1]);
+        }
+    }
+    return mesh;
+
+}
+
+/**
+ * Count the directed edges of a surface and check that each appears once, i.e. that the surface is manifold and
+ * consistently wound; return the number of boundary edges (whose reverse is missing).
+ */
+inline std::size_t check_wound(const org::lesleisnagy::geomlib::TriangleMesh<double> &mesh) {
+
+    std::map<std::pair<std::size_t, std::size_t>, int> edges;
+    for (const auto &t: mesh.triangles) {
+        REQUIRE( t[0] != t[1] );
+        REQUIRE( t[1] != t[2] );
+        REQUIRE( t[2] != t[0] );
+        for (std::size_t k = 0; k < 3; ++k) ++edges[{t[k], t[(k + 1) % 3]}];
+    }
+    std::size_t n_boundary = 0;
+    for (const auto &[e, count]: edges) {
+        REQUIRE( count == 1 );
+        if (edges.count({e.second, e.first}) == 0) ++n_boundary;
+    }
+    return n_boundary;
+
+}
+
+/**
+ * Return the volume enclosed by a closed outward wound surface.
+ */
+inline double enclosed_volume(const org::lesleisnagy::geomlib::TriangleMesh<double> &mesh) {
+
+    using org::lesleisnagy::geomlib::cross;
+    using org::lesleisnagy::geomlib::dot;
+
+    double volume = 0.0;
+    for (const auto &t: mesh.triangles) {
+        volume += dot(mesh.vertices[t[0]], cross(mesh.vertices[t[1]], mesh.vertices[t[2]])) / 6.0;
+    }
+    return volume;
+
+}
@@ -0,0 +1,197 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "octree.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::Vector3DSoA;
+
+/**
+ * Create a point cloud of uniform points with a dense cluster and a few exact duplicates.
+ */
+Vector3DSoA<double> cloud(std::size_t n, unsigned int seed) {
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> uniform(-2.0, 3.0);
+    std::normal_distribution<double> cluster(0.5, 0.01);
+
+    Vector3DSoA<double> points;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i % 4 == 0) points.push_back(Vector3D<double>(cluster(gen), cluster(gen), cluster(gen)));
+        else if (i % 97 == 1) points.push_back(points[i - 1]);
+        else points.push_back(Vector3D<double>(uniform(gen), uniform(gen), 0.5 * uniform(gen)));
+    }
+    return points;
+
+}
+
+TEST_CASE("Test morton_encode() and radix_sort() functions for 'double' type.", "Octree") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<std::uint32_t> cell(0, (1u << morton_bits) - 1);
+    for (std::size_t n = 0; n < 1000; ++n) {
+        const std::uint32_t i = cell(gen), j = cell(gen), k = cell(gen);
+        const std::uint64_t code = morton_encode(i, j, k);
+        REQUIRE( code < (std::uint64_t(1) << 63) );
+        REQUIRE( morton_decode(code) == std::array<std::uint32_t, 3>{i, j, k} );
+    }
+    REQUIRE( morton_encode(1, 0, 0) == 1 );
+    REQUIRE( morton_encode(0, 1, 0) == 2 );
+    REQUIRE( morton_encode(0, 0, 1) == 4 );
+    REQUIRE( morton_encode(2, 0, 0) == 8 );
+
+    // The sort is stable and agrees with std::stable_sort.
+    std::uniform_int_distribution<std::uint64_t> key(0, (std::uint64_t(1) << 40) - 1);
+    std::vector<std::uint64_t> keys(100000);
+    for (std::uint64_t &k: keys) k = key(gen) & ~std::uint64_t(0xff00);
+    for (std::size_t i = 0; i < keys.size(); i += 3) keys[i] = keys[i / 2];
+    std::vector<std::size_t> values(keys.size());
+    std::iota(values.begin(), values.end(), std::size_t(0));
+
+    std::vector<std::size_t> expected = values;
+    std::stable_sort(expected.begin(), expected.end(), [&](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+
+    for (std::size_t n_threads: {1, 4}) {
+        std::vector<std::uint64_t> sorted = keys;
+        std::vector<std::size_t> order = values;
+        radix_sort(sorted, order, 40, n_threads);
+        REQUIRE( order == expected );
+        REQUIRE( std::is_sorted(sorted.begin(), sorted.end()) );
+    }
+
+}
+
+TEST_CASE("Test LinearOctree construction for 'double' type.", "Octree") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    Vector3DSoA<double> points = cloud(20000, 11);
+    LinearOctree<double> octree(points, 16, 4);
+    LinearOctree<double> serial(points, 16, 1);
+
+    REQUIRE( octree.size() == points.size() );
+    REQUIRE( std::is_sorted(octree.codes().begin(), octree.codes().end()) );
+    REQUIRE( octree.codes() == serial.codes() );
+    REQUIRE( octree.permutation() == serial.permutation() );
+
+    std::vector<std::size_t> sorted = octree.permutation();
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < sorted.size(); ++i) REQUIRE( sorted[i] == i );
+
+    // Every node's cell holds its points and its children partition it.
+    REQUIRE( octree.nodes().size() == serial.nodes().size() );
+    const OctreeNode &root = octree.nodes()[0];
+    REQUIRE( (root.begin == 0 && root.end == points.size()) );
+    std::size_t leaves = 0;
+    for (std::size_t i = 0; i < octree.nodes().size(); ++i) {
+        const OctreeNode &node = octree.nodes()[i];
+        REQUIRE( octree.find(node.level, node.key) == i );
+        const Vector3D<double> lo = octree.lower_corner(node), hi = octree.upper_corner(node);
+        for (std::size_t p = node.begin; p < node.end; ++p) {
+            const Vector3D<double> r = points[octree.permutation()[p]];
+            REQUIRE( (lo.x() <= r.x() && r.x() <= hi.x() && lo.y() <= r.y() && r.y() <= hi.y() &&
+                      lo.z() <= r.z() && r.z() <= hi.z()) );
+        }
+        if (node.is_leaf()) {
+            REQUIRE( (node.size() <= 16 || node.level == morton_bits) );
+            ++leaves;
+            continue;
+        }
+        const OctreeNode &first = octree.nodes()[node.first_child];
+        const OctreeNode &last = octree.nodes()[node.first_child + node.n_children - 1];
+        REQUIRE( first.begin == node.begin );
+        REQUIRE( last.end == node.end );
+        for (std::size_t c = node.first_child; c < node.first_child + node.n_children; ++c) {
+            REQUIRE( octree.nodes()[c].size() > 0 );
+            REQUIRE( octree.nodes()[c].level == node.level + 1 );
+            REQUIRE( (octree.nodes()[c].key >> 3) == node.key );
+            if (c > node.first_child) REQUIRE( octree.nodes()[c].begin == octree.nodes()[c - 1].end );
+        }
+    }
+    REQUIRE( leaves > points.size() / 16 );
+
+}
+
+TEST_CASE("Test LinearOctree nearest(), within_radius() and within_box() functions for 'double' type.", "Octree") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    Vector3DSoA<double> points = cloud(5000, 3);
+    LinearOctree<double> octree(points, 8, 2);
+    Vector3DSoA<double> queries = cloud(200, 5);
+
+    auto distance2 = [&](const Vector3D<double> &q, std::size_t i) {
+        const Vector3D<double> d = points[i] - q;
+        return dot(d, d);
+    };
+
+    const std::size_t k = 7;
+    std::vector<std::size_t> indices(queries.size() * k);
+    std::vector<double> distances(queries.size() * k);
+    octree.nearest(queries, k, indices.data(), distances.data(), 3);
+
+    std::size_t total_radius = 0, total_box = 0;
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+
+        const Vector3D<double> query = queries[q];
+
+        // Brute force k nearest, ties by index.
+        std::vector<std::size_t> order(points.size());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](std::size_t a, std::size_t b) {
+            return std::make_pair(distance2(query, a), a) < std::make_pair(distance2(query, b), b);
+        });
+        order.resize(k);
+        REQUIRE( octree.nearest(query, k) == order );
+        for (std::size_t i = 0; i < k; ++i) {
+            REQUIRE( indices[q * k + i] == order[i] );
+            REQUIRE( fabs(distances[q * k + i] - sqrt(distance2(query, order[i]))) < 1E-15 );
+        }
+
+        const double radius = q % 2 == 0 ? 0.02 : 0.4;
+        std::vector<std::size_t> in_radius;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (distance2(query, i) <= radius * radius) in_radius.push_back(i);
+        }
+        REQUIRE( octree.within_radius(query, radius) == in_radius );
+        total_radius += in_radius.size();
+
+        const Vector3D<double> lower = query - Vector3D<double>(0.3, 0.1, 0.2);
+        const Vector3D<double> upper = query + Vector3D<double>(0.2, 0.4, 0.1);
+        std::vector<std::size_t> in_box;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const Vector3D<double> r = points[i];
+            if (lower.x() <= r.x() && r.x() <= upper.x() && lower.y() <= r.y() && r.y() <= upper.y() &&
+                lower.z() <= r.z() && r.z() <= upper.z()) {
+                in_box.push_back(i);
+            }
+        }
+        REQUIRE( octree.within_box(lower, upper) == in_box );
+        total_box += in_box.size();
+
+    }
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| radius hits     | " << total_radius                                       << std::endl;
+    std::cout << "| box hits        | " << total_box                                          << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    REQUIRE( total_radius > 0 );
+    REQUIRE( total_box > 0 );
+
+}
@@ -0,0 +1,133 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "partition.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+
+TEST_CASE("Test element_dual_graph() function for 'double' type.", "Partition") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = box(3, 4, 5);
+    CsrGraph graph = element_dual_graph(mesh.tetrahedra, 2);
+
+    // Every face is interior or on the boundary: 4 T = 2 (interior faces) + boundary faces.
+    const std::size_t boundary = 2 * 2 * (3 * 4 + 4 * 5 + 3 * 5);
+    REQUIRE( graph.adjacency.size() + boundary == 4 * mesh.n_tetrahedra() );
+
+    // The adjacency is symmetric.
+    for (std::size_t u = 0; u < graph.n_vertices(); ++u) {
+        for (std::size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; ++k) {
+            const std::size_t v = graph.adjacency[k];
+            auto first = graph.adjacency.begin() + static_cast<std::ptrdiff_t>(graph.offsets[v]);
+            auto last = graph.adjacency.begin() + static_cast<std::ptrdiff_t>(graph.offsets[v + 1]);
+            REQUIRE( std::find(first, last, u) != last );
+        }
+    }
+
+}
+
+TEST_CASE("Test partition_mesh() and coordinate_bisection() functions for 'double' type.", "Partition") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = box(16, 12, 10);
+    CsrGraph graph = element_dual_graph(mesh.tetrahedra);
+
+    for (std::size_t n_parts: {2, 5, 8}) {
+
+        PartitionOptions options;
+        std::vector<std::size_t> multilevel = partition_mesh(mesh, n_parts, options);
+        std::vector<std::size_t> geometric = coordinate_bisection(mesh, n_parts, 2);
+
+        for (const auto *parts: {&multilevel, &geometric}) {
+            std::vector<std::size_t> sizes(n_parts, 0);
+            for (std::size_t p: *parts) {
+                REQUIRE( p < n_parts );
+                ++sizes[p];
+            }
+            const double average = static_cast<double>(mesh.n_tetrahedra()) / static_cast<double>(n_parts);
+            for (std::size_t size: sizes) REQUIRE( static_cast<double>(size) <= options.imbalance * average + 1.0 );
+        }
+
+        const std::size_t multilevel_cut = edge_cut(graph, multilevel);
+        const std::size_t geometric_cut = edge_cut(graph, geometric);
+
+#ifdef DEBUG_MESSAGES
+        std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+        std::cout << "| parts           | " << n_parts                                            << std::endl;
+        std::cout << "| multilevel cut  | " << multilevel_cut                                     << std::endl;
+        std::cout << "| bisection cut   | " << geometric_cut                                      << std::endl;
+        std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+        // On a box, coordinate bisection is near optimal; the graph partitioner must be competitive.
+        REQUIRE( static_cast<double>(multilevel_cut) < 1.3 * static_cast<double>(geometric_cut) );
+
+        // The partitions are reproducible.
+        REQUIRE( partition_mesh(mesh, n_parts, options) == multilevel );
+
+    }
+
+}
+
+TEST_CASE("Test halo_elements() and extract_subdomain() functions for 'double' type.", "Partition") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = box(8, 6, 4);
+    const std::size_t n_parts = 4;
+    std::vector<std::size_t> parts = partition_mesh(mesh, n_parts);
+
+    double owned_volume = 0.0;
+    for (std::size_t part = 0; part < n_parts; ++part) {
+
+        Subdomain<double> subdomain = extract_subdomain(mesh, parts, part, 2);
+        const std::vector<std::size_t> first = halo_elements(mesh.tetrahedra, mesh.n_vertices(), parts, part, 1);
+
+        // Owned elements first, then the first layer, which touches the part.
+        std::vector<char> owned_vertex(mesh.n_vertices(), 0);
+        for (std::size_t k = 0; k < subdomain.n_owned_elements; ++k) {
+            REQUIRE( parts[subdomain.global_elements[k]] == part );
+            for (std::size_t v: mesh.tetrahedra[subdomain.global_elements[k]]) owned_vertex[v] = 1;
+        }
+        for (std::size_t k = 0; k < first.size(); ++k) {
+            REQUIRE( subdomain.global_elements[subdomain.n_owned_elements + k] == first[k] );
+            REQUIRE( parts[first[k]] != part );
+            bool touches = false;
+            for (std::size_t v: mesh.tetrahedra[first[k]]) touches = touches || owned_vertex[v];
+            REQUIRE( touches );
+        }
+        REQUIRE( subdomain.global_elements.size() > subdomain.n_owned_elements + first.size() );
+
+        // The local mesh reproduces the global geometry.
+        for (std::size_t k = 0; k < subdomain.mesh.n_tetrahedra(); ++k) {
+            const auto &t = subdomain.mesh.tetrahedra[k];
+            const auto &g = mesh.tetrahedra[subdomain.global_elements[k]];
+            for (std::size_t a = 0; a < 4; ++a) REQUIRE( subdomain.global_vertices[t[a]] == g[a] );
+            const double v = tetrahedron_volume(subdomain.mesh.vertices[t[0]], subdomain.mesh.vertices[t[1]],
+                                                subdomain.mesh.vertices[t[2]], subdomain.mesh.vertices[t[3]]);
+            if (k < subdomain.n_owned_elements) {
+                owned_volume += fabs(v);
+                for (std::size_t a = 0; a < 4; ++a) REQUIRE( t[a] < subdomain.n_interior_vertices );
+            }
+        }
+
+    }
+
+    REQUIRE( fabs(owned_volume - 8.0 * 6.0 * 4.0) < 1E-10 );
+
+}
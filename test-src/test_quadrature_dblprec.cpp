@@ -0,0 +1,144 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "quadrature.hpp"
+
+double factorial(int n) {
+
+    double f = 1.0;
+    for (int k = 2; k <= n; ++k) f *= k;
+    return f;
+
+}
+
+// The tables are compile time constants.
+static_assert(std::get<0>(org::lesleisnagy::geomlib::quadrature_tables<2>).size() == 1);
+static_assert(std::get<1>(org::lesleisnagy::geomlib::quadrature_tables<2>)[3].weight < 0.0);
+static_assert(std::get<4>(org::lesleisnagy::geomlib::quadrature_tables<3>).size() == 70);
+
+TEST_CASE("Test triangle_quadrature() function exactness for 'double' type.", "Quadrature") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    for (std::size_t order = 1; order <= max_quadrature_order; ++order) {
+
+        QuadratureRule<double> rule = triangle_quadrature<double>(order);
+        REQUIRE( rule.degree >= order );
+
+        double weight_sum = 0.0;
+        for (double w: rule.weights) weight_sum += w;
+        REQUIRE( fabs(weight_sum - 1.0) < 1E-14 );
+
+        // On the reference triangle (0,0), (1,0), (0,1), of area 1/2: int x^a y^b = a! b! / (a + b + 2)!.
+        for (int a = 0; a <= int(rule.degree); ++a) {
+            for (int b = 0; a + b <= int(rule.degree); ++b) {
+                double sum = 0.0;
+                for (std::size_t q = 0; q < rule.size(); ++q) {
+                    const double x = rule.barycentric[3 * q + 1], y = rule.barycentric[3 * q + 2];
+                    sum += rule.weights[q] * pow(x, a) * pow(y, b);
+                }
+                const double exact = factorial(a) * factorial(b) / factorial(a + b + 2);
+                REQUIRE( fabs(0.5 * sum - exact) < 1E-14 );
+            }
+        }
+
+    }
+
+}
+
+TEST_CASE("Test tetrahedron_quadrature() function exactness for 'double' type.", "Quadrature") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    for (std::size_t order = 1; order <= max_quadrature_order; ++order) {
+
+        QuadratureRule<double> rule = tetrahedron_quadrature<double>(order);
+        REQUIRE( rule.degree >= order );
+
+#ifdef DEBUG_MESSAGES
+        std::cout << "| order " << order << "        | " << rule.size() << " points"               << std::endl;
+#endif // DEBUG_MESSAGES
+
+        // On the reference tetrahedron, of volume 1/6: int x^a y^b z^c = a! b! c! / (a + b + c + 3)!.
+        for (int a = 0; a <= int(rule.degree); ++a) {
+            for (int b = 0; a + b <= int(rule.degree); ++b) {
+                for (int c = 0; a + b + c <= int(rule.degree); ++c) {
+                    double sum = 0.0;
+                    for (std::size_t q = 0; q < rule.size(); ++q) {
+                        const double x = rule.barycentric[4 * q + 1];
+                        const double y = rule.barycentric[4 * q + 2];
+                        const double z = rule.barycentric[4 * q + 3];
+                        sum += rule.weights[q] * pow(x, a) * pow(y, b) * pow(z, c);
+                    }
+                    const double exact = factorial(a) * factorial(b) * factorial(c) / factorial(a + b + c + 3);
+                    REQUIRE( fabs(sum / 6.0 - exact) < 1E-14 );
+                }
+            }
+        }
+
+    }
+
+    REQUIRE_THROWS( tetrahedron_quadrature<double>(0) );
+    REQUIRE_THROWS( tetrahedron_quadrature<double>(9) );
+
+}
+
+TEST_CASE("Test batch integrate() function over meshes for 'double' type.", "Quadrature") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    // The cube [0, 1] x [0, 2] x [0, 3] split into six tetrahedra (Kuhn triangulation), in several copies so that the
+    // element count spans multiple blocks and threads.
+    TetrahedralMesh<double> mesh;
+    for (int i = 0; i < 8; ++i) mesh.vertices.push_back(Vec3D(i & 1 ? 1.0 : 0.0, i & 2 ? 2.0 : 0.0, i & 4 ? 3.0 : 0.0));
+    const std::array<std::array<std::size_t, 4>, 6> kuhn = {{{0, 1, 3, 7}, {0, 1, 5, 7}, {0, 2, 3, 7},
+                                                            {0, 2, 6, 7}, {0, 4, 5, 7}, {0, 4, 6, 7}}};
+    const std::size_t copies = 100;
+    for (std::size_t c = 0; c < copies; ++c) for (const auto &t: kuhn) mesh.tetrahedra.push_back(t);
+
+    // int x^2 y z^3 over the cube = (1/3) (2) (81/4).
+    auto f = [](const Vec3D &r) { return r.x() * r.x() * r.y() * r.z() * r.z() * r.z(); };
+    const double exact = 1.0 / 3.0 * 2.0 * 81.0 / 4.0;
+
+    QuadratureRule<double> rule = tetrahedron_quadrature<double>(6);
+    std::vector<double> serial = integrate(mesh, rule, f, 1);
+    std::vector<double> threaded = integrate(mesh, rule, f, 3);
+
+    // The same integrand in batch form.
+    std::vector<double> batch = integrate(mesh, rule, [](const QuadratureBlock<double> &block) {
+        for (std::size_t k = 0; k < block.n_elements; ++k) {
+            block.values[k] = block.x[k] * block.x[k] * block.y[k] * block.z[k] * block.z[k] * block.z[k];
+        }
+    }, 2);
+
+    double total = 0.0;
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) {
+        REQUIRE( serial[e] == threaded[e] );
+        REQUIRE( serial[e] == batch[e] );
+        total += serial[e];
+    }
+    REQUIRE( fabs(total / copies - exact) < 1E-12 );
+
+    // Surface integral of x^2 + y over the two triangles of the unit square.
+    TriangleMesh<double> square;
+    square.vertices.push_back(Vec3D(0.0, 0.0, 0.0));
+    square.vertices.push_back(Vec3D(1.0, 0.0, 0.0));
+    square.vertices.push_back(Vec3D(1.0, 1.0, 0.0));
+    square.vertices.push_back(Vec3D(0.0, 1.0, 0.0));
+    square.triangles = {{0, 1, 2}, {0, 2, 3}};
+    std::vector<double> area = integrate(square, triangle_quadrature<double>(2),
+                                         [](const Vec3D &r) { return r.x() * r.x() + r.y(); });
+    REQUIRE( fabs(area[0] + area[1] - (1.0 / 3.0 + 0.5)) < 1E-12 );
+
+}
@@ -0,0 +1,80 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+
+#include "mpreal.h"
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "quadrature.hpp"
+
+TEST_CASE("Test tetrahedron_quadrature() function exactness for 'multiprecision' type.", "Quadrature") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+
+    const int digits = 50;
+    mpreal::set_default_prec(mpfr::digits2bits(digits));
+
+    auto factorial = [](int n) {
+        mpreal f = 1;
+        for (int k = 2; k <= n; ++k) f *= k;
+        return f;
+    };
+
+    for (std::size_t order = 1; order <= max_quadrature_order; ++order) {
+
+        // The rules are evaluated in the working precision rather than copied from the double tables.
+        QuadratureRule<mpreal> rule = tetrahedron_quadrature<mpreal>(order);
+
+        for (int a = 0; a <= int(rule.degree); ++a) {
+            for (int b = 0; a + b <= int(rule.degree); ++b) {
+                for (int c = 0; a + b + c <= int(rule.degree); ++c) {
+                    mpreal sum = 0;
+                    for (std::size_t q = 0; q < rule.size(); ++q) {
+                        sum += rule.weights[q] * pow(rule.barycentric[4 * q + 1], a) *
+                               pow(rule.barycentric[4 * q + 2], b) * pow(rule.barycentric[4 * q + 3], c);
+                    }
+                    const mpreal exact = factorial(a) * factorial(b) * factorial(c) / factorial(a + b + c + 3);
+                    REQUIRE( abs(sum / 6 - exact) < mpreal("1E-45") );
+                }
+            }
+        }
+
+    }
+
+}
+
+TEST_CASE("Test batch integrate() function over a triangle mesh for 'multiprecision' type.", "Quadrature") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using mpfr::mpreal;
+    using Vec3M = Vector3D<mpreal>;
+
+    const int digits = 50;
+    mpreal::set_default_prec(mpfr::digits2bits(digits));
+    Vec3M::set_eps(mpreal("1E-60"));
+
+    TriangleMesh<mpreal> square;
+    square.vertices.push_back(Vec3M(mpreal(0), mpreal(0), mpreal(0)));
+    square.vertices.push_back(Vec3M(mpreal(1), mpreal(0), mpreal(0)));
+    square.vertices.push_back(Vec3M(mpreal(1), mpreal(1), mpreal(0)));
+    square.vertices.push_back(Vec3M(mpreal(0), mpreal(1), mpreal(0)));
+    square.triangles = {{0, 2, 1}, {0, 3, 2}};
+
+    // int x^4 y^3 over the unit square = 1/20.
+    std::vector<mpreal> integral = integrate(square, triangle_quadrature<mpreal>(7), [](const Vec3M &r) {
+        return pow(r.x(), 4) * pow(r.y(), 3);
+    }, 2);
+
+    REQUIRE( abs(integral[0] + integral[1] - mpreal(1) / 20) < mpreal("1E-45") );
+
+}
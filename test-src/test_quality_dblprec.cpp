@@ -0,0 +1,181 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "parallel.hpp"
+#include "quality.hpp"
+
+TEST_CASE("Test tetrahedron_quality() function on a regular tetrahedron for 'double' type.", "Quality") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using std::string;
+    using Vec3D = Vector3D<double>;
+
+    Vec3D::set_eps(1E-12);
+    Vec3D r1(1.0, 1.0, 1.0);
+    Vec3D r2(1.0, -1.0, -1.0);
+    Vec3D r3(-1.0, 1.0, -1.0);
+    Vec3D r4(-1.0, -1.0, 1.0);
+
+    TetrahedronQuality<double> q = tetrahedron_quality(r1, r2, r3, r4);
+
+#ifdef DEBUG_MESSAGES
+    std::cout.precision(15);
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "|                  tetrahedron quality, regular (double)                    |" << std::endl;
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| volume          | " << q.volume                                          << std::endl;
+    std::cout << "| radius ratio    | " << q.radius_ratio                                    << std::endl;
+    std::cout << "| aspect ratio    | " << q.aspect_ratio                                    << std::endl;
+    std::cout << "| min dihedral    | " << q.min_dihedral_angle                              << std::endl;
+    std::cout << "| mean ratio      | " << q.mean_ratio                                      << std::endl;
+    std::cout << "| edge ratio      | " << q.edge_length_ratio                               << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    double eps = 1E-10;
+
+    REQUIRE( fabs(q.volume - tetrahedron_volume(r1, r2, r3, r4)) < eps );
+    REQUIRE( fabs(q.radius_ratio - 1.0) < eps );
+    REQUIRE( fabs(q.aspect_ratio - 1.0) < eps );
+    REQUIRE( fabs(q.min_dihedral_angle - acos(1.0 / 3.0)) < eps );
+    REQUIRE( fabs(q.mean_ratio - 1.0) < eps );
+    REQUIRE( fabs(q.edge_length_ratio - 1.0) < eps );
+
+    // Quality does not depend on orientation.
+    TetrahedronQuality<double> inverted = tetrahedron_quality(r2, r1, r3, r4);
+    REQUIRE( fabs(inverted.volume + q.volume) < eps );
+    REQUIRE( fabs(inverted.radius_ratio - 1.0) < eps );
+    REQUIRE( fabs(inverted.min_dihedral_angle - q.min_dihedral_angle) < eps );
+
+    Vec3D::set_eps(1E-7);
+
+}
+
+TEST_CASE("Test tetrahedron_quality() function on poor elements for 'double' type.", "Quality") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    // The standard corner tetrahedron.
+    Vec3D r1(0.0, 0.0, 0.0);
+    Vec3D r2(1.0, 0.0, 0.0);
+    Vec3D r3(0.0, 1.0, 0.0);
+    Vec3D r4(0.0, 0.0, 1.0);
+
+    TetrahedronQuality<double> q = tetrahedron_quality(r1, r2, r3, r4);
+
+    double eps = 1E-6;
+
+    // Radius ratio of the corner tetrahedron is 3 r_in / r_circ with r_in = 1/(3 + sqrt(3)), r_circ = sqrt(3)/2.
+    REQUIRE( fabs(q.radius_ratio - 3.0 / (3.0 + sqrt(3.0)) / (sqrt(3.0) / 2.0)) < eps );
+    REQUIRE( fabs(q.min_dihedral_angle - acos(1.0 / sqrt(3.0))) < eps );
+    REQUIRE( fabs(q.edge_length_ratio - 1.0 / sqrt(2.0)) < eps );
+
+    // A sliver: four nearly coplanar points on a square.
+    TetrahedronQuality<double> sliver = tetrahedron_quality(Vec3D(0.0, 0.0, 0.0), Vec3D(1.0, 0.0, 0.0),
+                                                            Vec3D(1.0, 1.0, 1E-4), Vec3D(0.0, 1.0, 0.0));
+    REQUIRE( sliver.radius_ratio < 1E-3 );
+    REQUIRE( sliver.mean_ratio < 1E-2 );
+    REQUIRE( sliver.aspect_ratio > 1E3 );
+    REQUIRE( sliver.min_dihedral_angle < 1E-3 );
+    REQUIRE( sliver.edge_length_ratio > 0.5 );
+
+}
+
+TEST_CASE("Test batch tetrahedron_quality() function and histogram() for 'double' type.", "Quality") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    TetrahedralMesh<double> mesh;
+    const std::size_t n_vertices = 2000;
+    for (std::size_t i = 0; i < n_vertices; ++i) mesh.vertices.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+
+    std::uniform_int_distribution<std::size_t> pick(0, n_vertices - 1);
+    for (std::size_t i = 0; i < 5000; ++i) {
+        std::array<std::size_t, 4> t = {pick(gen), pick(gen), pick(gen), pick(gen)};
+        if (t[0] == t[1] || t[0] == t[2] || t[0] == t[3] || t[1] == t[2] || t[1] == t[3] || t[2] == t[3]) continue;
+        mesh.tetrahedra.push_back(t);
+    }
+
+    auto serial = tetrahedron_quality(mesh, 1);
+    auto threaded = tetrahedron_quality(mesh, 4);
+
+    for (std::size_t i = 0; i < mesh.n_tetrahedra(); ++i) {
+        const auto &t = mesh.tetrahedra[i];
+        TetrahedronQuality<double> q = tetrahedron_quality(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                                           mesh.vertices[t[2]], mesh.vertices[t[3]]);
+        REQUIRE( serial.radius_ratio[i] == q.radius_ratio );
+        REQUIRE( threaded.radius_ratio[i] == q.radius_ratio );
+        REQUIRE( threaded.min_dihedral_angle[i] == q.min_dihedral_angle );
+        REQUIRE( threaded.mean_ratio[i] == q.mean_ratio );
+        REQUIRE( q.radius_ratio >= 0.0 );
+        REQUIRE( q.radius_ratio <= 1.0 + 1E-12 );
+        REQUIRE( q.mean_ratio <= 1.0 + 1E-12 );
+    }
+
+    Histogram h = histogram(threaded.radius_ratio, 0.0, 1.0, 10, 4);
+    Histogram h1 = histogram(serial.radius_ratio, 0.0, 1.0, 10, 1);
+
+    std::size_t total = h.underflow + h.overflow;
+    for (std::size_t b = 0; b < 10; ++b) {
+        total += h.counts[b];
+        REQUIRE( h.counts[b] == h1.counts[b] );
+    }
+    REQUIRE( total == mesh.n_tetrahedra() );
+    REQUIRE( h.underflow == 0 );
+    REQUIRE( fabs(h.bin_width() - 0.1) < 1E-15 );
+
+    REQUIRE_THROWS_AS( histogram(serial.radius_ratio, 0.0, 1.0, 0), std::invalid_argument );
+    REQUIRE_THROWS_AS( histogram(serial.radius_ratio, 1.0, 1.0, 10), std::invalid_argument );
+    REQUIRE_THROWS_AS( histogram(serial.radius_ratio, 1.0, 0.0, 10), std::invalid_argument );
+
+}
+
+TEST_CASE("Test parallel_for() function chunk count.", "Quality") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    // More threads than chunks of the rounded up chunk size: 9 indices over 8 threads make 5 chunks of 2.
+    std::atomic<std::size_t> n_calls = 0, n_indices = 0, n_beyond = 0;
+    const std::size_t used = parallel_for(0, 9, [&](std::size_t begin, std::size_t end, std::size_t t) {
+        n_beyond += t >= 5;
+        ++n_calls;
+        n_indices += end - begin;
+    }, 8, 1);
+    REQUIRE( used == 5 );
+    REQUIRE( n_calls == used );
+    REQUIRE( n_beyond == 0 );
+    REQUIRE( n_indices == 9 );
+
+    for (std::size_t n = 1; n <= 64; ++n) {
+        for (std::size_t n_threads = 1; n_threads <= 80; n_threads += 3) {
+            n_calls = 0;
+            n_indices = 0;
+            const std::size_t chunks = parallel_for(0, n, [&](std::size_t begin, std::size_t end, std::size_t) {
+                ++n_calls;
+                n_indices += end - begin;
+            }, n_threads, 1);
+            REQUIRE( chunks == n_calls );
+            REQUIRE( n_indices == n );
+        }
+    }
+
+}
@@ -0,0 +1,220 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "raycast.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TriangleMesh;
+
+/**
+ * Create the surface of the cube [0, n]^3, each face split into n x n squares of two triangles, wound so that
+ * triangle_normal() points out of the cube.
+ */
+TriangleMesh<double> cube_surface(std::size_t n) {
+
+    TriangleMesh<double> mesh;
+    for (std::size_t a = 0; a < 3; ++a) {
+        for (int side = 0; side < 2; ++side) {
+            // (e1, e2, axis) is right handed; swapping e1 and e2 turns the normal inwards for the lower face.
+            std::size_t e1 = (a + 1) % 3, e2 = (a + 2) % 3;
+            if (side == 0) std::swap(e1, e2);
+            auto vertex = [&](std::size_t i, std::size_t j) {
+                double r[3];
+                r[a] = side == 0 ? 0.0 : double(n);
+                r[e1] = double(i);
+                r[e2] = double(j);
+                mesh.vertices.push_back(Vector3D<double>(r[0], r[1], r[2]));
+                return mesh.n_vertices() - 1;
+            };
+            for (std::size_t i = 0; i < n; ++i) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    const std::size_t v00 = vertex(i, j), v10 = vertex(i + 1, j);
+                    const std::size_t v11 = vertex(i + 1, j + 1), v01 = vertex(i, j + 1);
+                    // Alternate the diagonals so that both orientations of shared edges occur.
+                    if ((i + j) % 2 == 0) {
+                        mesh.triangles.push_back({v00, v10, v11});
+                        mesh.triangles.push_back({v00, v11, v01});
+                    } else {
+                        mesh.triangles.push_back({v00, v10, v01});
+                        mesh.triangles.push_back({v10, v11, v01});
+                    }
+                }
+            }
+        }
+    }
+    return mesh;
+
+}
+
+TEST_CASE("Test ray_triangle_intersection() function for 'double' type.", "Raycast") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const Vec3D r1(1.0, 0.0, 0.5), r2(0.0, 2.0, 0.5), r3(-1.0, -1.0, 0.5);
+    const Vec3D normal = triangle_normal(r1, r2, r3);
+
+    // From the side the normal points to, through the point 0.2 r1 + 0.3 r2 + 0.5 r3.
+    const Vec3D target = 0.2 * r1 + 0.3 * r2 + 0.5 * r3;
+    const Vec3D origin = target + 3.0 * normal;
+    RayHit<double> hit = ray_triangle_intersection(origin, -1.0 * normal, r1, r2, r3);
+    REQUIRE( hit.hit() );
+    REQUIRE( hit.front_facing );
+    REQUIRE( fabs(hit.t - 3.0) < 1E-14 );
+    REQUIRE( fabs(hit.u - 0.3) < 1E-14 );
+    REQUIRE( fabs(hit.v - 0.5) < 1E-14 );
+
+    // From behind, and respecting the parameter interval.
+    hit = ray_triangle_intersection(target - 2.0 * normal, normal, r1, r2, r3);
+    REQUIRE( hit.hit() );
+    REQUIRE( !hit.front_facing );
+    REQUIRE( !ray_triangle_intersection(origin, -1.0 * normal, r1, r2, r3, 0.0, 2.5).hit() );
+    REQUIRE( !ray_triangle_intersection(origin, normal, r1, r2, r3).hit() );
+
+    // Missing, and edge-on.
+    REQUIRE( !ray_triangle_intersection(Vec3D(5.0, 5.0, 1.0), Vec3D(0.0, 0.0, -1.0), r1, r2, r3).hit() );
+    REQUIRE( !ray_triangle_intersection(Vec3D(-3.0, 0.0, 0.5), Vec3D(1.0, 0.0, 0.0), r1, r2, r3).hit() );
+
+    // A ray through the common edge of two triangles, or the common vertex of a fan, hits exactly one of them.
+    const Vec3D a(0.0, 0.0, 0.0), b(1.0, 0.0, 0.0), c(1.0, 1.0, 0.0), d(0.0, 1.0, 0.0), m(0.5, 0.5, 0.0);
+    for (const Vec3D &through: {Vec3D(0.25, 0.25, 0.0), Vec3D(0.5, 0.5, 0.0), Vec3D(0.0, 0.0, 0.0)}) {
+        for (const Vec3D &direction: {Vec3D(0.0, 0.0, -1.0), Vec3D(0.0, 0.0, 1.0), Vec3D(0.3, -0.2, 1.0)}) {
+            const Vec3D o = through - direction;
+            const std::size_t diagonal = ray_triangle_intersection(o, direction, a, b, c).hit() +
+                                         ray_triangle_intersection(o, direction, a, c, d).hit();
+            const std::size_t fan = ray_triangle_intersection(o, direction, m, a, b).hit() +
+                                    ray_triangle_intersection(o, direction, m, b, c).hit() +
+                                    ray_triangle_intersection(o, direction, m, c, d).hit() +
+                                    ray_triangle_intersection(o, direction, m, d, a).hit();
+            REQUIRE( diagonal == 1 );
+            if (through.x() != 0.0) REQUIRE( fan == 1 );
+        }
+    }
+
+}
+
+TEST_CASE("Test TriangleBvh count_crossings() and inside() functions for 'double' type.", "Raycast") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const std::size_t n = 4;
+    TriangleMesh<double> mesh = cube_surface(n);
+    TriangleBvh<double> bvh(mesh, 2);
+
+    // Rays from lattice points leave through grid vertices, grid edges, cube edges and cube corners.
+    std::size_t tested = 0;
+    for (std::size_t i = 0; i <= n + 2; ++i) {
+        for (std::size_t j = 0; j <= n + 2; ++j) {
+            for (std::size_t k = 0; k <= n + 2; ++k) {
+                const Vec3D origin(double(i) - 1.0, double(j) - 1.0, double(k) - 1.0);
+                const bool interior = i >= 2 && i <= n && j >= 2 && j <= n && k >= 2 && k <= n;
+                const bool exterior = i == 0 || i == n + 2 || j == 0 || j == n + 2 || k == 0 || k == n + 2;
+                if (!interior && !exterior) continue;
+                for (const Vec3D &direction: {Vec3D(1.0, 0.0, 0.0), Vec3D(0.0, -1.0, 0.0), Vec3D(1.0, 1.0, 0.0),
+                                              Vec3D(-1.0, 1.0, 1.0), Vec3D(0.5, 0.0, -1.0)}) {
+                    const std::size_t crossings = bvh.count_crossings(origin, direction);
+                    REQUIRE( crossings % 2 == (interior ? 1 : 0) );
+                    if (interior) REQUIRE( crossings == 1 );
+                    ++tested;
+                }
+            }
+        }
+    }
+    REQUIRE( tested > 500 );
+
+    // Classification of a lattice of points, none on the surface.
+    Vector3DSoA<double> points;
+    std::vector<char> expected;
+    for (int i = -2; i <= 2 * int(n) + 2; ++i) {
+        for (int j = -2; j <= 2 * int(n) + 2; ++j) {
+            for (int k = -2; k <= 2 * int(n) + 2; ++k) {
+                const Vec3D r(0.5 * i + 0.25, 0.5 * j + 0.25, 0.5 * k + 0.25);
+                points.push_back(r);
+                expected.push_back(r.x() > 0.0 && r.x() < double(n) && r.y() > 0.0 && r.y() < double(n) &&
+                                   r.z() > 0.0 && r.z() < double(n));
+            }
+        }
+    }
+    std::vector<char> inside(points.size());
+    bvh.inside(points, inside.data(), 2);
+    REQUIRE( inside == expected );
+
+}
+
+TEST_CASE("Test TriangleBvh intersect() function for 'double' type.", "Raycast") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const std::size_t n = 6;
+    TriangleMesh<double> mesh = cube_surface(n);
+    TriangleBvh<double> bvh(mesh);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> position(-2.0, double(n) + 2.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    Vector3DSoA<double> origins, directions;
+    for (std::size_t r = 0; r < 2000; ++r) {
+        origins.push_back(Vec3D(position(gen), position(gen), position(gen)));
+        directions.push_back(Vec3D(normal(gen), normal(gen), normal(gen)));
+    }
+    std::vector<RayHit<double>> hits(origins.size());
+    bvh.intersect(origins, directions, hits.data(), 3);
+
+    std::size_t n_hits = 0;
+    for (std::size_t r = 0; r < origins.size(); ++r) {
+
+        // Brute force nearest hit.
+        RayHit<double> expected;
+        for (std::size_t t = 0; t < mesh.n_triangles(); ++t) {
+            const auto &tri = mesh.triangles[t];
+            RayHit<double> hit = ray_triangle_intersection(origins[r], directions[r], mesh.vertices[tri[0]],
+                                                           mesh.vertices[tri[1]], mesh.vertices[tri[2]]);
+            if (hit.hit() && (!expected.hit() || hit.t < expected.t)) {
+                expected = hit;
+                expected.triangle = t;
+            }
+        }
+
+        const RayHit<double> single = bvh.intersect(origins[r], directions[r]);
+        REQUIRE( single.triangle == expected.triangle );
+        REQUIRE( hits[r].triangle == expected.triangle );
+        if (!expected.hit()) continue;
+        ++n_hits;
+        REQUIRE( hits[r].t == expected.t );
+        REQUIRE( single.t == expected.t );
+
+        // Rays from outside hit the outer side of the surface.
+        const Vec3D o = origins[r];
+        const bool outside = o.x() < 0.0 || o.x() > double(n) || o.y() < 0.0 || o.y() > double(n) ||
+                             o.z() < 0.0 || o.z() > double(n);
+        REQUIRE( hits[r].front_facing == outside );
+
+    }
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| rays            | " << origins.size()                                     << std::endl;
+    std::cout << "| hits            | " << n_hits                                             << std::endl;
+    std::cout << "| nodes           | " << bvh.nodes().size()                                 << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+    REQUIRE( n_hits > origins.size() / 4 );
+
+}
@@ -0,0 +1,177 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "predicates.hpp"
+#include "refinement.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+using org::lesleisnagy::geomlib::MeshRefiner;
+
+/**
+ * Check that the elements are positively oriented, fill the unit cube and meet face to face, and that the cached
+ * geometry is current.
+ */
+void check_conforming(const TetrahedralMesh<double> &mesh, const MeshRefiner<double> &refiner) {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    double volume = 0.0;
+    std::map<std::array<std::size_t, 3>, int> faces;
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) {
+        const auto &t = mesh.tetrahedra[e];
+        const Vector3D<double> r1 = mesh.vertices[t[0]], r2 = mesh.vertices[t[1]], r3 = mesh.vertices[t[2]],
+                               r4 = mesh.vertices[t[3]];
+        REQUIRE( orient3d(r1, r2, r3, r4) > 0 );
+        REQUIRE( refiner.volume(e) == tetrahedron_volume(r1, r2, r3, r4) );
+        REQUIRE( refiner.longest_edge_length(e) == std::max({edge_length(r1, r2), edge_length(r1, r3),
+                                                             edge_length(r1, r4), edge_length(r2, r3),
+                                                             edge_length(r2, r4), edge_length(r3, r4)}) );
+        volume += refiner.volume(e);
+        for (std::size_t f = 0; f < 4; ++f) {
+            std::array<std::size_t, 3> key = {t[(f + 1) % 4], t[(f + 2) % 4], t[(f + 3) % 4]};
+            std::sort(key.begin(), key.end());
+            ++faces[key];
+        }
+    }
+    REQUIRE( fabs(volume - 1.0) < 1E-12 );
+
+    // A hanging vertex would leave unmatched faces inside the cube, adding to the area of the unmatched ones.
+    double area = 0.0;
+    for (const auto &[face, count]: faces) {
+        REQUIRE( count <= 2 );
+        if (count != 1) continue;
+        const Vector3D<double> r1 = mesh.vertices[face[0]], r2 = mesh.vertices[face[1]], r3 = mesh.vertices[face[2]];
+        area += 0.5 * sqrt(norm_squared(cross(r2 - r1, r3 - r1)));
+    }
+    REQUIRE( fabs(area - 6.0) < 1E-12 );
+
+}
+
+/**
+ * Return the elements of a mesh as sorted vertex tuples, independent of the element order.
+ */
+std::vector<std::array<std::size_t, 4>> sorted_elements(const TetrahedralMesh<double> &mesh) {
+
+    std::vector<std::array<std::size_t, 4>> elements = mesh.tetrahedra;
+    for (auto &t: elements) std::sort(t.begin(), t.end());
+    std::sort(elements.begin(), elements.end());
+    return elements;
+
+}
+
+TEST_CASE("Test MeshRefiner refine() function for 'double' type.", "Refinement") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = kuhn_cube(3);
+    MeshRefiner<double> refiner(mesh, 1);
+
+    // Refine towards a corner: mark the elements whose centre is within a shrinking distance of it.
+    for (std::size_t step = 0; step < 6; ++step) {
+        std::vector<char> marked(mesh.n_tetrahedra(), 0);
+        for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) {
+            const auto &t = mesh.tetrahedra[e];
+            const Vector3D<double> centre = tetrahedron_center(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                                               mesh.vertices[t[2]], mesh.vertices[t[3]]);
+            marked[e] = norm_squared(centre) < 0.5 / double(step + 1);
+        }
+        const std::size_t n_before = mesh.n_tetrahedra();
+        const std::size_t n_bisections = refiner.refine(marked);
+        REQUIRE( n_bisections >= std::size_t(std::count(marked.begin(), marked.end(), 1)) );
+        REQUIRE( mesh.n_tetrahedra() == n_before + n_bisections );
+        check_conforming(mesh, refiner);
+    }
+
+    // The midpoints are shared and lie on their edges.
+    std::size_t max_level = 0;
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) max_level = std::max(max_level, refiner.level(e));
+    REQUIRE( max_level >= 6 );
+    for (std::size_t v = 64; v < mesh.n_vertices(); ++v) {
+        const auto [a, b] = refiner.parent_vertices(v);
+        REQUIRE( a != b );
+        const Vector3D<double> centre = edge_center(mesh.vertices[a], mesh.vertices[b]);
+        REQUIRE( centre.x() == mesh.vertices.x()[v] );
+        REQUIRE( centre.y() == mesh.vertices.y()[v] );
+        REQUIRE( centre.z() == mesh.vertices.z()[v] );
+    }
+
+}
+
+TEST_CASE("Test MeshRefiner coarsen() function for 'double' type.", "Refinement") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    const TetrahedralMesh<double> original = kuhn_cube(3);
+    TetrahedralMesh<double> mesh = original;
+    MeshRefiner<double> refiner(mesh, 1);
+
+    std::vector<char> marked(mesh.n_tetrahedra(), 0);
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); e += 7) marked[e] = 1;
+    refiner.refine(marked);
+    marked.assign(mesh.n_tetrahedra(), 1);
+    refiner.refine(marked);
+
+    // Coarsening everything back restores the original elements and leaves the midpoints unused.
+    for (std::size_t pass = 0; pass < 20; ++pass) {
+        marked.assign(mesh.n_tetrahedra(), 1);
+        if (refiner.coarsen(marked) == 0) break;
+        check_conforming(mesh, refiner);
+    }
+    REQUIRE( sorted_elements(mesh) == sorted_elements(original) );
+    for (std::size_t v = 0; v < mesh.n_vertices(); ++v) REQUIRE( refiner.is_vertex_used(v) == (v < 64) );
+
+    // Refining again reuses the vertex slots of the removed midpoints.
+    const std::size_t n_slots = mesh.n_vertices();
+    TetrahedralMesh<double> fresh = original;
+    MeshRefiner<double> fresh_refiner(fresh, 1);
+    marked.assign(mesh.n_tetrahedra(), 1);
+    refiner.refine(marked);
+    fresh_refiner.refine(marked);
+    REQUIRE( mesh.n_tetrahedra() == fresh.n_tetrahedra() );
+    REQUIRE( mesh.n_vertices() == std::max(n_slots, fresh.n_vertices()) );
+    check_conforming(mesh, refiner);
+
+    // Elements around a midpoint with an unmarked element keep it.
+    const std::size_t n_elements = mesh.n_tetrahedra();
+    marked.assign(mesh.n_tetrahedra(), 1);
+    marked[0] = 0;
+    REQUIRE( refiner.coarsen(marked) > 0 );
+    REQUIRE( mesh.n_tetrahedra() < n_elements );
+    REQUIRE( mesh.n_tetrahedra() > original.n_tetrahedra() );
+    check_conforming(mesh, refiner);
+
+}
+
+TEST_CASE("Test parallel MeshRefiner refine() function for 'double' type.", "Refinement") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> serial_mesh = kuhn_cube(8), parallel_mesh = serial_mesh;
+    MeshRefiner<double> serial(serial_mesh, 1), parallel(parallel_mesh, 4);
+    for (std::size_t step = 0; step < 2; ++step) {
+        std::vector<char> marked(serial_mesh.n_tetrahedra(), 1);
+        serial.refine(marked);
+        parallel.refine(marked);
+    }
+
+    // The rounds, and so the numbering, do not depend on the threads.
+    REQUIRE( serial_mesh.tetrahedra == parallel_mesh.tetrahedra );
+    REQUIRE( serial_mesh.n_vertices() == parallel_mesh.n_vertices() );
+    check_conforming(parallel_mesh, parallel);
+
+}
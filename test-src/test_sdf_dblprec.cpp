@@ -0,0 +1,187 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <map>
+#include <random>
+
+#include "vector3d.hpp"
+#include "mesh.hpp"
+#include "sdf.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TriangleMesh;
+
+/**
+ * Create the surface of the box [0, a] x [0, b] x [0, c] with unit squares split into two triangles, shared vertices
+ * numbered once and triangle_normal() pointing out of the box.
+ */
+TriangleMesh<double> box_surface(std::size_t a, std::size_t b, std::size_t c) {
+
+    TriangleMesh<double> mesh;
+    std::map<std::array<std::size_t, 3>, std::size_t> numbering;
+    const std::array<std::size_t, 3> n = {a, b, c};
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        for (int side = 0; side < 2; ++side) {
+            std::size_t e1 = (axis + 1) % 3, e2 = (axis + 2) % 3;
+            if (side == 0) std::swap(e1, e2);
+            auto vertex = [&](std::size_t i, std::size_t j) {
+                std::array<std::size_t, 3> r;
+                r[axis] = side == 0 ? 0 : n[axis];
+                r[e1] = i;
+                r[e2] = j;
+                auto [it, inserted] = numbering.emplace(r, mesh.n_vertices());
+                if (inserted) mesh.vertices.push_back(Vector3D<double>(double(r[0]), double(r[1]), double(r[2])));
+                return it->second;
+            };
+            for (std::size_t i = 0; i < n[e1]; ++i) {
+                for (std::size_t j = 0; j < n[e2]; ++j) {
+                    const std::size_t v00 = vertex(i, j), v10 = vertex(i + 1, j);
+                    const std::size_t v11 = vertex(i + 1, j + 1), v01 = vertex(i, j + 1);
+                    if ((i + j) % 2 == 0) {
+                        mesh.triangles.push_back({v00, v10, v11});
+                        mesh.triangles.push_back({v00, v11, v01});
+                    } else {
+                        mesh.triangles.push_back({v00, v10, v01});
+                        mesh.triangles.push_back({v10, v11, v01});
+                    }
+                }
+            }
+        }
+    }
+    return mesh;
+
+}
+
+/**
+ * The exact signed distance to the box [0, a] x [0, b] x [0, c].
+ */
+double box_distance(const Vector3D<double> &r, double a, double b, double c) {
+    const double dx = std::max(-r.x(), r.x() - a), dy = std::max(-r.y(), r.y() - b);
+    const double dz = std::max(-r.z(), r.z() - c);
+    const Vector3D<double> outside(std::max(dx, 0.0), std::max(dy, 0.0), std::max(dz, 0.0));
+    return sqrt(norm_squared(outside)) + std::min(std::max({dx, dy, dz}), 0.0);
+}
+
+TEST_CASE("Test closest_point_on_triangle() function for 'double' type.", "SignedDistance") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const Vec3D r1(0.0, 0.0, 0.0), r2(2.0, 0.0, 0.0), r3(0.0, 2.0, 0.0);
+
+    const std::vector<std::tuple<Vec3D, Vec3D, TriangleFeature>> cases = {
+            {Vec3D(-1.0, -1.0, 1.0), Vec3D(0.0, 0.0, 0.0), TriangleFeature::vertex1},
+            {Vec3D(3.0, -0.5, -1.0), Vec3D(2.0, 0.0, 0.0), TriangleFeature::vertex2},
+            {Vec3D(-0.5, 3.0, 2.0), Vec3D(0.0, 2.0, 0.0), TriangleFeature::vertex3},
+            {Vec3D(1.0, -1.0, 1.0), Vec3D(1.0, 0.0, 0.0), TriangleFeature::edge12},
+            {Vec3D(2.0, 2.0, -1.0), Vec3D(1.0, 1.0, 0.0), TriangleFeature::edge23},
+            {Vec3D(-3.0, 0.5, 0.0), Vec3D(0.0, 0.5, 0.0), TriangleFeature::edge31},
+            {Vec3D(0.5, 0.25, -4.0), Vec3D(0.5, 0.25, 0.0), TriangleFeature::face},
+    };
+    for (const auto &[p, expected, feature]: cases) {
+        const ClosestPoint<double> c = closest_point_on_triangle(p, r1, r2, r3);
+        REQUIRE( c.feature == feature );
+        REQUIRE( sqrt(norm_squared(c.point - expected)) < 1E-15 );
+    }
+
+    // Against sampling of the triangle.
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-3.0, 3.0);
+    const Vec3D s1(0.3, -0.2, 0.1), s2(1.7, 0.4, -0.6), s3(0.1, 1.3, 0.9);
+    for (std::size_t q = 0; q < 200; ++q) {
+        const Vec3D p(dist(gen), dist(gen), dist(gen));
+        const double d = sqrt(norm_squared(p - closest_point_on_triangle(p, s1, s2, s3).point));
+        double sampled = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i <= 50; ++i) {
+            for (std::size_t j = 0; i + j <= 50; ++j) {
+                const Vec3D r = s1 + (double(i) / 50.0) * (s2 - s1) + (double(j) / 50.0) * (s3 - s1);
+                sampled = std::min(sampled, sqrt(norm_squared(p - r)));
+            }
+        }
+        REQUIRE( d <= sampled + 1E-12 );
+        REQUIRE( sampled - d < 0.05 );
+    }
+
+}
+
+TEST_CASE("Test SignedDistanceField distance() function for 'double' type.", "SignedDistance") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const TriangleMesh<double> mesh = box_surface(3, 2, 4);
+    const SignedDistanceField<double> sdf(mesh, 2);
+
+    // Random points, and points on the diagonals of the box where the nearest point is a vertex or on an edge.
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(-2.0, 6.0);
+    Vector3DSoA<double> points;
+    for (std::size_t q = 0; q < 2000; ++q) points.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+    for (double s: {-1.5, -0.25, 0.5, 1.0}) {
+        points.push_back(Vec3D(-s, -s, -s));
+        points.push_back(Vec3D(3.0 + s, 2.0 + s, 4.0 + s));
+        points.push_back(Vec3D(1.5, -s, -s));
+        points.push_back(Vec3D(3.0 + s, 1.0, 4.0 + s));
+    }
+
+    std::vector<double> distances(points.size());
+    sdf.distance(points, distances.data(), 3);
+
+    double max_error = 0.0;
+    for (std::size_t q = 0; q < points.size(); ++q) {
+        const double expected = box_distance(points[q], 3.0, 2.0, 4.0);
+        REQUIRE( fabs(distances[q] - expected) < 1E-12 );
+        REQUIRE( distances[q] == sdf.distance(points[q]) );
+        max_error = std::max(max_error, fabs(distances[q] - expected));
+
+        const SurfacePoint<double> s = sdf.nearest(points[q]);
+        REQUIRE( s.triangle < mesh.n_triangles() );
+        REQUIRE( fabs(sqrt(norm_squared(points[q] - s.point)) - fabs(expected)) < 1E-12 );
+    }
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| points          | " << points.size()                                      << std::endl;
+    std::cout << "| max. error      | " << max_error                                          << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+}
+
+TEST_CASE("Test SignedDistanceField distance() function on a grid for 'double' type.", "SignedDistance") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const TriangleMesh<double> mesh = box_surface(3, 2, 4);
+    const SignedDistanceField<double> sdf(mesh);
+
+    RegularGrid<double> grid;
+    grid.origin = Vec3D(-1.9, -2.1, -1.7);
+    grid.spacing = 0.2;
+    grid.nx = 35;
+    grid.ny = 31;
+    grid.nz = 40;
+
+    for (std::size_t band: {1, 3}) {
+        const std::vector<double> distances = sdf.distance(grid, band, 3);
+        REQUIRE( distances.size() == grid.size() );
+        for (std::size_t k = 0; k < grid.nz; ++k) {
+            for (std::size_t j = 0; j < grid.ny; ++j) {
+                for (std::size_t i = 0; i < grid.nx; ++i) {
+                    const Vec3D r = grid.point(i, j, k);
+                    REQUIRE( fabs(distances[grid.index(i, j, k)] - box_distance(r, 3.0, 2.0, 4.0)) < 1E-12 );
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,154 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <array>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "predicates.hpp"
+#include "smoothing.hpp"
+
+#include "test_meshes.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TetrahedralMesh;
+
+/**
+ * The unit cube split into n x n x n cells of six tetrahedra each, with positive tetrahedron_volume()s, and its
+ * interior vertices moved randomly by up to `jitter` cell widths as long as no element inverts.
+ */
+TetrahedralMesh<double> jittered_cube(std::size_t n, double jitter, unsigned seed) {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    TetrahedralMesh<double> mesh = kuhn_cube(n);
+    const double h = 1.0 / double(n);
+    auto index = [n](std::size_t i, std::size_t j, std::size_t k) { return (k * (n + 1) + j) * (n + 1) + i; };
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(-jitter * h, jitter * h);
+    for (std::size_t k = 1; k < n; ++k) {
+        for (std::size_t j = 1; j < n; ++j) {
+            for (std::size_t i = 1; i < n; ++i) {
+                const std::size_t v = index(i, j, k);
+                const Vector3D<double> old = mesh.vertices[v];
+                for (std::size_t attempt = 0; attempt < 10; ++attempt) {
+                    mesh.vertices.set(v, old + Vector3D<double>(uniform(generator), uniform(generator),
+                                                                uniform(generator)));
+                    bool valid = true;
+                    for (const auto &t: mesh.tetrahedra) {
+                        if (t[0] != v && t[1] != v && t[2] != v && t[3] != v) continue;
+                        valid = valid && orient3d(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]],
+                                                  mesh.vertices[t[3]]) > 0;
+                    }
+                    if (valid) break;
+                    mesh.vertices.set(v, old);
+                }
+            }
+        }
+    }
+    return mesh;
+
+}
+
+/**
+ * Check that no element is inverted, that the boundary did not move and that the cached qualities are current.
+ */
+void check_smoothed(const TetrahedralMesh<double> &mesh, const TetrahedralMesh<double> &original,
+                    const org::lesleisnagy::geomlib::MeshSmoother<double> &smoother) {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    for (std::size_t e = 0; e < mesh.n_tetrahedra(); ++e) {
+        const auto &t = mesh.tetrahedra[e];
+        REQUIRE( orient3d(mesh.vertices[t[0]], mesh.vertices[t[1]], mesh.vertices[t[2]], mesh.vertices[t[3]]) > 0 );
+        REQUIRE( smoother.quality()[e] == signed_mean_ratio(mesh.vertices[t[0]], mesh.vertices[t[1]],
+                                                            mesh.vertices[t[2]], mesh.vertices[t[3]]) );
+    }
+    for (std::size_t v = 0; v < mesh.n_vertices(); ++v) {
+        if (!smoother.is_fixed(v)) continue;
+        REQUIRE( mesh.vertices.x()[v] == original.vertices.x()[v] );
+        REQUIRE( mesh.vertices.y()[v] == original.vertices.y()[v] );
+        REQUIRE( mesh.vertices.z()[v] == original.vertices.z()[v] );
+    }
+
+}
+
+TEST_CASE("Test signed_mean_ratio() function for 'double' type.", "Smoothing") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const Vec3D r1(1.0, 1.0, 1.0), r2(1.0, -1.0, -1.0), r3(-1.0, 1.0, -1.0), r4(-1.0, -1.0, 1.0);
+    const double q = signed_mean_ratio(r1, r2, r3, r4);
+    REQUIRE( fabs(fabs(q) - 1.0) < 1E-14 );
+    REQUIRE( signed_mean_ratio(r2, r1, r3, r4) == -q );
+    REQUIRE( (q > 0.0) == (tetrahedron_volume(r1, r2, r3, r4) > 0.0) );
+    REQUIRE( signed_mean_ratio(r1, r2, r3, Vec3D(0.0, 0.0, -1.0)) == 0.0 );
+
+}
+
+TEST_CASE("Test MeshSmoother smooth() function for 'double' type.", "Smoothing") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    const TetrahedralMesh<double> original = jittered_cube(8, 0.45, 1);
+
+    SECTION("smart Laplacian") {
+        TetrahedralMesh<double> mesh = original;
+        MeshSmoother<double> smoother(mesh, 4);
+        REQUIRE( smoother.n_colours() > 1 );
+        const SmoothingStatistics<double> statistics = smoother.smooth();
+        REQUIRE( statistics.n_moves > 0 );
+        REQUIRE( statistics.min_quality_after >= statistics.min_quality_before );
+        REQUIRE( statistics.mean_quality_after > statistics.mean_quality_before );
+        check_smoothed(mesh, original, smoother);
+    }
+
+    SECTION("Laplacian") {
+        TetrahedralMesh<double> mesh = original;
+        MeshSmoother<double> smoother(mesh, 4);
+        SmoothingOptions options;
+        options.method = SmoothingMethod::Laplacian;
+        const SmoothingStatistics<double> statistics = smoother.smooth(options);
+        REQUIRE( statistics.mean_quality_after > statistics.mean_quality_before );
+        check_smoothed(mesh, original, smoother);
+    }
+
+    SECTION("gradient") {
+        TetrahedralMesh<double> mesh = original;
+        MeshSmoother<double> smoother(mesh, 4);
+        SmoothingOptions options;
+        options.method = SmoothingMethod::Gradient;
+        options.max_sweeps = 20;
+        const SmoothingStatistics<double> statistics = smoother.smooth(options);
+        REQUIRE( statistics.min_quality_after > statistics.min_quality_before );
+        REQUIRE( statistics.mean_quality_after > statistics.mean_quality_before );
+        check_smoothed(mesh, original, smoother);
+    }
+
+    SECTION("fixed vertices and threads") {
+        TetrahedralMesh<double> serial_mesh = original, parallel_mesh = original;
+        MeshSmoother<double> serial(serial_mesh, 1), parallel(parallel_mesh, 4);
+        const std::size_t centre = (4 * 9 + 4) * 9 + 4;
+        serial.fix(centre);
+        parallel.fix(centre);
+        serial.smooth();
+        parallel.smooth();
+        REQUIRE( serial_mesh.vertices.x()[centre] == original.vertices.x()[centre] );
+
+        // A colour's vertices share no element, so the result does not depend on the threads.
+        for (std::size_t v = 0; v < original.n_vertices(); ++v) {
+            REQUIRE( serial_mesh.vertices.x()[v] == parallel_mesh.vertices.x()[v] );
+        }
+    }
+
+}
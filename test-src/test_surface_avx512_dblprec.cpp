@@ -0,0 +1,73 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "surface.hpp"
+
+// Defined in surface_avx512_kernel.cpp, the only part of this test built for AVX-512.
+void avx512_triangle_normals_areas_kernel(std::size_t n,
+                                          const double *x1, const double *y1, const double *z1,
+                                          const double *x2, const double *y2, const double *z2,
+                                          const double *x3, const double *y3, const double *z3,
+                                          double *nx, double *ny, double *nz, double *area,
+                                          double eps_squared);
+
+TEST_CASE("Test AVX-512 triangle normal & area kernel against the scalar kernel for 'double' type.", "Surface") {
+
+    using org::lesleisnagy::geomlib::detail::triangle_normals_areas_kernel;
+
+    if (!__builtin_cpu_supports("avx512f")) {
+        WARN("The CPU does not support AVX-512, the AVX-512 kernel is not tested.");
+        return;
+    }
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-20, 20);
+
+    // Whole vectors of eight and a remainder; every triangle at its own scale.
+    const std::size_t n = 8 * 125 + 3;
+    std::vector<std::vector<double>> r(9, std::vector<double>(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        const double scale = std::ldexp(1.0, exponent(gen));
+        for (auto &c: r) c[i] = scale * dist(gen);
+    }
+
+    // Degenerate triangles, left to the regularisation: collinear and coincident vertices.
+    for (std::size_t c = 0; c < 9; ++c) r[c][5] = double(c % 3 + 1) * double(c / 3);
+    for (std::size_t c = 0; c < 9; ++c) r[c][13] = 0.5;
+
+    const double eps_squared = 1E-14;
+    std::vector<double> nx(n), ny(n), nz(n), area(n);
+    std::vector<double> expected_nx(n), expected_ny(n), expected_nz(n), expected_area(n);
+
+    avx512_triangle_normals_areas_kernel(n, r[0].data(), r[1].data(), r[2].data(), r[3].data(), r[4].data(),
+                                         r[5].data(), r[6].data(), r[7].data(), r[8].data(),
+                                         nx.data(), ny.data(), nz.data(), area.data(), eps_squared);
+    triangle_normals_areas_kernel<double>(n, r[0].data(), r[1].data(), r[2].data(), r[3].data(), r[4].data(),
+                                          r[5].data(), r[6].data(), r[7].data(), r[8].data(),
+                                          expected_nx.data(), expected_ny.data(), expected_nz.data(),
+                                          expected_area.data(), eps_squared);
+
+    // Two Newton-Raphson steps from the 14-bit estimate leave the reciprocal square root within a couple of ulps;
+    // allow four, relative to the area and (for the unit normals) absolute.
+    const double tolerance = 4.0 * std::numeric_limits<double>::epsilon();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE( std::fabs(nx[i] - expected_nx[i]) <= tolerance );
+        REQUIRE( std::fabs(ny[i] - expected_ny[i]) <= tolerance );
+        REQUIRE( std::fabs(nz[i] - expected_nz[i]) <= tolerance );
+        REQUIRE( std::fabs(area[i] - expected_area[i]) <= tolerance * expected_area[i] );
+    }
+
+    REQUIRE( area[13] == Approx(1E-7 / 2.0) );
+
+}
@@ -0,0 +1,105 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "geometry.hpp"
+#include "mesh.hpp"
+#include "surface.hpp"
+
+TEST_CASE("Test triangle_normals_and_areas() function over SoA triangles for 'double' type.", "Surface") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    Vec3D::set_eps(1E-7);
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    // An odd count exercises any remainder loop after the vector body.
+    const std::size_t n = 1001;
+    Vector3DSoA<double> r1, r2, r3;
+    for (std::size_t i = 0; i < n; ++i) {
+        r1.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r2.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+        r3.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+    }
+
+    // A degenerate triangle: the regularisation keeps the result finite.
+    r1.push_back(Vec3D(0.0, 0.0, 0.0));
+    r2.push_back(Vec3D(1.0, 1.0, 1.0));
+    r3.push_back(Vec3D(2.0, 2.0, 2.0));
+
+    Vector3DSoA<double> normals;
+    std::vector<double> areas;
+    triangle_normals_and_areas(r1, r2, r3, normals, areas);
+
+    REQUIRE( normals.size() == n + 1 );
+    REQUIRE( areas.size() == n + 1 );
+
+    double eps = 1E-14;
+
+    for (std::size_t i = 0; i <= n; ++i) {
+        Vec3D expected_normal = triangle_normal(r1[i], r2[i], r3[i]);
+        double expected_area = triangle_area(r1[i], r2[i], r3[i]);
+        REQUIRE( fabs(normals[i].x() - expected_normal.x()) < eps );
+        REQUIRE( fabs(normals[i].y() - expected_normal.y()) < eps );
+        REQUIRE( fabs(normals[i].z() - expected_normal.z()) < eps );
+        REQUIRE( fabs(areas[i] - expected_area) <= eps * expected_area );
+    }
+
+    REQUIRE( areas[n] == Approx(1E-7 / 2.0) );
+    REQUIRE( normals[n].x() == 0.0 );
+
+}
+
+TEST_CASE("Test triangle_normals_and_areas() function over a surface mesh for 'double' type.", "Surface") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    Vec3D::set_eps(1E-7);
+
+    // A closed octahedron, wound so that all normals point outward.
+    TriangleMesh<double> mesh;
+    mesh.vertices.push_back(Vec3D( 1.0,  0.0,  0.0));
+    mesh.vertices.push_back(Vec3D(-1.0,  0.0,  0.0));
+    mesh.vertices.push_back(Vec3D( 0.0,  1.0,  0.0));
+    mesh.vertices.push_back(Vec3D( 0.0, -1.0,  0.0));
+    mesh.vertices.push_back(Vec3D( 0.0,  0.0,  1.0));
+    mesh.vertices.push_back(Vec3D( 0.0,  0.0, -1.0));
+    mesh.triangles = {{0, 2, 4}, {2, 1, 4}, {1, 3, 4}, {3, 0, 4},
+                      {2, 0, 5}, {1, 2, 5}, {3, 1, 5}, {0, 3, 5}};
+
+    // Repeat the faces to give the threads some work.
+    std::vector<std::array<std::size_t, 3>> faces = mesh.triangles;
+    for (int k = 0; k < 999; ++k) mesh.triangles.insert(mesh.triangles.end(), faces.begin(), faces.end());
+
+    Vector3DSoA<double> normals;
+    std::vector<double> areas;
+    triangle_normals_and_areas(mesh, normals, areas, 4);
+
+    REQUIRE( normals.size() == mesh.n_triangles() );
+
+    double eps = 1E-14;
+
+    for (std::size_t i = 0; i < mesh.n_triangles(); ++i) {
+        const auto &t = mesh.triangles[i];
+        Vec3D r1 = mesh.vertices[t[0]], r2 = mesh.vertices[t[1]], r3 = mesh.vertices[t[2]];
+        Vec3D c = triangle_center(r1, r2, r3);
+        REQUIRE( dot(normals[i], c) > 0.0 );
+        REQUIRE( fabs(areas[i] - triangle_area(r1, r2, r3)) < eps );
+        REQUIRE( fabs(normals[i].x() - triangle_normal(r1, r2, r3).x()) < eps );
+    }
+
+}
@@ -0,0 +1,154 @@
+//
+// Created by Lesleis Nagy on 19/10/2026.
+//
+
+#define CATCH_CONFIG_MAIN
+#include <catch/catch.hpp>
+
+#include <iostream>
+#include <random>
+
+#include "vector3d.hpp"
+#include "vector3d_soa.hpp"
+#include "mesh.hpp"
+#include "winding.hpp"
+
+using org::lesleisnagy::geomlib::Vector3D;
+using org::lesleisnagy::geomlib::TriangleMesh;
+
+/**
+ * A sphere of the given radius built from an n_theta x n_phi latitude/longitude grid, with triangle_normal() pointing
+ * outwards.
+ */
+TriangleMesh<double> sphere(double radius, std::size_t n_theta, std::size_t n_phi) {
+
+    TriangleMesh<double> mesh;
+    for (std::size_t i = 0; i <= n_theta; ++i) {
+        const double theta = M_PI * double(i) / double(n_theta);
+        for (std::size_t j = 0; j < n_phi; ++j) {
+            const double phi = 2.0 * M_PI * double(j) / double(n_phi);
+            mesh.vertices.push_back(Vector3D<double>(radius * sin(theta) * cos(phi), radius * sin(theta) * sin(phi),
+                                                     radius * cos(theta)));
+        }
+    }
+    for (std::size_t i = 0; i < n_theta; ++i) {
+        for (std::size_t j = 0; j < n_phi; ++j) {
+            const std::size_t a = i * n_phi + j, b = i * n_phi + (j + 1) % n_phi;
+            const std::size_t c = a + n_phi, d = b + n_phi;
+            if (i != 0) mesh.triangles.push_back({a, c, b});
+            if (i + 1 != n_theta) mesh.triangles.push_back({b, c, d});
+        }
+    }
+    return mesh;
+
+}
+
+TEST_CASE("Test winding_number() function for 'double' type.", "WindingNumber") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const TriangleMesh<double> mesh = sphere(1.0, 16, 32);
+
+    REQUIRE( fabs(winding_number(Vec3D(0.1, 0.2, -0.3), mesh) - 1.0) < 1E-12 );
+    REQUIRE( fabs(winding_number(Vec3D(0.0, 0.0, 0.0), mesh) - 1.0) < 1E-12 );
+    REQUIRE( fabs(winding_number(Vec3D(1.5, -0.2, 0.3), mesh)) < 1E-12 );
+    REQUIRE( fabs(winding_number(Vec3D(0.0, 0.0, 20.0), mesh)) < 1E-12 );
+
+    // Nested surfaces add up.
+    TriangleMesh<double> nested = mesh;
+    const TriangleMesh<double> inner = sphere(0.5, 8, 16);
+    for (const auto &t: inner.triangles) {
+        nested.triangles.push_back({t[0] + mesh.n_vertices(), t[1] + mesh.n_vertices(), t[2] + mesh.n_vertices()});
+    }
+    for (std::size_t v = 0; v < inner.n_vertices(); ++v) nested.vertices.push_back(inner.vertices[v]);
+    REQUIRE( fabs(winding_number(Vec3D(0.1, 0.0, 0.0), nested) - 2.0) < 1E-12 );
+    REQUIRE( fabs(winding_number(Vec3D(0.0, 0.7, 0.0), nested) - 1.0) < 1E-12 );
+
+}
+
+TEST_CASE("Test WindingNumber operator() function for 'double' type.", "WindingNumber") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    const TriangleMesh<double> mesh = sphere(1.0, 24, 48);
+
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-2.0, 2.0);
+    Vector3DSoA<double> points;
+    for (std::size_t q = 0; q < 1000; ++q) points.push_back(Vec3D(dist(gen), dist(gen), dist(gen)));
+
+    // A huge accuracy ratio never uses the dipole terms.
+    const WindingNumber<double> exact(mesh, 1E9);
+    // The default ratio.
+    const WindingNumber<double> fast(mesh);
+    std::vector<double> w(points.size());
+    fast(points, w.data(), 3);
+
+    double max_error = 0.0;
+    for (std::size_t q = 0; q < points.size(); ++q) {
+        const double expected = winding_number(points[q], mesh);
+        REQUIRE( fabs(exact(points[q]) - expected) < 1E-12 );
+        REQUIRE( w[q] == fast(points[q]) );
+        max_error = std::max(max_error, fabs(w[q] - expected));
+    }
+    REQUIRE( max_error < 0.1 );
+
+#ifdef DEBUG_MESSAGES
+    std::cout << "+---------------------------------------------------------------------------+" << std::endl;
+    std::cout << "| points          | " << points.size()                                      << std::endl;
+    std::cout << "| max. error      | " << max_error                                          << std::endl;
+    std::cout << "+-----------------+---------------------------------------------------------+" << std::endl;
+#endif // DEBUG_MESSAGES
+
+}
+
+TEST_CASE("Test WindingNumber inside() function on an imperfect surface for 'double' type.", "WindingNumber") {
+
+    using namespace org::lesleisnagy::geomlib;
+
+    using Vec3D = Vector3D<double>;
+
+    // Punch holes into the sphere and crack it open along a meridian by giving one side its own, displaced,
+    // vertices.
+    const std::size_t n_theta = 24, n_phi = 48;
+    const TriangleMesh<double> closed = sphere(1.0, n_theta, n_phi);
+    TriangleMesh<double> mesh;
+    mesh.vertices = closed.vertices;
+    std::vector<std::size_t> cracked(closed.n_vertices());
+    for (std::size_t v = 0; v < closed.n_vertices(); ++v) {
+        cracked[v] = mesh.n_vertices();
+        mesh.vertices.push_back(1.001 * closed.vertices[v]);
+    }
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (std::size_t t = 0; t < closed.n_triangles(); ++t) {
+        if (uniform(gen) < 0.03) continue;
+        auto triangle = closed.triangles[t];
+        if (triangle[0] % n_phi < n_phi / 2) {
+            for (std::size_t &v: triangle) v = cracked[v];
+        }
+        mesh.triangles.push_back(triangle);
+    }
+    REQUIRE( mesh.n_triangles() < closed.n_triangles() );
+
+    Vector3DSoA<double> points;
+    std::vector<char> expected;
+    std::uniform_real_distribution<double> dist(-2.0, 2.0);
+    while (points.size() < 2000) {
+        const Vec3D r(dist(gen), dist(gen), dist(gen));
+        const double radius = sqrt(norm_squared(r));
+        if (fabs(radius - 1.0) < 0.25) continue;
+        points.push_back(r);
+        expected.push_back(radius < 1.0);
+    }
+
+    const WindingNumber<double> winding(mesh);
+    std::vector<char> inside(points.size());
+    winding.inside(points, inside.data(), 3);
+    REQUIRE( inside == expected );
+
+}